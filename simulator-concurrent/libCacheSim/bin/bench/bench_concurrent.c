@@ -0,0 +1,223 @@
+//
+// the throughput of cache->get of each concurrent eviction algorithm
+// with 1 to 64 threads,
+// hit: every request hits, the cache holds half of its size
+// zipf: a synthetic Zipf stream over twice the cache size
+//
+// the cache is warmed up by the main thread as in parallel_simulate, then
+// each worker replays its own slice of the stream with the hash values
+// computed ahead of time, the reported ns/op is the wall time divided by the
+// number of requests of all threads, i.e., the inverse of the throughput
+//
+
+#define _GNU_SOURCE
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../dataStructure/hash/hash.h"
+#include "../../include/libCacheSim/logging.h"
+#include "../cachesim/cache_init.h"
+#include "internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+  const char *name;
+  obj_id_t *obj_ids;
+  uint64_t *hvs;
+  int64_t n_req;
+} bench_stream_t;
+
+typedef struct {
+  cache_t *cache;
+  const bench_stream_t *stream;
+  pthread_barrier_t *barrier;
+  int thread_id;
+  int n_thread;
+  int64_t n_miss;
+} worker_t;
+
+/* generate n ids in [1, n_obj] following a Zipf distribution */
+static obj_id_t *gen_zipf_ids(double alpha, int64_t n_obj, int64_t n) {
+  double *cdf = malloc(sizeof(double) * n_obj);
+  obj_id_t *ids = malloc(sizeof(obj_id_t) * n);
+  if (cdf == NULL || ids == NULL) {
+    ERROR("cannot allocate the Zipf stream of %ld requests\n", (long)n);
+  }
+
+  double sum = 0;
+  for (int64_t i = 0; i < n_obj; i++) {
+    sum += 1.0 / pow((double)(i + 1), alpha);
+    cdf[i] = sum;
+  }
+
+  for (int64_t i = 0; i < n; i++) {
+    double r = (double)(next_rand() >> 11) / (double)(1ULL << 53) * sum;
+    int64_t lo = 0, hi = n_obj - 1;
+    while (lo < hi) {
+      int64_t mid = (lo + hi) / 2;
+      if (cdf[mid] < r) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    ids[i] = lo + 1;
+  }
+
+  free(cdf);
+  return ids;
+}
+
+static void *worker_func(void *arg) {
+  worker_t *w = (worker_t *)arg;
+  cache_t *cache = w->cache;
+  const bench_stream_t *stream = w->stream;
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(w->thread_id % sysconf(_SC_NPROCESSORS_ONLN), &cpuset);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+  cache_attach_thread_stat(cache, w->thread_id);
+
+  request_t *req = new_request();
+  int64_t n_miss = 0;
+  pthread_barrier_wait(w->barrier);
+
+  /* the requests are dealt round-robin as in parallel_simulate */
+  for (int64_t i = w->thread_id; i < stream->n_req; i += w->n_thread) {
+    req->obj_id = stream->obj_ids[i];
+    req->hv = stream->hvs[i];
+    if (!cache->get(cache, req)) n_miss++;
+  }
+
+  w->n_miss = n_miss;
+  free_request(req);
+  return NULL;
+}
+
+/**
+ * @brief create a fresh cache, warm it up and time n_thread workers
+ * replaying the stream
+ *
+ * @return the wall time of the measured part in nanoseconds
+ */
+static uint64_t run_concurrent(const char *algo, int64_t cache_size,
+                               int n_thread, uint64_t seed,
+                               const bench_stream_t *stream,
+                               double *miss_ratio) {
+  set_rand_seed(seed);
+  cache_t *cache = create_cache(NULL, algo, cache_size, NULL, false, n_thread);
+
+  request_t *req = new_request();
+  bool is_hit = strcmp(stream->name, "hit") == 0;
+  if (is_hit) {
+    for (int64_t i = 0; i < cache_size / 2; i++) {
+      req->obj_id = i + 1;
+      req->hv = 0;
+      if (!cache->find(cache, req, true)) cache->insert(cache, req);
+    }
+  } else {
+    /* fill the cache with the head of the stream */
+    int64_t n_inserted = 0;
+    for (int64_t i = 0; i < stream->n_req && n_inserted < cache_size; i++) {
+      req->obj_id = stream->obj_ids[i];
+      req->hv = stream->hvs[i];
+      if (!cache->find(cache, req, true)) {
+        cache->insert(cache, req);
+        n_inserted++;
+      }
+    }
+  }
+  cache->warmup_complete = true;
+  free_request(req);
+
+  cache_init_thread_stat(cache, n_thread);
+  pthread_t *threads = malloc(sizeof(pthread_t) * n_thread);
+  worker_t *workers = malloc(sizeof(worker_t) * n_thread);
+  pthread_barrier_t barrier;
+  pthread_barrier_init(&barrier, NULL, n_thread + 1);
+
+  for (int i = 0; i < n_thread; i++) {
+    workers[i] = (worker_t){.cache = cache,
+                            .stream = stream,
+                            .barrier = &barrier,
+                            .thread_id = i,
+                            .n_thread = n_thread,
+                            .n_miss = 0};
+    pthread_create(&threads[i], NULL, worker_func, &workers[i]);
+  }
+
+  pthread_barrier_wait(&barrier);
+  uint64_t start = bench_now_ns();
+  int64_t n_miss = 0;
+  for (int i = 0; i < n_thread; i++) {
+    pthread_join(threads[i], NULL);
+    n_miss += workers[i].n_miss;
+  }
+  uint64_t ns = bench_now_ns() - start;
+
+  *miss_ratio = (double)n_miss / (double)stream->n_req;
+  pthread_barrier_destroy(&barrier);
+  free(workers);
+  free(threads);
+  cache->cache_free(cache);
+  return ns;
+}
+
+void bench_concurrent(const struct arguments *args, bench_report_t *report) {
+  int64_t cache_size = args->cache_size;
+  int64_t n_op = args->n_op;
+  bench_stream_t streams[2];
+  memset(streams, 0, sizeof(streams));
+
+  streams[0].name = "hit";
+  streams[0].obj_ids = malloc(sizeof(obj_id_t) * n_op);
+  for (int64_t i = 0; i < n_op; i++) {
+    streams[0].obj_ids[i] = bench_rand_below(cache_size / 2) + 1;
+  }
+  streams[1].name = "zipf";
+  streams[1].obj_ids = gen_zipf_ids(args->zipf_alpha, cache_size * 2, n_op);
+
+  for (int j = 0; j < 2; j++) {
+    streams[j].n_req = n_op;
+    streams[j].hvs = malloc(sizeof(uint64_t) * n_op);
+    get_hash_value_int_64_batch(streams[j].obj_ids, streams[j].hvs, n_op);
+  }
+
+  for (int i = 0; i < args->n_eviction_algo; i++) {
+    const char *algo = args->eviction_algo[i];
+    for (int j = 0; j < 2; j++) {
+      for (int k = 0; k < args->n_thread_cnt; k++) {
+        int n_thread = args->thread_cnts[k];
+        uint64_t ns[N_MAX_REPEAT];
+        double miss_ratio = 0;
+        for (int r = 0; r < args->n_repeat; r++) {
+          ns[r] = run_concurrent(algo, cache_size, n_thread, args->seed,
+                                 &streams[j], &miss_ratio);
+        }
+
+        char param[64];
+        snprintf(param, sizeof(param), "%s/c%ld/t%d", streams[j].name,
+                 (long)cache_size, n_thread);
+        bench_report_add(report, "concurrent", algo, param, n_op, ns,
+                         args->n_repeat, miss_ratio);
+      }
+    }
+  }
+
+  for (int j = 0; j < 2; j++) {
+    free(streams[j].obj_ids);
+    free(streams[j].hvs);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,200 @@
+#define _GNU_SOURCE
+#include <argp.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../../include/libCacheSim/logging.h"
+#include "internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const char *argp_program_version = "bench 0.0.1";
+const char *argp_program_bug_address =
+    "https://groups.google.com/g/libcachesim/";
+
+enum argp_option_short {
+  OPTION_EVICTION_ALGO = 'e',
+  OPTION_THREADS = 'j',
+  OPTION_NUM_OP = 'n',
+  OPTION_CACHE_SIZE = 'c',
+  OPTION_REPEAT = 'r',
+  OPTION_BASELINE = 'b',
+  OPTION_OUTPUT_PATH = 'o',
+
+  OPTION_SEED = 0x101,
+  OPTION_ZIPF_ALPHA = 0x102,
+  OPTION_REGRESSION_PCT = 0x103,
+};
+
+/*
+   OPTIONS.  Field 1 in ARGP.
+   Order of fields: {NAME, KEY, ARG, FLAGS, DOC}.
+*/
+static struct argp_option options[] = {
+    {NULL, 0, NULL, 0, "benchmark options:", 0},
+    {"eviction-algo", OPTION_EVICTION_ALGO, "lru,clock", 0,
+     "Comma separated eviction algorithms", 1},
+    {"threads", OPTION_THREADS, "1,2,4,8,16,32,64", 0,
+     "Comma separated numbers of threads to run each case with", 1},
+    {"num-op", OPTION_NUM_OP, "10000000", 0,
+     "Number of requests measured in each run, over all threads", 1},
+    {"cache-size", OPTION_CACHE_SIZE, "1048576", 0,
+     "Cache size in objects", 1},
+    {"repeat", OPTION_REPEAT, "5", 0,
+     "Number of runs of each case, the median is reported", 1},
+    {"seed", OPTION_SEED, "42", 0, "Random seed of the streams", 1},
+    {"zipf-alpha", OPTION_ZIPF_ALPHA, "1.0", 0,
+     "Skewness of the synthetic Zipf stream", 1},
+
+    {NULL, 0, NULL, 0, "output:", 0},
+    {"output", OPTION_OUTPUT_PATH, "bench.csv", 0,
+     "Also write the CSV results to this file", 5},
+    {"baseline", OPTION_BASELINE, "baseline.csv", 0,
+     "Compare with the CSV output of an earlier run", 5},
+    {"regression-pct", OPTION_REGRESSION_PCT, "10", 0,
+     "A case slower than the baseline by more than this percentage is a "
+     "regression, the exit code is 1 if there is any",
+     5},
+
+    {0}};
+
+/* the algorithms that support concurrent get */
+static const char *default_algos = "lru,clock,lru-prob,lru-delay,batch,fh,bp";
+static const char *default_thread_cnts = "1,2,4,8,16,32,64";
+
+static void split_algos(char *algos, struct arguments *args) {
+  args->n_eviction_algo = 0;
+  char *saveptr = NULL;
+  char *algo = strtok_r(algos, ",", &saveptr);
+  while (algo != NULL) {
+    if (args->n_eviction_algo >= N_MAX_ALGO) {
+      ERROR("too many eviction algorithms, at most %d\n", N_MAX_ALGO);
+    }
+    args->eviction_algo[args->n_eviction_algo++] = algo;
+    algo = strtok_r(NULL, ",", &saveptr);
+  }
+}
+
+static void split_thread_cnts(const char *thread_cnts, struct arguments *args) {
+  args->n_thread_cnt = 0;
+  const char *p = thread_cnts;
+  while (*p != '\0') {
+    if (args->n_thread_cnt >= N_MAX_THREAD_CNT) {
+      ERROR("too many thread counts, at most %d\n", N_MAX_THREAD_CNT);
+    }
+    int n_thread = atoi(p);
+    if (n_thread <= 0) {
+      ERROR("invalid thread count in %s\n", thread_cnts);
+    }
+    args->thread_cnts[args->n_thread_cnt++] = n_thread;
+    p += strcspn(p, ",");
+    if (*p == ',') p++;
+  }
+}
+
+/*
+   PARSER. Field 2 in ARGP.
+   Order of parameters: KEY, ARG, STATE.
+*/
+static error_t parse_opt(int key, char *arg, struct argp_state *state) {
+  struct arguments *arguments = state->input;
+
+  switch (key) {
+    case OPTION_EVICTION_ALGO:
+      split_algos(arg, arguments);
+      break;
+    case OPTION_THREADS:
+      split_thread_cnts(arg, arguments);
+      break;
+    case OPTION_NUM_OP:
+      arguments->n_op = atoll(arg);
+      break;
+    case OPTION_CACHE_SIZE:
+      arguments->cache_size = atoll(arg);
+      break;
+    case OPTION_REPEAT:
+      arguments->n_repeat = atoi(arg);
+      break;
+    case OPTION_SEED:
+      arguments->seed = strtoull(arg, NULL, 10);
+      break;
+    case OPTION_ZIPF_ALPHA:
+      arguments->zipf_alpha = atof(arg);
+      break;
+    case OPTION_OUTPUT_PATH:
+      strncpy(arguments->ofilepath, arg, OFILEPATH_LEN - 1);
+      break;
+    case OPTION_BASELINE:
+      arguments->baseline_path = arg;
+      break;
+    case OPTION_REGRESSION_PCT:
+      arguments->regression_pct = atof(arg);
+      break;
+    case ARGP_KEY_ARG:
+      printf("bench does not take positional arguments, found %s\n", arg);
+      argp_usage(state);
+      exit(1);
+    default:
+      return ARGP_ERR_UNKNOWN;
+  }
+  return 0;
+}
+
+/* Program documentation. */
+static char doc[] =
+    "example: ./bench -e lru,clock -j 1,8,64 -o bench.csv\n"
+    "         ./bench -b bench.csv\n\n"
+    "each case is run several times and the median ns/op is printed as CSV "
+    "on stdout, when a baseline is given, the change of each case is "
+    "printed on stderr\n\n";
+
+/**
+ * @brief initialize the arguments
+ *
+ * @param args
+ */
+static void init_arg(struct arguments *args) {
+  memset(args, 0, sizeof(struct arguments));
+
+  static char algos[512];
+  strncpy(algos, default_algos, sizeof(algos) - 1);
+
+  split_algos(algos, args);
+  split_thread_cnts(default_thread_cnts, args);
+  args->n_op = 10000000;
+  args->cache_size = 1 << 20;
+  args->n_repeat = 5;
+  args->seed = 42;
+  args->zipf_alpha = 1.0;
+  args->regression_pct = 10;
+}
+
+/**
+ * @brief parse the command line arguments
+ *
+ * @param argc
+ * @param argv
+ */
+void parse_cmd(int argc, char *argv[], struct arguments *args) {
+  init_arg(args);
+
+  static struct argp argp = {options, parse_opt, NULL, doc};
+
+  argp_parse(&argp, argc, argv, 0, 0, args);
+
+  if (args->n_repeat < 1 || args->n_repeat > N_MAX_REPEAT) {
+    ERROR("repeat should be in [1, %d]\n", N_MAX_REPEAT);
+  }
+  if (args->n_op <= 0 || args->n_op > UINT32_MAX) {
+    ERROR("num-op should be in [1, %u]\n", UINT32_MAX);
+  }
+  if (args->cache_size < 2 || args->cache_size > UINT32_MAX) {
+    ERROR("cache-size should be in [2, %u]\n", UINT32_MAX);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
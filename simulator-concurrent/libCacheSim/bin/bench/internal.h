@@ -0,0 +1,98 @@
+#pragma once
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../../include/libCacheSim/cache.h"
+#include "../../utils/include/mymath.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define N_MAX_ALGO 64
+#define N_MAX_REPEAT 64
+#define N_MAX_THREAD_CNT 16
+#define OFILEPATH_LEN 128
+
+/* This structure is used to communicate with parse_opt. */
+struct arguments {
+  char *eviction_algo[N_MAX_ALGO];
+  int n_eviction_algo;
+  /* the numbers of threads to run each case with */
+  int thread_cnts[N_MAX_THREAD_CNT];
+  int n_thread_cnt;
+  /* the number of operations measured in each run, over all threads */
+  int64_t n_op;
+  /* the cache size in objects */
+  int64_t cache_size;
+  int n_repeat;
+  uint64_t seed;
+  double zipf_alpha;
+
+  char *baseline_path;
+  /* a case is a regression if it is this much slower than the baseline */
+  double regression_pct;
+  char ofilepath[OFILEPATH_LEN];
+};
+
+/* one row of the output, also used to hold the rows of the baseline */
+typedef struct {
+  char suite[16];
+  char name[32];
+  char param[64];
+  uint64_t n_op;
+  double ns_per_op;     /* median over the runs */
+  double min_ns_per_op; /* the fastest run */
+  double miss_ratio;    /* only for the algo suite, -1 otherwise */
+} bench_result_t;
+
+typedef struct {
+  FILE *ofile;
+  bench_result_t *baseline;
+  int n_baseline;
+  double regression_pct;
+  int n_result;
+  int n_regression;
+} bench_report_t;
+
+void parse_cmd(int argc, char *argv[], struct arguments *args);
+
+void bench_report_open(bench_report_t *report, const struct arguments *args);
+
+/**
+ * @brief summarize the per-run timings of one case, print it as a CSV row,
+ * and compare it with the same case in the baseline
+ *
+ * @param report
+ * @param suite
+ * @param name
+ * @param param
+ * @param n_op the number of operations in each run
+ * @param ns the total nanoseconds of each run
+ * @param n_run
+ * @param miss_ratio
+ */
+void bench_report_add(bench_report_t *report, const char *suite,
+                      const char *name, const char *param, uint64_t n_op,
+                      const uint64_t *ns, int n_run, double miss_ratio);
+
+void bench_report_close(bench_report_t *report);
+
+void bench_concurrent(const struct arguments *args, bench_report_t *report);
+
+static inline uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* a uniform integer in [0, n) */
+static inline uint64_t bench_rand_below(uint64_t n) {
+  return ((next_rand() >> 32) * n) >> 32;
+}
+
+#ifdef __cplusplus
+}
+#endif
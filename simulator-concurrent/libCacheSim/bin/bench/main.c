@@ -0,0 +1,23 @@
+//
+// microbenchmarks of the concurrent eviction algorithms,
+// see the Microbenchmarks section of the README
+//
+
+#include <stdlib.h>
+
+#include "internal.h"
+
+int main(int argc, char **argv) {
+  struct arguments args;
+  parse_cmd(argc, argv, &args);
+  set_rand_seed(args.seed);
+
+  bench_report_t report;
+  bench_report_open(&report, &args);
+
+  bench_concurrent(&args, &report);
+
+  bench_report_close(&report);
+
+  return report.n_regression > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
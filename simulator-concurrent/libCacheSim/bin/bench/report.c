@@ -0,0 +1,145 @@
+//
+// print the benchmark results as CSV and compare them with a baseline,
+// the baseline is the CSV output of an earlier run
+//
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/libCacheSim/logging.h"
+#include "internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CSV_HEADER "suite,name,param,n_op,ns_per_op,min_ns_per_op,miss_ratio"
+
+static void print_row(FILE *ofile, const bench_result_t *r) {
+  fprintf(ofile, "%s,%s,%s,%lu,%.3lf,%.3lf,%.6lf\n", r->suite, r->name,
+          r->param, (unsigned long)r->n_op, r->ns_per_op, r->min_ns_per_op,
+          r->miss_ratio);
+}
+
+static int load_baseline(const char *path, bench_result_t **results) {
+  FILE *ifile = fopen(path, "r");
+  if (ifile == NULL) {
+    ERROR("cannot open baseline %s: %s\n", path, strerror(errno));
+  }
+
+  int n_result = 0, n_alloc = 256;
+  bench_result_t *r = malloc(sizeof(bench_result_t) * n_alloc);
+  char line[512];
+  while (fgets(line, sizeof(line), ifile) != NULL) {
+    if (strncmp(line, "suite,", 6) == 0) continue;
+    if (n_result == n_alloc) {
+      n_alloc *= 2;
+      r = realloc(r, sizeof(bench_result_t) * n_alloc);
+    }
+    unsigned long n_op;
+    int n_field = sscanf(line, "%15[^,],%31[^,],%63[^,],%lu,%lf,%lf,%lf",
+                         r[n_result].suite, r[n_result].name,
+                         r[n_result].param, &n_op, &r[n_result].ns_per_op,
+                         &r[n_result].min_ns_per_op, &r[n_result].miss_ratio);
+    if (n_field != 7) {
+      WARN("skip malformed baseline line: %s", line);
+      continue;
+    }
+    r[n_result].n_op = n_op;
+    n_result += 1;
+  }
+  fclose(ifile);
+
+  *results = r;
+  return n_result;
+}
+
+static const bench_result_t *find_baseline(const bench_report_t *report,
+                                           const bench_result_t *r) {
+  for (int i = 0; i < report->n_baseline; i++) {
+    const bench_result_t *b = &report->baseline[i];
+    if (strcmp(b->suite, r->suite) == 0 && strcmp(b->name, r->name) == 0 &&
+        strcmp(b->param, r->param) == 0) {
+      return b;
+    }
+  }
+  return NULL;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+void bench_report_open(bench_report_t *report, const struct arguments *args) {
+  memset(report, 0, sizeof(bench_report_t));
+  report->regression_pct = args->regression_pct;
+
+  if (args->baseline_path != NULL) {
+    report->n_baseline = load_baseline(args->baseline_path, &report->baseline);
+    INFO("loaded %d baseline results from %s\n", report->n_baseline,
+         args->baseline_path);
+  }
+
+  if (args->ofilepath[0] != '\0') {
+    report->ofile = fopen(args->ofilepath, "w");
+    if (report->ofile == NULL) {
+      ERROR("cannot open %s: %s\n", args->ofilepath, strerror(errno));
+    }
+    fprintf(report->ofile, "%s\n", CSV_HEADER);
+  }
+
+  printf("%s\n", CSV_HEADER);
+}
+
+void bench_report_add(bench_report_t *report, const char *suite,
+                      const char *name, const char *param, uint64_t n_op,
+                      const uint64_t *ns, int n_run, double miss_ratio) {
+  uint64_t sorted[N_MAX_REPEAT];
+  memcpy(sorted, ns, sizeof(uint64_t) * n_run);
+  qsort(sorted, n_run, sizeof(uint64_t), cmp_u64);
+
+  bench_result_t r;
+  memset(&r, 0, sizeof(r));
+  strncpy(r.suite, suite, sizeof(r.suite) - 1);
+  strncpy(r.name, name, sizeof(r.name) - 1);
+  strncpy(r.param, param, sizeof(r.param) - 1);
+  r.n_op = n_op;
+  r.ns_per_op = (double)sorted[n_run / 2] / (double)n_op;
+  r.min_ns_per_op = (double)sorted[0] / (double)n_op;
+  r.miss_ratio = miss_ratio;
+
+  print_row(stdout, &r);
+  fflush(stdout);
+  if (report->ofile != NULL) print_row(report->ofile, &r);
+  report->n_result += 1;
+
+  const bench_result_t *b = find_baseline(report, &r);
+  if (b == NULL) return;
+
+  double change_pct = (r.ns_per_op / b->ns_per_op - 1) * 100;
+  if (change_pct > report->regression_pct) {
+    report->n_regression += 1;
+    fprintf(stderr, "REGRESSION %s/%s/%s: %.2lf -> %.2lf ns/op (%+.1lf%%)\n",
+            r.suite, r.name, r.param, b->ns_per_op, r.ns_per_op, change_pct);
+  } else {
+    fprintf(stderr, "%s/%s/%s: %.2lf -> %.2lf ns/op (%+.1lf%%)\n", r.suite,
+            r.name, r.param, b->ns_per_op, r.ns_per_op, change_pct);
+  }
+}
+
+void bench_report_close(bench_report_t *report) {
+  if (report->ofile != NULL) fclose(report->ofile);
+  if (report->baseline != NULL) free(report->baseline);
+
+  if (report->n_baseline > 0) {
+    fprintf(stderr, "%d of %d cases are more than %.1lf%% slower than the "
+            "baseline\n", report->n_regression, report->n_result,
+            report->regression_pct);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -25,6 +25,8 @@ static int conv_cache_sizes(char *cache_size_str, struct arguments *args);
 
 static void parse_eviction_algo(struct arguments *args, const char *arg);
 
+static unsigned long conv_size_str_to_byte_ul(char *cache_size_str);
+
 const char *argp_program_version = "cachesim 0.0.1";
 const char *argp_program_bug_address =
     "https://groups.google.com/g/libcachesim";
@@ -47,6 +49,10 @@ enum argp_option_short {
 
   OPTION_PREFETCH_ALGO = 'p',
   OPTION_PREFETCH_PARAMS = 0x109,
+  OPTION_OUTPUT_FORMAT = 0x10a,
+  OPTION_PERF_COUNTER = 0x10b,
+  OPTION_THREAD_PLACEMENT = 0x10c,
+  OPTION_OCCUPANCY_SLACK = 0x10d,
 };
 
 /*
@@ -81,6 +87,10 @@ static struct argp_option options[] = {
     {"ignore-obj-size", OPTION_IGNORE_OBJ_SIZE, "false", 0,
      "specify to ignore the object size from the trace", 6},
     {"output", OPTION_OUTPUT_PATH, "output", 0, "Output path", 6},
+    {"output-format", OPTION_OUTPUT_FORMAT, "txt", 0,
+     "Output format: txt/json/csv, json and csv append one record per cache "
+     "to the output path",
+     6},
     {"num-thread", OPTION_NUM_THREAD, "16", 0,
      "Number of threads if running when using default cache sizes", 6},
 
@@ -92,6 +102,20 @@ static struct argp_option options[] = {
      10},
     {"consider-obj-metadata", OPTION_CONSIDER_OBJ_METADATA, "false", 0,
      "Whether consider per object metadata size in the simulated cache", 10},
+    {"perf-counter", OPTION_PERF_COUNTER, "false", 0,
+     "count cycles, instructions, LLC/dTLB/branch misses and context "
+     "switches of each worker thread with perf_event_open",
+     10},
+    {"thread-placement", OPTION_THREAD_PLACEMENT, "linear", 0,
+     "where the worker threads run: linear/compact/scatter/physical-core/"
+     "node-local/none, read from the CPU topology in sysfs",
+     10},
+    {"occupancy-slack", OPTION_OCCUPANCY_SLACK, "0", 0,
+     "keep the occupancy changes of each worker thread local until they "
+     "reach this many bytes over all threads, which bounds how far the cache "
+     "may overshoot its size, at most 1/64 of the cache size, 0 updates the "
+     "shared counters on every miss",
+     10},
     {"verbose", OPTION_VERBOSE, "1", 0, "Produce verbose output", 10},
 
     {0}};
@@ -137,6 +161,17 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
     case OPTION_OUTPUT_PATH:
       strncpy(arguments->ofilepath, arg, OFILEPATH_LEN);
       break;
+    case OPTION_OUTPUT_FORMAT:
+      if (strcasecmp(arg, "txt") == 0) {
+        arguments->output_format = OUTPUT_FORMAT_TXT;
+      } else if (strcasecmp(arg, "json") == 0) {
+        arguments->output_format = OUTPUT_FORMAT_JSON;
+      } else if (strcasecmp(arg, "csv") == 0) {
+        arguments->output_format = OUTPUT_FORMAT_CSV;
+      } else {
+        ERROR("unknown output format %s, supported: txt/json/csv\n", arg);
+      }
+      break;
     case OPTION_NUM_REQ:
       arguments->n_req = atoi(arg);
       break;
@@ -164,6 +199,23 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
     case OPTION_WARMUP_SEC:
       arguments->warmup_sec = atoi(arg);
       break;
+    case OPTION_PERF_COUNTER:
+      arguments->use_perf_counter = is_true(arg) ? true : false;
+      break;
+    case OPTION_OCCUPANCY_SLACK:
+      arguments->occupancy_slack = (int64_t)conv_size_str_to_byte_ul(arg);
+      if (arguments->occupancy_slack < 0) {
+        ERROR("occupancy slack %s must not be negative\n", arg);
+      }
+      break;
+    case OPTION_THREAD_PLACEMENT:
+      if (!parse_placement_policy(arg, &arguments->thread_placement)) {
+        ERROR(
+            "unknown thread placement %s, supported: linear/compact/scatter/"
+            "physical-core/node-local/none\n",
+            arg);
+      }
+      break;
     case ARGP_KEY_ARG:
       if (state->arg_num >= N_ARGS) {
         printf("found too many arguments, current %s\n", arg);
@@ -218,8 +270,12 @@ static void init_arg(struct arguments *args) {
   args->trace_type_params = NULL;
   args->verbose = true;
   args->use_ttl = false;
+  args->output_format = OUTPUT_FORMAT_TXT;
   args->ignore_obj_size = false;
   args->consider_obj_metadata = false;
+  args->use_perf_counter = false;
+  args->thread_placement = PLACEMENT_LINEAR;
+  args->occupancy_slack = 0;
   args->report_interval = 3600 * 24;
   args->n_thread = n_cores();
   args->warmup_sec = -1;
@@ -282,8 +338,12 @@ void parse_cmd(int argc, char *argv[], struct arguments *args) {
 
   if (args->ofilepath[0] == '\0') {
     char *trace_filename = rindex(args->trace_path, '/');
-    snprintf(args->ofilepath, OFILEPATH_LEN, "%s.cachesim",
-             trace_filename == NULL ? args->trace_path : trace_filename + 1);
+    const char *ext = args->output_format == OUTPUT_FORMAT_JSON  ? ".json"
+                      : args->output_format == OUTPUT_FORMAT_CSV ? ".csv"
+                                                                 : "";
+    snprintf(args->ofilepath, OFILEPATH_LEN, "%s.cachesim%s",
+             trace_filename == NULL ? args->trace_path : trace_filename + 1,
+             ext);
   }
 
   /* convert trace type string to enum */
@@ -297,6 +357,8 @@ void parse_cmd(int argc, char *argv[], struct arguments *args) {
   reader_init_params.obj_id_is_num = true;
   reader_init_params.cap_at_n_req = args->n_req;
   reader_init_params.sampler = NULL;
+  /* the hash table and the sampler use the hash from the reader */
+  reader_init_params.offload_hash = true;
 
   parse_reader_params(args->trace_type_params, &reader_init_params);
 
@@ -528,9 +590,28 @@ void print_parsed_args(struct arguments *args) {
     n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1,
                   ", eviction-params: %s", args->eviction_params);
 
+  if (args->output_format == OUTPUT_FORMAT_JSON)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1,
+                  ", output format json");
+  else if (args->output_format == OUTPUT_FORMAT_CSV)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1,
+                  ", output format csv");
+
   if (args->use_ttl)
     n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", use ttl");
 
+  if (args->use_perf_counter)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", perf counters");
+
+  if (args->thread_placement != PLACEMENT_LINEAR)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1,
+                  ", thread placement %s",
+                  placement_policy_names[args->thread_placement]);
+
+  if (args->occupancy_slack > 0)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1,
+                  ", occupancy slack %ld", (long)args->occupancy_slack);
+
   if (args->ignore_obj_size)
     n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1,
                   ", ignore object size");
@@ -7,6 +7,8 @@
 #include "../../include/libCacheSim/enum.h"
 #include "../../include/libCacheSim/evictionAlgo.h"
 #include "../../include/libCacheSim/reader.h"
+#include "../../utils/include/perfCounter.h"
+#include "../../utils/include/topology.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,6 +19,30 @@ extern "C" {
 #define N_MAX_CACHE_SIZE 128
 #define OFILEPATH_LEN 128
 
+typedef enum {
+  OUTPUT_FORMAT_TXT = 0,
+  OUTPUT_FORMAT_JSON,
+  OUTPUT_FORMAT_CSV,
+} output_format_e;
+
+/* the result of simulating one cache, used to write machine-readable records */
+typedef struct {
+  const char *trace_path;
+  const cache_t *cache;
+  uint64_t n_req;
+  uint64_t n_miss;
+  uint64_t n_req_byte;
+  uint64_t n_miss_byte;
+  int64_t n_promotion;
+  double runtime;
+  int n_thread;
+  bool ignore_obj_size;
+  /* the counters of the measured part, NULL if not collected */
+  const perf_counter_t *perf;
+  /* n_thread counters of the worker threads, NULL if single threaded */
+  const perf_counter_t *perf_per_thread;
+} sim_result_t;
+
 /* This structure is used to communicate with parse_opt. */
 struct arguments {
   /* argument from the user */
@@ -46,6 +72,11 @@ struct arguments {
   bool ignore_obj_size;
   bool consider_obj_metadata;
   bool use_ttl;
+  output_format_e output_format;
+  bool use_perf_counter; /* collect hardware counters of the measured part */
+  placement_policy_e thread_placement; /* where the worker threads run */
+  /* the bytes the occupancy seen by a worker may be off, 0 is exact */
+  int64_t occupancy_slack;
 
   /* arguments generated */
   reader_t *reader;
@@ -57,7 +88,16 @@ void parse_cmd(int argc, char *argv[], struct arguments *args);
 void free_arg(struct arguments *args);
 
 void simulate(reader_t *reader, cache_t *cache, int report_interval,
-              int warmup_sec, char *ofilepath);
+              int warmup_sec, char *ofilepath, output_format_e output_format,
+              bool use_perf_counter);
+
+void parallel_simulate(reader_t *reader, cache_t *cache, int report_interval,
+                       char *ofilepath, int num_threads,
+                       output_format_e output_format, bool use_perf_counter,
+                       placement_policy_e placement, int64_t occupancy_slack);
+
+void write_result_record(const char *ofilepath, output_format_e format,
+                         const sim_result_t *res);
 
 void print_parsed_args(struct arguments *args);
 
@@ -23,7 +23,9 @@ int main(int argc, char **argv) {
 
   if (args.n_cache_size * args.n_eviction_algo == 1 && args.n_thread >= 1) {
     parallel_simulate(args.reader, args.caches[0], args.report_interval,
-                      args.ofilepath, args.n_thread);
+                      args.ofilepath, args.n_thread, args.output_format,
+                      args.use_perf_counter, args.thread_placement,
+                      args.occupancy_slack);
     free_arg(&args);
     return 0;
   }
@@ -0,0 +1,339 @@
+/**
+ * machine-readable result records for cachesim
+ *
+ * one record is produced per (trace, algorithm, params, cache size), each
+ * record is formatted into memory first and appended to the output file with
+ * a single write(2) on an O_APPEND descriptor, so that concurrent cachesim
+ * processes sharing the same output file never interleave partial records
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "../../include/libCacheSim/logging.h"
+#include "internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RESULT_RECORD_LEN 8192
+
+/* the record grows when it does not fit, e.g., per-thread perf counters of
+ * many threads */
+typedef struct {
+  char *buf;
+  int len;
+  int cap;
+} record_buf_t;
+
+static void buf_append(record_buf_t *rb, const char *fmt, ...) {
+  va_list ap;
+  while (true) {
+    va_start(ap, fmt);
+    int n = vsnprintf(rb->buf + rb->len, rb->cap - rb->len, fmt, ap);
+    va_end(ap);
+    if (n < 0) {
+      ERROR("cannot format result record %s\n", strerror(errno));
+      abort();
+    }
+    if (n < rb->cap - rb->len) {
+      rb->len += n;
+      return;
+    }
+
+    rb->cap = MAX(rb->cap * 2, rb->len + n + 1);
+    rb->buf = realloc(rb->buf, rb->cap);
+    if (rb->buf == NULL) {
+      ERROR("cannot allocate %d bytes for the result record\n", rb->cap);
+      abort();
+    }
+  }
+}
+
+static void buf_append_json_str(record_buf_t *rb, const char *s, int len) {
+  buf_append(rb, "\"");
+  for (int i = 0; i < len && s[i] != '\0'; i++) {
+    unsigned char c = (unsigned char)s[i];
+    if (c == '"' || c == '\\') {
+      buf_append(rb, "\\%c", c);
+    } else if (c < 0x20) {
+      buf_append(rb, "\\u%04x", c);
+    } else {
+      buf_append(rb, "%c", c);
+    }
+  }
+  buf_append(rb, "\"");
+}
+
+static void buf_append_csv_str(record_buf_t *rb, const char *s) {
+  buf_append(rb, "\"");
+  for (const char *p = s; *p != '\0'; p++) {
+    if (*p == '"') {
+      buf_append(rb, "\"\"");
+    } else {
+      buf_append(rb, "%c", *p);
+    }
+  }
+  buf_append(rb, "\"");
+}
+
+/**
+ * @brief copy the effective parameters of the cache into params, the
+ * algorithms print them in different styles, e.g., "n-seg=4;seg-size=2" and
+ * "prob=0.5000, combine=1\n", they are normalized to "key=value,key=value",
+ * the parameters given on the command line are used if the algorithm does not
+ * report its parameters
+ *
+ * @param cache
+ * @param params
+ * @param len
+ */
+static void get_effective_params(const cache_t *cache, char *params, int len) {
+  const char *src = cache->init_params;
+  if (cache->current_params != NULL) {
+    const char *curr = cache->current_params(cache);
+    if (curr != NULL) src = curr;
+  }
+
+  int n = 0;
+  bool sep = false;
+  for (const char *p = src; *p != '\0' && n < len - 1; p++) {
+    if (*p == ',' || *p == ';') {
+      sep = n > 0;
+    } else if (*p != ' ' && *p != '\n' && *p != '\t') {
+      if (sep && n < len - 2) params[n++] = ',';
+      sep = false;
+      params[n++] = *p;
+    }
+  }
+  params[n] = '\0';
+}
+
+/**
+ * @brief append the eviction parameters as a JSON object,
+ * e.g., "n-seg=4,type=lru" becomes {"n-seg": 4, "type": "lru"}
+ *
+ * @param rb
+ * @param params
+ */
+static void buf_append_params_json(record_buf_t *rb, const char *params) {
+  buf_append(rb, "{");
+  const char *p = params;
+  bool first = true;
+  while (p != NULL && *p != '\0') {
+    const char *end = strchr(p, ',');
+    int tok_len = end == NULL ? (int)strlen(p) : (int)(end - p);
+    const char *eq = memchr(p, '=', tok_len);
+    if (tok_len > 0 && eq != NULL) {
+      const char *val = eq + 1;
+      int val_len = (int)(p + tok_len - val);
+      char val_str[128] = {0};
+      memcpy(val_str, val, val_len < 127 ? val_len : 127);
+
+      if (!first) buf_append(rb, ", ");
+      buf_append_json_str(rb, p, (int)(eq - p));
+      buf_append(rb, ": ");
+
+      char *num_end = NULL;
+      double v = strtod(val_str, &num_end);
+      if (val_str[0] != '\0' && *num_end == '\0' && isfinite(v)) {
+        buf_append(rb, "%s", val_str);
+      } else {
+        buf_append_json_str(rb, val_str, val_len);
+      }
+      first = false;
+    }
+    p = end == NULL ? NULL : end + 1;
+  }
+  buf_append(rb, "}");
+}
+
+/**
+ * @brief the peak resident set size of this process in KiB
+ */
+static long get_peak_rss_kib(void) {
+  struct rusage r_usage;
+  if (getrusage(RUSAGE_SELF, &r_usage) != 0) return -1;
+  return r_usage.ru_maxrss;
+}
+
+/* the perf counter columns are empty when they are not collected */
+static const char *csv_header =
+    "trace,algorithm,cache_name,params,cache_size,ignore_obj_size,n_req,n_miss,miss_ratio,n_req_byte,n_miss_byte,"
+    "byte_miss_ratio,n_promotion,runtime_sec,throughput_mqps,peak_rss_kib,n_thread,cycles,instructions,llc_misses,"
+    "dtlb_misses,branch_misses,context_switches\n";
+
+/**
+ * @brief append the counters as a JSON object, the events that cannot be
+ * counted on this machine are null
+ */
+static void buf_append_perf_json(record_buf_t *rb, const perf_counter_t *perf) {
+  buf_append(rb, "{");
+  for (int i = 0; i < N_PERF_COUNTER; i++) {
+    buf_append(rb, "%s\"%s\": ", i == 0 ? "" : ", ", perf_counter_names[i]);
+    if (perf->valid[i]) {
+      buf_append(rb, "%" PRIu64, perf->values[i]);
+    } else {
+      buf_append(rb, "null");
+    }
+  }
+  buf_append(rb, "}");
+}
+
+static void format_json(record_buf_t *rb, const sim_result_t *res) {
+  const cache_t *cache = res->cache;
+  char params[CACHE_INIT_PARAMS_LEN];
+  get_effective_params(cache, params, sizeof(params));
+
+  buf_append(rb, "{\"trace\": ");
+  buf_append_json_str(rb, res->trace_path, (int)strlen(res->trace_path));
+  buf_append(rb, ", \"algorithm\": ");
+  buf_append_json_str(rb, cache->algo_name, CACHE_NAME_ARRAY_LEN);
+  buf_append(rb, ", \"cache_name\": ");
+  buf_append_json_str(rb, cache->cache_name, CACHE_NAME_ARRAY_LEN);
+  buf_append(rb, ", \"params\": ");
+  buf_append_params_json(rb, params);
+  buf_append(rb, ", \"params_str\": ");
+  buf_append_json_str(rb, params, sizeof(params));
+  buf_append(rb,
+             ", \"cache_size\": %ld, \"ignore_obj_size\": %s, \"n_req\": %lu, \"n_miss\": %lu, \"miss_ratio\": %.6lf, "
+             "\"n_req_byte\": %lu, \"n_miss_byte\": %lu, \"byte_miss_ratio\": %.6lf, \"n_promotion\": %ld, "
+             "\"runtime_sec\": %.6lf, \"throughput_mqps\": %.4lf, \"peak_rss_kib\": %ld, \"n_thread\": %d",
+             (long)cache->cache_size, res->ignore_obj_size ? "true" : "false", (unsigned long)res->n_req,
+             (unsigned long)res->n_miss, res->n_req == 0 ? 0.0 : (double)res->n_miss / (double)res->n_req,
+             (unsigned long)res->n_req_byte, (unsigned long)res->n_miss_byte,
+             res->n_req_byte == 0 ? 0.0 : (double)res->n_miss_byte / (double)res->n_req_byte, (long)res->n_promotion,
+             res->runtime, res->runtime > 0 ? (double)res->n_req / 1000000.0 / res->runtime : 0.0, get_peak_rss_kib(),
+             res->n_thread);
+
+  if (res->perf != NULL) {
+    buf_append(rb, ", \"perf\": ");
+    buf_append_perf_json(rb, res->perf);
+  }
+  if (res->perf_per_thread != NULL) {
+    buf_append(rb, ", \"perf_per_thread\": [");
+    for (int i = 0; i < res->n_thread; i++) {
+      if (i > 0) buf_append(rb, ", ");
+      buf_append_perf_json(rb, &res->perf_per_thread[i]);
+    }
+    buf_append(rb, "]");
+  }
+  buf_append(rb, "}\n");
+}
+
+static void format_csv(record_buf_t *rb, const sim_result_t *res) {
+  const cache_t *cache = res->cache;
+  char params[CACHE_INIT_PARAMS_LEN];
+  get_effective_params(cache, params, sizeof(params));
+
+  buf_append_csv_str(rb, res->trace_path);
+  buf_append(rb, ",");
+  buf_append_csv_str(rb, cache->algo_name);
+  buf_append(rb, ",");
+  buf_append_csv_str(rb, cache->cache_name);
+  buf_append(rb, ",");
+  buf_append_csv_str(rb, params);
+  buf_append(rb, ",%ld,%d,%lu,%lu,%.6lf,%lu,%lu,%.6lf,%ld,%.6lf,%.4lf,%ld,%d", (long)cache->cache_size,
+             res->ignore_obj_size ? 1 : 0, (unsigned long)res->n_req, (unsigned long)res->n_miss,
+             res->n_req == 0 ? 0.0 : (double)res->n_miss / (double)res->n_req, (unsigned long)res->n_req_byte,
+             (unsigned long)res->n_miss_byte,
+             res->n_req_byte == 0 ? 0.0 : (double)res->n_miss_byte / (double)res->n_req_byte, (long)res->n_promotion,
+             res->runtime, res->runtime > 0 ? (double)res->n_req / 1000000.0 / res->runtime : 0.0, get_peak_rss_kib(),
+             res->n_thread);
+
+  for (int i = 0; i < N_PERF_COUNTER; i++) {
+    if (res->perf != NULL && res->perf->valid[i]) {
+      buf_append(rb, ",%" PRIu64, res->perf->values[i]);
+    } else {
+      buf_append(rb, ",");
+    }
+  }
+  buf_append(rb, "\n");
+}
+
+/**
+ * @brief create the CSV file with its header if it does not exist, the
+ * header is written to a private file that is then linked to ofilepath,
+ * so a concurrent writer can never see the file without its header
+ *
+ * @param ofilepath
+ */
+static void create_csv_with_header(const char *ofilepath) {
+  if (access(ofilepath, F_OK) == 0) return;
+
+  char tmp_path[PATH_MAX];
+  snprintf(tmp_path, sizeof(tmp_path), "%s.%ld.tmp", ofilepath, (long)getpid());
+  int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    ERROR("cannot open file %s %s\n", tmp_path, strerror(errno));
+    exit(1);
+  }
+  ssize_t len = (ssize_t)strlen(csv_header);
+  if (write(fd, csv_header, len) != len) {
+    ERROR("failed to write result header to %s %s\n", tmp_path, strerror(errno));
+    exit(1);
+  }
+  close(fd);
+
+  /* link fails with EEXIST if another writer created the file first */
+  if (link(tmp_path, ofilepath) != 0 && errno != EEXIST) {
+    ERROR("cannot create file %s %s\n", ofilepath, strerror(errno));
+    exit(1);
+  }
+  unlink(tmp_path);
+}
+
+/**
+ * @brief append one result record to ofilepath,
+ * JSON records are written one object per line (JSON lines),
+ * CSV records get a header when the file is created,
+ * so results of many runs can be merged by appending to the same file
+ *
+ * @param ofilepath
+ * @param format
+ * @param res
+ */
+void write_result_record(const char *ofilepath, output_format_e format, const sim_result_t *res) {
+  record_buf_t rb = {.buf = malloc(RESULT_RECORD_LEN), .len = 0, .cap = RESULT_RECORD_LEN};
+  if (rb.buf == NULL) {
+    ERROR("cannot allocate the result record\n");
+    abort();
+  }
+
+  if (format == OUTPUT_FORMAT_JSON) {
+    format_json(&rb, res);
+  } else if (format == OUTPUT_FORMAT_CSV) {
+    create_csv_with_header(ofilepath);
+    format_csv(&rb, res);
+  } else {
+    ERROR("unsupported output format %d\n", format);
+    abort();
+  }
+
+  int fd = open(ofilepath, O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (fd < 0) {
+    ERROR("cannot open file %s %s\n", ofilepath, strerror(errno));
+    exit(1);
+  }
+  ssize_t n_written = write(fd, rb.buf, rb.len);
+  if (n_written != rb.len) {
+    ERROR("failed to write result to %s %s\n", ofilepath, strerror(errno));
+    exit(1);
+  }
+  close(fd);
+  free(rb.buf);
+}
+
+#ifdef __cplusplus
+}
+#endif
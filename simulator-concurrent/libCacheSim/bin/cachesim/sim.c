@@ -12,9 +12,13 @@
 #include <sysexits.h>
 #include "../../include/libCacheSim/cache.h"
 #include "../../include/libCacheSim/reader.h"
+#include "../../traceReader/generalReader/synthetic.h"
+#include "../../dataStructure/hash/hash.h"
 #include "../../utils/include/mymath.h"
 #include "../../utils/include/mystr.h"
 #include "../../utils/include/mysys.h"
+#include "../../utils/include/topology.h"
+#include "internal.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,36 +32,69 @@ typedef struct thread_params {
   uint64_t req_cnt;
   uint64_t miss_cnt;
   request_t** req_list;
+  bool use_perf_counter;
+  perf_counter_t perf;
+  /* the requests of the thread are oracles[start_offset + j * num_threads +
+   * thread_id], built by the thread so they are on its node */
+  const uint64_t* oracles;
+  uint64_t start_offset;
+  const cpu_topology_t* topo;
+  thread_placement_t placement;
+  /* the threads start together after all request lists are built */
+  pthread_barrier_t* barrier;
 } thread_params_t;
 
+/* build the request list after binding, so its pages are first touched on
+ * the node of the thread */
+static void build_req_list(thread_params_t* thread_params) {
+  uint64_t thread_id = thread_params->thread_id;
+  uint64_t num_threads = thread_params->num_threads;
+  uint64_t n_req_thread = thread_params->req_cnt / num_threads;
+  const uint64_t* oracles = thread_params->oracles + thread_params->start_offset;
+
+  request_t** req_list = malloc(sizeof(request_t*) * n_req_thread);
+  /* hash the requests of the thread in one batch, so the workers do not
+   * hash in find and again in insert */
+  obj_id_t* obj_ids = malloc(sizeof(obj_id_t) * n_req_thread);
+  uint64_t* hvs = malloc(sizeof(uint64_t) * n_req_thread);
+  for (uint64_t j = 0; j < n_req_thread; j++) {
+    obj_ids[j] = oracles[j * num_threads + thread_id];
+  }
+  get_hash_value_int_64_batch(obj_ids, hvs, n_req_thread);
+  for (uint64_t j = 0; j < n_req_thread; j++) {
+    req_list[j] = new_request();
+    req_list[j]->clock_time = 0;
+    req_list[j]->obj_id = obj_ids[j];
+    // req_list[j]->obj_id += i * 10000007UL;
+    DEBUG_ASSERT(req_list[j]->obj_id != 0);
+    req_list[j]->obj_size = 1;
+    req_list[j]->next_access_vtime = -1;
+    req_list[j]->hv = hvs[j];
+  }
+  free(obj_ids);
+  free(hvs);
+  thread_params->req_list = req_list;
+}
 
 void* thread_function(void* arg){
 
   thread_params_t* thread_params = (thread_params_t*)arg;
-  uint64_t thread_id = thread_params->thread_id;
   uint64_t num_threads = thread_params->num_threads;
-  uint64_t item_size = thread_params->reader->item_size;
   uint64_t req_cnt = thread_params->req_cnt;
 
-  request_t* wasted = new_request();
-
-  // printf("triggered thread_id: %lu\n", ((thread_params_t*)arg)->thread_id);
-  // pthread_set_affinity(((thread_params_t*)arg)->thread_id);
-  /* bind worker to the core */
-  cpu_set_t cpuset;
-  pthread_t thread = pthread_self();
-
-  CPU_ZERO(&cpuset);
-  CPU_SET(thread_id, &cpuset);
+  /* bind the worker first, the request list and the objects it inserts
+   * are then allocated on its node */
+  topology_bind_thread(thread_params->topo, &thread_params->placement);
+  build_req_list(thread_params);
 
-  if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset) != 0) {
-    printf("fail to bind worker thread to core %lu: %s\n", thread_id,
-           strerror(errno));
-  } else {
-    // printf("binding worker thread to core %lu\n", thread_id);
-  }
+  request_t* wasted = new_request();
+  cache_attach_thread_stat(thread_params->cache, thread_params->thread_id);
+  pthread_barrier_wait(thread_params->barrier);
 
-  
+  /* the counters only follow this thread, so open them here */
+  bool use_perf = thread_params->use_perf_counter &&
+                  perf_counter_open(&thread_params->perf) > 0;
+  if (use_perf) perf_counter_start(&thread_params->perf);
 
   // read the file
   uint64_t miss_cnt = 0;
@@ -73,6 +110,11 @@ void* thread_function(void* arg){
     memcpy(req, wasted, sizeof(request_t));
     // move to the next request
   }
+  if (use_perf) {
+    perf_counter_stop(&thread_params->perf);
+    perf_counter_close(&thread_params->perf);
+  }
+  cache_flush_occupancy_shard(thread_params->cache);
   // only used for oracleGeneralBin
   // printf("miss count: %ld\n", miss_cnt);
   atomic_fetch_add(&thread_params->miss_cnt, miss_cnt);
@@ -83,7 +125,9 @@ void* thread_function(void* arg){
 
 
 void parallel_simulate(reader_t *reader, cache_t *cache, int report_interval,
-             char *ofilepath, int num_threads) {
+                       char *ofilepath, int num_threads,
+                       output_format_e output_format, bool use_perf_counter,
+                       placement_policy_e placement, int64_t occupancy_slack) {
   /* random seed */
   srand(time(NULL));
   set_rand_seed(rand());
@@ -95,9 +139,17 @@ void parallel_simulate(reader_t *reader, cache_t *cache, int report_interval,
   double alpha = 1;
   bool write_to_file_flag = false;
 
-  // printf("generating file\n");
-  uint64_t* oracles = generate_zipf(alpha, req_cnt + warmup_cnt, obj_num);
-  // printf("generating file finished\n");
+  /* the ids are 1 to obj_num, generated by all threads in parallel, the
+   * stream only depends on the seed */
+  char spec_str[128];
+  synthetic_spec_t spec;
+  snprintf(spec_str, sizeof(spec_str), "%d:zipf(%lf,%d);seed=%d",
+           req_cnt + warmup_cnt, alpha, obj_num, rand());
+  if (!synthetic_parse_spec(spec_str, &spec)) {
+    ERROR("invalid workload spec %s\n", spec_str);
+  }
+  uint64_t* oracles = malloc(sizeof(uint64_t) * (req_cnt + warmup_cnt));
+  synthetic_gen_obj_ids(&spec, 0, req_cnt + warmup_cnt, oracles, num_threads);
 
   if (write_to_file_flag) {
     write_to_file("/users/bobob/zipf.bin", oracles, req_cnt, write_to_file_flag);
@@ -115,7 +167,7 @@ void parallel_simulate(reader_t *reader, cache_t *cache, int report_interval,
     uint32_t obj_size = 1;
     int64_t next_access_vtime = -1;
     req->clock_time = real_time;
-    req->obj_id = obj_id + 1;
+    req->obj_id = obj_id;
     req->obj_size = obj_size;
     req->next_access_vtime = next_access_vtime;
     if (!cache->find(cache, req, true)) {
@@ -136,9 +188,21 @@ void parallel_simulate(reader_t *reader, cache_t *cache, int report_interval,
   // }
 
 
-  // preprocessing
-  // first version should have lock each round
-  // create num_threads threads
+  /* the topology is read before any thread is bound, so it has all CPUs
+   * allowed by taskset */
+  cpu_topology_t* topo = topology_load();
+  thread_placement_t* placements =
+      malloc(sizeof(thread_placement_t) * num_threads);
+  topology_place_threads(topo, placement, num_threads, placements);
+  INFO("%d threads on %d CPUs in %d nodes, placement %s\n", num_threads,
+       topo->n_cpu, topo->n_node, placement_policy_names[placement]);
+
+  /* warmup is done by the main thread, only count the measured region */
+  cache_init_thread_stat(cache, num_threads);
+  cache_init_occupancy_shard(cache, num_threads, occupancy_slack);
+
+  pthread_barrier_t barrier;
+  pthread_barrier_init(&barrier, NULL, num_threads + 1);
   pthread_t threads[num_threads];
   thread_params_t* thread_params = malloc(sizeof(thread_params_t) * num_threads);
   for (uint64_t i = 0; i < num_threads; i++) {
@@ -148,34 +212,25 @@ void parallel_simulate(reader_t *reader, cache_t *cache, int report_interval,
     thread_params[i].num_threads = num_threads;
     thread_params[i].miss_cnt = 0;
     thread_params[i].req_cnt = req_cnt;
-    // preload the file
-    request_t** req_list = malloc(sizeof(request_t*) * req_cnt / num_threads);
-    for (uint64_t j = 0; j < req_cnt / num_threads; j++) {
-      req_list[j] = new_request();
-      uint32_t real_time = 0;
-      uint64_t obj_id = oracles[j * num_threads + i + start_offset];
-      uint32_t obj_size = 1;
-      int64_t next_access_vtime = -1;
-      req_list[j]->clock_time = real_time;
-      req_list[j]->obj_id = obj_id + 1;
-      // req_list[j]->obj_id += i * 10000007UL;
-      DEBUG_ASSERT(req_list[j]->obj_id != 0);
-      req_list[j]->obj_size = obj_size;
-      req_list[j]->next_access_vtime = next_access_vtime;
-    }
-    thread_params[i].req_list = req_list;
+    thread_params[i].req_list = NULL;
+    thread_params[i].use_perf_counter = use_perf_counter;
+    memset(&thread_params[i].perf, 0, sizeof(perf_counter_t));
+    thread_params[i].oracles = oracles;
+    thread_params[i].start_offset = start_offset;
+    thread_params[i].topo = topo;
+    thread_params[i].placement = placements[i];
+    thread_params[i].barrier = &barrier;
+    pthread_create(&threads[i], NULL, thread_function, &thread_params[i]);
   }
 
+  /* the clock starts when all threads have built their requests */
+  pthread_barrier_wait(&barrier);
   double start_time = gettime();
-  for (uint64_t i = 0; i < num_threads; i++) {
-    pthread_create(&threads[i], NULL, thread_function, &thread_params[i]);
-  }
 
   for (uint64_t i = 0; i < num_threads; i++) {
     pthread_join(threads[i], NULL);
   }
 
-
   double runtime = gettime() - start_time;
   // printf("runtime total: %.8lf\n", runtime);
 
@@ -200,17 +255,68 @@ void parallel_simulate(reader_t *reader, cache_t *cache, int report_interval,
 
 #pragma GCC diagnostic pop
   printf("%s", output_str);
+  cache_dump_thread_stat_json(cache, stdout);
+
+  /* the sum over the threads per request, then each thread per request of
+   * its own share of the requests */
+  perf_counter_t perf_sum;
+  perf_counter_t* perf_per_thread = NULL;
+  char perf_str[1024];
+  if (use_perf_counter) {
+    perf_counter_sum_init(&perf_sum);
+    perf_per_thread = malloc(sizeof(perf_counter_t) * num_threads);
+    for (uint64_t i = 0; i < num_threads; i++) {
+      perf_counter_sum(&perf_sum, &thread_params[i].perf);
+      perf_per_thread[i] = thread_params[i].perf;
+    }
+    perf_counter_snprint(perf_str, sizeof(perf_str), &perf_sum, req_cnt);
+    printf("perf total: %s\n", perf_str);
+    for (uint64_t i = 0; i < num_threads; i++) {
+      perf_counter_snprint(perf_str, sizeof(perf_str), &perf_per_thread[i],
+                           req_cnt / num_threads);
+      printf("perf thread %lu: %s\n", (unsigned long)i, perf_str);
+    }
+  }
 
-  FILE *output_file = fopen(ofilepath, "a");
-  if (output_file == NULL) {
-    ERROR("cannot open file %s %s\n", ofilepath, strerror(errno));
-    exit(1);
+  if (output_format != OUTPUT_FORMAT_TXT) {
+    thread_stat_t stat_sum;
+    thread_stat_aggregate(cache->thread_stats, cache->n_thread_stats,
+                          &stat_sum);
+    /* every synthetic request has size 1 */
+    sim_result_t res = {.trace_path = reader->trace_path,
+                        .cache = cache,
+                        .n_req = req_cnt,
+                        .n_miss = miss_cnt,
+                        .n_req_byte = req_cnt,
+                        .n_miss_byte = miss_cnt,
+                        .n_promotion = (int64_t)stat_sum.n_promotion,
+                        .runtime = runtime,
+                        .n_thread = num_threads,
+                        .ignore_obj_size = true,
+                        .perf = use_perf_counter ? &perf_sum : NULL,
+                        .perf_per_thread = perf_per_thread};
+    write_result_record(ofilepath, output_format, &res);
+  } else {
+    FILE *output_file = fopen(ofilepath, "a");
+    if (output_file == NULL) {
+      ERROR("cannot open file %s %s\n", ofilepath, strerror(errno));
+      exit(1);
+    }
+    fprintf(output_file, "%s\n", output_str);
+    cache_dump_thread_stat_json(cache, output_file);
+    if (use_perf_counter) {
+      perf_counter_snprint(perf_str, sizeof(perf_str), &perf_sum, req_cnt);
+      fprintf(output_file, "perf total: %s\n", perf_str);
+    }
+    fclose(output_file);
   }
-  fprintf(output_file, "%s\n", output_str);
-  fclose(output_file);
 
   // do the free
+  free(perf_per_thread);
   free(thread_params);
+  free(placements);
+  topology_free(topo);
+  pthread_barrier_destroy(&barrier);
 
 #if defined(TRACK_EVICTION_V_AGE)
   while (cache->get_occupied_byte(cache) > 0) {
@@ -225,7 +331,8 @@ void parallel_simulate(reader_t *reader, cache_t *cache, int report_interval,
 #endif
 
 void simulate(reader_t *reader, cache_t *cache, int report_interval,
-              int warmup_sec, char *ofilepath) {
+              int warmup_sec, char *ofilepath, output_format_e output_format,
+              bool use_perf_counter) {
   /* random seed */
   srand(time(NULL));
   set_rand_seed(rand());
@@ -234,6 +341,11 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval,
   uint64_t req_cnt = 0, miss_cnt = 0;
   uint64_t last_req_cnt = 0, last_miss_cnt = 0;
   uint64_t req_byte = 0, miss_byte = 0;
+  /* counts the calling thread from the first request after warmup */
+  perf_counter_t perf_storage, *perf = NULL;
+  if (use_perf_counter && perf_counter_open(&perf_storage) > 0) {
+    perf = &perf_storage;
+  }
 
   read_one_req(reader, req);
   uint64_t start_ts = (uint64_t)req->clock_time;
@@ -249,6 +361,7 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval,
     } else {
       if (start_time < 0) {
         start_time = gettime();
+        if (perf != NULL) perf_counter_start(perf);
       }
     }
 
@@ -279,6 +392,7 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval,
   }
 
   double runtime = gettime() - start_time;
+  if (perf != NULL) perf_counter_stop(perf);
 
   char output_str[1024];
   char size_str[8];
@@ -293,15 +407,39 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval,
            (double)req_cnt / 1000000.0 / runtime);
 
 #pragma GCC diagnostic pop
+  if (perf != NULL) {
+    /* replace the newline with the counters */
+    int len = (int)strlen(output_str) - 1;
+    len += snprintf(output_str + len, 1024 - len, ", ");
+    len += perf_counter_snprint(output_str + len, 1024 - len - 1, perf,
+                                req_cnt);
+    snprintf(output_str + len, 1024 - len, "\n");
+  }
   printf("%s", output_str);
 
-  FILE *output_file = fopen(ofilepath, "a");
-  if (output_file == NULL) {
-    ERROR("cannot open file %s %s\n", ofilepath, strerror(errno));
-    exit(1);
+  if (output_format != OUTPUT_FORMAT_TXT) {
+    sim_result_t res = {.trace_path = reader->trace_path,
+                        .cache = cache,
+                        .n_req = req_cnt,
+                        .n_miss = miss_cnt,
+                        .n_req_byte = req_byte,
+                        .n_miss_byte = miss_byte,
+                        .n_promotion = 0,
+                        .runtime = runtime,
+                        .n_thread = 1,
+                        .ignore_obj_size = false,
+                        .perf = perf,
+                        .perf_per_thread = NULL};
+    write_result_record(ofilepath, output_format, &res);
+  } else {
+    FILE *output_file = fopen(ofilepath, "a");
+    if (output_file == NULL) {
+      ERROR("cannot open file %s %s\n", ofilepath, strerror(errno));
+      exit(1);
+    }
+    fprintf(output_file, "%s\n", output_str);
+    fclose(output_file);
   }
-  fprintf(output_file, "%s\n", output_str);
-  fclose(output_file);
 
 #if defined(TRACK_EVICTION_V_AGE)
   while (cache->get_occupied_byte(cache) > 0) {
@@ -309,6 +447,7 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval,
   }
 
 #endif
+  if (perf != NULL) perf_counter_close(perf);
 }
 
 #ifdef __cplusplus
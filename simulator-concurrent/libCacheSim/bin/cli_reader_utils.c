@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "../include/libCacheSim/reader.h"
+#include "../include/libCacheSim/traceManifest.h"
 #include "../utils/include/mystr.h"
 #include "cli_reader_utils.h"
 
@@ -167,45 +168,23 @@ bool should_disable_obj_metadata(reader_t *reader) {
 }
 #undef N_TEST
 
+/**
+ * @brief get the working set size from the trace manifest, which is computed
+ * once per trace and cached in a sidecar file
+ *
+ * @param reader
+ * @param wss_obj
+ * @param wss_byte
+ */
 void cal_working_set_size(reader_t *reader, int64_t *wss_obj,
                           int64_t *wss_byte) {
-  reset_reader(reader);
-  request_t *req = new_request();
-  GHashTable *obj_table = g_hash_table_new(g_direct_hash, g_direct_equal);
-  *wss_obj = 0;
-  *wss_byte = 0;
-
-  // sample the object space in case there are too many objects
-  // which can cause a crash
-  int scaling_factor = 1;
-  if (reader->file_size > 5 * GiB) {
-    scaling_factor = 101;
-  } else if (reader->file_size > 1 * GiB) {
-    scaling_factor = 11;
-  }
+  const trace_manifest_t *manifest = get_trace_manifest(reader);
+  *wss_obj = manifest->n_obj;
+  *wss_byte = manifest->n_obj_byte;
+  if (reader->n_total_req == 0) reader->n_total_req = manifest->n_req;
 
-  INFO("calculating working set size...\n");
-  // while (read_one_req(reader, req) == 0) {
-  //   if (scaling_factor > 1 && req->obj_id % scaling_factor != 0) {
-  //     continue;
-  //   }
-
-  //   if (g_hash_table_contains(obj_table, (gconstpointer)req->obj_id)) {
-  //     continue;
-  //   }
-
-  //   g_hash_table_add(obj_table, (gpointer)req->obj_id);
-
-  //   *wss_obj += 1;
-  //   *wss_byte += req->obj_size;
-  // }
-  *wss_obj *= scaling_factor;
-  *wss_byte *= scaling_factor;
-  INFO("working set size: %ld object %ld byte\n", (long)*wss_obj,
-       (long)*wss_byte);
-
-  free_request(req);
-  reset_reader(reader);
+  INFO("working set size: %ld object %ld byte%s\n", (long)*wss_obj,
+       (long)*wss_byte, manifest->is_estimate ? " (estimated)" : "");
 }
 
 /**
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include <thread>
+
 #include "../../include/libCacheSim/const.h"
 #include "../../utils/include/mystr.h"
 #include "../../utils/include/mysys.h"
@@ -30,6 +32,9 @@ enum argp_option_short {
   OPTION_ACCESS_PATTERN_SAMPLE_RATIO = 0x102,
   OPTION_TRACK_N_HIT = 0x103,
   OPTION_TRACK_N_POPULAR = 0x104,
+  OPTION_NUM_THREAD = 0x105,
+  OPTION_SKETCH_MEM = 0x106,
+  OPTION_SKETCH_TOP_K = 0x107,
 
   OPTION_ENABLE_ALL = 0x200,
   OPTION_ENABLE_COMMON = 0x201,
@@ -109,6 +114,18 @@ static struct argp_option options[] = {
      "track one-hit-wonder, two-hit-wonder, etc.", 4},
     {"track-n-popular", OPTION_TRACK_N_POPULAR, "8", 0,
      "track how many requests the n most popular objects get", 4},
+    {"num-thread", OPTION_NUM_THREAD, "1", 0,
+     "one thread decodes the trace and the others run the analysis modules, "
+     "-1 uses all the cores",
+     4},
+    {"sketch-mem", OPTION_SKETCH_MEM, "0", 0,
+     "MiB of fixed-size summaries used by popularity, accessPattern and reuse "
+     "instead of per-object state, for traces too large for the exact "
+     "analysis, 0 disables, the object map shared by all analyses is still "
+     "exact and uses about 32 bytes per object",
+     4},
+    {"sketch-top-k", OPTION_SKETCH_TOP_K, "10000", 0,
+     "the number of most popular objects tracked when sketch-mem is set", 4},
 
     {NULL, 0, NULL, 0, "common parameters:", 0},
 
@@ -150,6 +167,20 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
     case OPTION_TRACK_N_HIT:
       arguments->analysis_param.track_n_hit = atoi(arg);
       break;
+    case OPTION_NUM_THREAD:
+      arguments->analysis_param.n_thread = atoi(arg);
+      if (arguments->analysis_param.n_thread == 0 ||
+          arguments->analysis_param.n_thread == -1) {
+        arguments->analysis_param.n_thread =
+            (int)std::thread::hardware_concurrency();
+      }
+      break;
+    case OPTION_SKETCH_MEM:
+      arguments->analysis_param.sketch_mem_mb = atoi(arg);
+      break;
+    case OPTION_SKETCH_TOP_K:
+      arguments->analysis_param.sketch_top_k = atoi(arg);
+      break;
     case OPTION_ENABLE_ALL:
       arguments->analysis_option.req_rate = true;
       arguments->analysis_option.access_pattern = true;
@@ -7,6 +7,33 @@
 #include "../include/libCacheSim/prefetchAlgo.h"
 #include <stdatomic.h>
 
+/* threads that are not attached to a cache share this scratch block */
+static thread_stat_t unattached_thread_stat;
+__thread thread_stat_t *curr_thread_stat = &unattached_thread_stat;
+__thread occupancy_shard_t *curr_occupancy_shard = NULL;
+
+/**
+ * @brief add the change of an insert or an eviction to the occupancy, the
+ * change is kept in the shard of the calling thread until it reaches the
+ * slack, so threads do not bounce the cache line of the shared counters
+ */
+static inline void cache_update_occupancy(cache_t *cache, int64_t n_obj,
+                                          int64_t n_byte) {
+  occupancy_shard_t *shard = curr_occupancy_shard;
+  if (shard == NULL || shard->cache != cache) {
+    __atomic_fetch_add(&cache->n_obj, n_obj, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&cache->occupied_byte, n_byte, __ATOMIC_RELAXED);
+    return;
+  }
+
+  shard->n_obj += n_obj;
+  shard->occupied_byte += n_byte;
+  if (llabs(shard->occupied_byte) >= cache->occupancy_slack ||
+      llabs(shard->n_obj) >= cache->occupancy_slack_obj) {
+    cache_flush_occupancy_shard(cache);
+  }
+}
+
 /** this file contains both base function, which should be called by all
  *eviction algorithms, and the queue related functions, which should be called
  *by algorithm that uses only one queue and needs to update the queue such as
@@ -27,6 +54,7 @@ cache_t *cache_struct_init(const char *const cache_name,
   cache_t *cache = my_malloc(cache_t);
   memset(cache, 0, sizeof(cache_t));
   strncpy(cache->cache_name, cache_name, CACHE_NAME_ARRAY_LEN);
+  strncpy(cache->algo_name, cache_name, CACHE_NAME_ARRAY_LEN - 1);
 
   if (init_params != NULL) {
     strncpy(cache->init_params, init_params, CACHE_INIT_PARAMS_LEN);
@@ -38,6 +66,7 @@ cache_t *cache_struct_init(const char *const cache_name,
   cache->future_stack_dist = NULL;
   cache->future_stack_dist_array_size = 0;
   cache->default_ttl = params.default_ttl;
+  cache->thread_num = params.num_thread;
   cache->n_req = 0;
   cache->to_evict_candidate = NULL;
   cache->to_evict_candidate_gen_vtime = -1;
@@ -74,6 +103,8 @@ cache_t *cache_struct_init(const char *const cache_name,
  */
 void cache_struct_free(cache_t *cache) {
   free_hashtable(cache->hashtable);
+  if (cache->thread_stats != NULL) free(cache->thread_stats);
+  if (cache->occupancy_shards != NULL) free(cache->occupancy_shards);
   if (cache->admissioner != NULL) cache->admissioner->free(cache->admissioner);
   if (cache->prefetcher != NULL) cache->prefetcher->free(cache->prefetcher);
   my_free(sizeof(cache_t), cache);
@@ -252,13 +283,7 @@ cache_obj_t *cache_insert_base(cache_t *cache, const request_t *req) {
   if (cache_obj == NULL) {
     return NULL;
   }
-  // static __thread uint64_t local_nobj = 0;
-  // static __thread uint64_t local_occupied_byte = 0;
-  // batch_add(&local_nobj, &cache->n_obj);
-  // batch_add(&local_occupied_byte, &cache->occupied_byte);
-  __atomic_fetch_add(&cache->n_obj, 1, __ATOMIC_RELAXED);
-  // // printf("cache n_obj: %ld\n", cache->n_obj);
-  __atomic_fetch_add(&cache->occupied_byte, req->obj_size + cache->obj_md_size, __ATOMIC_RELAXED);
+  cache_update_occupancy(cache, 1, req->obj_size + cache->obj_md_size);
 
   return cache_obj;
 }
@@ -287,12 +312,9 @@ void cache_evict_base(cache_t *cache, cache_obj_t *obj,
  */
 void cache_remove_obj_base(cache_t *cache, cache_obj_t *obj,
                            bool remove_from_hashtable) {
-  // static __thread uint64_t local_nobj = 0;
-  // static __thread uint64_t local_occupied_byte = 0;
-  // batch_sub(&local_nobj, &cache->n_obj);
-  // batch_sub(&local_occupied_byte, &cache->occupied_byte);
-  __atomic_fetch_sub(&cache->n_obj, 1, __ATOMIC_RELAXED);
-  __atomic_fetch_sub(&cache->occupied_byte, 1, __ATOMIC_RELAXED);
+  cache_update_occupancy(cache, -1,
+                         -(int64_t)(obj->obj_size + cache->obj_md_size));
+  THREAD_STAT_INC(n_eviction);
   // printf("we are deleting the object: %ld\n", obj->obj_id);
   if (remove_from_hashtable) {
    hashtable_delete(cache->hashtable, obj);
@@ -455,6 +477,124 @@ bool dump_cached_obj_age(cache_t *cache, const request_t *req,
   return true;
 }
 
+/**
+ * @brief allocate one counter block per worker thread
+ *
+ * @param cache
+ * @param n_thread
+ */
+void cache_init_thread_stat(cache_t *cache, int n_thread) {
+  if (cache->thread_stats != NULL) free(cache->thread_stats);
+  cache->thread_stats =
+      aligned_alloc(sizeof(thread_stat_t), sizeof(thread_stat_t) * n_thread);
+  if (cache->thread_stats == NULL) {
+    ERROR("cannot allocate the counters of %d threads\n", n_thread);
+  }
+  memset(cache->thread_stats, 0, sizeof(thread_stat_t) * n_thread);
+  cache->n_thread_stats = n_thread;
+}
+
+/**
+ * @brief let the calling thread count into its own block of this cache
+ *
+ * @param cache
+ * @param thread_id
+ */
+void cache_attach_thread_stat(cache_t *cache, int thread_id) {
+  DEBUG_ASSERT(thread_id < cache->n_thread_stats);
+  curr_thread_stat = &cache->thread_stats[thread_id];
+  curr_occupancy_shard = cache->occupancy_shards == NULL
+                             ? NULL
+                             : &cache->occupancy_shards[thread_id];
+}
+
+/**
+ * @brief allocate one occupancy shard per worker thread, each thread may
+ * hold max_overshoot / n_thread bytes that are not folded, and as many
+ * objects as the mean object size of the cache gives for those bytes
+ *
+ * @param cache
+ * @param n_thread
+ * @param max_overshoot
+ */
+void cache_init_occupancy_shard(cache_t *cache, int n_thread,
+                                int64_t max_overshoot) {
+  if (cache->occupancy_shards != NULL) free(cache->occupancy_shards);
+  cache->occupancy_shards = NULL;
+
+  int64_t max_slack = cache->cache_size / OCCUPANCY_SLACK_MAX_FRACTION;
+  if (max_overshoot > max_slack) {
+    WARN("occupancy slack %ld is more than 1/%d of cache size %ld, use %ld\n",
+         (long)max_overshoot, OCCUPANCY_SLACK_MAX_FRACTION,
+         (long)cache->cache_size, (long)max_slack);
+    max_overshoot = max_slack;
+  }
+  cache->occupancy_slack = max_overshoot / n_thread;
+  cache->occupancy_slack_obj = cache->occupancy_slack;
+  if (cache->occupancy_slack <= 1) {
+    /* a slack of one byte folds every change */
+    return;
+  }
+
+  /* the objects of a shard are bounded by the bytes they would take at the
+   * mean object size, one byte per object before the cache has any */
+  int64_t n_obj = cache->get_n_obj(cache);
+  int64_t n_byte = cache->get_occupied_byte(cache);
+  if (n_obj > 0 && n_byte > n_obj) {
+    cache->occupancy_slack_obj =
+        MAX(cache->occupancy_slack / (n_byte / n_obj), 1);
+  }
+
+  cache->occupancy_shards = aligned_alloc(
+      sizeof(occupancy_shard_t), sizeof(occupancy_shard_t) * n_thread);
+  if (cache->occupancy_shards == NULL) {
+    ERROR("cannot allocate the occupancy shards of %d threads\n", n_thread);
+  }
+  memset(cache->occupancy_shards, 0, sizeof(occupancy_shard_t) * n_thread);
+  for (int i = 0; i < n_thread; i++) {
+    cache->occupancy_shards[i].cache = cache;
+  }
+}
+
+/**
+ * @brief fold the changes of the calling thread into the shared counters
+ *
+ * @param cache
+ */
+void cache_flush_occupancy_shard(cache_t *cache) {
+  occupancy_shard_t *shard = curr_occupancy_shard;
+  if (shard == NULL || shard->cache != cache) return;
+
+  __atomic_fetch_add(&cache->n_obj, shard->n_obj, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&cache->occupied_byte, shard->occupied_byte,
+                     __ATOMIC_RELAXED);
+  shard->n_obj = 0;
+  shard->occupied_byte = 0;
+}
+
+/**
+ * @brief dump the counters as one JSON line, the aggregated counters first
+ * and then one object per thread
+ *
+ * @param cache
+ * @param ofile
+ */
+void cache_dump_thread_stat_json(const cache_t *cache, FILE *ofile) {
+  thread_stat_t sum;
+  thread_stat_aggregate(cache->thread_stats, cache->n_thread_stats, &sum);
+
+  fprintf(ofile, "{\"cache_name\": \"%s\", \"cache_size\": %ld, "
+          "\"n_thread\": %d, \"total\": ",
+          cache->cache_name, (long)cache->cache_size, cache->n_thread_stats);
+  thread_stat_print_json(ofile, &sum);
+  fprintf(ofile, ", \"per_thread\": [");
+  for (int i = 0; i < cache->n_thread_stats; i++) {
+    if (i > 0) fprintf(ofile, ", ");
+    thread_stat_print_json(ofile, &cache->thread_stats[i]);
+  }
+  fprintf(ofile, "]}\n");
+}
+
 static uint64_t test_and_test_and_set(uint64_t *dummy) {
     uint64_t expected = UINT64_MAX;
     uint64_t new = UINT64_MAX - 1;
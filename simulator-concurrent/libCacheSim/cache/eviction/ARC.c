@@ -59,6 +59,7 @@ typedef struct ARC_params {
 // ***********************************************************************
 
 static void ARC_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *ARC_effective_params(const cache_t *cache);
 static void ARC_free(cache_t *cache);
 static bool ARC_get(cache_t *cache, const request_t *req);
 static cache_obj_t *ARC_find(cache_t *cache, const request_t *req,
@@ -101,6 +102,7 @@ cache_t *ARC_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("ARC", ccache_params, cache_specific_params);
   cache->cache_init = ARC_init;
+  cache->current_params = ARC_effective_params;
   cache->cache_free = ARC_free;
   cache->get = ARC_get;
   cache->find = ARC_find;
@@ -605,6 +607,10 @@ static const char *ARC_current_params(ARC_params_t *params) {
   return params_str;
 }
 
+static const char *ARC_effective_params(const cache_t *cache) {
+  return ARC_current_params((ARC_params_t *)cache->eviction_params);
+}
+
 static void ARC_parse_params(cache_t *cache,
                              const char *cache_specific_params) {
   ARC_params_t *params = (ARC_params_t *)(cache->eviction_params);
@@ -702,11 +708,11 @@ static void _ARC_sanity_check(cache_t *cache, const request_t *req) {
   }
 
   DEBUG_ASSERT(params->L1_data_size + params->L2_data_size ==
-               cache->occupied_byte);
+               cache_get_occupied_byte_default(cache));
   // DEBUG_ASSERT(params->L1_data_size + params->L2_data_size +
   //                  params->L1_ghost_size + params->L2_ghost_size <=
   //              cache->cache_size * 2);
-  DEBUG_ASSERT(cache->occupied_byte <= cache->cache_size);
+  DEBUG_ASSERT(cache_get_occupied_byte_default(cache) <= cache->cache_size);
 }
 
 static inline void _ARC_sanity_check_full(cache_t *cache,
@@ -790,7 +796,8 @@ static bool ARC_get_debug(cache_t *cache, const request_t *req) {
     return false;
   }
 
-  while (cache->occupied_byte + req->obj_size + cache->obj_md_size >
+  while (cache_get_occupied_byte_default(cache) + req->obj_size +
+             cache->obj_md_size >
          cache->cache_size) {
     cache->evict(cache, req);
   }
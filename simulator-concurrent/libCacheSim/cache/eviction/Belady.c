@@ -114,7 +114,7 @@ static bool Belady_get(cache_t *cache, const request_t *req) {
   DEBUG_ASSERT(req->next_access_vtime != -2);
   Belady_params_t *params = cache->eviction_params;
 
-  DEBUG_ASSERT(cache->n_obj == params->pq->size - 1);
+  DEBUG_ASSERT(cache_get_n_obj_default(cache) == params->pq->size - 1);
   bool ret = cache_get_base(cache, req);
 
   return ret;
@@ -30,6 +30,7 @@ typedef struct {
 
 static void BeladySize_parse_params(cache_t *cache,
                                     const char *cache_specific_params);
+static const char *BeladySize_effective_params(const cache_t *cache);
 static void BeladySize_free(cache_t *cache);
 static bool BeladySize_get(cache_t *cache, const request_t *req);
 static cache_obj_t *BeladySize_find(cache_t *cache, const request_t *req,
@@ -58,6 +59,7 @@ cache_t *BeladySize_init(const common_cache_params_t ccache_params,
   cache_t *cache = cache_struct_init("BeladySize", ccache_params, cache_specific_params);
 
   cache->cache_init = BeladySize_init;
+  cache->current_params = BeladySize_effective_params;
   cache->cache_free = BeladySize_free;
   cache->get = BeladySize_get;
   cache->find = BeladySize_find;
@@ -279,6 +281,11 @@ static const char *BeladySize_current_params(BeladySize_params_t *params) {
   return params_str;
 }
 
+static const char *BeladySize_effective_params(const cache_t *cache) {
+  return BeladySize_current_params(
+      (BeladySize_params_t *)cache->eviction_params);
+}
+
 /**
  * parse the given parameters
  * input parameter is a string,
@@ -362,7 +362,7 @@ static void CR_LFU_evict(cache_t *cache, const request_t *req) {
     }
     if (params->min_freq == old_min_freq) {
       params->min_freq = -1;
-      DEBUG_ASSERT(cache->n_obj == 1);
+      DEBUG_ASSERT(cache_get_n_obj_default(cache) == 1);
     } else {
       DEBUG_ASSERT(params->min_freq > old_min_freq);
     }
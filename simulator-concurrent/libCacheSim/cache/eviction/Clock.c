@@ -12,6 +12,7 @@
 
 #include "../../dataStructure/hashtable/hashtable.h"
 #include "../../include/libCacheSim/evictionAlgo.h"
+#include "../../include/libCacheSim/segmentedQueue.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,7 +21,7 @@ extern "C" {
 // #define USE_BELADY
 #undef USE_BELADY
 
-static const char *DEFAULT_PARAMS = "n-bit-counter=1";
+static const char *DEFAULT_PARAMS = "n-bit-counter=1,n-seg=1";
 
 // ***********************************************************************
 // ****                                                               ****
@@ -30,6 +31,7 @@ static const char *DEFAULT_PARAMS = "n-bit-counter=1";
 
 static void Clock_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *Clock_effective_params(const cache_t *cache);
 static void Clock_free(cache_t *cache);
 static bool Clock_get(cache_t *cache, const request_t *req);
 static cache_obj_t *Clock_find(cache_t *cache, const request_t *req,
@@ -56,6 +58,7 @@ cache_t *Clock_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("Clock", ccache_params, cache_specific_params);
   cache->cache_init = Clock_init;
+  cache->current_params = Clock_effective_params;
   cache->cache_free = Clock_free;
   cache->get = Clock_get;
   cache->find = Clock_find;
@@ -79,13 +82,18 @@ cache_t *Clock_init(const common_cache_params_t ccache_params,
   params->q_tail = NULL;
   params->n_bit_counter = 1;
   params->max_freq = 1;
+  params->n_seg = 1;
 
   Clock_parse_params(cache, DEFAULT_PARAMS);
   if (cache_specific_params != NULL) {
     Clock_parse_params(cache, cache_specific_params);
   }
 
-  if (params->n_bit_counter != 1) {
+  if (params->n_seg > 1) {
+    params->segs = segmented_queue_create(params->n_seg);
+    snprintf(cache->cache_name, CACHE_NAME_ARRAY_LEN, "Clock-%d-seg-%d",
+             params->n_bit_counter, params->n_seg);
+  } else if (params->n_bit_counter != 1) {
     snprintf(cache->cache_name, CACHE_NAME_ARRAY_LEN, "Clock-%d",
              params->n_bit_counter);
   }
@@ -101,6 +109,8 @@ cache_t *Clock_init(const common_cache_params_t ccache_params,
  * @param cache
  */
 static void Clock_free(cache_t *cache) {
+  Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
+  if (params->segs != NULL) segmented_queue_free(params->segs);
   free(cache->eviction_params);
   cache_struct_free(cache);
 }
@@ -173,7 +183,11 @@ static cache_obj_t *Clock_find(cache_t *cache, const request_t *req,
  */
 static cache_obj_t *Clock_insert(cache_t *cache, const request_t *req) {
   cache_obj_t *obj = cache_insert_base(cache, req);
-  if (obj != NULL){
+  Clock_params_t *clock_params = (Clock_params_t *)cache->eviction_params;
+  if (obj != NULL && clock_params->segs != NULL) {
+    segmented_queue_insert(clock_params->segs, cache, obj);
+    if (cache->warmup_complete) atomic_store(&obj->clock.freq, 0);
+  } else if (obj != NULL){
     FIFO_params_t *params = (FIFO_params_t *)cache->eviction_params;
     if (!cache->warmup_complete){
       prepend_obj_to_head(&params->q_head, &params->q_tail, obj);
@@ -203,7 +217,11 @@ static cache_obj_t *Clock_to_evict(cache_t *cache, const request_t *req) {
   Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
 
   int n_round = 0;
-  cache_obj_t *obj_to_evict = params->q_tail;
+  cache_obj_t *q_tail = params->q_tail;
+  if (params->segs != NULL) {
+    q_tail = segmented_queue_largest(params->segs)->q_tail;
+  }
+  cache_obj_t *obj_to_evict = q_tail;
 #ifdef USE_BELADY
   while (obj_to_evict->next_access_vtime != INT64_MAX) {
 #else
@@ -211,7 +229,7 @@ static cache_obj_t *Clock_to_evict(cache_t *cache, const request_t *req) {
 #endif
     obj_to_evict = obj_to_evict->queue.prev;
     if (obj_to_evict == NULL) {
-      obj_to_evict = params->q_tail;
+      obj_to_evict = q_tail;
       n_round += 1;
     }
   }
@@ -219,6 +237,26 @@ static cache_obj_t *Clock_to_evict(cache_t *cache, const request_t *req) {
   return obj_to_evict;
 }
 
+/**
+ * @brief evict an object from the segmented ring, the hand of the chosen
+ * segment reinserts the objects with a non-zero frequency at the head of
+ * the same segment
+ *
+ * @param cache
+ * @param segs
+ */
+static void Clock_evict_segmented(cache_t *cache, segmented_queue_t *segs) {
+  int seg_id = -1;
+  cache_obj_t *obj_to_evict = segmented_queue_pop(segs, cache, &seg_id);
+  while (obj_to_evict->clock.freq > 0) {
+    segmented_queue_reinsert(segs, seg_id, obj_to_evict);
+    THREAD_STAT_INC(n_reinsertion);
+    obj_to_evict->clock.freq -= 1;
+    obj_to_evict = segmented_queue_pop(segs, cache, &seg_id);
+  }
+  cache_evict_base(cache, obj_to_evict, true);
+}
+
 /**
  * @brief evict an object from the cache
  * it needs to call cache_evict_base before returning
@@ -231,11 +269,16 @@ static cache_obj_t *Clock_to_evict(cache_t *cache, const request_t *req) {
 static void Clock_evict(cache_t *cache, const request_t *req) {
 
   Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
+  if (params->segs != NULL) {
+    Clock_evict_segmented(cache, params->segs);
+    return;
+  }
   // pthread_spin_lock(&cache->lock);
   // spin_lock(&cache->val_lock);
   cache_obj_t *obj_to_evict = T_evict_last_obj(&params->q_head, &params->q_tail);
   while (obj_to_evict->clock.freq > 0) {
     T_prepend_obj_to_head(&params->q_head, &params->q_tail, obj_to_evict);
+    THREAD_STAT_INC(n_reinsertion);
     // __atomic_fetch_sub(&obj_to_evict->clock.freq, 1, __ATOMIC_RELAXED);
     obj_to_evict->clock.freq -= 1;
     obj_to_evict = T_evict_last_obj(&params->q_head, &params->q_tail);
@@ -263,7 +306,11 @@ static void Clock_remove_obj(cache_t *cache, cache_obj_t *obj) {
   Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
 
   DEBUG_ASSERT(obj != NULL);
-  remove_obj_from_list(&params->q_head, &params->q_tail, obj);
+  if (params->segs != NULL) {
+    segmented_queue_remove(params->segs, obj);
+  } else {
+    remove_obj_from_list(&params->q_head, &params->q_tail, obj);
+  }
   cache_remove_obj_base(cache, obj, true);
 }
 
@@ -299,11 +346,17 @@ static bool Clock_remove(cache_t *cache, const obj_id_t obj_id) {
 static const char *Clock_current_params(cache_t *cache,
                                         Clock_params_t *params) {
   static __thread char params_str[128];
-  snprintf(params_str, 128, "n-bit-counter=%d\n", params->n_bit_counter);
+  snprintf(params_str, 128, "n-bit-counter=%d, n-seg=%d\n",
+           params->n_bit_counter, params->n_seg);
 
   return params_str;
 }
 
+static const char *Clock_effective_params(const cache_t *cache) {
+  return Clock_current_params((cache_t *)cache,
+                              (Clock_params_t *)cache->eviction_params);
+}
+
 static void Clock_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
@@ -329,6 +382,14 @@ static void Clock_parse_params(cache_t *cache,
       if (strlen(end) > 2) {
         ERROR("param parsing error, find string \"%s\" after number\n", end);
       }
+    } else if (strcasecmp(key, "n-seg") == 0) {
+      params->n_seg = (int)strtol(value, &end, 0);
+      if (strlen(end) > 2) {
+        ERROR("param parsing error, find string \"%s\" after number\n", end);
+      }
+      if (params->n_seg <= 0) {
+        ERROR("n-seg must be positive, but it is %d\n", params->n_seg);
+      }
     } else if (strcasecmp(key, "print") == 0) {
       printf("current parameters: %s\n", Clock_current_params(cache, params));
       exit(0);
@@ -14,6 +14,7 @@
 
 #include "../../dataStructure/hashtable/hashtable.h"
 #include "../../include/libCacheSim/evictionAlgo.h"
+#include "../../include/libCacheSim/segmentedQueue.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,7 +23,7 @@ extern "C" {
 // #define USE_BELADY
 #undef USE_BELADY
 
-static const char *DEFAULT_PARAMS = "n-bit-counter=1,delay-ratio=0.05";
+static const char *DEFAULT_PARAMS = "n-bit-counter=1,delay-ratio=0.05,n-seg=1";
 
 // ***********************************************************************
 // ****                                                               ****
@@ -31,6 +32,7 @@ static const char *DEFAULT_PARAMS = "n-bit-counter=1,delay-ratio=0.05";
 // ***********************************************************************
 
 static void DelayFR_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *DelayFR_effective_params(const cache_t *cache);
 static void DelayFR_free(cache_t *cache);
 static bool DelayFR_get(cache_t *cache, const request_t *req);
 static cache_obj_t *DelayFR_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -61,6 +63,9 @@ typedef struct {
   int64_t delay_time;
   float delay_ratio;
 
+  /* NULL if the ring is the single list of q_head and q_tail */
+  segmented_queue_t *segs;
+  int n_seg;
 } DelayFR_params_t;
 
 /**
@@ -72,6 +77,7 @@ typedef struct {
 cache_t *DelayFR_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("DelayFR", ccache_params, cache_specific_params);
   cache->cache_init = DelayFR_init;
+  cache->current_params = DelayFR_effective_params;
   cache->cache_free = DelayFR_free;
   cache->get = DelayFR_get;
   cache->find = DelayFR_find;
@@ -95,6 +101,7 @@ cache_t *DelayFR_init(const common_cache_params_t ccache_params, const char *cac
   params->q_tail = NULL;
   params->n_bit_counter = 1;
   params->max_freq = 1;
+  params->n_seg = 1;
 
   DelayFR_parse_params(cache, DEFAULT_PARAMS);
   if (cache_specific_params != NULL) {
@@ -102,6 +109,11 @@ cache_t *DelayFR_init(const common_cache_params_t ccache_params, const char *cac
   }
 
   snprintf(cache->cache_name, CACHE_NAME_ARRAY_LEN, "DelayFR-%d-%f", params->n_bit_counter, params->delay_ratio);
+  if (params->n_seg > 1) {
+    params->segs = segmented_queue_create(params->n_seg);
+    snprintf(cache->cache_name, CACHE_NAME_ARRAY_LEN, "DelayFR-%d-%f-seg-%d", params->n_bit_counter,
+             params->delay_ratio, params->n_seg);
+  }
 
   pthread_spin_init(&cache->lock, 0);
   return cache;
@@ -113,6 +125,8 @@ cache_t *DelayFR_init(const common_cache_params_t ccache_params, const char *cac
  * @param cache
  */
 static void DelayFR_free(cache_t *cache) {
+  DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
+  if (params->segs != NULL) segmented_queue_free(params->segs);
   free(cache->eviction_params);
   cache_struct_free(cache);
 }
@@ -189,10 +203,14 @@ static cache_obj_t *DelayFR_insert(cache_t *cache, const request_t *req) {
   cache_obj_t *obj = cache_insert_base(cache, req);
   if (obj != NULL) {
     DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
-    if (!cache->warmup_complete) {
+    if (params->segs != NULL) {
+      segmented_queue_insert(params->segs, cache, obj);
+    } else if (!cache->warmup_complete) {
       prepend_obj_to_head(&params->q_head, &params->q_tail, obj);
     } else {
       T_prepend_obj_to_head(&params->q_head, &params->q_tail, obj);
+    }
+    if (cache->warmup_complete) {
       atomic_fetch_add(&params->current_time, 1);
       atomic_store(&obj->clock.freq, 0);
       atomic_store(&obj->delay_FR.last_reuse_time, atomic_load(&params->current_time));
@@ -219,7 +237,8 @@ static cache_obj_t *DelayFR_to_evict(cache_t *cache, const request_t *req) {
   DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
 
   int n_round = 0;
-  cache_obj_t *obj_to_evict = params->q_tail;
+  cache_obj_t *q_tail = params->segs == NULL ? params->q_tail : segmented_queue_largest(params->segs)->q_tail;
+  cache_obj_t *obj_to_evict = q_tail;
 #ifdef USE_BELADY
   while (obj_to_evict->next_access_vtime != INT64_MAX) {
 #else
@@ -227,7 +246,7 @@ static cache_obj_t *DelayFR_to_evict(cache_t *cache, const request_t *req) {
 #endif
     obj_to_evict = obj_to_evict->queue.prev;
     if (obj_to_evict == NULL) {
-      obj_to_evict = params->q_tail;
+      obj_to_evict = q_tail;
       n_round += 1;
     }
   }
@@ -235,6 +254,25 @@ static cache_obj_t *DelayFR_to_evict(cache_t *cache, const request_t *req) {
   return obj_to_evict;
 }
 
+/**
+ * @brief evict an object from the segmented ring, see Clock_evict_segmented
+ *
+ * @param cache
+ * @param params
+ */
+static void DelayFR_evict_segmented(cache_t *cache, DelayFR_params_t *params) {
+  int seg_id = -1;
+  cache_obj_t *obj_to_evict = segmented_queue_pop(params->segs, cache, &seg_id);
+  while (obj_to_evict->clock.freq > 0) {
+    segmented_queue_reinsert(params->segs, seg_id, obj_to_evict);
+    THREAD_STAT_INC(n_reinsertion);
+    obj_to_evict->clock.freq -= 1;
+    obj_to_evict = segmented_queue_pop(params->segs, cache, &seg_id);
+    atomic_fetch_add(&params->current_time, 1);
+  }
+  cache_evict_base(cache, obj_to_evict, true);
+}
+
 /**
  * @brief evict an object from the cache
  * it needs to call cache_evict_base before returning
@@ -246,11 +284,16 @@ static cache_obj_t *DelayFR_to_evict(cache_t *cache, const request_t *req) {
  */
 static void DelayFR_evict(cache_t *cache, const request_t *req) {
   DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
+  if (params->segs != NULL) {
+    DelayFR_evict_segmented(cache, params);
+    return;
+  }
   // pthread_spin_lock(&cache->lock);
   // spin_lock(&cache->val_lock);
   cache_obj_t *obj_to_evict = T_evict_last_obj(&params->q_head, &params->q_tail);
   while (obj_to_evict->clock.freq > 0) {
     T_prepend_obj_to_head(&params->q_head, &params->q_tail, obj_to_evict);
+    THREAD_STAT_INC(n_reinsertion);
     // __atomic_fetch_sub(&obj_to_evict->clock.freq, 1, __ATOMIC_RELAXED);
     obj_to_evict->clock.freq -= 1;
     obj_to_evict = T_evict_last_obj(&params->q_head, &params->q_tail);
@@ -279,7 +322,11 @@ static void DelayFR_remove_obj(cache_t *cache, cache_obj_t *obj) {
   DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
 
   DEBUG_ASSERT(obj != NULL);
-  remove_obj_from_list(&params->q_head, &params->q_tail, obj);
+  if (params->segs != NULL) {
+    segmented_queue_remove(params->segs, obj);
+  } else {
+    remove_obj_from_list(&params->q_head, &params->q_tail, obj);
+  }
   cache_remove_obj_base(cache, obj, true);
 }
 
@@ -314,11 +361,17 @@ static bool DelayFR_remove(cache_t *cache, const obj_id_t obj_id) {
 // ***********************************************************************
 static const char *DelayFR_current_params(cache_t *cache, DelayFR_params_t *params) {
   static __thread char params_str[128];
-  snprintf(params_str, 128, "n-bit-counter=%d\n", params->n_bit_counter);
+  snprintf(params_str, 128, "n-bit-counter=%d, delay-ratio=%f, n-seg=%d\n", params->n_bit_counter,
+           params->delay_ratio, params->n_seg);
 
   return params_str;
 }
 
+static const char *DelayFR_effective_params(const cache_t *cache) {
+  return DelayFR_current_params((cache_t *)cache,
+                                (DelayFR_params_t *)cache->eviction_params);
+}
+
 static void DelayFR_parse_params(cache_t *cache, const char *cache_specific_params) {
   DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
@@ -349,6 +402,14 @@ static void DelayFR_parse_params(cache_t *cache, const char *cache_specific_para
       if (strlen(end) > 2) {
         ERROR("param parsing error, find string \"%s\" after number\n", end);
       }
+    } else if (strcasecmp(key, "n-seg") == 0) {
+      params->n_seg = (int)strtol(value, &end, 0);
+      if (strlen(end) > 2) {
+        ERROR("param parsing error, find string \"%s\" after number\n", end);
+      }
+      if (params->n_seg <= 0) {
+        ERROR("n-seg must be positive, but it is %d\n", params->n_seg);
+      }
     } else if (strcasecmp(key, "print") == 0) {
       printf("current parameters: %s\n", DelayFR_current_params(cache, params));
       exit(0);
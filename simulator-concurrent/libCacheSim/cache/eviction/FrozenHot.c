@@ -152,7 +152,7 @@ cache_t *FH_init(const common_cache_params_t ccache_params,
  */
 static cache_obj_t* FH_lru_find(cache_t *cache, const request_t *req,
                              const bool from_regular) {
-  pthread_spin_lock(&cache->lock);                           
+  cache_lock(cache);
   FH_params_t *params = (FH_params_t *)cache->eviction_params;
   cache_obj_t *cache_obj = cache_find_base(cache, req, true);
 
@@ -160,13 +160,14 @@ static cache_obj_t* FH_lru_find(cache_t *cache, const request_t *req,
     if (!__atomic_load_n(&params->constucting, __ATOMIC_RELAXED)){
       // only promote object in qlist
       if (params->is_frozen && from_regular){
-        pthread_spin_unlock(&cache->lock);
+        cache_unlock(cache);
         return cache_obj;
       }
-      move_obj_to_head(&params->q_head, &params->q_tail, cache_obj); 
+      move_obj_to_head(&params->q_head, &params->q_tail, cache_obj);
+      THREAD_STAT_INC(n_promotion);
     }
   } 
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
   return cache_obj;
 }
 
@@ -179,7 +180,7 @@ static cache_obj_t* FH_lru_find(cache_t *cache, const request_t *req,
  * @param req not used
  */
 static void FH_lru_evict(cache_t *cache, const request_t *req) {
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   FH_params_t *params = (FH_params_t *)cache->eviction_params;
   // if (params->constucting){
   //   pthread_spin_unlock(&cache->lock);
@@ -193,11 +194,11 @@ static void FH_lru_evict(cache_t *cache, const request_t *req) {
     params->q_tail->queue.next = NULL;
   } else {
     /* cache->n_obj has not been updated */
-    DEBUG_ASSERT(cache->n_obj == 1);
+    DEBUG_ASSERT(cache_get_n_obj_default(cache) == 1);
     params->q_head = NULL;
   }
   cache_evict_base(cache, obj_to_evict, true);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 }
 
 /**
@@ -211,7 +212,7 @@ static void FH_lru_evict(cache_t *cache, const request_t *req) {
  * @return the inserted object
  */
 static cache_obj_t *FH_lru_insert(cache_t *cache, const request_t *req) {
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   FH_params_t *params = (FH_params_t *)cache->eviction_params;
   // if (__atomic_load_n(&params->constucting, __ATOMIC_RELAXED)){
   //   pthread_spin_unlock(&cache->lock);
@@ -221,7 +222,7 @@ static cache_obj_t *FH_lru_insert(cache_t *cache, const request_t *req) {
   if (obj != NULL){
     prepend_obj_to_head(&params->q_head, &params->q_tail, obj);
   }
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
   return obj;
 }
 
@@ -383,7 +384,7 @@ static bool FH_Regular_get(cache_t *cache, const request_t *req, FH_params_t *pa
   // 2. the cache should already wait for 2 * cache_size accesses
   // pthread_rwlock_unlock(&params->constructing);
   // WARNING: each thread may conatins less than 100 objects and cannot contribute to the total
-  if ((params->regular_cache_access >= 2 * cache->cache_size) && (cache->n_obj >= params->split_obj)){
+  if ((params->regular_cache_access >= 2 * cache->cache_size) && (cache_get_n_obj_default(cache) >= params->split_obj)){
     // if ((params->regular_cache_access == 10000)){
     // do compare and set and if it is true then go on
     bool TRUE = false;
@@ -529,7 +530,8 @@ static void construction(void* c){
 static cache_obj_t *FH_to_evict(cache_t *cache, const request_t *req) {
   FH_params_t *params = (FH_params_t *)cache->eviction_params;
 
-  DEBUG_ASSERT(params->q_tail != NULL || cache->occupied_byte == 0);
+  DEBUG_ASSERT(params->q_tail != NULL ||
+               cache_get_occupied_byte_default(cache) == 0);
   cache->to_evict_candidate_gen_vtime = cache->n_req;
   return params->q_tail;
 }
@@ -42,6 +42,8 @@ static void set_default_params(GLCache_params_t *params) {
   params->rank_intvl = 0.02;
   params->merge_consecutive_segs = true;
   params->retrain_intvl = 86400;
+  params->async_train = false;
+  params->n_train_thread = 1;
   params->train_source_y = TRAIN_Y_FROM_ONLINE;
   params->type = LOGCACHE_LEARNED;
 
@@ -53,7 +55,7 @@ const char *GLCache_default_params(void) {
   return "segment-size=100, n-merge=2, "
          "type=learned, rank-intvl=0.02,"
          "merge-consecutive-segs=true, train-source-y=online,"
-         "retrain-intvl=86400";
+         "retrain-intvl=86400, train-mode=sync, train-thread=1";
 }
 
 static void GLCache_parse_init_params(const char *cache_specific_params,
@@ -76,6 +78,17 @@ static void GLCache_parse_init_params(const char *cache_specific_params,
       params->merge_consecutive_segs = atoi(value);
     } else if (strcasecmp(key, "retrain-intvl") == 0) {
       params->retrain_intvl = atoi(value);
+    } else if (strcasecmp(key, "train-mode") == 0) {
+      if (strcasecmp(value, "sync") == 0) {
+        params->async_train = false;
+      } else if (strcasecmp(value, "async") == 0) {
+        params->async_train = true;
+      } else {
+        ERROR("Unknown train-mode %s, support sync/async\n", value);
+        exit(1);
+      }
+    } else if (strcasecmp(key, "train-thread") == 0) {
+      params->n_train_thread = atoi(value);
     } else if (strcasecmp(key, "train-source-y") == 0) {
       if (strcasecmp(value, "online") == 0) {
         params->train_source_y = TRAIN_Y_FROM_ONLINE;
@@ -206,6 +219,9 @@ cache_t *GLCache_init(const common_cache_params_t ccache_params,
  */
 static void GLCache_free(cache_t *cache) {
   GLCache_params_t *params = cache->eviction_params;
+  /* the training thread reads the training matrices */
+  install_trained_model(cache, true);
+
   bucket_t *bkt = &params->train_bucket;
   segment_t *seg = bkt->first_seg, *next_seg;
 
@@ -280,6 +296,7 @@ static bool GLCache_get(cache_t *cache, const request_t *req) {
       params->type == LOGCACHE_ITEM_ORACLE) {
     /* generate training data by taking a snapshot */
     learner_t *l = &params->learner;
+    if (l->training) install_trained_model(cache, false);
     if (l->last_train_rtime > 0 &&
         params->curr_rtime - l->last_train_rtime >= params->retrain_intvl + 1) {
       train(cache);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <pthread.h>
 #include <xgboost/c_api.h>
 
 #include "../../../include/libCacheSim/cache.h"
@@ -73,6 +74,13 @@ typedef struct learner {
   int32_t valid_matrix_n_row;
   int32_t inf_matrix_n_row;
 
+  /* async training: the model is trained on train_thread from train_dm and
+   * valid_dm while the cache keeps using booster, and it replaces booster
+   * on the first request after train_done is set */
+  bool training;
+  bool train_done; /* accessed with __atomic builtins */
+  pthread_t train_thread;
+  BoosterHandle new_booster;
 } learner_t;
 
 typedef struct cache_state {
@@ -180,6 +188,11 @@ typedef struct {
   // lowest utility) or we merge non-consecutive segments based on ranking
   bool merge_consecutive_segs;
   int retrain_intvl;
+  /* train in the background instead of blocking the request that triggers
+   * the training, the model is then used a few requests later, so the
+   * result may differ between runs */
+  bool async_train;
+  int n_train_thread;
   train_source_e train_source_y;
   GLCache_type_e type;
   double rank_intvl;
@@ -279,6 +292,8 @@ void seg_hit_update(GLCache_params_t *params, cache_obj_t *cache_obj);
 /************* learning *****************/
 void train(cache_t *cache);
 
+void install_trained_model(cache_t *cache, bool wait);
+
 void inference(cache_t *cache);
 
 /************* data preparation *****************/
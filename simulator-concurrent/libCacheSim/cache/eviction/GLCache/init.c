@@ -22,6 +22,7 @@ void check_params(GLCache_params_t *params) {
   assert(params->n_merge > 1 && params->n_merge <= 100);
   assert(params->rank_intvl > 0 && params->rank_intvl < 1);
   assert(params->segment_size / params->n_merge > 1);
+  assert(params->n_train_thread >= 1);
 }
 
 void init_seg_sel(cache_t *cache) {
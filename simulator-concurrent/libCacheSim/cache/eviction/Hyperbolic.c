@@ -19,6 +19,7 @@ typedef struct Hyperbolic_params {
 
 static void Hyperbolic_parse_params(cache_t *cache,
                                     const char *cache_specific_params);
+static const char *Hyperbolic_effective_params(const cache_t *cache);
 static void Hyperbolic_free(cache_t *cache);
 static bool Hyperbolic_get(cache_t *cache, const request_t *req);
 static cache_obj_t *Hyperbolic_find(cache_t *cache, const request_t *req,
@@ -48,6 +49,7 @@ cache_t *Hyperbolic_init(const common_cache_params_t ccache_params,
 
   cache_t *cache = cache_struct_init("Hyperbolic", ccache_params_local, cache_specific_params);
   cache->cache_init = Hyperbolic_init;
+  cache->current_params = Hyperbolic_effective_params;
   cache->cache_free = Hyperbolic_free;
   cache->get = Hyperbolic_get;
   cache->find = Hyperbolic_find;
@@ -205,7 +207,7 @@ static void Hyperbolic_evict(cache_t *cache,
   cache->to_evict_candidate_gen_vtime = -1;
 
   if (obj_to_evict == NULL) {
-    DEBUG_ASSERT(cache->n_obj == 0);
+    DEBUG_ASSERT(cache_get_n_obj_default(cache) == 0);
     WARN("no object can be evicted\n");
   }
 
@@ -251,6 +253,11 @@ static const char *Hyperbolic_current_params(Hyperbolic_params_t *params) {
   return params_str;
 }
 
+static const char *Hyperbolic_effective_params(const cache_t *cache) {
+  return Hyperbolic_current_params(
+      (Hyperbolic_params_t *)cache->eviction_params);
+}
+
 static void Hyperbolic_parse_params(cache_t *cache,
                                     const char *cache_specific_params) {
   char *end;
@@ -19,13 +19,17 @@ extern "C" {
 typedef struct {
   void *LRB_cache;
   char *objective;
+  /* sync or async, see LRBCache::train */
+  bool async_train;
+  int n_train_thread;
   SimpleRequest lrb_req;
 
   pair<uint64_t, uint32_t> to_evict_pair;
   cache_obj_t obj_tmp;
 } LRB_params_t;
 
-static const char *DEFAULT_PARAMS = "objective=byte-miss-ratio";
+static const char *DEFAULT_PARAMS =
+    "objective=byte-miss-ratio, train-mode=sync, train-thread=1";
 
 // ***********************************************************************
 // ****                                                               ****
@@ -46,6 +50,7 @@ static int64_t LRB_get_occupied_byte(const cache_t *cache);
 static int64_t LRB_get_n_obj(const cache_t *cache);
 
 static void LRB_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *LRB_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -72,6 +77,7 @@ cache_t *LRB_init(const common_cache_params_t ccache_params,
 
   cache_t *cache = cache_struct_init("LRB", ccache_params, cache_specific_params);
   cache->cache_init = LRB_init;
+  cache->current_params = LRB_effective_params;
   cache->cache_free = LRB_free;
   cache->get = LRB_get;
   cache->find = LRB_find;
@@ -95,10 +101,9 @@ cache_t *LRB_init(const common_cache_params_t ccache_params,
   memset(params, 0, sizeof(LRB_params_t));
   cache->eviction_params = params;
 
+  LRB_parse_params(cache, DEFAULT_PARAMS);
   if (cache_specific_params != NULL) {
     LRB_parse_params(cache, cache_specific_params);
-  } else {
-    LRB_parse_params(cache, DEFAULT_PARAMS);
   }
 
   auto *lrb = new lrb::LRBCache();
@@ -109,6 +114,8 @@ cache_t *LRB_init(const common_cache_params_t ccache_params,
   std::map<string, string> params_map;
 
   params_map["objective"] = params->objective;
+  params_map["train_mode"] = params->async_train ? "async" : "sync";
+  params_map["num_threads"] = std::to_string(params->n_train_thread);
 
   if (strcmp(params->objective, "object-miss-ratio") == 0) {
     snprintf(cache->cache_name, CACHE_NAME_ARRAY_LEN, "%s", "LRB-OMR");
@@ -307,13 +314,23 @@ static int64_t LRB_get_occupied_byte(const cache_t *cache) {
 // ***********************************************************************
 static const char *LRB_current_params(cache_t *cache, LRB_params_t *params) {
   static __thread char params_str[128];
-  int n = snprintf(params_str, 128, "objective=%s", params->objective);
+  int n = snprintf(params_str, sizeof(params_str),
+                   "objective=%s, train-mode=%s, train-thread=%d",
+                   params->objective, params->async_train ? "async" : "sync",
+                   params->n_train_thread);
 
-  snprintf(cache->cache_name + n, 128 - n, "\n");
+  if (n >= 0 && (size_t)n < sizeof(params_str)) {
+    snprintf(params_str + n, sizeof(params_str) - n, "\n");
+  }
 
   return params_str;
 }
 
+static const char *LRB_effective_params(const cache_t *cache) {
+  return LRB_current_params((cache_t *)cache,
+                            (LRB_params_t *)cache->eviction_params);
+}
+
 static void LRB_parse_params(cache_t *cache,
                              const char *cache_specific_params) {
   LRB_params_t *params = (LRB_params_t *)cache->eviction_params;
@@ -332,10 +349,24 @@ static void LRB_parse_params(cache_t *cache,
     }
 
     if (strcasecmp(key, "objective") == 0) {
+      free(params->objective);
       params->objective = strdup(value);
       if (params->objective == NULL) {
         ERROR("out of memory %s\n", strerror(errno));
       }
+    } else if (strcasecmp(key, "train-mode") == 0) {
+      if (strcasecmp(value, "sync") == 0) {
+        params->async_train = false;
+      } else if (strcasecmp(value, "async") == 0) {
+        params->async_train = true;
+      } else {
+        ERROR("Unknown train-mode %s, support sync/async\n", value);
+      }
+    } else if (strcasecmp(key, "train-thread") == 0) {
+      params->n_train_thread = (int)strtol(value, &end, 0);
+      if (params->n_train_thread < 1) {
+        ERROR("train-thread must be at least 1, given %s\n", value);
+      }
     } else if (strcasecmp(key, "print") == 0) {
       printf("current parameters: %s\n", LRB_current_params(cache, params));
       exit(0);
@@ -12,6 +12,7 @@
 #include <pthread.h> 
 #include "../../dataStructure/hashtable/hashtable.h"
 #include "../../include/libCacheSim/evictionAlgo.h"
+#include "../../include/libCacheSim/promotionCombiner.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +26,9 @@ extern "C" {
 // ****                                                               ****
 // ***********************************************************************
 
+static void LRU_parse_params(cache_t *cache,
+                             const char *cache_specific_params);
+static const char *LRU_effective_params(const cache_t *cache);
 static void LRU_free(cache_t *cache);
 static bool LRU_get(cache_t *cache, const request_t *req);
 static cache_obj_t *LRU_find(cache_t *cache, const request_t *req,
@@ -34,6 +38,7 @@ static cache_obj_t *LRU_to_evict(cache_t *cache, const request_t *req);
 static void LRU_evict(cache_t *cache, const request_t *req);
 static bool LRU_remove(cache_t *cache, const obj_id_t obj_id);
 static void LRU_print_cache(const cache_t *cache);
+static cache_obj_t *LRU_promote(cache_t *cache, const request_t *req);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -45,13 +50,15 @@ static void LRU_print_cache(const cache_t *cache);
  * @brief initialize a LRU cache
  *
  * @param ccache_params some common cache parameters
- * @param cache_specific_params LRU specific parameters, should be NULL
+ * @param cache_specific_params LRU specific parameters, see parse_params
+ * function or use -e "print" with the cachesim binary
  */
 cache_t *LRU_init(const common_cache_params_t ccache_params,
                   const char *cache_specific_params) {
   cache_t *cache =
       cache_struct_init("LRU", ccache_params, cache_specific_params);
   cache->cache_init = LRU_init;
+  cache->current_params = LRU_effective_params;
   cache->cache_free = LRU_free;
   cache->get = LRU_get;
   cache->find = LRU_find;
@@ -82,8 +89,16 @@ cache_t *LRU_init(const common_cache_params_t ccache_params,
   LRU_params_t *params = malloc(sizeof(LRU_params_t));
   params->q_head = NULL;
   params->q_tail = NULL;
+  params->combiner = NULL;
   cache->eviction_params = params;
 
+  if (cache_specific_params != NULL) {
+    LRU_parse_params(cache, cache_specific_params);
+  }
+  if (params->combiner != NULL) {
+    snprintf(cache->cache_name, CACHE_NAME_ARRAY_LEN, "LRU_combine");
+  }
+
   return cache;
 }
 
@@ -92,7 +107,11 @@ cache_t *LRU_init(const common_cache_params_t ccache_params,
  *
  * @param cache
  */
-static void LRU_free(cache_t *cache) { cache_struct_free(cache); }
+static void LRU_free(cache_t *cache) {
+  LRU_params_t *params = (LRU_params_t *)cache->eviction_params;
+  if (params->combiner != NULL) promotion_combiner_free(params->combiner);
+  cache_struct_free(cache);
+}
 
 /**
  * @brief this function is the user facing API
@@ -136,10 +155,13 @@ static bool LRU_get(cache_t *cache, const request_t *req) {
 static cache_obj_t *LRU_find(cache_t *cache, const request_t *req,
                              const bool update_cache) {
 
-
   LRU_params_t *params = (LRU_params_t *)cache->eviction_params;
+  if (params->combiner != NULL) {
+    return promotion_combiner_promote(params->combiner, cache, req);
+  }
+
   cache_obj_t *cache_obj = hashtable_find_obj_id(cache->hashtable, req->obj_id);
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   // pthread_mutex_lock(&cache->lock2);
   cache_obj = hashtable_find_obj_id(cache->hashtable, req->obj_id);
   if (cache_obj) {
@@ -147,11 +169,29 @@ static cache_obj_t *LRU_find(cache_t *cache, const request_t *req,
       // printf("we are here\n");
       // pthread_cond_wait(&cache->cond_var, &cache->lock2);
       move_obj_to_head(&params->q_head, &params->q_tail, cache_obj);
+      THREAD_STAT_INC(n_promotion);
       // pthread_cond_signal(&cache->cond_var);
       // spin_unlock(&cache->val_lock);
   }
   // pthread_mutex_unlock(&cache->lock2);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
+  return cache_obj;
+}
+
+/**
+ * @brief move the object of req to the head, called by the combiner with
+ * cache->lock held
+ *
+ * @param cache
+ * @param req
+ * @return the object or NULL if it is not in the cache
+ */
+static cache_obj_t *LRU_promote(cache_t *cache, const request_t *req) {
+  LRU_params_t *params = (LRU_params_t *)cache->eviction_params;
+  cache_obj_t *cache_obj = hashtable_find_obj_id(cache->hashtable, req->obj_id);
+  if (cache_obj) {
+    move_obj_to_head(&params->q_head, &params->q_tail, cache_obj);
+  }
   return cache_obj;
 }
 
@@ -168,7 +208,7 @@ static cache_obj_t *LRU_find(cache_t *cache, const request_t *req,
 static cache_obj_t *LRU_insert(cache_t *cache, const request_t *req) {
 
   // spin_lock(&cache->val_lock);
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   cache_obj_t *obj = cache_insert_base(cache, req);
   // printf("thread %lu called insert\n", pthread_self());
   if (obj != NULL){
@@ -176,7 +216,7 @@ static cache_obj_t *LRU_insert(cache_t *cache, const request_t *req) {
     prepend_obj_to_head(&params->q_head, &params->q_tail, obj);
   }
   // spin_unlock(&cache->val_lock);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
   return obj;
 }
 
@@ -193,7 +233,8 @@ static cache_obj_t *LRU_insert(cache_t *cache, const request_t *req) {
 static cache_obj_t *LRU_to_evict(cache_t *cache, const request_t *req) {
   LRU_params_t *params = (LRU_params_t *)cache->eviction_params;
 
-  DEBUG_ASSERT(params->q_tail != NULL || cache->occupied_byte == 0);
+  DEBUG_ASSERT(params->q_tail != NULL ||
+               cache_get_occupied_byte_default(cache) == 0);
   cache->to_evict_candidate_gen_vtime = cache->n_req;
   return params->q_tail;
 }
@@ -208,7 +249,7 @@ static cache_obj_t *LRU_to_evict(cache_t *cache, const request_t *req) {
  */
 static void LRU_evict(cache_t *cache, const request_t *req) {
   // spin_lock(&cache->val_lock);
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   LRU_params_t *params = (LRU_params_t *)cache->eviction_params;
   cache_obj_t *obj_to_evict = params->q_tail;
   DEBUG_ASSERT(params->q_tail != NULL);
@@ -217,12 +258,12 @@ static void LRU_evict(cache_t *cache, const request_t *req) {
     params->q_tail->queue.next = NULL;
   } else {
     /* cache->n_obj has not been updated */
-    DEBUG_ASSERT(cache->n_obj == 1);
+    DEBUG_ASSERT(cache_get_n_obj_default(cache) == 1);
     params->q_head = NULL;
   }
   cache_evict_base(cache, obj_to_evict, true);
   // spin_unlock(&cache->val_lock);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 
 #if defined(TRACK_DEMOTION)
   if (cache->track_demotion)
@@ -283,6 +324,59 @@ static bool LRU_remove(cache_t *cache, const obj_id_t obj_id) {
   return true;
 }
 
+// ***********************************************************************
+// ****                                                               ****
+// ****                parameter set up functions                     ****
+// ****                                                               ****
+// ***********************************************************************
+static const char *LRU_current_params(LRU_params_t *params) {
+  static __thread char params_str[128];
+  snprintf(params_str, 128, "combine=%d\n", params->combiner != NULL);
+  return params_str;
+}
+
+static const char *LRU_effective_params(const cache_t *cache) {
+  return LRU_current_params((LRU_params_t *)cache->eviction_params);
+}
+
+static void LRU_parse_params(cache_t *cache,
+                             const char *cache_specific_params) {
+  LRU_params_t *params = (LRU_params_t *)cache->eviction_params;
+  char *params_str = strdup(cache_specific_params);
+  char *old_params_str = params_str;
+  char *end;
+
+  while (params_str != NULL && params_str[0] != '\0') {
+    /* different parameters are separated by comma,
+     * key and value are separated by = */
+    char *key = strsep((char **)&params_str, "=");
+    char *value = strsep((char **)&params_str, ",");
+
+    // skip the white space
+    while (params_str != NULL && *params_str == ' ') {
+      params_str++;
+    }
+
+    if (strcasecmp(key, "combine") == 0) {
+      long combine = strtol(value, &end, 0);
+      if (strlen(end) > 2) {
+        ERROR("param parsing error, find string \"%s\" after number\n", end);
+      }
+      if (combine && params->combiner == NULL) {
+        params->combiner =
+            promotion_combiner_create(cache->thread_num, LRU_promote);
+      }
+    } else if (strcasecmp(key, "print") == 0) {
+      printf("current parameters: %s\n", LRU_current_params(params));
+      exit(0);
+    } else {
+      ERROR("%s does not have parameter %s\n", cache->cache_name, key);
+      exit(1);
+    }
+  }
+  free(old_params_str);
+}
+
 static void LRU_print_cache(const cache_t *cache) {
   LRU_params_t *params = (LRU_params_t *)cache->eviction_params;
   cache_obj_t *cur = params->q_head;
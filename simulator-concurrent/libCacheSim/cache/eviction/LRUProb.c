@@ -11,6 +11,7 @@
 
 #include "../../dataStructure/hashtable/hashtable.h"
 #include "../../include/libCacheSim/cache.h"
+#include "../../include/libCacheSim/promotionCombiner.h"
 #include "../../utils/include/mymath.h"
 
 #ifdef __cplusplus
@@ -23,6 +24,8 @@ typedef struct LRU_Prob_params {
 
   double prob;
   int threshold;
+  /* NULL if every promotion takes cache->lock itself */
+  promotion_combiner_t *combiner;
 } LRU_Prob_params_t;
 
 // ***********************************************************************
@@ -32,6 +35,7 @@ typedef struct LRU_Prob_params {
 // ***********************************************************************
 
 static void LRU_Prob_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *LRU_Prob_effective_params(const cache_t *cache);
 static void LRU_Prob_free(cache_t *cache);
 static bool LRU_Prob_get(cache_t *cache, const request_t *req);
 static cache_obj_t *LRU_Prob_find(cache_t *cache, const request_t *req,
@@ -40,6 +44,7 @@ static cache_obj_t *LRU_Prob_insert(cache_t *cache, const request_t *req);
 static cache_obj_t *LRU_Prob_to_evict(cache_t *cache, const request_t *req);
 static void LRU_Prob_evict(cache_t *cache, const request_t *req);
 static bool LRU_Prob_remove(cache_t *cache, const obj_id_t obj_id);
+static cache_obj_t *LRU_Prob_promote(cache_t *cache, const request_t *req);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -59,6 +64,7 @@ cache_t *LRU_Prob_init(const common_cache_params_t ccache_params,
                        const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LRU_Prob", ccache_params, cache_specific_params);
   cache->cache_init = LRU_Prob_init;
+  cache->current_params = LRU_Prob_effective_params;
   cache->cache_free = LRU_Prob_free;
   cache->get = LRU_Prob_get;
   cache->find = LRU_Prob_find;
@@ -78,15 +84,18 @@ cache_t *LRU_Prob_init(const common_cache_params_t ccache_params,
   cache->eviction_params =
       (LRU_Prob_params_t *)malloc(sizeof(LRU_Prob_params_t));
   LRU_Prob_params_t *params = (LRU_Prob_params_t *)(cache->eviction_params);
+  params->q_head = NULL;
+  params->q_tail = NULL;
   params->prob = 0.5;
+  params->combiner = NULL;
 
   if (cache_specific_params != NULL) {
     LRU_Prob_parse_params(cache, cache_specific_params);
   }
 
   params->threshold = (int)1.0 / params->prob;
-  snprintf(cache->cache_name, CACHE_NAME_ARRAY_LEN, "LRU_Prob_%lf",
-           params->prob);
+  snprintf(cache->cache_name, CACHE_NAME_ARRAY_LEN, "LRU_Prob_%lf%s",
+           params->prob, params->combiner != NULL ? "_combine" : "");
 
   return cache;
 }
@@ -97,6 +106,8 @@ cache_t *LRU_Prob_init(const common_cache_params_t ccache_params,
  * @param cache
  */
 static void LRU_Prob_free(cache_t *cache) {
+  LRU_Prob_params_t *params = (LRU_Prob_params_t *)cache->eviction_params;
+  if (params->combiner != NULL) promotion_combiner_free(params->combiner);
   free(cache->eviction_params);
   cache_struct_free(cache);
 }
@@ -151,17 +162,37 @@ static cache_obj_t* LRU_Prob_find(cache_t *cache, const request_t *req,
   promote = (normalized_val < params->prob);
   if (!promote){
     return cache_find_base(cache, req, update_cache);
+  } else if (params->combiner != NULL && likely(update_cache)) {
+    return promotion_combiner_promote(params->combiner, cache, req);
   }else{
-    pthread_spin_lock(&cache->lock);
+    cache_lock(cache);
     obj = cache_find_base(cache, req, update_cache);
     if (obj != NULL && likely(update_cache)) {
       move_obj_to_head(&params->q_head, &params->q_tail, obj);
+      THREAD_STAT_INC(n_promotion);
     }
-    pthread_spin_unlock(&cache->lock);
+    cache_unlock(cache);
     return obj;
   }
 }
 
+/**
+ * @brief move the object of req to the head, called by the combiner with
+ * cache->lock held
+ *
+ * @param cache
+ * @param req
+ * @return the object or NULL if not found
+ */
+static cache_obj_t *LRU_Prob_promote(cache_t *cache, const request_t *req) {
+  LRU_Prob_params_t *params = (LRU_Prob_params_t *)cache->eviction_params;
+  cache_obj_t *obj = cache_find_base(cache, req, true);
+  if (obj != NULL) {
+    move_obj_to_head(&params->q_head, &params->q_tail, obj);
+  }
+  return obj;
+}
+
 /**
  * @brief insert an object into the cache,
  * update the hash table and cache metadata
@@ -174,15 +205,15 @@ static cache_obj_t* LRU_Prob_find(cache_t *cache, const request_t *req,
  * @return the inserted object
  */
 static cache_obj_t *LRU_Prob_insert(cache_t *cache, const request_t *req) {
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   cache_obj_t *obj = cache_insert_base(cache, req);
   if (obj == NULL) {
-    pthread_spin_unlock(&cache->lock);
+    cache_unlock(cache);
     return NULL;
   }
   LRU_Prob_params_t *params = (LRU_Prob_params_t *)cache->eviction_params;
   prepend_obj_to_head(&params->q_head, &params->q_tail, obj);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 
   return obj;
 }
@@ -214,12 +245,12 @@ static cache_obj_t *LRU_Prob_to_evict(cache_t *cache, const request_t *req) {
  */
 static void LRU_Prob_evict(cache_t *cache, const request_t *req) {
 
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   LRU_Prob_params_t *params = (LRU_Prob_params_t *)cache->eviction_params;
   cache_obj_t *obj_to_evict = params->q_tail;
   remove_obj_from_list(&params->q_head, &params->q_tail, obj_to_evict);
   cache_remove_obj_base(cache, obj_to_evict, true);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 }
 
 static void LRU_Prob_remove_obj(cache_t *cache, cache_obj_t *obj_to_remove) {
@@ -261,10 +292,15 @@ static bool LRU_Prob_remove(cache_t *cache, const obj_id_t obj_id) {
 // ***********************************************************************
 static const char *LRU_Prob_current_params(LRU_Prob_params_t *params) {
   static __thread char params_str[128];
-  snprintf(params_str, 128, "prob=%.4lf\n", params->prob);
+  snprintf(params_str, 128, "prob=%.4lf, combine=%d\n", params->prob,
+           params->combiner != NULL);
   return params_str;
 }
 
+static const char *LRU_Prob_effective_params(const cache_t *cache) {
+  return LRU_Prob_current_params((LRU_Prob_params_t *)cache->eviction_params);
+}
+
 static void LRU_Prob_parse_params(cache_t *cache,
                                   const char *cache_specific_params) {
   LRU_Prob_params_t *params = (LRU_Prob_params_t *)cache->eviction_params;
@@ -289,6 +325,15 @@ static void LRU_Prob_parse_params(cache_t *cache,
         ERROR("param parsing error, find string \"%s\" after number\n", end);
       }
 
+    } else if (strcasecmp(key, "combine") == 0) {
+      long combine = strtol(value, &end, 0);
+      if (strlen(end) > 2) {
+        ERROR("param parsing error, find string \"%s\" after number\n", end);
+      }
+      if (combine && params->combiner == NULL) {
+        params->combiner =
+            promotion_combiner_create(cache->thread_num, LRU_Prob_promote);
+      }
     } else if (strcasecmp(key, "print") == 0) {
       printf("current parameters: %s\n", LRU_Prob_current_params(params));
       exit(0);
@@ -38,6 +38,7 @@ extern "C" {
 // ***********************************************************************
 
 static void LRU_delay_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *LRU_delay_effective_params(const cache_t *cache);
 static void LRU_delay_free(cache_t *cache);
 static bool LRU_delay_get(cache_t *cache, const request_t *req);
 static cache_obj_t *LRU_delay_find(cache_t *cache, const request_t *req,
@@ -63,6 +64,7 @@ cache_t *LRU_delay_init(const common_cache_params_t ccache_params,
                   const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LRU_delay", ccache_params, cache_specific_params);
   cache->cache_init = LRU_delay_init;
+  cache->current_params = LRU_delay_effective_params;
   cache->cache_free = LRU_delay_free;
   cache->get = LRU_delay_get;
   cache->find = LRU_delay_find;
@@ -172,14 +174,15 @@ static cache_obj_t *LRU_delay_find(cache_t *cache, const request_t *req,
     if (req->next_access_vtime != INT64_MAX)
 #endif
     //  check whether the last access time is greater than the delay time
-      pthread_spin_lock(&cache->lock);
+      cache_lock(cache);
       cache_obj = cache_find_base(cache, req, update_cache);
       if (cache_obj && params->vtime - cache_obj->delay_count.last_vtime > params->delay_time) {
         move_obj_to_head(&params->q_head, &params->q_tail, cache_obj);
         cache_obj->delay_count.last_vtime = params->vtime;
         params->promote_time++;
+        THREAD_STAT_INC(n_promotion);
       }
-      pthread_spin_unlock(&cache->lock);
+      cache_unlock(cache);
       // update the last access time
   }
 
@@ -209,17 +212,17 @@ static cache_obj_t *LRU_delay_insert(cache_t *cache, const request_t *req) {
   //   local_vtime = 0;
   // }
 
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   //since we are under the protection of lock, I believe it is ok to just use regular addition
   params->vtime += 1;
   cache_obj_t *obj = cache_insert_base(cache, req);
   if (obj == NULL) {
-    pthread_spin_unlock(&cache->lock);
+    cache_unlock(cache);
     return NULL;
   }
   obj->delay_count.last_vtime = params->vtime;
   prepend_obj_to_head(&params->q_head, &params->q_tail, obj);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 
   return obj;
 }
@@ -237,7 +240,8 @@ static cache_obj_t *LRU_delay_insert(cache_t *cache, const request_t *req) {
 static cache_obj_t *LRU_delay_to_evict(cache_t *cache, const request_t *req) {
   LRU_delay_params_t *params = (LRU_delay_params_t *)cache->eviction_params;
 
-  DEBUG_ASSERT(params->q_tail != NULL || cache->occupied_byte == 0);
+  DEBUG_ASSERT(params->q_tail != NULL ||
+               cache_get_occupied_byte_default(cache) == 0);
 
   cache->to_evict_candidate_gen_vtime = cache->n_req;
   return params->q_tail;
@@ -252,13 +256,13 @@ static cache_obj_t *LRU_delay_to_evict(cache_t *cache, const request_t *req) {
  * @param req not used
  */
 static void LRU_delay_evict(cache_t *cache, const request_t *req) {
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   LRU_delay_params_t *params = (LRU_delay_params_t *)cache->eviction_params;
   cache_obj_t *obj_to_evict = params->q_tail;
   obj_to_evict->delay_count.last_vtime = 0;
   remove_obj_from_list(&params->q_head, &params->q_tail, obj_to_evict);
   cache_remove_obj_base(cache, obj_to_evict, true);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 }
 
 /**
@@ -321,6 +325,10 @@ static const char *LRU_delay_current_params(
   return params_str;
 }
 
+static const char *LRU_delay_effective_params(const cache_t *cache) {
+  return LRU_delay_current_params((LRU_delay_params_t *)cache->eviction_params);
+}
+
 static void LRU_delay_parse_params(cache_t *cache,
                                   const char *cache_specific_params) {
   LRU_delay_params_t *params = (LRU_delay_params_t *)cache->eviction_params;
@@ -157,7 +157,7 @@ static void LeCaRv0_free(cache_t *cache) {
 static bool LeCaRv0_get(cache_t *cache, const request_t *req) {
   /* occupied bytes and n_obj are maintained by LRU and LFU
    * see get_n_obj and get_occupied_byte */
-  DEBUG_ASSERT(cache->occupied_byte == 0);
+  DEBUG_ASSERT(cache_get_occupied_byte_default(cache) == 0);
 
   return cache_get_base(cache, req);
 }
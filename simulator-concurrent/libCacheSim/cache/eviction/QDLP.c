@@ -65,6 +65,7 @@ static inline int64_t QDLP_get_n_obj(const cache_t *cache);
 static inline bool QDLP_can_insert(cache_t *cache, const request_t *req);
 static void QDLP_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *QDLP_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -77,6 +78,7 @@ cache_t *QDLP_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("QDLP", ccache_params, cache_specific_params);
   cache->cache_init = QDLP_init;
+  cache->current_params = QDLP_effective_params;
   cache->cache_free = QDLP_free;
   cache->get = QDLP_get;
   cache->find = QDLP_find;
@@ -434,6 +436,10 @@ static const char *QDLP_current_params(QDLP_params_t *params) {
   return params_str;
 }
 
+static const char *QDLP_effective_params(const cache_t *cache) {
+  return QDLP_current_params((QDLP_params_t *)cache->eviction_params);
+}
+
 static void QDLP_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   QDLP_params_t *params = (QDLP_params_t *)(cache->eviction_params);
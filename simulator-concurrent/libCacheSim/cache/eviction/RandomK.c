@@ -32,6 +32,7 @@ static const char *DEFAULT_PARAMS = "k=1";
 // ***********************************************************************
 
 static void RandomK_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *RandomK_effective_params(const cache_t *cache);
 static void RandomK_free(cache_t *cache);
 static bool RandomK_get(cache_t *cache, const request_t *req);
 static cache_obj_t *RandomK_find(cache_t *cache, const request_t *req,
@@ -62,6 +63,7 @@ cache_t *RandomK_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("RandomK", ccache_params_copy, cache_specific_params);
   cache->cache_init = RandomK_init;
+  cache->current_params = RandomK_effective_params;
   cache->cache_free = RandomK_free;
   cache->get = RandomK_get;
   cache->find = RandomK_find;
@@ -205,10 +207,10 @@ static inline cache_obj_t *RandomK_select(cache_t *cache, const int k) {
  * @param req not used
  */
 static void RandomK_evict(cache_t *cache, const request_t *req) {
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   cache_obj_t *obj_to_evict = RandomK_to_evict(cache, req);
   cache_evict_base(cache, obj_to_evict, true);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 }
 
 /**
@@ -245,6 +247,10 @@ static const char *RandomK_current_params(RandomK_params_t *params) {
   return params_str;
 }
 
+static const char *RandomK_effective_params(const cache_t *cache) {
+  return RandomK_current_params((RandomK_params_t *)cache->eviction_params);
+}
+
 static void RandomK_parse_params(cache_t *cache,
                                   const char *cache_specific_params) {
   RandomK_params_t *params = (RandomK_params_t *)cache->eviction_params;
@@ -72,6 +72,7 @@ static inline int64_t S3FIFO_get_n_obj(const cache_t *cache);
 static inline bool S3FIFO_can_insert(cache_t *cache, const request_t *req);
 static void S3FIFO_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *S3FIFO_effective_params(const cache_t *cache);
 
 static void S3FIFO_evict_fifo(cache_t *cache, const request_t *req);
 static void S3FIFO_evict_main(cache_t *cache, const request_t *req);
@@ -87,6 +88,7 @@ cache_t *S3FIFO_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("S3FIFO", ccache_params, cache_specific_params);
   cache->cache_init = S3FIFO_init;
+  cache->current_params = S3FIFO_effective_params;
   cache->cache_free = S3FIFO_free;
   cache->get = S3FIFO_get;
   cache->find = S3FIFO_find;
@@ -493,6 +495,10 @@ static const char *S3FIFO_current_params(S3FIFO_params_t *params) {
   return params_str;
 }
 
+static const char *S3FIFO_effective_params(const cache_t *cache) {
+  return S3FIFO_current_params((S3FIFO_params_t *)cache->eviction_params);
+}
+
 static void S3FIFO_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   S3FIFO_params_t *params = (S3FIFO_params_t *)(cache->eviction_params);
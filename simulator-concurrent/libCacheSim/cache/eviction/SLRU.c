@@ -50,6 +50,7 @@ static void SLRU_cool(cache_t *cache, const request_t *req, const int id);
 bool SLRU_can_insert(cache_t *cache, const request_t *req);
 static void SLRU_parse_params(cache_t *cache,
                               const char *cache_specific_params);
+static const char *SLRU_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -105,6 +106,7 @@ cache_t *SLRU_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("SLRU", ccache_params, cache_specific_params);
   cache->cache_init = SLRU_init;
+  cache->current_params = SLRU_effective_params;
   cache->cache_free = SLRU_free;
   cache->get = SLRU_get;
   cache->find = SLRU_find;
@@ -266,7 +268,7 @@ static cache_obj_t *SLRU_find(cache_t *cache, const request_t *req,
       // if the LRU is full
       SLRU_cool(cache, req, obj->SLRU.lru_id);
     }
-    DEBUG_ASSERT(cache->occupied_byte <= cache->cache_size);
+    DEBUG_ASSERT(cache_get_occupied_byte_default(cache) <= cache->cache_size);
   }
 
   return obj;
@@ -299,7 +301,8 @@ static cache_obj_t *SLRU_insert(cache_t *cache, const request_t *req) {
 
   if (nth_seg == -1) {
     // No space for insertion
-    while (cache->occupied_byte + req->obj_size + cache->obj_md_size >
+    while (cache_get_occupied_byte_default(cache) + req->obj_size +
+               cache->obj_md_size >
            cache->cache_size) {
       cache->evict(cache, req);
     }
@@ -414,6 +417,11 @@ static const char *SLRU_current_params(cache_t *cache, SLRU_params_t *params) {
   return params_str;
 }
 
+static const char *SLRU_effective_params(const cache_t *cache) {
+  return SLRU_current_params((cache_t *)cache,
+                             (SLRU_params_t *)cache->eviction_params);
+}
+
 static void SLRU_parse_params(cache_t *cache,
                               const char *cache_specific_params) {
   SLRU_params_t *params = (SLRU_params_t *)cache->eviction_params;
@@ -565,7 +573,8 @@ bool SLRU_get_debug(cache_t *cache, const request_t *req) {
   }
 
   if (!cache_hit) {
-    while (cache->occupied_byte + req->obj_size + cache->obj_md_size >
+    while (cache_get_occupied_byte_default(cache) + req->obj_size +
+               cache->obj_md_size >
            cache->cache_size) {
       cache->evict(cache, req);
     }
@@ -417,6 +417,7 @@ static bool SR_LRU_remove(cache_t *cache, const obj_id_t obj_id) {
 
   bool in_R = false, in_SR = false;
   params->req_local->obj_id = obj_id;
+  params->req_local->hv = 0;
   cache_obj_t *obj = R->find(R, params->req_local, false);
   if (obj != NULL) {
     in_R = true;
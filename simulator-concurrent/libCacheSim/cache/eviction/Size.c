@@ -109,7 +109,7 @@ static void Size_free(cache_t *cache) {
  */
 static bool Size_get(cache_t *cache, const request_t *req) {
   Size_params_t *params = cache->eviction_params;
-  DEBUG_ASSERT(cache->n_obj == params->pq->size - 1);
+  DEBUG_ASSERT(cache_get_n_obj_default(cache) == params->pq->size - 1);
   bool ret = cache_get_base(cache, req);
 
   return ret;
@@ -59,6 +59,7 @@ static inline int64_t TwoQ_get_n_obj(const cache_t *cache);
 static inline bool TwoQ_can_insert(cache_t *cache, const request_t *req);
 static void TwoQ_parse_params(cache_t *cache,
                               const char *cache_specific_params);
+static const char *TwoQ_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -71,6 +72,7 @@ cache_t *TwoQ_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("TwoQ", ccache_params, cache_specific_params);
   cache->cache_init = TwoQ_init;
+  cache->current_params = TwoQ_effective_params;
   cache->cache_free = TwoQ_free;
   cache->get = TwoQ_get;
   cache->find = TwoQ_find;
@@ -329,6 +331,10 @@ static const char *TwoQ_current_params(TwoQ_params_t *params) {
   return params_str;
 }
 
+static const char *TwoQ_effective_params(const cache_t *cache) {
+  return TwoQ_current_params((TwoQ_params_t *)cache->eviction_params);
+}
+
 static void TwoQ_parse_params(cache_t *cache,
                               const char *cache_specific_params) {
   TwoQ_params_t *params = (TwoQ_params_t *)(cache->eviction_params);
@@ -199,7 +199,7 @@ static void WTinyLFU_free(cache_t *cache) {
 static bool WTinyLFU_get(cache_t *cache, const request_t *req) {
   /* because this field cannot be updated in time since segment LRUs are
    * updated, so we should not use this field */
-  DEBUG_ASSERT(cache->occupied_byte == 0);
+  DEBUG_ASSERT(cache_get_occupied_byte_default(cache) == 0);
 
   bool ck = cache_get_base(cache, req);
   return ck;
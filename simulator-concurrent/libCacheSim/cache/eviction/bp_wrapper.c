@@ -44,6 +44,7 @@ static const char *DEFAULT_PARAMS = "batch-size=32,queue-size=64";
 
 static void bp_wrapper_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *bp_wrapper_effective_params(const cache_t *cache);
 static void bp_wrapper_free(cache_t *cache);
 static bool bp_wrapper_get(cache_t *cache, const request_t *req);
 static cache_obj_t *bp_wrapper_find(cache_t *cache, const request_t *req,
@@ -69,6 +70,7 @@ cache_t *bp_wrapper_init(const common_cache_params_t ccache_params,
                     const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("bp_wrapper", ccache_params, cache_specific_params);
   cache->cache_init = bp_wrapper_init;
+  cache->current_params = bp_wrapper_effective_params;
   cache->cache_free = bp_wrapper_free;
   cache->get = bp_wrapper_get;
   cache->find = bp_wrapper_find;
@@ -184,6 +186,11 @@ static bool bp_wrapper_get(cache_t *cache, const request_t *req) {
       //   __builtin_prefetch(&buff[i]);
       // }
       trylock_outcome = pthread_spin_trylock(&cache->lock);
+      if (trylock_outcome) {
+        THREAD_STAT_INC(n_lock_contended);
+      } else {
+        THREAD_STAT_INC(n_lock);
+      }
     }else{
       // there are still fewer objects than batch-size so we just stop here
       return true;
@@ -196,7 +203,7 @@ static bool bp_wrapper_get(cache_t *cache, const request_t *req) {
         // for (int i = 0; i < pos; i++) {
         //   __builtin_prefetch(&buff[i]);
         // }
-        pthread_spin_lock(&cache->lock);
+        cache_lock(cache);
       }
     }
 
@@ -217,12 +224,13 @@ static bool bp_wrapper_get(cache_t *cache, const request_t *req) {
         // }
         // DEBUG_ASSERT(contains_object(params->q_head, o));
         move_obj_to_head(&params->q_head, &params->q_tail, o);
+        THREAD_STAT_INC(n_promotion);
         // DEBUG_ASSERT(params->q_head == o);
       }
     }
 
     // unlock!!
-    pthread_spin_unlock(&cache->lock);
+    cache_unlock(cache);
     pos = 0;
     trylock_outcome = false;
     return true;
@@ -233,7 +241,7 @@ static bool bp_wrapper_get(cache_t *cache, const request_t *req) {
       __builtin_prefetch(&buff[i]);
     }
     // lock
-    pthread_spin_lock(&cache->lock);
+    cache_lock(cache);
     // printf("miss activation at: %lu\n", pos);
     for (int i = 0; i < pos; i++) {
       cache_obj_t *obj = buff[i];
@@ -249,6 +257,7 @@ static bool bp_wrapper_get(cache_t *cache, const request_t *req) {
         // }
         // DEBUG_ASSERT(contains_object(params->q_head, o));
         move_obj_to_head(&params->q_head, &params->q_tail, o);
+        THREAD_STAT_INC(n_promotion);
         // DEBUG_ASSERT(params->q_head == o);
       }
     }
@@ -273,7 +282,7 @@ static bool bp_wrapper_get(cache_t *cache, const request_t *req) {
 
     // unlock
     pos = 0;
-    pthread_spin_unlock(&cache->lock);
+    cache_unlock(cache);
     return false;
   }
 }
@@ -359,7 +368,7 @@ static void bp_wrapper_evict(cache_t *cache, const request_t *req) {
     params->q_tail->queue.next = NULL;
   } else {
     /* cache->n_obj has not been updated */
-    DEBUG_ASSERT(cache->n_obj == 1);
+    DEBUG_ASSERT(cache_get_n_obj_default(cache) == 1);
     params->q_head = NULL;
   }
   cache_evict_base(cache, obj_to_evict, true);
@@ -427,6 +436,11 @@ static const char *bp_wrapper_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *bp_wrapper_effective_params(const cache_t *cache) {
+  return bp_wrapper_current_params((cache_t *)cache,
+                                   (bp_wrapper_params_t *)cache->eviction_params);
+}
+
 static void bp_wrapper_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   bp_wrapper_params_t *params = (bp_wrapper_params_t *)cache->eviction_params;
@@ -59,6 +59,7 @@ static inline int64_t LP_TwoQ_get_n_obj(const cache_t *cache);
 static inline bool LP_TwoQ_can_insert(cache_t *cache, const request_t *req);
 static void LP_TwoQ_parse_params(cache_t *cache,
                                  const char *cache_specific_params);
+static const char *LP_TwoQ_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -76,6 +77,7 @@ cache_t *LP_TwoQ_init(const common_cache_params_t ccache_params,
                       const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LP-TwoQv2", ccache_params, cache_specific_params);
   cache->cache_init = LP_TwoQ_init;
+  cache->current_params = LP_TwoQ_effective_params;
   cache->cache_free = LP_TwoQ_free;
   cache->get = LP_TwoQ_get;
   cache->find = LP_TwoQ_find;
@@ -342,6 +344,10 @@ static const char *LP_TwoQ_current_params(LP_TwoQ_params_t *params) {
   return params_str;
 }
 
+static const char *LP_TwoQ_effective_params(const cache_t *cache) {
+  return LP_TwoQ_current_params((LP_TwoQ_params_t *)cache->eviction_params);
+}
+
 static void LP_TwoQ_parse_params(cache_t *cache,
                                  const char *cache_specific_params) {
   LP_TwoQ_params_t *params = (LP_TwoQ_params_t *)(cache->eviction_params);
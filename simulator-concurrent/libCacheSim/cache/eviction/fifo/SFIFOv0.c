@@ -42,6 +42,7 @@ static const char *DEFAULT_CACHE_PARAMS = "n-queue=4";
 
 static void SFIFOv0_parse_params(cache_t *cache,
                                  const char *cache_specific_params);
+static const char *SFIFOv0_effective_params(const cache_t *cache);
 static void SFIFOv0_free(cache_t *cache);
 static bool SFIFOv0_get(cache_t *cache, const request_t *req);
 static cache_obj_t *SFIFOv0_find(cache_t *cache, const request_t *req,
@@ -75,6 +76,7 @@ cache_t *SFIFOv0_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("SFIFOv0", ccache_params, cache_specific_params);
   cache->cache_init = SFIFOv0_init;
+  cache->current_params = SFIFOv0_effective_params;
   cache->cache_free = SFIFOv0_free;
   cache->get = SFIFOv0_get;
   cache->find = SFIFOv0_find;
@@ -376,6 +378,10 @@ static const char *SFIFOv0_current_params(SFIFOv0_params_t *params) {
   return params_str;
 }
 
+static const char *SFIFOv0_effective_params(const cache_t *cache) {
+  return SFIFOv0_current_params((SFIFOv0_params_t *)cache->eviction_params);
+}
+
 static void SFIFOv0_parse_params(cache_t *cache,
                                  const char *cache_specific_params) {
   SFIFOv0_params_t *params = (SFIFOv0_params_t *)cache->eviction_params;
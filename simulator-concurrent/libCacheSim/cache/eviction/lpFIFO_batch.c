@@ -46,6 +46,7 @@ static const char *DEFAULT_PARAMS = "batch-size=0.2";
 static void lpFIFO_print(cache_t *cache);
 static void lpFIFO_batch_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *lpFIFO_batch_effective_params(const cache_t *cache);
 static void lpFIFO_batch_free(cache_t *cache);
 static bool lpFIFO_batch_get(cache_t *cache, const request_t *req);
 static cache_obj_t *lpFIFO_batch_find(cache_t *cache, const request_t *req,
@@ -73,6 +74,7 @@ cache_t *lpFIFO_batch_init(const common_cache_params_t ccache_params,
                     const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("lpFIFO_batch", ccache_params, cache_specific_params);
   cache->cache_init = lpFIFO_batch_init;
+  cache->current_params = lpFIFO_batch_effective_params;
   cache->cache_free = lpFIFO_batch_free;
   cache->get = lpFIFO_batch_get;
   cache->find = lpFIFO_batch_find;
@@ -222,19 +224,19 @@ static cache_obj_t *lpFIFO_batch_find(cache_t *cache, const request_t *req,
  * @return the inserted object
  */
 static cache_obj_t *lpFIFO_batch_insert(cache_t *cache, const request_t *req) {
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   lpFIFO_batch_params_t *params = (lpFIFO_batch_params_t *)cache->eviction_params;
   params->time_insert += 1;
   cache_obj_t *obj = cache_insert_base(cache, req);
   if (obj == NULL) {
-    pthread_spin_unlock(&cache->lock);
+    cache_unlock(cache);
     return NULL;
   }
   prepend_obj_to_head(&params->q_head, &params->q_tail, obj);
 #ifdef USE_BELADY
   obj->next_access_vtime = req->next_access_vtime;
 #endif
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
   return obj;
 }
 
@@ -279,13 +281,13 @@ static cache_obj_t *lpFIFO_batch_to_evict(cache_t *cache, const request_t *req)
  * @param evicted_obj if not NULL, return the evicted object to caller
  */
 static void lpFIFO_batch_evict(cache_t *cache, const request_t *req) {
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   lpFIFO_batch_params_t *params = (lpFIFO_batch_params_t *)cache->eviction_params;
 
   cache_obj_t *obj_to_evict = params->q_tail;
   remove_obj_from_list(&params->q_head, &params->q_tail, obj_to_evict);
   cache_evict_base(cache, obj_to_evict, true);
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 }
 
 /**
@@ -295,7 +297,7 @@ static void lpFIFO_batch_evict(cache_t *cache, const request_t *req) {
  * @param req not used
  */
 static void lpFIFO_batch_promote_all(cache_t *cache, const request_t *req, uint64_t *buff, const uint64_t* start) {
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   lpFIFO_batch_params_t *params = (lpFIFO_batch_params_t *)cache->eviction_params;
   uint64_t pos = 0;
   uint64_t count = 0;
@@ -315,10 +317,11 @@ static void lpFIFO_batch_promote_all(cache_t *cache, const request_t *req, uint6
     if (obj != NULL) {
       move_obj_to_head(&params->q_head, &params->q_tail, obj);
       promotion += 1;
+      THREAD_STAT_INC(n_promotion);
     }
     pos += 1;
   }
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 }
 
 /**
@@ -396,6 +399,11 @@ static const char *lpFIFO_batch_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *lpFIFO_batch_effective_params(const cache_t *cache) {
+  return lpFIFO_batch_current_params((cache_t *)cache,
+                                     (lpFIFO_batch_params_t *)cache->eviction_params);
+}
+
 static void lpFIFO_batch_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   lpFIFO_batch_params_t *params = (lpFIFO_batch_params_t *)cache->eviction_params;
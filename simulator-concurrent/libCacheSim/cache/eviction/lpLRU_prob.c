@@ -34,6 +34,7 @@ static const char *DEFAULT_CACHE_PARAMS = "prob=0.5";
 
 static void lpLRU_prob_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *lpLRU_prob_effective_params(const cache_t *cache);
 static void lpLRU_prob_free(cache_t *cache);
 static bool lpLRU_prob_get(cache_t *cache, const request_t *req);
 static cache_obj_t *lpLRU_prob_find(cache_t *cache, const request_t *req,
@@ -60,6 +61,7 @@ cache_t *lpLRU_prob_init(const common_cache_params_t ccache_params,
                   const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("lpLRU_prob", ccache_params, cache_specific_params);
   cache->cache_init = lpLRU_prob_init;
+  cache->current_params = lpLRU_prob_effective_params;
   cache->cache_free = lpLRU_prob_free;
   cache->get = lpLRU_prob_get;
   cache->find = lpLRU_prob_find;
@@ -159,9 +161,12 @@ static cache_obj_t *lpLRU_prob_find(cache_t *cache, const request_t *req,
 #ifdef USE_BELADY
     if (req->next_access_vtime != INT64_MAX)
 #endif
-      pthread_spin_lock(&cache->lock);
+    {
+      cache_lock(cache);
       move_obj_to_head(&params->q_head, &params->q_tail, cache_obj);
-      pthread_spin_unlock(&cache->lock);
+      THREAD_STAT_INC(n_promotion);
+      cache_unlock(cache);
+    }
   }
   return cache_obj;
 }
@@ -180,9 +185,9 @@ static cache_obj_t *lpLRU_prob_insert(cache_t *cache, const request_t *req) {
   lpLRU_prob_params_t *params = (lpLRU_prob_params_t *)cache->eviction_params;
 
   cache_obj_t *obj = cache_insert_base(cache, req);
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   prepend_obj_to_head(&params->q_head, &params->q_tail, obj);
-  pthread_spin_lock(&cache->lock);
+  cache_unlock(cache);
 
   return obj;
 }
@@ -200,7 +205,8 @@ static cache_obj_t *lpLRU_prob_insert(cache_t *cache, const request_t *req) {
 static cache_obj_t *lpLRU_prob_to_evict(cache_t *cache, const request_t *req) {
   lpLRU_prob_params_t *params = (lpLRU_prob_params_t *)cache->eviction_params;
 
-  DEBUG_ASSERT(params->q_tail != NULL || cache->occupied_byte == 0);
+  DEBUG_ASSERT(params->q_tail != NULL ||
+               cache_get_occupied_byte_default(cache) == 0);
 
   cache->to_evict_candidate_gen_vtime = cache->n_req;
   return params->q_tail;
@@ -223,16 +229,16 @@ static void lpLRU_prob_evict(cache_t *cache, const request_t *req) {
   // we chose to do it manually
   // remove_obj_from_list(&params->q_head, &params->q_tail, obj)
 
-  pthread_spin_lock(&cache->lock);
+  cache_lock(cache);
   params->q_tail = params->q_tail->queue.prev;
   if (likely(params->q_tail != NULL)) {
     params->q_tail->queue.next = NULL;
   } else {
     /* cache->n_obj has not been updated */
-    DEBUG_ASSERT(cache->n_obj == 1);
+    DEBUG_ASSERT(cache_get_n_obj_default(cache) == 1);
     params->q_head = NULL;
   }
-  pthread_spin_unlock(&cache->lock);
+  cache_unlock(cache);
 
 #if defined(TRACK_DEMOTION)
   if (cache->track_demotion)
@@ -319,6 +325,11 @@ static const char *lpLRU_prob_current_params(lpLRU_prob_params_t *params) {
   return params_str;
 }
 
+static const char *lpLRU_prob_effective_params(const cache_t *cache) {
+  return lpLRU_prob_current_params(
+      (lpLRU_prob_params_t *)cache->eviction_params);
+}
+
 static void lpLRU_prob_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   lpLRU_prob_params_t *params = (lpLRU_prob_params_t *)cache->eviction_params;
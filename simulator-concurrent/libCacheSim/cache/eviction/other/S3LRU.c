@@ -67,6 +67,7 @@ static inline int64_t S3LRU_get_n_obj(const cache_t *cache);
 static inline bool S3LRU_can_insert(cache_t *cache, const request_t *req);
 static void S3LRU_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *S3LRU_effective_params(const cache_t *cache);
 
 static void S3LRU_evict_LRU(cache_t *cache, const request_t *req);
 static void S3LRU_evict_main(cache_t *cache, const request_t *req);
@@ -82,6 +83,7 @@ cache_t *S3LRU_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("S3LRU", ccache_params, cache_specific_params);
   cache->cache_init = S3LRU_init;
+  cache->current_params = S3LRU_effective_params;
   cache->cache_free = S3LRU_free;
   cache->get = S3LRU_get;
   cache->find = S3LRU_find;
@@ -459,6 +461,10 @@ static const char *S3LRU_current_params(S3LRU_params_t *params) {
   return params_str;
 }
 
+static const char *S3LRU_effective_params(const cache_t *cache) {
+  return S3LRU_current_params((S3LRU_params_t *)cache->eviction_params);
+}
+
 static void S3LRU_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   S3LRU_params_t *params = (S3LRU_params_t *)(cache->eviction_params);
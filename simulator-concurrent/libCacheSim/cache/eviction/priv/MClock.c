@@ -47,6 +47,7 @@ static const char *DEFAULT_PARAMS =
 
 static void MClock_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *MClock_effective_params(const cache_t *cache);
 static void MClock_free(cache_t *cache);
 static bool MClock_get(cache_t *cache, const request_t *req);
 static cache_obj_t *MClock_find(cache_t *cache, const request_t *req,
@@ -75,6 +76,7 @@ cache_t *MClock_init(const common_cache_params_t ccache_params,
                      const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("MClock", ccache_params, cache_specific_params);
   cache->cache_init = MClock_init;
+  cache->current_params = MClock_effective_params;
   cache->cache_free = MClock_free;
   cache->get = MClock_get;
   cache->find = MClock_find;
@@ -205,7 +207,8 @@ static void reset_hands(cache_t *cache) {
   int hand_idx = 0;
   int64_t obj_idx = 0;
   while (obj != NULL) {
-    if (obj_idx >= params->hand_pos[hand_idx] * cache->n_obj) {
+    if (obj_idx >=
+        params->hand_pos[hand_idx] * cache_get_n_obj_default(cache)) {
       params->hands[hand_idx++] = obj;
     }
     obj = obj->queue.next;
@@ -393,13 +396,13 @@ static bool MClock_remove(cache_t *cache, const obj_id_t obj_id) {
 
 static int64_t MClock_get_occupied_byte(const cache_t *cache) {
   // MClock_params_t *params = (MClock_params_t *)cache->eviction_params;
-  int64_t occupied_byte = cache->occupied_byte;
+  int64_t occupied_byte = cache_get_occupied_byte_default(cache);
   return occupied_byte;
 }
 
 static int64_t MClock_get_n_obj(const cache_t *cache) {
   // MClock_params_t *params = (MClock_params_t *)cache->eviction_params;
-  int64_t n_obj = cache->n_obj;
+  int64_t n_obj = cache_get_n_obj_default(cache);
   return n_obj;
 }
 
@@ -422,6 +425,11 @@ static const char *MClock_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *MClock_effective_params(const cache_t *cache) {
+  return MClock_current_params((cache_t *)cache,
+                               (MClock_params_t *)cache->eviction_params);
+}
+
 static void MClock_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   MClock_params_t *params = (MClock_params_t *)cache->eviction_params;
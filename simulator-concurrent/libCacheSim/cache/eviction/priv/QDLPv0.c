@@ -74,6 +74,7 @@ typedef struct {
 
 static void QDLPv0_parse_params(cache_t *cache,
                               const char *cache_specific_params);
+static const char *QDLPv0_effective_params(const cache_t *cache);
 static void QDLPv0_free(cache_t *cache);
 static bool QDLPv0_get(cache_t *cache, const request_t *req);
 static cache_obj_t *QDLPv0_find(cache_t *cache, const request_t *req,
@@ -105,6 +106,7 @@ cache_t *QDLPv0_init(const common_cache_params_t ccache_params,
                    const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("QDLPv0", ccache_params, cache_specific_params);
   cache->cache_init = QDLPv0_init;
+  cache->current_params = QDLPv0_effective_params;
   cache->cache_free = QDLPv0_free;
   cache->get = QDLPv0_get;
   cache->find = QDLPv0_find;
@@ -191,9 +193,10 @@ static bool QDLPv0_get(cache_t *cache, const request_t *req) {
   QDLPv0_params_t *params = cache->eviction_params;
   bool cache_hit = cache_get_base(cache, req);
   DEBUG_PRINT("%ld QDLPv0_get2\n", cache->n_req);
-  DEBUG_ASSERT(params->n_fifo_obj + params->n_clock_obj == cache->n_obj);
+  DEBUG_ASSERT(params->n_fifo_obj + params->n_clock_obj ==
+               cache_get_n_obj_default(cache));
   DEBUG_ASSERT(params->n_fifo_byte + params->n_clock_byte ==
-               cache->occupied_byte);
+               cache_get_occupied_byte_default(cache));
 
   return cache_hit;
 }
@@ -474,6 +477,10 @@ static const char *QDLPv0_current_params(QDLPv0_params_t *params) {
   return params_str;
 }
 
+static const char *QDLPv0_effective_params(const cache_t *cache) {
+  return QDLPv0_current_params((QDLPv0_params_t *)cache->eviction_params);
+}
+
 static void QDLPv0_parse_params(cache_t *cache,
                               const char *cache_specific_params) {
   QDLPv0_params_t *params = (QDLPv0_params_t *)cache->eviction_params;
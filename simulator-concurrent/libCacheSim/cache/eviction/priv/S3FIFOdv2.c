@@ -102,6 +102,7 @@ static inline int64_t S3FIFOdv2_get_n_obj(const cache_t *cache);
 static inline bool S3FIFOdv2_can_insert(cache_t *cache, const request_t *req);
 static void S3FIFOdv2_parse_params(cache_t *cache,
                                    const char *cache_specific_params);
+static const char *S3FIFOdv2_effective_params(const cache_t *cache);
 
 static void S3FIFOdv2_evict_fifo(cache_t *cache, const request_t *req);
 static void S3FIFOdv2_evict_main(cache_t *cache, const request_t *req);
@@ -117,6 +118,7 @@ cache_t *S3FIFOdv2_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("S3FIFOdv2", ccache_params, cache_specific_params);
   cache->cache_init = S3FIFOdv2_init;
+  cache->current_params = S3FIFOdv2_effective_params;
   cache->cache_free = S3FIFOdv2_free;
   cache->get = S3FIFOdv2_get;
   cache->find = S3FIFOdv2_find;
@@ -840,6 +842,10 @@ static const char *S3FIFOdv2_current_params(S3FIFOdv2_params_t *params) {
   return params_str;
 }
 
+static const char *S3FIFOdv2_effective_params(const cache_t *cache) {
+  return S3FIFOdv2_current_params((S3FIFOdv2_params_t *)cache->eviction_params);
+}
+
 static void S3FIFOdv2_parse_params(cache_t *cache,
                                    const char *cache_specific_params) {
   S3FIFOdv2_params_t *params = (S3FIFOdv2_params_t *)(cache->eviction_params);
@@ -0,0 +1,132 @@
+//
+//  promotionCombiner.c
+//  libCacheSim
+//
+//  flat combining of promotions, see promotionCombiner.h
+//
+
+#include "../include/libCacheSim/promotionCombiner.h"
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* the combiner scans the slots at most this many times, later passes pick
+ * up the promotions published while the earlier passes were running */
+#define COMBINER_MAX_PASS 4
+
+/* a waiter gives up the core after this many spins, the combiner may have
+ * been preempted when there are more threads than cores */
+#define COMBINER_SPIN_BEFORE_YIELD 1024
+
+#if defined(__x86_64__) || defined(__i386__)
+#define combiner_pause() __builtin_ia32_pause()
+#else
+#define combiner_pause() __asm__ __volatile__("" ::: "memory")
+#endif
+
+promotion_combiner_t *promotion_combiner_create(int n_thread,
+                                                combiner_apply_func_ptr apply) {
+  promotion_combiner_t *combiner = malloc(sizeof(promotion_combiner_t));
+  if (combiner == NULL) {
+    ERROR("cannot allocate the promotion combiner\n");
+  }
+  combiner->slots = NULL;
+  combiner->n_slot = 0;
+  combiner->apply = apply;
+  /* without the number of threads there are no slots, every promotion
+   * falls back to taking cache->lock */
+  if (n_thread <= 0) return combiner;
+
+  combiner->slots = aligned_alloc(sizeof(combiner_slot_t),
+                                  sizeof(combiner_slot_t) * n_thread);
+  if (combiner->slots == NULL) {
+    ERROR("cannot allocate the combiner slots of %d threads\n", n_thread);
+  }
+  memset(combiner->slots, 0, sizeof(combiner_slot_t) * n_thread);
+  combiner->n_slot = n_thread;
+  return combiner;
+}
+
+void promotion_combiner_free(promotion_combiner_t *combiner) {
+  free(combiner->slots);
+  free(combiner);
+}
+
+/* apply the pending promotions of all slots, cache->lock is held */
+static void combiner_run(promotion_combiner_t *combiner, cache_t *cache,
+                         int self) {
+  uint64_t n_combined = 0;
+  for (int pass = 0; pass < COMBINER_MAX_PASS; pass++) {
+    int n_applied = 0;
+    for (int i = 0; i < combiner->n_slot; i++) {
+      combiner_slot_t *slot = &combiner->slots[i];
+      if (__atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) !=
+          COMBINER_SLOT_PENDING) {
+        continue;
+      }
+      slot->obj = combiner->apply(cache, slot->req);
+      __atomic_store_n(&slot->state, COMBINER_SLOT_DONE, __ATOMIC_RELEASE);
+      n_applied += 1;
+      if (i != self) n_combined += 1;
+    }
+    if (n_applied == 0) break;
+  }
+  THREAD_STAT_ADD(n_combined, n_combined);
+}
+
+cache_obj_t *promotion_combiner_promote(promotion_combiner_t *combiner,
+                                        cache_t *cache, const request_t *req) {
+  cache_obj_t *obj;
+  int self = cache_thread_id(cache);
+  if (self < 0 || self >= combiner->n_slot) {
+    cache_lock(cache);
+    obj = combiner->apply(cache, req);
+    cache_unlock(cache);
+    if (obj != NULL) THREAD_STAT_INC(n_promotion);
+    return obj;
+  }
+
+  thread_stat_t *stat = curr_thread_stat;
+  combiner_slot_t *slot = &combiner->slots[self];
+  slot->req = req;
+  __atomic_store_n(&slot->state, COMBINER_SLOT_PENDING, __ATOMIC_RELEASE);
+
+  bool contended = false;
+  uint64_t n_spin = 0;
+  while (true) {
+    if (pthread_spin_trylock(&cache->lock) == 0) {
+      stat->n_lock += 1;
+      /* the own slot is either applied by this round or was applied by the
+       * previous combiner */
+      combiner_run(combiner, cache, self);
+      cache_unlock(cache);
+      break;
+    }
+
+    if (!contended) {
+      stat->n_lock_contended += 1;
+      contended = true;
+    }
+    /* wait for a combiner to apply the slot, or for the lock to be free so
+     * that this thread can take the combiner role */
+    while (__atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) ==
+               COMBINER_SLOT_PENDING &&
+           __atomic_load_n(&cache->lock, __ATOMIC_RELAXED) != 0) {
+      stat->n_lock_spin += 1;
+      if (++n_spin % COMBINER_SPIN_BEFORE_YIELD == 0) {
+        sched_yield();
+      } else {
+        combiner_pause();
+      }
+    }
+    if (__atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) == COMBINER_SLOT_DONE) {
+      break;
+    }
+  }
+
+  obj = slot->obj;
+  __atomic_store_n(&slot->state, COMBINER_SLOT_EMPTY, __ATOMIC_RELAXED);
+  if (obj != NULL) THREAD_STAT_INC(n_promotion);
+  return obj;
+}
@@ -0,0 +1,184 @@
+//
+//  segmentedQueue.c
+//  libCacheSim
+//
+//  segmented FIFO ring of Clock-style policies, see segmentedQueue.h
+//
+
+#include "../include/libCacheSim/segmentedQueue.h"
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* the rotation of the inserts and evictions of the calling thread */
+static __thread uint64_t insert_cursor = 0;
+static __thread uint64_t evict_cursor = 0;
+
+static inline bool try_lock_flag(int *flag) {
+  return __atomic_load_n(flag, __ATOMIC_RELAXED) == 0 &&
+         __atomic_exchange_n(flag, 1, __ATOMIC_ACQUIRE) == 0;
+}
+
+static inline void unlock_flag(int *flag) {
+  __atomic_store_n(flag, 0, __ATOMIC_RELEASE);
+}
+
+/* link the object at the head, the insert flag of the segment is held */
+static inline void prepend_locked(queue_segment_t *seg, cache_obj_t *obj) {
+  T_prepend_obj_to_head(&seg->q_head, &seg->q_tail, obj);
+  /* a pop that sees the count sees the prev link of the old head */
+  __atomic_fetch_add(&seg->n_obj, 1, __ATOMIC_RELEASE);
+  unlock_flag(&seg->inserting);
+}
+
+segmented_queue_t *segmented_queue_create(int n_seg) {
+  if (n_seg <= 0) {
+    ERROR("the number of segments must be positive, but it is %d\n", n_seg);
+  }
+
+  segmented_queue_t *sq = malloc(sizeof(segmented_queue_t));
+  if (sq == NULL) {
+    ERROR("cannot allocate the segmented queue\n");
+  }
+  sq->segs =
+      aligned_alloc(sizeof(queue_segment_t), sizeof(queue_segment_t) * n_seg);
+  if (sq->segs == NULL) {
+    ERROR("cannot allocate %d queue segments\n", n_seg);
+  }
+  memset(sq->segs, 0, sizeof(queue_segment_t) * n_seg);
+  sq->n_seg = n_seg;
+  sq->warmup_cursor = 0;
+  return sq;
+}
+
+void segmented_queue_free(segmented_queue_t *sq) {
+  free(sq->segs);
+  free(sq);
+}
+
+void segmented_queue_insert(segmented_queue_t *sq, const cache_t *cache,
+                            cache_obj_t *obj) {
+  queue_segment_t *seg;
+  if (!cache->warmup_complete) {
+    /* warmup is single-threaded */
+    seg = &sq->segs[sq->warmup_cursor++ % sq->n_seg];
+    prepend_obj_to_head(&seg->q_head, &seg->q_tail, obj);
+    seg->n_obj += 1;
+    return;
+  }
+
+  int tid = cache_thread_id(cache);
+  uint64_t id = (uint64_t)(tid < 0 ? 0 : tid) + insert_cursor++;
+  while (true) {
+    bool has_seg = false;
+    for (int i = 0; i < sq->n_seg; i++) {
+      seg = &sq->segs[(id + i) % sq->n_seg];
+      /* a segment that is empty after warmup stays empty */
+      if (__atomic_load_n(&seg->q_head, __ATOMIC_RELAXED) == NULL) continue;
+      has_seg = true;
+      if (try_lock_flag(&seg->inserting)) {
+        prepend_locked(seg, obj);
+        return;
+      }
+    }
+    if (!has_seg) break;
+    /* the threads that are inserting may have been preempted */
+    sched_yield();
+  }
+  ERROR("all %d segments are empty, the cache is not warmed up\n", sq->n_seg);
+}
+
+/* reserve an object of the segment, false if only its last object is left */
+static inline bool reserve_obj(queue_segment_t *seg) {
+  if (__atomic_fetch_sub(&seg->n_obj, 1, __ATOMIC_ACQUIRE) < 2) {
+    __atomic_fetch_add(&seg->n_obj, 1, __ATOMIC_RELAXED);
+    return false;
+  }
+  return true;
+}
+
+/* pop the tail of the segment, NULL if another thread is popping from it or
+ * only its last object is left */
+static cache_obj_t *try_pop(queue_segment_t *seg) {
+  if (__atomic_load_n(&seg->n_obj, __ATOMIC_RELAXED) < 2 ||
+      !try_lock_flag(&seg->popping)) {
+    return NULL;
+  }
+  cache_obj_t *obj = NULL;
+  if (reserve_obj(seg)) obj = T_evict_last_obj(&seg->q_head, &seg->q_tail);
+  unlock_flag(&seg->popping);
+  return obj;
+}
+
+cache_obj_t *segmented_queue_pop(segmented_queue_t *sq, const cache_t *cache,
+                                 int *seg_id) {
+  cache_obj_t *obj;
+  /* the hand stays in its segment while it reinserts objects */
+  if (*seg_id >= 0 && (obj = try_pop(&sq->segs[*seg_id])) != NULL) {
+    return obj;
+  }
+
+  int tid = cache_thread_id(cache);
+  int first = (int)(((uint64_t)(tid < 0 ? 0 : tid) + evict_cursor++) %
+                    sq->n_seg);
+  int second = (first + sq->n_seg / 2) % sq->n_seg;
+  if (__atomic_load_n(&sq->segs[second].n_obj, __ATOMIC_RELAXED) >
+      __atomic_load_n(&sq->segs[first].n_obj, __ATOMIC_RELAXED)) {
+    int tmp = first;
+    first = second;
+    second = tmp;
+  }
+
+  /* the two choices, then every segment in turn until one is not busy */
+  while (true) {
+    bool has_obj = false;
+    for (int i = 0; i < sq->n_seg + 2; i++) {
+      int id = i == 0 ? first : i == 1 ? second : (first + i - 1) % sq->n_seg;
+      queue_segment_t *seg = &sq->segs[id];
+      if ((obj = try_pop(seg)) != NULL) {
+        *seg_id = id;
+        return obj;
+      }
+      /* a pop in flight has reserved objects that are still counted out */
+      has_obj |= __atomic_load_n(&seg->n_obj, __ATOMIC_RELAXED) >= 2 ||
+                 __atomic_load_n(&seg->popping, __ATOMIC_RELAXED) != 0;
+    }
+    if (!has_obj) break;
+    /* the threads that are popping may have been preempted */
+    sched_yield();
+  }
+  ERROR("no segment has more than one object, use fewer segments\n");
+  return NULL;
+}
+
+void segmented_queue_reinsert(segmented_queue_t *sq, int seg_id,
+                              cache_obj_t *obj) {
+  queue_segment_t *seg = &sq->segs[seg_id];
+  /* the object goes back to its own segment, so wait for the inserter */
+  while (!try_lock_flag(&seg->inserting)) sched_yield();
+  prepend_locked(seg, obj);
+}
+
+void segmented_queue_remove(segmented_queue_t *sq, cache_obj_t *obj) {
+  cache_obj_t *head = obj;
+  while (head->queue.prev != NULL) head = head->queue.prev;
+
+  for (int i = 0; i < sq->n_seg; i++) {
+    queue_segment_t *seg = &sq->segs[i];
+    if (seg->q_head == head) {
+      remove_obj_from_list(&seg->q_head, &seg->q_tail, obj);
+      seg->n_obj -= 1;
+      return;
+    }
+  }
+  ERROR("object %lu is not in any segment\n", (unsigned long)obj->obj_id);
+}
+
+queue_segment_t *segmented_queue_largest(segmented_queue_t *sq) {
+  queue_segment_t *largest = &sq->segs[0];
+  for (int i = 1; i < sq->n_seg; i++) {
+    if (sq->segs[i].n_obj > largest->n_obj) largest = &sq->segs[i];
+  }
+  return largest;
+}
@@ -52,6 +52,29 @@ typedef enum{
   #error "unknown hash"
 #endif
 
+/* the hash of a request, readers that offload hashing store it in req->hv,
+ * 0 means it has not been computed */
+#define get_hash_value_req(req) \
+  ((req)->hv != 0 ? (req)->hv : get_hash_value_int_64(&(req)->obj_id))
+
+/**
+ * hash n object ids, the loop has no dependency between iterations,
+ * so the compiler vectorizes it when the target has 64-bit vector multiply
+ * (e.g., AVX-512DQ), and it overlaps the multiplies of different keys
+ * otherwise
+ *
+ * @param keys
+ * @param hvs the hash values, hvs[i] is the hash of keys[i]
+ * @param n
+ */
+static inline void get_hash_value_int_64_batch(const obj_id_t *__restrict keys,
+                                               uint64_t *__restrict hvs,
+                                               size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    hvs[i] = get_hash_value_int_64(&keys[i]);
+  }
+}
+
 //(size_t) XXH64(src, srcSize, 0)
 //(size_t) XXH3_64bits(src, srcSize)
 
@@ -33,6 +33,7 @@ extern "C" {
 
 #include "../../include/libCacheSim/logging.h"
 #include "../../include/libCacheSim/macro.h"
+#include "../../include/libCacheSim/threadStat.h"
 #include "../../utils/include/mymath.h"
 #include "../hash/hash.h"
 #include "chainedHashTableV2.h"
@@ -63,8 +64,8 @@ static inline cache_obj_t *_last_obj_in_bucket(const hashtable_t *hashtable,
 static inline cache_obj_t* add_to_bucket(hashtable_t *hashtable,
                                  const request_t *req) {
   cache_obj_t *cache_obj = create_cache_obj_from_request(req);
-  uint64_t hv = get_hash_value_int_64(&cache_obj->obj_id) &
-                hashmask(hashtable->hashpower);
+  /* the find before the insert used the same hash */
+  uint64_t hv = get_hash_value_req(req) & hashmask(hashtable->hashpower);
 
   uint64_t *dummy = &(hashtable->ptr_table[hv]->obj_id);
 
@@ -154,14 +155,14 @@ hashtable_t *create_chained_hashtable_v2(const uint16_t hashpower) {
 
 
 
-cache_obj_t *chained_hashtable_find_obj_id_v2(const hashtable_t *hashtable,
-                                              const obj_id_t obj_id) {
+/* find obj_id in the bucket of hash value hv */
+static inline cache_obj_t *find_in_bucket(const hashtable_t *hashtable,
+                                          const obj_id_t obj_id, uint64_t hv) {
 
   // we will use the same lock
   DEBUG_ASSERT(obj_id != UINT64_MAX);
   DEBUG_ASSERT(obj_id != 0);
   cache_obj_t *cache_obj = NULL;
-  uint64_t hv = get_hash_value_int_64(&obj_id);
   hv = hv & hashmask(hashtable->hashpower);
   uint64_t *dummy = &(hashtable->ptr_table[hv]->obj_id);
   test_and_test_and_set(dummy);
@@ -180,9 +181,16 @@ cache_obj_t *chained_hashtable_find_obj_id_v2(const hashtable_t *hashtable,
   return cache_obj;
 }
 
+cache_obj_t *chained_hashtable_find_obj_id_v2(const hashtable_t *hashtable,
+                                              const obj_id_t obj_id) {
+  return find_in_bucket(hashtable, obj_id, get_hash_value_int_64(&obj_id));
+}
+
+/* the hash value computed ahead of time is used if there is one */
 cache_obj_t *chained_hashtable_find_v2(const hashtable_t *hashtable,
                                        const request_t *req) {
-  cache_obj_t* obj = chained_hashtable_find_obj_id_v2(hashtable, req->obj_id);
+  cache_obj_t* obj = find_in_bucket(hashtable, req->obj_id,
+                                    get_hash_value_req(req));
   return obj;
 }
 
@@ -276,6 +284,7 @@ bool chained_hashtable_try_delete_v2(hashtable_t *hashtable,
   uint64_t new = UINT64_MAX - 1;
   while (__atomic_compare_exchange(dummy, &old, &new, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == 0) {
     old = UINT64_MAX;
+    THREAD_STAT_INC(n_bucket_spin);
   }
 
   if (hashtable->ptr_table[hv] -> hash_next == cache_obj) {
@@ -598,6 +607,7 @@ static void test_and_test_and_set(unsigned long* dummy) {
         // Busy wait if the lock is taken
         while (__atomic_load_n(dummy, __ATOMIC_RELAXED) == UINT64_MAX - 1) {
             // Lock is busy, just wait
+            THREAD_STAT_INC(n_bucket_spin);
         }
     }
 }
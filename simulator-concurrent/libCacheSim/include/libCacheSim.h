@@ -15,6 +15,7 @@
 #include "libCacheSim/reader.h"
 #include "libCacheSim/request.h"
 #include "libCacheSim/sampling.h"
+#include "libCacheSim/traceManifest.h"
 
 /* admission */
 #include "libCacheSim/admissionAlgo.h"
@@ -18,6 +18,7 @@
 #include "logging.h"
 #include "macro.h"
 #include "request.h"
+#include "threadStat.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -69,6 +70,9 @@ typedef int64_t (*cache_get_n_obj_func_ptr)(const cache_t *);
 
 typedef void (*cache_print_cache_func_ptr)(const cache_t *);
 
+/* the parameters the algorithm runs with, including the defaults */
+typedef const char *(*cache_current_params_func_ptr)(const cache_t *);
+
 // #define EVICTION_AGE_ARRAY_SZE 40
 #define EVICTION_AGE_ARRAY_SZE 320
 #define EVICTION_AGE_LOG_BASE 1.08
@@ -92,6 +96,23 @@ typedef struct {
   char cache_name[CACHE_NAME_ARRAY_LEN];
 } cache_stat_t;
 
+/* the changes to the occupancy of a cache made by one worker thread that
+ * are not folded into cache->n_obj and cache->occupied_byte yet, only the
+ * owner thread reads and writes it */
+typedef struct occupancy_shard {
+  int64_t n_obj;
+  int64_t occupied_byte;
+  const struct cache *cache;
+} __attribute__((aligned(64))) occupancy_shard_t;
+
+/* the slack of all occupancy shards together is at most this fraction of
+ * the cache size, e.g., 64 lets a cache overshoot its size by 1/64 */
+#define OCCUPANCY_SLACK_MAX_FRACTION 64
+
+/* the shard of the calling thread, NULL if it is not attached to a cache
+ * with sharded occupancy */
+extern __thread occupancy_shard_t *curr_occupancy_shard;
+
 struct hashtable;
 struct cache {
   struct hashtable *hashtable;
@@ -110,6 +131,8 @@ struct cache {
   cache_get_occupied_byte_func_ptr get_occupied_byte;
   cache_get_n_obj_func_ptr get_n_obj;
   cache_print_cache_func_ptr print_cache;
+  /* optional, NULL if the algorithm has no parameters */
+  cache_current_params_func_ptr current_params;
 
   admissioner_t *admissioner;
 
@@ -133,6 +156,16 @@ struct cache {
   pthread_cond_t cond_var;
   uint64_t val_lock;
   bool warmup_complete;
+  /* one counter block per worker thread, see threadStat.h */
+  thread_stat_t *thread_stats;
+  int n_thread_stats;
+  /* one occupancy shard per worker thread, NULL if every insert and
+   * eviction updates n_obj and occupied_byte directly */
+  occupancy_shard_t *occupancy_shards;
+  /* a shard is folded when its byte change reaches occupancy_slack or its
+   * object change reaches occupancy_slack_obj */
+  int64_t occupancy_slack;
+  int64_t occupancy_slack_obj;
   /************ end of private fields *************/
 
   // because some algorithms choose different candidates
@@ -153,6 +186,9 @@ struct cache {
    * some situations */
   // cache_stat_t stat;
   char cache_name[CACHE_NAME_ARRAY_LEN];
+  /* the name given to cache_struct_init, cache_name may have a suffix of the
+   * parameters, e.g., Clock-2 */
+  char algo_name[CACHE_NAME_ARRAY_LEN];
   char init_params[CACHE_INIT_PARAMS_LEN];
 
   void *last_request_metadata;
@@ -281,7 +317,15 @@ void cache_evict_base(cache_t *cache, cache_obj_t *obj,
  * @param cache
  */
 static inline int64_t cache_get_occupied_byte_default(const cache_t *cache) {
-  return cache->occupied_byte;
+  int64_t occupied_byte = __atomic_load_n(&cache->occupied_byte,
+                                          __ATOMIC_RELAXED);
+  const occupancy_shard_t *shard = curr_occupancy_shard;
+  if (shard != NULL && shard->cache == cache) {
+    /* the view of the calling thread, the changes of the other threads
+     * that are not folded are bounded by the slack */
+    occupied_byte += shard->occupied_byte;
+  }
+  return occupied_byte;
 }
 
 /**
@@ -292,7 +336,10 @@ static inline int64_t cache_get_occupied_byte_default(const cache_t *cache) {
  * @param cache
  */
 static inline int64_t cache_get_n_obj_default(const cache_t *cache) {
-  return cache->n_obj;
+  int64_t n_obj = __atomic_load_n(&cache->n_obj, __ATOMIC_RELAXED);
+  const occupancy_shard_t *shard = curr_occupancy_shard;
+  if (shard != NULL && shard->cache == cache) n_obj += shard->n_obj;
+  return n_obj;
 }
 
 static inline int64_t cache_get_reference_time(const cache_t *cache) {
@@ -307,6 +354,96 @@ static inline int64_t cache_get_virtual_time(const cache_t *cache) {
   return cache->n_req;
 }
 
+/**
+ * @brief acquire cache->lock and record the acquisition and the contention
+ * in the counter block of the calling thread
+ *
+ * @param cache
+ */
+static inline void cache_lock(cache_t *cache) {
+  thread_stat_t *stat = curr_thread_stat;
+  stat->n_lock += 1;
+  if (likely(pthread_spin_trylock(&cache->lock) == 0)) return;
+
+  stat->n_lock_contended += 1;
+  do {
+    /* spin on a plain load so that waiting does not bounce the cache line */
+    while (__atomic_load_n(&cache->lock, __ATOMIC_RELAXED) != 0) {
+      stat->n_lock_spin += 1;
+    }
+  } while (pthread_spin_trylock(&cache->lock) != 0);
+}
+
+static inline void cache_unlock(cache_t *cache) {
+  pthread_spin_unlock(&cache->lock);
+}
+
+/**
+ * @brief the id of the worker thread whose counter block the calling thread
+ * is attached to in this cache
+ *
+ * @param cache
+ * @return the thread id or -1 if the thread is not attached, e.g., the main
+ * thread during warmup
+ */
+static inline int cache_thread_id(const cache_t *cache) {
+  if (cache->thread_stats == NULL) return -1;
+  uintptr_t base = (uintptr_t)cache->thread_stats;
+  uintptr_t curr = (uintptr_t)curr_thread_stat;
+  if (curr < base) return -1;
+  uintptr_t id = (curr - base) / sizeof(thread_stat_t);
+  return id < (uintptr_t)cache->n_thread_stats ? (int)id : -1;
+}
+
+/**
+ * @brief allocate one counter block per worker thread,
+ * it needs to be called before the worker threads start
+ *
+ * @param cache
+ * @param n_thread
+ */
+void cache_init_thread_stat(cache_t *cache, int n_thread);
+
+/**
+ * @brief point the counter block of the calling thread to the one owned by
+ * thread_id in this cache
+ *
+ * @param cache
+ * @param thread_id
+ */
+void cache_attach_thread_stat(cache_t *cache, int thread_id);
+
+/**
+ * @brief give each worker thread an occupancy shard, so inserts and
+ * evictions update a thread-local change instead of two shared atomics,
+ * it needs to be called after cache_init_thread_stat and before the worker
+ * threads attach
+ *
+ * @param cache
+ * @param n_thread
+ * @param max_overshoot the most bytes the occupancy seen by a thread may
+ * differ from the true occupancy, 0 updates the shared counters directly,
+ * it is clamped to cache_size / OCCUPANCY_SLACK_MAX_FRACTION
+ */
+void cache_init_occupancy_shard(cache_t *cache, int n_thread,
+                                int64_t max_overshoot);
+
+/**
+ * @brief fold the occupancy shard of the calling thread into the cache,
+ * worker threads call it before they exit
+ *
+ * @param cache
+ */
+void cache_flush_occupancy_shard(cache_t *cache);
+
+/**
+ * @brief dump the aggregated and the per-thread counters as one JSON line
+ *
+ * @param cache
+ * @param ofile
+ */
+void cache_dump_thread_stat_json(const cache_t *cache, FILE *ofile);
+
 /**
  * @brief print cache stat
  *
@@ -11,11 +11,16 @@ typedef struct {
   cache_obj_t *q_tail;
 } FIFO_params_t;
 
+struct promotion_combiner;
+struct segmented_queue;
+
 /* used by LRU related */
 typedef struct {
   cache_obj_t *q_head;
   cache_obj_t *q_tail;
   pthread_mutex_t lock;
+  /* NULL if every hit promotes under cache->lock itself */
+  struct promotion_combiner *combiner;
 } LRU_params_t;
 
 /* used by LFU related */
@@ -37,6 +42,10 @@ typedef struct {
 
   int64_t n_obj_rewritten;
   int64_t n_byte_rewritten;
+
+  /* NULL if the ring is the single list of q_head and q_tail */
+  struct segmented_queue *segs;
+  int n_seg;
 } Clock_params_t;
 
 cache_t *ARC_init(const common_cache_params_t ccache_params, const char *cache_specific_params);
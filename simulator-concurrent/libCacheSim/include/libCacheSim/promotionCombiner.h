@@ -0,0 +1,81 @@
+//
+//  promotionCombiner.h
+//  libCacheSim
+//
+//  flat combining of promotions for list-based concurrent policies, a thread
+//  that hits publishes the request in its own slot, the thread that acquires
+//  cache->lock becomes the combiner and applies all published promotions in
+//  one critical section, so the list head stays in the cache of one core
+//  instead of moving between the cores on every hit
+//
+
+#ifndef PROMOTION_COMBINER_H
+#define PROMOTION_COMBINER_H
+
+#include "cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief find the object of req and move it to the head of the list,
+ * called by the combiner with cache->lock held
+ *
+ * @return the object or NULL if it is not in the cache
+ */
+typedef cache_obj_t *(*combiner_apply_func_ptr)(cache_t *, const request_t *);
+
+typedef enum {
+  COMBINER_SLOT_EMPTY = 0,
+  COMBINER_SLOT_PENDING,
+  COMBINER_SLOT_DONE,
+} combiner_slot_state_e;
+
+/* the owner thread writes req and sets the state to pending or empty,
+ * the combiner writes obj and sets the state to done */
+typedef struct combiner_slot {
+  const request_t *req;
+  cache_obj_t *obj;
+  int state;
+} __attribute__((aligned(64))) combiner_slot_t;
+
+typedef struct promotion_combiner {
+  /* one slot per worker thread, indexed by the thread id of the counter
+   * block the thread is attached to */
+  combiner_slot_t *slots;
+  int n_slot;
+  combiner_apply_func_ptr apply;
+} promotion_combiner_t;
+
+/**
+ * @brief create a combiner for a cache used by n_thread worker threads,
+ * if n_thread is not positive every promotion takes cache->lock
+ *
+ * @param n_thread
+ * @param apply the promotion of the policy
+ */
+promotion_combiner_t *promotion_combiner_create(int n_thread,
+                                                combiner_apply_func_ptr apply);
+
+void promotion_combiner_free(promotion_combiner_t *combiner);
+
+/**
+ * @brief promote the object of req, the calling thread either applies the
+ * promotion itself together with the ones published by the other threads,
+ * or waits until a combiner has applied it, threads that are not attached
+ * to the cache promote under cache->lock directly
+ *
+ * @param combiner
+ * @param cache
+ * @param req
+ * @return the object or NULL if it is not in the cache
+ */
+cache_obj_t *promotion_combiner_promote(promotion_combiner_t *combiner,
+                                        cache_t *cache, const request_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROMOTION_COMBINER_H */
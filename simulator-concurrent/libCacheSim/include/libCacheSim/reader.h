@@ -39,6 +39,8 @@ typedef struct {
   bool ignore_obj_size;
   bool ignore_size_zero_req;
   bool obj_id_is_num;
+  /* compute req->hv when reading so that the cache does not hash again */
+  bool offload_hash;
   int64_t cap_at_n_req;  // only process at most n_req requests
 
   int time_field;
@@ -72,6 +74,7 @@ enum read_direction {
 };
 
 struct zstd_reader;
+struct trace_manifest;
 typedef struct reader {
   /************* common fields *************/
   uint64_t n_read_req;
@@ -116,6 +119,8 @@ typedef struct reader {
   bool ignore_size_zero_req;
   /* if true, ignore the obj_size in the trace, and use size one */
   bool ignore_obj_size;
+  /* if true, the reader computes the hash value of each request */
+  bool offload_hash;
 
 
   /* this is used when
@@ -127,6 +132,9 @@ typedef struct reader {
   /* used for trace sampling */
   sampler_t *sampler;
   enum read_direction read_direction;
+
+  /* the summary of the trace, computed or loaded on first use */
+  struct trace_manifest *manifest;
 } reader_t;
 
 static inline void set_default_reader_init_params(reader_init_param_t *params) {
@@ -0,0 +1,104 @@
+//
+//  segmentedQueue.h
+//  libCacheSim
+//
+//  the FIFO ring of Clock-style policies split into segments, each segment
+//  has its own head (insertion point) and tail (hand), threads insert into
+//  and evict from different segments so that they do not all contend on
+//  one head and one tail pointer
+//
+
+#ifndef SEGMENTED_QUEUE_H
+#define SEGMENTED_QUEUE_H
+
+#include "cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct queue_segment {
+  cache_obj_t *q_head;
+  cache_obj_t *q_tail;
+  /* a pop reserves an object by decrementing it first, the last object of
+   * a segment is never popped so that inserts never see an empty list */
+  int64_t n_obj;
+  /* one thread inserts at the head at a time, so an insert is linked to the
+   * old head before the next insert is counted and the prev links from the
+   * tail reach every counted object */
+  int inserting;
+  /* one thread pops from the tail at a time, otherwise a pop that read the
+   * tail and its prev before the tail was popped, reinserted and became the
+   * tail again would install the stale prev as the tail */
+  int popping;
+} __attribute__((aligned(64))) queue_segment_t;
+
+typedef struct segmented_queue {
+  queue_segment_t *segs;
+  int n_seg;
+  /* the segment of the next insert during warmup */
+  int64_t warmup_cursor;
+} segmented_queue_t;
+
+segmented_queue_t *segmented_queue_create(int n_seg);
+
+void segmented_queue_free(segmented_queue_t *sq);
+
+/**
+ * @brief insert an object at the head of a segment, each thread rotates over
+ * the segments starting from its thread id, so all segments age at the same
+ * rate and the segmented queue keeps an approximate FIFO order, a segment
+ * that another thread is inserting into is skipped
+ *
+ * @param sq
+ * @param cache
+ * @param obj
+ */
+void segmented_queue_insert(segmented_queue_t *sq, const cache_t *cache,
+                            cache_obj_t *obj);
+
+/**
+ * @brief pop the tail of a segment, the thread picks the larger of its
+ * round-robin segment and the opposite segment, which balances the segments,
+ * and moves on to the next segment if another thread is popping from it
+ *
+ * @param sq
+ * @param cache
+ * @param seg_id the segment to pop from if it is not negative and has more
+ * than one object, set to the segment the object is popped from
+ * @return the object
+ */
+cache_obj_t *segmented_queue_pop(segmented_queue_t *sq, const cache_t *cache,
+                                 int *seg_id);
+
+/**
+ * @brief insert a popped object back at the head of its segment
+ *
+ * @param sq
+ * @param seg_id
+ * @param obj
+ */
+void segmented_queue_reinsert(segmented_queue_t *sq, int seg_id,
+                              cache_obj_t *obj);
+
+/**
+ * @brief remove an object from its segment, this walks to the head of the
+ * segment and is not thread-safe, it is used by user triggered removes
+ *
+ * @param sq
+ * @param obj
+ */
+void segmented_queue_remove(segmented_queue_t *sq, cache_obj_t *obj);
+
+/**
+ * @brief the segment with the most objects, used by to_evict
+ *
+ * @param sq
+ */
+queue_segment_t *segmented_queue_largest(segmented_queue_t *sq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEGMENTED_QUEUE_H */
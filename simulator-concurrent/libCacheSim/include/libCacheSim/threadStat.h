@@ -0,0 +1,93 @@
+//
+//  threadStat.h
+//  libCacheSim
+//
+//  per-thread counters used to explain the scalability of concurrent caches,
+//  each worker thread owns one cache-line aligned block so that counting
+//  does not introduce extra sharing
+//
+
+#ifndef THREAD_STAT_H
+#define THREAD_STAT_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct thread_stat {
+  /* number of times cache->lock is acquired */
+  uint64_t n_lock;
+  /* number of failed trylock before acquiring cache->lock */
+  uint64_t n_lock_contended;
+  /* number of iterations spent waiting for cache->lock */
+  uint64_t n_lock_spin;
+  /* number of objects moved to the head on a hit */
+  uint64_t n_promotion;
+  /* number of objects reinserted at eviction time, e.g., Clock */
+  uint64_t n_reinsertion;
+  /* number of objects removed from the cache */
+  uint64_t n_eviction;
+  /* number of iterations spent waiting for a hashtable bucket lock */
+  uint64_t n_bucket_spin;
+  /* number of promotions applied on behalf of other threads while holding
+   * the combiner role, see promotionCombiner.h */
+  uint64_t n_combined;
+} __attribute__((aligned(64))) thread_stat_t;
+
+/* the counter block of the calling thread, threads that are not attached
+ * to a cache (e.g., the main thread during warmup) share a scratch block */
+extern __thread thread_stat_t *curr_thread_stat;
+
+#define THREAD_STAT_INC(field) (curr_thread_stat->field += 1)
+#define THREAD_STAT_ADD(field, n) (curr_thread_stat->field += (n))
+
+/**
+ * @brief sum the counters of n_thread blocks into one
+ *
+ * @param stats
+ * @param n_thread
+ * @param sum
+ */
+static inline void thread_stat_aggregate(const thread_stat_t *stats,
+                                         const int n_thread,
+                                         thread_stat_t *sum) {
+  memset(sum, 0, sizeof(thread_stat_t));
+  for (int i = 0; i < n_thread; i++) {
+    sum->n_lock += stats[i].n_lock;
+    sum->n_lock_contended += stats[i].n_lock_contended;
+    sum->n_lock_spin += stats[i].n_lock_spin;
+    sum->n_promotion += stats[i].n_promotion;
+    sum->n_reinsertion += stats[i].n_reinsertion;
+    sum->n_eviction += stats[i].n_eviction;
+    sum->n_bucket_spin += stats[i].n_bucket_spin;
+    sum->n_combined += stats[i].n_combined;
+  }
+}
+
+/**
+ * @brief print one counter block as a JSON object (no trailing newline)
+ *
+ * @param ofile
+ * @param stat
+ */
+static inline void thread_stat_print_json(FILE *ofile,
+                                          const thread_stat_t *stat) {
+  fprintf(ofile,
+          "{\"n_lock\": %" PRIu64 ", \"n_lock_contended\": %" PRIu64
+          ", \"n_lock_spin\": %" PRIu64 ", \"n_promotion\": %" PRIu64
+          ", \"n_reinsertion\": %" PRIu64 ", \"n_eviction\": %" PRIu64
+          ", \"n_bucket_spin\": %" PRIu64 ", \"n_combined\": %" PRIu64 "}",
+          stat->n_lock, stat->n_lock_contended, stat->n_lock_spin,
+          stat->n_promotion, stat->n_reinsertion, stat->n_eviction,
+          stat->n_bucket_spin, stat->n_combined);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREAD_STAT_H */
@@ -0,0 +1,62 @@
+//
+//  traceManifest.h
+//  libCacheSim
+//
+//  summary statistics of a trace that are computed in one pass and cached
+//  in a sidecar file next to the trace, so that later runs on the same trace
+//  (e.g., the jobs of a cache size sweep) do not need to decode it again
+//
+
+#ifndef TRACE_MANIFEST_H
+#define TRACE_MANIFEST_H
+
+#include "reader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRACE_MANIFEST_VERSION 1
+#define TRACE_MANIFEST_N_SIZE_BUCKET 48
+
+typedef struct trace_manifest {
+  int64_t n_req;
+  int64_t n_req_byte;
+  /* the number of unique objects and bytes (working set size) */
+  int64_t n_obj;
+  int64_t n_obj_byte;
+  /* true if n_obj and n_obj_byte are estimated because the trace has
+   * too many objects to count exactly */
+  bool is_estimate;
+  int64_t start_time;
+  int64_t end_time;
+  /* number of requests with size in [2^i, 2^(i+1)), size 0 is in bucket 0 */
+  int64_t size_hist[TRACE_MANIFEST_N_SIZE_BUCKET];
+} trace_manifest_t;
+
+/**
+ * @brief scan the trace once and compute the manifest,
+ * the reader is not moved because the scan uses a cloned reader
+ *
+ * @param reader
+ * @param manifest
+ */
+void compute_trace_manifest(reader_t *reader, trace_manifest_t *manifest);
+
+/**
+ * @brief get the manifest of the trace, it is computed at most once,
+ * first from the reader, then from the sidecar file <trace_path>.manifest
+ * if the trace has not changed (same path, size and mtime) and the reader
+ * uses the same parameters, otherwise it is computed and the sidecar is
+ * (re)written, traces with a sampler do not use the sidecar
+ *
+ * @param reader
+ * @return const trace_manifest_t* owned by the reader
+ */
+const trace_manifest_t *get_trace_manifest(reader_t *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_MANIFEST_H */
@@ -26,13 +26,13 @@ using namespace std;
 namespace traceAnalyzer {
 
 void AccessPattern::add_req(const request_t *req) {
-  if (n_seen_req_ > 0xfffffff0) {
-    if (n_seen_req_ == 0xfffffff0) {
-      INFO("trace is too long, accessPattern uses up to 0xfffffff0 requests\n");
-    }
+  if (n_seen_req_ >= 0xfffffff0) {
     return;
   }
   n_seen_req_ += 1;
+  if (n_seen_req_ == 0xfffffff0) {
+    INFO("trace is too long, accessPattern uses up to 0xfffffff0 requests\n");
+  }
 
   if (start_rtime_ == -1) {
     start_rtime_ = req->clock_time;
@@ -102,4 +102,113 @@ void AccessPattern::dump(string &path_base) {
   ofs2.close();
 }
 
+/* the seed that separates the sampling hash from the sketch hashes */
+#define ACCESS_PATTERN_HASH_SEED 0xac
+
+int64_t BoundedAccessPattern::admit(obj_id_t obj_id, uint64_t hash) {
+  uint32_t slot_idx;
+  if (slots_.size() < n_slot_) {
+    slot_idx = slots_.size();
+    slots_.push_back({});
+  } else {
+    /* replace the sampled object with the largest hash */
+    slot_idx = hash_heap_.top().second;
+    hash_heap_.pop();
+    slot_map_.erase(slots_[slot_idx].obj_id);
+  }
+
+  slots_[slot_idx] = {obj_id, hash, 0};
+  slot_map_[obj_id] = slot_idx;
+  hash_heap_.emplace(hash, slot_idx);
+  return slot_idx;
+}
+
+void BoundedAccessPattern::add_req(const request_t *req) {
+  if (n_seen_req_ >= 0xfffffff0) {
+    return;
+  }
+  n_seen_req_ += 1;
+  if (n_seen_req_ == 0xfffffff0) {
+    INFO("trace is too long, accessPattern uses up to 0xfffffff0 requests\n");
+  }
+
+  if (start_rtime_ == -1) {
+    start_rtime_ = req->clock_time;
+  }
+
+  uint64_t hash = sketch_hash(req->obj_id, ACCESS_PATTERN_HASH_SEED);
+  if (slots_.size() == n_slot_ && hash > hash_heap_.top().first) {
+    /* every sampled object has a smaller hash */
+    return;
+  }
+
+  int64_t slot_idx;
+  auto it = slot_map_.find(req->obj_id);
+  if (it == slot_map_.end()) {
+    slot_idx = admit(req->obj_id, hash);
+  } else {
+    slot_idx = it->second;
+  }
+
+  struct slot &s = slots_[slot_idx];
+  uint64_t pos;
+  if (s.n_access < (uint32_t)max_n_access_) {
+    pos = s.n_access;
+  } else {
+    /* reservoir sampling over the accesses after the first one */
+    uint64_t r = next_rand() % s.n_access;
+    if (r >= (uint64_t)max_n_access_ - 1) {
+      s.n_access += 1;
+      return;
+    }
+    pos = r + 1;
+  }
+  rtime_arena_[slot_idx * max_n_access_ + pos] =
+      (uint32_t)(req->clock_time - start_rtime_);
+  vtime_arena_[slot_idx * max_n_access_ + pos] = (uint32_t)n_seen_req_;
+  s.n_access += 1;
+}
+
+void BoundedAccessPattern::dump(string &path_base) {
+  /* the reservoir replaces accesses in random order, the time is
+   * monotonic, so sorting the two arrays separately keeps them paired */
+  vector<uint32_t> sorted_slots;
+  sorted_slots.reserve(slots_.size());
+  for (uint32_t i = 0; i < slots_.size(); i++) {
+    uint32_t n = std::min(slots_[i].n_access, (uint32_t)max_n_access_);
+    uint32_t *rtime = &rtime_arena_[(uint64_t)i * max_n_access_];
+    uint32_t *vtime = &vtime_arena_[(uint64_t)i * max_n_access_];
+    sort(rtime, rtime + n);
+    sort(vtime, vtime + n);
+    sorted_slots.push_back(i);
+  }
+
+  /* sort the objects by the first access */
+  sort(sorted_slots.begin(), sorted_slots.end(), [&](uint32_t a, uint32_t b) {
+    return vtime_arena_[(uint64_t)a * max_n_access_] <
+           vtime_arena_[(uint64_t)b * max_n_access_];
+  });
+
+  const char *names[2] = {"real", "virtual"};
+  const char *suffixes[2] = {".accessRtime", ".accessVtime"};
+  vector<uint32_t> *arenas[2] = {&rtime_arena_, &vtime_arena_};
+  for (int k = 0; k < 2; k++) {
+    ofstream ofs(path_base + suffixes[k], ios::out | ios::trunc);
+    ofs << "# " << path_base << "\n";
+    ofs << "# access pattern " << names[k] << " time, each line stores the "
+        << names[k] << " time of requests to an object (" << slots_.size()
+        << " sampled objects, at most " << max_n_access_
+        << " requests per object)\n";
+    for (uint32_t i : sorted_slots) {
+      uint32_t n = std::min(slots_[i].n_access, (uint32_t)max_n_access_);
+      const uint32_t *t = &(*arenas[k])[(uint64_t)i * max_n_access_];
+      for (uint32_t j = 0; j < n; j++) {
+        ofs << t[j] << ",";
+      }
+      ofs << "\n";
+    }
+    ofs.close();
+  }
+}
+
 };  // namespace traceAnalyzer
@@ -3,6 +3,7 @@
 //
 
 #include <algorithm>  // std::make_heap, std::pop_heap, std::push_heap, std::sort_heap
+#include <thread>
 #include <vector>  // std::vector
 
 #include "analyzer.h"
@@ -21,8 +22,24 @@ void traceAnalyzer::TraceAnalyzer::initialize() {
     req_rate_stat_ = new ReqRate(time_window_);
   }
 
+  /* the sketches split the memory budget */
+  uint64_t sketch_mem = (uint64_t)sketch_mem_mb_ * MiB / 2;
+  if (sketch_mem_mb_ > 0) {
+    INFO("sketch memory %d MiB bounds popularity, accessPattern and reuse, "
+         "the object map is exact and uses about %zu bytes per object\n",
+         sketch_mem_mb_, sizeof(obj_info_map_type::value_type) + 1);
+  }
+
   if (option_.access_pattern) {
-    access_stat_ = new AccessPattern(access_pattern_sample_ratio_inv_);
+    if (sketch_mem_mb_ > 0) {
+      bounded_access_stat_ = new BoundedAccessPattern(sketch_mem);
+    } else {
+      access_stat_ = new AccessPattern(access_pattern_sample_ratio_inv_);
+    }
+  }
+
+  if (option_.popularity && sketch_mem_mb_ > 0) {
+    popularity_sketch_ = new PopularitySketch(sketch_mem, sketch_top_k_);
   }
 
   if (option_.size) {
@@ -30,7 +47,8 @@ void traceAnalyzer::TraceAnalyzer::initialize() {
   }
 
   if (option_.reuse) {
-    reuse_stat_ = new ReuseDistribution(output_path_, time_window_);
+    reuse_stat_ = new ReuseDistribution(output_path_, time_window_, 5, 1000,
+                                        sketch_mem_mb_ > 0);
   }
 
   if (option_.popularity_decay) {
@@ -55,6 +73,39 @@ void traceAnalyzer::TraceAnalyzer::initialize() {
   }
 
   // scan_detector_ = new ScanDetector(reader_, output_path, 100);
+
+  add_module(ttl_stat_);
+  add_module(req_rate_stat_);
+  add_module(size_stat_);
+  add_module(reuse_stat_);
+  add_module(access_stat_);
+  add_module(bounded_access_stat_);
+  add_module(popularity_sketch_);
+  add_module(popularity_decay_stat_);
+  add_module(prob_at_age_);
+  add_module(lifetime_stat_);
+  add_module(create_future_reuse_);
+  add_module(size_change_distribution_);
+  add_module(scan_detector_);
+}
+
+/**
+ * @brief the loop of a module thread, worker i runs modules i, i + n_worker,
+ * ... on every batch
+ */
+void traceAnalyzer::TraceAnalyzer::analyze_batches(BatchRing *ring,
+                                                   int worker_id,
+                                                   int n_worker) {
+  request_t *reqs;
+  int n_req;
+  while (ring->next(worker_id, &reqs, &n_req)) {
+    for (size_t m = worker_id; m < modules_.size(); m += n_worker) {
+      for (int i = 0; i < n_req; i++) {
+        modules_[m](&reqs[i]);
+      }
+    }
+    ring->release(worker_id);
+  }
 }
 
 void traceAnalyzer::TraceAnalyzer::cleanup() {
@@ -64,7 +115,9 @@ void traceAnalyzer::TraceAnalyzer::cleanup() {
   delete reuse_stat_;
   delete size_stat_;
   delete access_stat_;
+  delete bounded_access_stat_;
   delete popularity_stat_;
+  delete popularity_sketch_;
   delete popularity_decay_stat_;
 
   delete prob_at_age_;
@@ -88,6 +141,22 @@ void traceAnalyzer::TraceAnalyzer::cleanup() {
 void traceAnalyzer::TraceAnalyzer::run() {
   if (has_run_) return;
 
+  /* the decoder (this thread) reads the trace and tracks the objects, the
+   * modules run on the worker threads */
+  int n_worker = std::min(n_thread_ - 1, (int)modules_.size());
+  BatchRing *ring = nullptr;
+  std::vector<std::thread> workers;
+  request_t *batch = nullptr;
+  int n_req_in_batch = 0;
+  if (n_worker > 0) {
+    ring = new BatchRing(n_worker, PIPELINE_N_BATCH, PIPELINE_BATCH_SIZE);
+    for (int i = 0; i < n_worker; i++) {
+      workers.emplace_back(&TraceAnalyzer::analyze_batches, this, ring, i,
+                           n_worker);
+    }
+    batch = ring->next_to_fill();
+  }
+
   request_t *req = new_request();
   read_one_req(reader_, req);
   start_ts_ = req->clock_time;
@@ -172,53 +241,34 @@ void traceAnalyzer::TraceAnalyzer::run() {
 
     op_stat_->add_req(req);
 
-    if (ttl_stat_ != nullptr) {
-      ttl_stat_->add_req(req);
-    }
-
-    if (req_rate_stat_ != nullptr) {
-      req_rate_stat_->add_req(req);
-    }
-
-    if (size_stat_ != nullptr) {
-      size_stat_->add_req(req);
-    }
-
-    if (reuse_stat_ != nullptr) {
-      reuse_stat_->add_req(req);
-    }
-
-    if (access_stat_ != nullptr) {
-      access_stat_->add_req(req);
-    }
-
-    if (popularity_decay_stat_ != nullptr) {
-      popularity_decay_stat_->add_req(req);
-    }
-
-    if (prob_at_age_ != nullptr) {
-      prob_at_age_->add_req(req);
-    }
-
-    if (lifetime_stat_ != nullptr) {
-      lifetime_stat_->add_req(req);
-    }
-
-    if (create_future_reuse_ != nullptr) {
-      create_future_reuse_->add_req(req);
-    }
-
-    if (size_change_distribution_ != nullptr) {
-      size_change_distribution_->add_req(req);
-    }
-    if (scan_detector_ != nullptr) {
-      scan_detector_->add_req(req);
+    if (ring == nullptr) {
+      for (auto &module : modules_) {
+        module(req);
+      }
+    } else {
+      copy_request(&batch[n_req_in_batch++], req);
+      if (n_req_in_batch == ring->batch_size()) {
+        ring->publish(n_req_in_batch);
+        batch = ring->next_to_fill();
+        n_req_in_batch = 0;
+      }
     }
 
     read_one_req(reader_, req);
   } while (req->valid);
   end_ts_ = req->clock_time + start_ts_;
 
+  if (ring != nullptr) {
+    if (n_req_in_batch > 0) {
+      ring->publish(n_req_in_batch);
+    }
+    ring->close();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    delete ring;
+  }
+
   /* processing */
   post_processing();
 
@@ -248,10 +298,18 @@ void traceAnalyzer::TraceAnalyzer::run() {
     access_stat_->dump(output_path_);
   }
 
+  if (bounded_access_stat_ != nullptr) {
+    bounded_access_stat_->dump(output_path_);
+  }
+
   if (popularity_stat_ != nullptr) {
     popularity_stat_->dump(output_path_);
   }
 
+  if (popularity_sketch_ != nullptr) {
+    popularity_sketch_->dump(output_path_);
+  }
+
   if (popularity_decay_stat_ != nullptr) {
     popularity_decay_stat_->dump(output_path_);
   }
@@ -305,6 +363,14 @@ string traceAnalyzer::TraceAnalyzer::gen_stat_str() {
            << "object size weighted by req/obj: " << mean_obj_size_req << "/"
            << mean_obj_size_obj << "\n"
            << "frequency mean: " << freq_mean << "\n";
+  if (sketch_mem_mb_ > 0) {
+    /* the summaries are bounded, the object map is not */
+    double obj_map_mb = (double)(obj_map_.mask() + 1) *
+                        (double)(sizeof(obj_info_map_type::value_type) + 1) /
+                        (double)MiB;
+    stat_ss_ << "sketch memory: " << sketch_mem_mb_
+             << " MiB, object map: " << obj_map_mb << " MiB\n";
+  }
   stat_ss_ << "time span: " << time_span << "("
            << (double)(end_ts_ - start_ts_) / 3600 / 24 << " day)\n";
 
@@ -314,6 +380,7 @@ string traceAnalyzer::TraceAnalyzer::gen_stat_str() {
   }
   if (req_rate_stat_ != nullptr) stat_ss_ << *req_rate_stat_;
   if (popularity_stat_ != nullptr) stat_ss_ << *popularity_stat_;
+  if (popularity_sketch_ != nullptr) stat_ss_ << *popularity_sketch_;
 
   stat_ss_ << "X-hit (number of obj accessed X times): ";
   for (int i = 0; i < track_n_hit_; i++) {
@@ -352,7 +419,13 @@ void traceAnalyzer::TraceAnalyzer::post_processing() {
     }
   }
 
-  if (option_.popularity) {
+  if (popularity_sketch_ != nullptr) {
+    popularity_sketch_->run();
+    auto sorted_freq = popularity_sketch_->get_sorted_freq();
+    for (int i = 0; i < track_n_popular_ && i < (int)sorted_freq.size(); i++) {
+      popular_cnt_[i] = sorted_freq[i];
+    }
+  } else if (option_.popularity) {
     popularity_stat_ = new Popularity(obj_map_);
     auto sorted_freq = popularity_stat_->get_sorted_freq();
     for (int i = 0; i < track_n_popular_; i++) {
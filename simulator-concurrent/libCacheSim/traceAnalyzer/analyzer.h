@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -21,6 +22,7 @@
 #include "../include/libCacheSim/reader.h"
 #include "accessPattern.h"
 #include "op.h"
+#include "pipeline.h"
 #include "popularity.h"
 #include "popularityDecay.h"
 #include "reqRate.h"
@@ -66,6 +68,15 @@ typedef struct analysis_param {
   int warmup_time;
   double access_pattern_sample_ratio;
   int access_pattern_sample_ratio_inv;
+  /* one thread decodes the trace, the others run the analysis modules,
+   * 1 runs everything on the calling thread */
+  int n_thread;
+  /* if positive, popularity, accessPattern and reuse use summaries of this
+   * many MiB in total instead of per-object state, 0 is exact,
+   * obj_map_ is not bounded, it grows by about 32 bytes per object */
+  int sketch_mem_mb;
+  /* the number of most popular objects tracked with sketch_mem_mb */
+  int sketch_top_k;
 } analysis_param_t;
 
 static analysis_param_t default_param() {
@@ -76,6 +87,9 @@ static analysis_param_t default_param() {
   param.warmup_time = 86400;
   param.access_pattern_sample_ratio = 0.01;
   param.access_pattern_sample_ratio_inv = 101;
+  param.n_thread = 1;
+  param.sketch_mem_mb = 0;
+  param.sketch_top_k = 10000;
 
   return param;
 };
@@ -99,6 +113,10 @@ static struct analysis_option default_option() {
 
 #define DEFAULT_PREALLOC_N_OBJ 1e8
 
+/* the requests handed from the decoder to the module threads */
+#define PIPELINE_BATCH_SIZE 1024
+#define PIPELINE_N_BATCH 32
+
 class TraceAnalyzer {
  public:
   explicit TraceAnalyzer(reader_t *reader, string output_path,
@@ -112,7 +130,10 @@ class TraceAnalyzer {
         track_n_popular_(params.track_n_popular),
         track_n_hit_(params.track_n_hit),
         time_window_(params.time_window),
-        warmup_time_(params.warmup_time) {
+        warmup_time_(params.warmup_time),
+        n_thread_(params.n_thread),
+        sketch_mem_mb_(params.sketch_mem_mb),
+        sketch_top_k_(params.sketch_top_k) {
     if (warmup_time_ % time_window_ != 0) {
       /* the popularityDecay computation needs warmup time to be multiple of
        * time_window */
@@ -150,6 +171,10 @@ class TraceAnalyzer {
   int track_n_hit_;
   // the sampling ratio used in access pattern analysis
   int access_pattern_sample_ratio_inv_;
+  int n_thread_;
+  // the memory of the popularity, accessPattern and reuse summaries
+  int sketch_mem_mb_;
+  int sketch_top_k_;
 
   /* stat */
   int64_t n_req_ = 0;
@@ -166,6 +191,8 @@ class TraceAnalyzer {
    * an object is requested, we ignore for now */
   //  uint64_t sum_req_size_req = 0, sum_req_size_obj = 0;
 
+  /* exact in sketch mode as well, every analysis uses it to find the first
+   * request and the previous request of an object */
   obj_info_map_type obj_map_;
 
  private:
@@ -180,7 +207,9 @@ class TraceAnalyzer {
   SizeDistribution *size_stat_ = nullptr;
   ReuseDistribution *reuse_stat_ = nullptr;
   AccessPattern *access_stat_ = nullptr;
+  BoundedAccessPattern *bounded_access_stat_ = nullptr;
   Popularity *popularity_stat_ = nullptr;
+  PopularitySketch *popularity_sketch_ = nullptr;
   PopularityDecay *popularity_decay_stat_ = nullptr;
 
   ProbAtAge *prob_at_age_ = nullptr;
@@ -194,6 +223,19 @@ class TraceAnalyzer {
 
   string output_path_;
 
+  /* the add_req of the enabled modules, they do not share state, so each
+   * can run on its own thread as long as it sees the requests in order */
+  std::vector<std::function<void(request_t *)>> modules_;
+
+  template <typename T>
+  void add_module(T *module) {
+    if (module != nullptr) {
+      modules_.emplace_back([module](request_t *req) { module->add_req(req); });
+    }
+  }
+
+  void analyze_batches(BatchRing *ring, int worker_id, int n_worker);
+
   void post_processing();
 
   string gen_stat_str();
@@ -0,0 +1,161 @@
+//
+// fixed-size summaries used when the analyzer runs with a memory budget,
+// their memory is set at construction and does not grow with the number of
+// objects or requests in the trace
+//
+// CountMinSketch   frequency of any object, never under-estimates
+// TopK             the K most frequent objects, the counts come from the
+//                  Count-Min sketch
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../dataStructure/robin_hood.h"
+#include "../include/config.h"
+
+namespace traceAnalyzer {
+
+/* the finalizer of splitmix64, a cheap hash that mixes every input bit */
+static inline uint64_t sketch_hash(uint64_t x, uint64_t seed) {
+  x += seed * 0x9e3779b97f4a7c15ULL + 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+class CountMinSketch {
+ public:
+  /**
+   * @param mem_size the memory of the counters in bytes
+   * @param depth the number of rows, the error probability is e^-depth
+   */
+  explicit CountMinSketch(uint64_t mem_size, int depth = 4)
+      : depth_(std::max(1, std::min(depth, max_depth_))) {
+    uint64_t width = mem_size / sizeof(uint32_t) / depth_;
+    /* round down to a power of two so the column is a mask of the hash */
+    width_ = 1024;
+    while (width_ * 2 <= width) width_ *= 2;
+    counters_.resize(width_ * depth_, 0);
+  }
+
+  /* add one request and return the new estimate, conservative update only
+   * increases the counters that equal the minimum, which reduces the
+   * over-estimate of the less popular objects */
+  uint32_t add(obj_id_t obj_id) {
+    uint32_t *cnt[max_depth_];
+    uint32_t est = UINT32_MAX;
+    for (int i = 0; i < depth_; i++) {
+      cnt[i] = &counters_[idx(obj_id, i)];
+      est = std::min(est, *cnt[i]);
+    }
+    if (est == UINT32_MAX) return est;
+    for (int i = 0; i < depth_; i++) {
+      if (*cnt[i] == est) *cnt[i] += 1;
+    }
+    return est + 1;
+  }
+
+  uint32_t estimate(obj_id_t obj_id) const {
+    uint32_t est = UINT32_MAX;
+    for (int i = 0; i < depth_; i++) {
+      est = std::min(est, counters_[idx(obj_id, i)]);
+    }
+    return est;
+  }
+
+  uint64_t mem_size() const { return counters_.size() * sizeof(uint32_t); }
+
+ private:
+  /* the position of the object's counter in row i */
+  inline uint64_t idx(obj_id_t obj_id, int i) const {
+    return i * width_ + (sketch_hash(obj_id, i) & (width_ - 1));
+  }
+
+  static constexpr int max_depth_ = 16;
+  const int depth_;
+  uint64_t width_;
+  std::vector<uint32_t> counters_;
+};
+
+class TopK {
+ public:
+  explicit TopK(int k) : k_(k) {
+    heap_.reserve(k_);
+    pos_.reserve(k_);
+  }
+
+  /**
+   * @brief update the count of an object, the object replaces the least
+   * frequent tracked object if the count is larger
+   */
+  void update(obj_id_t obj_id, uint32_t cnt) {
+    auto it = pos_.find(obj_id);
+    if (it != pos_.end()) {
+      /* the count from the sketch never decreases */
+      heap_[it->second].first = cnt;
+      sift_down(it->second);
+      return;
+    }
+
+    if ((int)heap_.size() < k_) {
+      heap_.emplace_back(cnt, obj_id);
+      pos_[obj_id] = heap_.size() - 1;
+      sift_up(heap_.size() - 1);
+    } else if (cnt > heap_[0].first) {
+      pos_.erase(heap_[0].second);
+      heap_[0] = {cnt, obj_id};
+      pos_[obj_id] = 0;
+      sift_down(0);
+    }
+  }
+
+  /* the counts of the tracked objects, the most frequent first */
+  std::vector<uint32_t> sorted_cnt() const {
+    std::vector<uint32_t> cnts;
+    cnts.reserve(heap_.size());
+    for (const auto &p : heap_) cnts.push_back(p.first);
+    std::sort(cnts.begin(), cnts.end(), std::greater<>());
+    return cnts;
+  }
+
+  int size() const { return (int)heap_.size(); }
+
+ private:
+  void swap_entry(size_t a, size_t b) {
+    std::swap(heap_[a], heap_[b]);
+    pos_[heap_[a].second] = a;
+    pos_[heap_[b].second] = b;
+  }
+
+  void sift_up(size_t i) {
+    while (i > 0 && heap_[(i - 1) / 2].first > heap_[i].first) {
+      swap_entry(i, (i - 1) / 2);
+      i = (i - 1) / 2;
+    }
+  }
+
+  void sift_down(size_t i) {
+    while (true) {
+      size_t smallest = i, l = 2 * i + 1, r = 2 * i + 2;
+      if (l < heap_.size() && heap_[l].first < heap_[smallest].first)
+        smallest = l;
+      if (r < heap_.size() && heap_[r].first < heap_[smallest].first)
+        smallest = r;
+      if (smallest == i) return;
+      swap_entry(i, smallest);
+      i = smallest;
+    }
+  }
+
+  const int k_;
+  /* a min-heap of (count, obj_id) */
+  std::vector<std::pair<uint32_t, obj_id_t>> heap_;
+  robin_hood::unordered_flat_map<obj_id_t, size_t> pos_;
+};
+
+}  // namespace traceAnalyzer
@@ -0,0 +1,310 @@
+//
+//  manifest.c
+//  libCacheSim
+//
+//  the working set size is counted exactly until the trace has too many
+//  objects, then the number of objects is estimated with a HyperLogLog and
+//  the number of bytes with the mean size of a hash-sampled object subset,
+//  sampling on the hash rather than the object id avoids the bias when the
+//  object ids are not random
+//
+
+#include "../include/libCacheSim/traceManifest.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MANIFEST_SUFFIX ".manifest"
+#define MANIFEST_KEY_LEN 512
+#define MANIFEST_PATH_LEN 4096
+
+/* switch from exact counting to estimation above this many objects */
+#define MANIFEST_EXACT_N_OBJ (1L << 24)
+/* the sampled object set is halved when it grows above this */
+#define MANIFEST_SAMPLE_N_OBJ (1L << 20)
+
+#define HLL_PRECISION 14
+#define HLL_N_REGISTER (1 << HLL_PRECISION)
+
+typedef struct {
+  GHashTable *exact_set;
+  /* obj_id -> obj_size of the objects whose hash has sample_shift leading
+   * zero bits, i.e., a 2^-sample_shift sample of the object space */
+  GHashTable *sample_set;
+  int sample_shift;
+  uint8_t hll[HLL_N_REGISTER];
+} wss_counter_t;
+
+static inline uint64_t mix64(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+static inline bool in_sample(uint64_t hv, int sample_shift) {
+  return sample_shift == 0 || hv >> (64 - sample_shift) == 0;
+}
+
+static gboolean not_in_sample(gpointer key, gpointer value, gpointer user_data) {
+  return !in_sample(mix64((uint64_t)key), *(int *)user_data);
+}
+
+static void wss_counter_add(wss_counter_t *counter, uint64_t obj_id, int64_t obj_size) {
+  uint64_t hv = mix64(obj_id);
+
+  /* HyperLogLog: the first HLL_PRECISION bits select the register,
+   * the register keeps the max position of the first one bit in the rest */
+  uint32_t idx = hv >> (64 - HLL_PRECISION);
+  uint64_t w = hv << HLL_PRECISION;
+  uint8_t rank = w == 0 ? 64 - HLL_PRECISION + 1 : __builtin_clzll(w) + 1;
+  if (rank > counter->hll[idx]) counter->hll[idx] = rank;
+
+  if (counter->exact_set != NULL) {
+    g_hash_table_insert(counter->exact_set, (gpointer)obj_id, (gpointer)obj_size);
+    if (g_hash_table_size(counter->exact_set) > MANIFEST_EXACT_N_OBJ) {
+      g_hash_table_destroy(counter->exact_set);
+      counter->exact_set = NULL;
+    }
+  }
+
+  if (in_sample(hv, counter->sample_shift)) {
+    g_hash_table_insert(counter->sample_set, (gpointer)obj_id, (gpointer)obj_size);
+    if (g_hash_table_size(counter->sample_set) > MANIFEST_SAMPLE_N_OBJ) {
+      counter->sample_shift += 1;
+      g_hash_table_foreach_remove(counter->sample_set, not_in_sample, &counter->sample_shift);
+    }
+  }
+}
+
+static double hll_estimate(const uint8_t *hll) {
+  double sum = 0;
+  int n_zero = 0;
+  for (int i = 0; i < HLL_N_REGISTER; i++) {
+    sum += ldexp(1.0, -hll[i]);
+    if (hll[i] == 0) n_zero += 1;
+  }
+
+  double m = HLL_N_REGISTER;
+  double est = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+  /* use linear counting for small cardinality */
+  if (est <= 2.5 * m && n_zero > 0) est = m * log(m / n_zero);
+  return est;
+}
+
+static void sum_obj_size(gpointer key, gpointer value, gpointer user_data) { *(int64_t *)user_data += (int64_t)value; }
+
+static void wss_counter_result(wss_counter_t *counter, trace_manifest_t *manifest) {
+  if (counter->exact_set != NULL) {
+    manifest->is_estimate = false;
+    manifest->n_obj = g_hash_table_size(counter->exact_set);
+    manifest->n_obj_byte = 0;
+    g_hash_table_foreach(counter->exact_set, sum_obj_size, &manifest->n_obj_byte);
+    return;
+  }
+
+  manifest->is_estimate = true;
+  manifest->n_obj = (int64_t)hll_estimate(counter->hll);
+  int64_t sample_byte = 0;
+  g_hash_table_foreach(counter->sample_set, sum_obj_size, &sample_byte);
+  int64_t n_sample = g_hash_table_size(counter->sample_set);
+  manifest->n_obj_byte = n_sample == 0 ? 0 : (int64_t)((double)sample_byte / n_sample * manifest->n_obj);
+}
+
+/**
+ * @brief scan the trace once and compute the manifest
+ *
+ * @param reader
+ * @param manifest
+ */
+void compute_trace_manifest(reader_t *reader, trace_manifest_t *manifest) {
+  memset(manifest, 0, sizeof(trace_manifest_t));
+  wss_counter_t *counter = calloc(1, sizeof(wss_counter_t));
+  counter->exact_set = g_hash_table_new(g_direct_hash, g_direct_equal);
+  counter->sample_set = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+  INFO("scanning trace %s to build the manifest...\n", reader->trace_path);
+  reader_t *reader_copy = clone_reader(reader);
+  request_t *req = new_request();
+  bool first = true;
+  while (read_one_req(reader_copy, req) == 0) {
+    if (first) {
+      manifest->start_time = req->clock_time;
+      first = false;
+    }
+    manifest->end_time = req->clock_time;
+    manifest->n_req += 1;
+    manifest->n_req_byte += req->obj_size;
+
+    int bucket = req->obj_size <= 1 ? 0 : 63 - __builtin_clzll((uint64_t)req->obj_size);
+    if (bucket >= TRACE_MANIFEST_N_SIZE_BUCKET) bucket = TRACE_MANIFEST_N_SIZE_BUCKET - 1;
+    manifest->size_hist[bucket] += 1;
+
+    wss_counter_add(counter, req->obj_id, req->obj_size);
+  }
+  free_request(req);
+  close_reader(reader_copy);
+
+  wss_counter_result(counter, manifest);
+  if (counter->exact_set != NULL) g_hash_table_destroy(counter->exact_set);
+  g_hash_table_destroy(counter->sample_set);
+  free(counter);
+
+  INFO("trace %s: %ld requests, working set size %ld objects %ld bytes%s\n", reader->trace_path,
+       (long)manifest->n_req, (long)manifest->n_obj, (long)manifest->n_obj_byte,
+       manifest->is_estimate ? " (estimated)" : "");
+}
+
+/* the reader parameters that change what the reader returns */
+static void get_reader_key(const reader_t *reader, char *key) {
+  const reader_init_param_t *p = &reader->init_params;
+  snprintf(key, MANIFEST_KEY_LEN,
+           "type=%d,fmt=%s,obj-id-is-num=%d,ignore-obj-size=%d,ignore-size-zero-req=%d,cap=%ld,"
+           "fields=%d:%d:%d:%d:%d:%d:%d,header=%d,delimiter=%d,offset=%ld",
+           (int)reader->trace_type, p->binary_fmt_str == NULL ? "" : p->binary_fmt_str, (int)reader->obj_id_is_num,
+           (int)reader->ignore_obj_size, (int)reader->ignore_size_zero_req, (long)reader->cap_at_n_req, p->time_field,
+           p->obj_id_field, p->obj_size_field, p->op_field, p->ttl_field, p->cnt_field, p->next_access_vtime_field,
+           (int)p->has_header, (int)p->delimiter, (long)p->trace_start_offset);
+}
+
+/* the sidecar is only valid for the same trace file */
+static bool get_trace_id(const reader_t *reader, char *abs_path, int64_t *file_size, int64_t *mtime) {
+  struct stat st;
+  if (realpath(reader->trace_path, abs_path) == NULL || stat(abs_path, &st) != 0) return false;
+  *file_size = (int64_t)st.st_size;
+  *mtime = (int64_t)st.st_mtime;
+  return true;
+}
+
+static bool load_manifest(const char *sidecar_path, const char *abs_path, int64_t file_size, int64_t mtime,
+                          const char *reader_key, trace_manifest_t *manifest) {
+  FILE *ifile = fopen(sidecar_path, "r");
+  if (ifile == NULL) return false;
+
+  char *line = malloc(MANIFEST_PATH_LEN + 64);
+  char *val;
+  int version = 0, n_field = 0, is_estimate = 0;
+  bool match = true;
+  memset(manifest, 0, sizeof(trace_manifest_t));
+  while (match && fgets(line, MANIFEST_PATH_LEN + 64, ifile) != NULL) {
+    line[strcspn(line, "\n")] = '\0';
+    if (line[0] == '#' || (val = strchr(line, '=')) == NULL) continue;
+    *val++ = '\0';
+
+    if (strcmp(line, "version") == 0) {
+      version = atoi(val);
+      match = version == TRACE_MANIFEST_VERSION;
+    } else if (strcmp(line, "trace_path") == 0) {
+      match = strcmp(val, abs_path) == 0;
+    } else if (strcmp(line, "file_size") == 0) {
+      match = atoll(val) == file_size;
+    } else if (strcmp(line, "mtime") == 0) {
+      match = atoll(val) == mtime;
+    } else if (strcmp(line, "reader") == 0) {
+      match = strcmp(val, reader_key) == 0;
+    } else if (strcmp(line, "n_req") == 0) {
+      manifest->n_req = atoll(val), n_field++;
+    } else if (strcmp(line, "n_req_byte") == 0) {
+      manifest->n_req_byte = atoll(val), n_field++;
+    } else if (strcmp(line, "n_obj") == 0) {
+      manifest->n_obj = atoll(val), n_field++;
+    } else if (strcmp(line, "n_obj_byte") == 0) {
+      manifest->n_obj_byte = atoll(val), n_field++;
+    } else if (strcmp(line, "is_estimate") == 0) {
+      is_estimate = atoi(val), n_field++;
+    } else if (strcmp(line, "start_time") == 0) {
+      manifest->start_time = atoll(val), n_field++;
+    } else if (strcmp(line, "end_time") == 0) {
+      manifest->end_time = atoll(val), n_field++;
+    } else if (strcmp(line, "size_hist") == 0) {
+      char *p = val;
+      for (int i = 0; i < TRACE_MANIFEST_N_SIZE_BUCKET && *p != '\0'; i++) {
+        manifest->size_hist[i] = strtoll(p, &p, 10);
+        if (*p == ',') p++;
+      }
+      n_field++;
+    }
+  }
+  free(line);
+  fclose(ifile);
+
+  manifest->is_estimate = is_estimate != 0;
+  return match && version == TRACE_MANIFEST_VERSION && n_field == 8;
+}
+
+static void save_manifest(const char *sidecar_path, const char *abs_path, int64_t file_size, int64_t mtime,
+                          const char *reader_key, const trace_manifest_t *manifest) {
+  /* write to a temporary file and rename it, so that concurrent jobs on the
+   * same trace never see a partial sidecar */
+  char tmp_path[MANIFEST_PATH_LEN + 32];
+  snprintf(tmp_path, sizeof(tmp_path), "%s.%ld", sidecar_path, (long)getpid());
+  FILE *ofile = fopen(tmp_path, "w");
+  if (ofile == NULL) {
+    WARN("cannot write trace manifest %s %s\n", tmp_path, strerror(errno));
+    return;
+  }
+
+  fprintf(ofile, "# libCacheSim trace manifest\nversion=%d\ntrace_path=%s\nfile_size=%ld\nmtime=%ld\nreader=%s\n",
+          TRACE_MANIFEST_VERSION, abs_path, (long)file_size, (long)mtime, reader_key);
+  fprintf(ofile, "n_req=%ld\nn_req_byte=%ld\nn_obj=%ld\nn_obj_byte=%ld\nis_estimate=%d\nstart_time=%ld\nend_time=%ld\n",
+          (long)manifest->n_req, (long)manifest->n_req_byte, (long)manifest->n_obj, (long)manifest->n_obj_byte,
+          (int)manifest->is_estimate, (long)manifest->start_time, (long)manifest->end_time);
+  fprintf(ofile, "size_hist=");
+  for (int i = 0; i < TRACE_MANIFEST_N_SIZE_BUCKET; i++) {
+    fprintf(ofile, i == 0 ? "%ld" : ",%ld", (long)manifest->size_hist[i]);
+  }
+  fprintf(ofile, "\n");
+
+  if (fclose(ofile) != 0 || rename(tmp_path, sidecar_path) != 0) {
+    WARN("cannot write trace manifest %s %s\n", sidecar_path, strerror(errno));
+    unlink(tmp_path);
+  }
+}
+
+/**
+ * @brief get the manifest of the trace, load it from the sidecar file
+ * or compute it if the sidecar does not exist or is stale
+ *
+ * @param reader
+ * @return const trace_manifest_t*
+ */
+const trace_manifest_t *get_trace_manifest(reader_t *reader) {
+  if (reader->manifest != NULL) return reader->manifest;
+
+  trace_manifest_t *manifest = malloc(sizeof(trace_manifest_t));
+  reader->manifest = manifest;
+
+  char abs_path[MANIFEST_PATH_LEN];
+  char sidecar_path[MANIFEST_PATH_LEN + 16];
+  char reader_key[MANIFEST_KEY_LEN];
+  int64_t file_size, mtime;
+  /* sampling is random, so the result cannot be reused */
+  bool use_sidecar = reader->sampler == NULL && get_trace_id(reader, abs_path, &file_size, &mtime);
+  if (use_sidecar) {
+    snprintf(sidecar_path, sizeof(sidecar_path), "%s%s", abs_path, MANIFEST_SUFFIX);
+    get_reader_key(reader, reader_key);
+    if (load_manifest(sidecar_path, abs_path, file_size, mtime, reader_key, manifest)) {
+      DEBUG("load trace manifest %s\n", sidecar_path);
+      return manifest;
+    }
+  }
+
+  compute_trace_manifest(reader, manifest);
+  if (use_sidecar) {
+    save_manifest(sidecar_path, abs_path, file_size, mtime, reader_key, manifest);
+  }
+
+  return manifest;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,7 +8,9 @@
 
 #include <ctype.h>
 
+#include "../dataStructure/hash/hash.h"
 #include "../include/libCacheSim/macro.h"
+#include "../include/libCacheSim/traceManifest.h"
 #include "customizedReader/akamaiBin.h"
 #include "customizedReader/cf1Bin.h"
 #include "customizedReader/oracle/oracleAkamaiBin.h"
@@ -26,6 +28,7 @@
 #include "generalReader/lcs.h"
 #include "generalReader/libcsv.h"
 #include "generalReader/readerInternal.h"
+#include "generalReader/synthetic.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -70,6 +73,7 @@ reader_t *setup_reader(const char *const trace_path,
   reader->n_read_req = 0;
   reader->ignore_size_zero_req = true;
   reader->ignore_obj_size = false;
+  reader->offload_hash = false;
   reader->cloned = false;
   reader->item_size = 0;
   reader->obj_id_is_num = false;
@@ -80,6 +84,7 @@ reader_t *setup_reader(const char *const trace_path,
   reader->read_direction = READ_FORWARD;
   reader->n_req_left = 0;
   reader->last_req_clock_time = -1;
+  reader->manifest = NULL;
 
   if (init_params != NULL) {
     memcpy(&reader->init_params, init_params, sizeof(reader_init_param_t));
@@ -87,6 +92,7 @@ reader_t *setup_reader(const char *const trace_path,
       reader->init_params.binary_fmt_str = strdup(init_params->binary_fmt_str);
 
     reader->ignore_obj_size = init_params->ignore_obj_size;
+    reader->offload_hash = init_params->offload_hash;
     reader->ignore_size_zero_req = init_params->ignore_size_zero_req;
     reader->obj_id_is_num = init_params->obj_id_is_num;
     reader->trace_start_offset = init_params->trace_start_offset;
@@ -101,6 +107,12 @@ reader_t *setup_reader(const char *const trace_path,
   assert(trace_path != NULL);
   reader->trace_path = strdup(trace_path);
 
+  if (trace_type == SYNTHETIC_TRACE) {
+    /* the trace path is the workload spec, there is no file to open */
+    syntheticReader_setup(reader);
+    return reader;
+  }
+
   // create a dummy text file
   char* text = "thisisnowadummytexttrac";
   char* trace_path_d= "dummy.txt";
@@ -440,6 +452,9 @@ int read_one_req(reader_t *const reader, request_t *const req) {
       case VALPIN_TRACE:
         status = valpin_read_one_req(reader, req);
         break;
+      case SYNTHETIC_TRACE:
+        status = synthetic_read_one_req(reader, req);
+        break;
       default:
         ERROR(
             "cannot recognize reader obj_id_type, given reader obj_id_type: "
@@ -447,6 +462,11 @@ int read_one_req(reader_t *const reader, request_t *const req) {
             reader->trace_type);
         abort();
     }
+
+    /* the sampler, the hash table and the shards share this hash */
+    if (reader->offload_hash) {
+      req->hv = get_hash_value_int_64(&req->obj_id);
+    }
   }
 
   if (reader->sampler != NULL) {
@@ -646,21 +666,10 @@ void reset_reader(reader_t *const reader) {
 uint64_t get_num_of_req(reader_t *const reader) {
   if (reader->n_total_req > 0) return reader->n_total_req;
 
-  uint64_t n_req = 0;
-
-  if (reader->trace_format == TXT_TRACE_FORMAT || reader->is_zstd_file) {
-    reader_t *reader_copy = clone_reader(reader);
-    reader_copy->mmap_offset = 0;
-    request_t *req = new_request();
-    while (read_one_req(reader_copy, req) == 0) {
-      n_req++;
-    }
-  } else {
-    ERROR("should not reach here\n");
-    abort();
-  }
-  reader->n_total_req = n_req;
-  return n_req;
+  /* txt and compressed traces need a full scan, which also computes the
+   * rest of the manifest, so later users do not scan the trace again */
+  reader->n_total_req = get_trace_manifest(reader)->n_req;
+  return reader->n_total_req;
 }
 
 reader_t *clone_reader(const reader_t *const reader_in) {
@@ -668,7 +677,8 @@ reader_t *clone_reader(const reader_t *const reader_in) {
                                   &reader_in->init_params);
   reader->n_total_req = reader_in->n_total_req;
 
-  if (reader->trace_format != TXT_TRACE_FORMAT) {
+  if (reader->trace_format != TXT_TRACE_FORMAT &&
+      reader->mapped_file != NULL) {
     munmap(reader->mapped_file, reader->file_size);
     reader->mapped_file = reader_in->mapped_file;
   }
@@ -726,6 +736,10 @@ int close_reader(reader_t *const reader) {
     free(reader->sampler);
   }
 
+  if (reader->manifest != NULL) {
+    free(reader->manifest);
+  }
+
   free(reader->trace_path);
   free(reader);
 
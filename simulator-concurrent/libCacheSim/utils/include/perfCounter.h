@@ -0,0 +1,97 @@
+//
+//  perfCounter.h
+//  libCacheSim
+//
+//  hardware and software event counters of the calling thread through
+//  perf_event_open(2), used to explain the throughput of a simulation
+//  by cache misses, branch misses and context switches
+//
+
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  PERF_CYCLES = 0,
+  PERF_INSTRUCTIONS,
+  PERF_LLC_MISSES,
+  PERF_DTLB_MISSES,
+  PERF_BRANCH_MISSES,
+  PERF_CONTEXT_SWITCHES,
+
+  N_PERF_COUNTER
+} perf_counter_e;
+
+extern const char *perf_counter_names[N_PERF_COUNTER];
+
+typedef struct {
+  /* the file descriptor of each event, -1 if it cannot be opened,
+   * e.g., hardware events in a VM or perf_event_paranoid too high */
+  int fds[N_PERF_COUNTER];
+  /* the first opened event, all events are enabled and read as one group */
+  int leader_fd;
+  int n_open;
+  bool valid[N_PERF_COUNTER];
+  /* the counts of the last measured region, scaled up if the kernel
+   * multiplexed the group with other events */
+  uint64_t values[N_PERF_COUNTER];
+} perf_counter_t;
+
+/**
+ * @brief open the counters of the calling thread, the events that are not
+ * supported are skipped with a warning
+ *
+ * @param pc
+ * @return the number of events opened, 0 if none is available
+ */
+int perf_counter_open(perf_counter_t *pc);
+
+/**
+ * @brief reset and start counting
+ */
+void perf_counter_start(perf_counter_t *pc);
+
+/**
+ * @brief stop counting and read the counts into pc->values
+ */
+void perf_counter_stop(perf_counter_t *pc);
+
+void perf_counter_close(perf_counter_t *pc);
+
+/**
+ * @brief add the counts of pc to sum, an event is valid in the sum only if
+ * it is valid in every added counter
+ *
+ * @param sum initialized with perf_counter_sum_init
+ * @param pc
+ */
+void perf_counter_sum(perf_counter_t *sum, const perf_counter_t *pc);
+
+void perf_counter_sum_init(perf_counter_t *sum);
+
+/**
+ * @brief format the counts per request, e.g.,
+ * "cycles/req 512.3000, instructions/req 801.2000, ..., IPC 1.56",
+ * context switches are the total count
+ *
+ * @param buf
+ * @param len
+ * @param pc
+ * @param n_req
+ * @return the number of characters written
+ */
+int perf_counter_snprint(char *buf, size_t len, const perf_counter_t *pc,
+                         uint64_t n_req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERF_COUNTER_H */
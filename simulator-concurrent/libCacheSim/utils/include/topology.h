@@ -0,0 +1,101 @@
+//
+//  topology.h
+//  libCacheSim
+//
+//  the CPUs, physical cores and NUMA nodes that the process may run on,
+//  read from sysfs, and the placement of the worker threads on them, so
+//  scalability runs use the same cores on the same hosts without taskset
+//
+
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  /* thread i on the i-th allowed CPU */
+  PLACEMENT_LINEAR = 0,
+  /* fill the hardware threads of a core, then the cores of a node */
+  PLACEMENT_COMPACT,
+  /* spread the threads over the nodes, then the cores, siblings last */
+  PLACEMENT_SCATTER,
+  /* one hardware thread per physical core, siblings only when the threads
+   * outnumber the cores */
+  PLACEMENT_PHYSICAL_CORE,
+  /* bind each thread to all CPUs of a node, the nodes are filled in turn */
+  PLACEMENT_NODE_LOCAL,
+  /* do not bind the threads */
+  PLACEMENT_NONE,
+
+  N_PLACEMENT_POLICY
+} placement_policy_e;
+
+extern const char *placement_policy_names[N_PLACEMENT_POLICY];
+
+typedef struct {
+  int cpu;
+  int node;
+  int package;
+  int core;
+  /* the index of the CPU among the hardware threads of its core */
+  int smt;
+} cpu_info_t;
+
+typedef struct {
+  /* the CPUs in the affinity mask of the process, sorted by id */
+  cpu_info_t *cpus;
+  int n_cpu;
+  int n_node;
+} cpu_topology_t;
+
+typedef struct {
+  /* -1 if the thread may run on any CPU of the node */
+  int cpu;
+  /* -1 if the thread is not bound */
+  int node;
+} thread_placement_t;
+
+/**
+ * @brief read the topology of the CPUs the calling thread may run on,
+ * call it before binding any thread, CPUs without sysfs topology are
+ * treated as separate cores on node 0
+ */
+cpu_topology_t *topology_load(void);
+
+void topology_free(cpu_topology_t *topo);
+
+/**
+ * @brief parse the name of a placement policy
+ *
+ * @return false if the name is unknown
+ */
+bool parse_placement_policy(const char *name, placement_policy_e *policy);
+
+/**
+ * @brief compute where each of the n_thread threads runs, threads wrap
+ * around when they outnumber the CPUs
+ *
+ * @param placements n_thread entries
+ */
+void topology_place_threads(const cpu_topology_t *topo,
+                            placement_policy_e policy, int n_thread,
+                            thread_placement_t *placements);
+
+/**
+ * @brief bind the calling thread to its placement, the memory it touches
+ * first is then allocated on its node
+ *
+ * @return 0 on success
+ */
+int topology_bind_thread(const cpu_topology_t *topo,
+                         const thread_placement_t *placement);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPOLOGY_H */
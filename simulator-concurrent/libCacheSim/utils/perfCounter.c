@@ -0,0 +1,211 @@
+//
+//  perfCounter.c
+//  libCacheSim
+//
+//  the events of one thread are opened as a group, so they are enabled,
+//  disabled and multiplexed together, and the ratios between them (e.g.,
+//  IPC) are computed over the same instructions
+//
+
+#define _GNU_SOURCE
+
+#include "include/perfCounter.h"
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "../include/libCacheSim/logging.h"
+
+const char *perf_counter_names[N_PERF_COUNTER] = {
+    "cycles",      "instructions",  "llc_misses",
+    "dtlb_misses", "branch_misses", "context_switches"};
+
+#ifdef __linux__
+static const struct {
+  uint32_t type;
+  uint64_t config;
+} perf_events[N_PERF_COUNTER] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+};
+
+static int open_event(perf_counter_e event, int group_fd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = perf_events[event].type;
+  attr.config = perf_events[event].config;
+  attr.disabled = group_fd == -1 ? 1 : 0;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  /* pid 0 and cpu -1: the calling thread on any CPU */
+  int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd,
+                        PERF_FLAG_FD_CLOEXEC);
+  if (fd < 0 && (errno == EACCES || errno == EPERM)) {
+    /* perf_event_paranoid >= 2 only allows counting the user space */
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd,
+                      PERF_FLAG_FD_CLOEXEC);
+  }
+  return fd;
+}
+
+/* set with atomic exchange, the worker threads open their counters at the
+ * same time */
+static bool warned[N_PERF_COUNTER];
+#endif
+
+int perf_counter_open(perf_counter_t *pc) {
+  memset(pc, 0, sizeof(perf_counter_t));
+  pc->leader_fd = -1;
+  for (int i = 0; i < N_PERF_COUNTER; i++) pc->fds[i] = -1;
+
+#ifdef __linux__
+  for (int i = 0; i < N_PERF_COUNTER; i++) {
+    pc->fds[i] = open_event((perf_counter_e)i, pc->leader_fd);
+    if (pc->fds[i] < 0) {
+      /* every thread opens its own counters, only warn once per event */
+      if (!__atomic_exchange_n(&warned[i], true, __ATOMIC_RELAXED)) {
+        WARN("cannot open perf event %s: %s\n", perf_counter_names[i],
+             strerror(errno));
+      }
+      continue;
+    }
+    if (pc->leader_fd == -1) pc->leader_fd = pc->fds[i];
+    pc->n_open += 1;
+  }
+#else
+  WARN("perf counters are only supported on Linux\n");
+#endif
+
+  return pc->n_open;
+}
+
+void perf_counter_start(perf_counter_t *pc) {
+  memset(pc->values, 0, sizeof(pc->values));
+  memset(pc->valid, 0, sizeof(pc->valid));
+  if (pc->leader_fd == -1) return;
+
+#ifdef __linux__
+  ioctl(pc->leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(pc->leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void perf_counter_stop(perf_counter_t *pc) {
+  if (pc->leader_fd == -1) return;
+
+#ifdef __linux__
+  ioctl(pc->leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+  /* nr, time_enabled, time_running, then one value per event in the
+   * order they joined the group */
+  uint64_t buf[3 + N_PERF_COUNTER];
+  ssize_t n_byte = read(pc->leader_fd, buf, sizeof(buf));
+  if (n_byte < (ssize_t)(3 * sizeof(uint64_t)) ||
+      buf[0] != (uint64_t)pc->n_open) {
+    WARN("cannot read perf counters: %s\n", strerror(errno));
+    return;
+  }
+
+  uint64_t time_enabled = buf[1], time_running = buf[2];
+  if (time_running == 0) {
+    WARN("perf counters were never scheduled\n");
+    return;
+  }
+
+  double scale = (double)time_enabled / (double)time_running;
+  int pos = 0;
+  for (int i = 0; i < N_PERF_COUNTER; i++) {
+    if (pc->fds[i] < 0) continue;
+    pc->values[i] = (uint64_t)((double)buf[3 + pos] * scale);
+    pc->valid[i] = true;
+    pos += 1;
+  }
+#endif
+}
+
+void perf_counter_close(perf_counter_t *pc) {
+  /* close the members before the leader */
+  for (int i = N_PERF_COUNTER - 1; i >= 0; i--) {
+    if (pc->fds[i] >= 0) close(pc->fds[i]);
+    pc->fds[i] = -1;
+  }
+  pc->leader_fd = -1;
+  pc->n_open = 0;
+}
+
+void perf_counter_sum_init(perf_counter_t *sum) {
+  memset(sum, 0, sizeof(perf_counter_t));
+  sum->leader_fd = -1;
+  for (int i = 0; i < N_PERF_COUNTER; i++) {
+    sum->fds[i] = -1;
+    sum->valid[i] = true;
+  }
+}
+
+void perf_counter_sum(perf_counter_t *sum, const perf_counter_t *pc) {
+  for (int i = 0; i < N_PERF_COUNTER; i++) {
+    sum->values[i] += pc->values[i];
+    sum->valid[i] = sum->valid[i] && pc->valid[i];
+  }
+}
+
+/* append to buf at n, the returned length is clamped to the buffer, so that
+ * len - n never wraps around when the output is truncated */
+static int buf_append(char *buf, size_t len, int n, const char *fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  int ret = vsnprintf(buf + n, len - n, fmt, ap);
+  va_end(ap);
+
+  if (ret > 0) n += ret;
+  return n < (int)len ? n : (int)len - 1;
+}
+
+int perf_counter_snprint(char *buf, size_t len, const perf_counter_t *pc,
+                         uint64_t n_req) {
+  int n = 0;
+  buf[0] = '\0';
+  double n_req_d = n_req == 0 ? 1.0 : (double)n_req;
+
+  for (int i = 0; i < N_PERF_COUNTER && n < (int)len - 1; i++) {
+    if (!pc->valid[i]) continue;
+    if (i == PERF_CONTEXT_SWITCHES) {
+      /* too rare to be meaningful per request */
+      n = buf_append(buf, len, n, "%s%s %" PRIu64, n == 0 ? "" : ", ",
+                     perf_counter_names[i], pc->values[i]);
+    } else {
+      n = buf_append(buf, len, n, "%s%s/req %.4lf", n == 0 ? "" : ", ",
+                     perf_counter_names[i], (double)pc->values[i] / n_req_d);
+    }
+  }
+  if (pc->valid[PERF_CYCLES] && pc->valid[PERF_INSTRUCTIONS] &&
+      pc->values[PERF_CYCLES] > 0 && n < (int)len - 1) {
+    n = buf_append(buf, len, n, ", IPC %.2lf",
+                   (double)pc->values[PERF_INSTRUCTIONS] /
+                       (double)pc->values[PERF_CYCLES]);
+  }
+  if (n == 0) n = buf_append(buf, len, 0, "no perf counter available");
+
+  return n;
+}
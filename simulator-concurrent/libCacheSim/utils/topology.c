@@ -0,0 +1,212 @@
+//
+//  topology.c
+//  libCacheSim
+//
+//  each policy is an order of the allowed CPUs, thread i runs on the i-th
+//  CPU of the order, the order is a sort by a per-CPU key
+//
+
+#define _GNU_SOURCE
+
+#include "include/topology.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/libCacheSim/logging.h"
+
+#define SYSFS_CPU_DIR "/sys/devices/system/cpu"
+
+const char *placement_policy_names[N_PLACEMENT_POLICY] = {
+    "linear", "compact", "scatter", "physical-core", "node-local", "none"};
+
+static int read_sysfs_int(const char *path, int default_val) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL) return default_val;
+  int v;
+  if (fscanf(f, "%d", &v) != 1) v = default_val;
+  fclose(f);
+  return v;
+}
+
+/* the node of a CPU is the nodeN entry in its sysfs directory */
+static int read_cpu_node(int cpu) {
+  char path[128];
+  snprintf(path, sizeof(path), SYSFS_CPU_DIR "/cpu%d", cpu);
+  DIR *dir = opendir(path);
+  if (dir == NULL) return 0;
+
+  int node = 0;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL) {
+    if (strncmp(entry->d_name, "node", 4) == 0 &&
+        sscanf(entry->d_name + 4, "%d", &node) == 1) {
+      break;
+    }
+  }
+  closedir(dir);
+  return node;
+}
+
+cpu_topology_t *topology_load(void) {
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+    WARN("cannot get the affinity mask, assume one CPU\n");
+    CPU_SET(0, &mask);
+  }
+
+  cpu_topology_t *topo = calloc(1, sizeof(cpu_topology_t));
+  topo->cpus = malloc(sizeof(cpu_info_t) * CPU_COUNT(&mask));
+  char path[128];
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (!CPU_ISSET(cpu, &mask)) continue;
+    cpu_info_t *info = &topo->cpus[topo->n_cpu++];
+    info->cpu = cpu;
+    info->node = read_cpu_node(cpu);
+    snprintf(path, sizeof(path),
+             SYSFS_CPU_DIR "/cpu%d/topology/physical_package_id", cpu);
+    info->package = read_sysfs_int(path, 0);
+    snprintf(path, sizeof(path), SYSFS_CPU_DIR "/cpu%d/topology/core_id", cpu);
+    /* without sysfs every CPU is its own core */
+    info->core = read_sysfs_int(path, cpu);
+  }
+
+  for (int i = 0; i < topo->n_cpu; i++) {
+    cpu_info_t *info = &topo->cpus[i];
+    info->smt = 0;
+    bool new_node = true;
+    for (int j = 0; j < i; j++) {
+      if (topo->cpus[j].package == info->package &&
+          topo->cpus[j].core == info->core) {
+        info->smt += 1;
+      }
+      if (topo->cpus[j].node == info->node) new_node = false;
+    }
+    if (new_node) topo->n_node += 1;
+  }
+
+  return topo;
+}
+
+void topology_free(cpu_topology_t *topo) {
+  free(topo->cpus);
+  free(topo);
+}
+
+bool parse_placement_policy(const char *name, placement_policy_e *policy) {
+  for (int i = 0; i < N_PLACEMENT_POLICY; i++) {
+    if (strcasecmp(name, placement_policy_names[i]) == 0) {
+      *policy = (placement_policy_e)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+typedef struct {
+  int key[4];
+  int idx;
+} cpu_order_t;
+
+static inline void set_key(cpu_order_t *o, int k0, int k1, int k2, int k3) {
+  o->key[0] = k0;
+  o->key[1] = k1;
+  o->key[2] = k2;
+  o->key[3] = k3;
+}
+
+static int cmp_cpu_order(const void *p1, const void *p2) {
+  const cpu_order_t *a = p1, *b = p2;
+  for (int i = 0; i < 4; i++) {
+    if (a->key[i] != b->key[i]) return a->key[i] < b->key[i] ? -1 : 1;
+  }
+  return a->idx - b->idx;
+}
+
+/* the rank of the core of cpu i among the cores of its node */
+static int core_rank_in_node(const cpu_topology_t *topo, int i) {
+  const cpu_info_t *info = &topo->cpus[i];
+  int rank = 0;
+  for (int j = 0; j < topo->n_cpu; j++) {
+    const cpu_info_t *other = &topo->cpus[j];
+    if (other->node != info->node || other->smt != 0) continue;
+    if (other->package < info->package ||
+        (other->package == info->package && other->core < info->core)) {
+      rank += 1;
+    }
+  }
+  return rank;
+}
+
+void topology_place_threads(const cpu_topology_t *topo,
+                            placement_policy_e policy, int n_thread,
+                            thread_placement_t *placements) {
+  cpu_order_t *order = malloc(sizeof(cpu_order_t) * topo->n_cpu);
+  for (int i = 0; i < topo->n_cpu; i++) {
+    const cpu_info_t *info = &topo->cpus[i];
+    cpu_order_t *o = &order[i];
+    o->idx = i;
+    switch (policy) {
+      case PLACEMENT_COMPACT:
+      case PLACEMENT_NODE_LOCAL:
+        set_key(o, info->node, info->package, info->core, info->smt);
+        break;
+      case PLACEMENT_SCATTER:
+        set_key(o, info->smt, core_rank_in_node(topo, i), info->node, 0);
+        break;
+      case PLACEMENT_PHYSICAL_CORE:
+        set_key(o, info->smt, info->node, info->package, info->core);
+        break;
+      default:
+        /* the CPUs are sorted by id */
+        set_key(o, 0, 0, 0, 0);
+        break;
+    }
+  }
+  qsort(order, topo->n_cpu, sizeof(cpu_order_t), cmp_cpu_order);
+
+  for (int i = 0; i < n_thread; i++) {
+    const cpu_info_t *info = &topo->cpus[order[i % topo->n_cpu].idx];
+    if (policy == PLACEMENT_NONE) {
+      placements[i] = (thread_placement_t){-1, -1};
+    } else if (policy == PLACEMENT_NODE_LOCAL) {
+      placements[i] = (thread_placement_t){-1, info->node};
+    } else {
+      placements[i] = (thread_placement_t){info->cpu, info->node};
+    }
+  }
+  if (n_thread > topo->n_cpu && policy != PLACEMENT_NONE) {
+    WARN("%d threads share %d CPUs\n", n_thread, topo->n_cpu);
+  }
+
+  free(order);
+}
+
+int topology_bind_thread(const cpu_topology_t *topo,
+                         const thread_placement_t *placement) {
+  if (placement->node < 0) return 0;
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  if (placement->cpu >= 0) {
+    CPU_SET(placement->cpu, &cpuset);
+  } else {
+    for (int i = 0; i < topo->n_cpu; i++) {
+      if (topo->cpus[i].node == placement->node) {
+        CPU_SET(topo->cpus[i].cpu, &cpuset);
+      }
+    }
+  }
+
+  int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+  if (ret != 0) {
+    WARN("fail to bind thread to cpu %d node %d: %s\n", placement->cpu,
+         placement->node, strerror(ret));
+  }
+  return ret;
+}
@@ -40,14 +40,24 @@ def _load_reuse_data(datapath: str) -> Tuple[dict, dict]:
     data_line = ifile.readline()
     desc_line = ifile.readline()
     m = re.match(r"# reuse real time: freq \(time granularity (?P<tg>\d+)\)", desc_line)
-    assert m is not None, (
+    # traceAnalyzer --sketch-mem buckets the real time by log_base ** (rtime + 1)
+    m_log = re.match(
+        r"# reuse real time: freq \(log base (?P<lb>\d+\.?\d*) of reuse time \+ 1\)",
+        desc_line,
+    )
+    assert m is not None or m_log is not None, (
         "the input file might not be reuse data file, desc line "
         + desc_line
         + " data "
         + datapath
     )
 
-    rtime_granularity = int(m.group("tg"))
+    if m is not None:
+        rtime_granularity = int(m.group("tg"))
+        to_rtime = lambda pos: pos * rtime_granularity
+    else:
+        rtime_log_base = float(m_log.group("lb"))
+        to_rtime = lambda pos: pos if pos < 0 else rtime_log_base**pos - 1
     log_base = 1.5
 
     reuse_rtime_count, reuse_vtime_count = {}, {}
@@ -71,7 +81,7 @@ def _load_reuse_data(datapath: str) -> Tuple[dict, dict]:
             reuse_time, count = [int(i) for i in line.split(":")]
             if reuse_time < -1:
                 print("find negative reuse time " + line)
-            reuse_rtime_count[reuse_time * rtime_granularity] = count
+            reuse_rtime_count[to_rtime(reuse_time)] = count
 
     for line in ifile:
         if len(line.strip()) == 0:
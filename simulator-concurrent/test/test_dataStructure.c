@@ -0,0 +1,539 @@
+//
+// tests of the structures shared by the worker threads of a cache
+//
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "../libCacheSim/include/libCacheSim/promotionCombiner.h"
+#include "../libCacheSim/include/libCacheSim/segmentedQueue.h"
+#include "common.h"
+
+#define N_TEST_THREAD 4
+#define N_TEST_PROMOTION 20000
+/* the test policy holds the lock longer on every this many promotions */
+#define N_TEST_SLOW_PROMOTION 500
+#define N_TEST_SEG 8
+#define N_TEST_SEG_OP 20000
+#define N_TEST_OCC_OP 20000
+/* the bytes a thread may hold in its occupancy shard */
+#define TEST_OCC_SLACK 4096
+/* the objects in the cache before the threads start and their mean size */
+#define TEST_OCC_WARM_OBJ 1000
+#define TEST_OCC_WARM_OBJ_SIZE 1024
+
+typedef struct {
+  cache_t *cache;
+  void *shared;
+  int thread_id;
+} test_thread_arg_t;
+
+/* run func in n_thread threads, func attaches the thread to its counter
+ * block and returns the number of wrong results, which are summed */
+static uint64_t run_test_threads(cache_t *cache, void *shared, int n_thread,
+                                 void *(*func)(void *)) {
+  pthread_t threads[N_TEST_THREAD];
+  test_thread_arg_t args[N_TEST_THREAD];
+  g_assert_cmpint(n_thread, <=, N_TEST_THREAD);
+  for (int i = 0; i < n_thread; i++) {
+    args[i] = (test_thread_arg_t){
+        .cache = cache, .shared = shared, .thread_id = i};
+    g_assert_cmpint(pthread_create(&threads[i], NULL, func, &args[i]), ==, 0);
+  }
+  uint64_t n_wrong = 0;
+  for (int i = 0; i < n_thread; i++) {
+    void *ret;
+    pthread_join(threads[i], &ret);
+    n_wrong += (uint64_t)ret;
+  }
+  return n_wrong;
+}
+
+static cache_t *create_test_struct_cache(int n_thread) {
+  common_cache_params_t cc_params = {
+      .cache_size = CACHE_SIZE, .hashpower = 20, .num_thread = n_thread};
+  cache_t *cache = cache_struct_init("test", cc_params, NULL);
+  pthread_spin_init(&cache->lock, 0);
+  cache_init_thread_stat(cache, n_thread);
+  return cache;
+}
+
+/* the objects that the promotions return, indexed by obj_id */
+static cache_obj_t combiner_objs[N_TEST_THREAD * N_TEST_PROMOTION];
+static uint64_t combiner_n_applied;
+static uint64_t combiner_n_unlocked;
+
+/* the promotion of a test policy, a plain counter so that two promotions
+ * applied at the same time lose an update, the slow promotions let the
+ * other threads publish theirs while the lock is held */
+static cache_obj_t *combiner_test_apply(cache_t *cache, const request_t *req) {
+  if (pthread_spin_trylock(&cache->lock) != EBUSY) {
+    __atomic_fetch_add(&combiner_n_unlocked, 1, __ATOMIC_RELAXED);
+  }
+  combiner_n_applied += 1;
+  if (req->obj_id % N_TEST_SLOW_PROMOTION == 0) usleep(100);
+  if (req->obj_id >= N_TEST_THREAD * N_TEST_PROMOTION) return NULL;
+  return &combiner_objs[req->obj_id];
+}
+
+static void reset_combiner_test(void) {
+  combiner_n_applied = 0;
+  combiner_n_unlocked = 0;
+}
+
+static void *combiner_fallback_thread(void *arg) {
+  test_thread_arg_t *targ = arg;
+  promotion_combiner_t *combiner = targ->shared;
+  cache_attach_thread_stat(targ->cache, targ->thread_id);
+  request_t *req = new_request();
+  uint64_t n_wrong = 0;
+
+  req->obj_id = 1;
+  if (promotion_combiner_promote(combiner, targ->cache, req) !=
+      &combiner_objs[1]) {
+    n_wrong += 1;
+  }
+  /* an object that is not in the cache is not counted as a promotion */
+  req->obj_id = N_TEST_THREAD * N_TEST_PROMOTION;
+  if (promotion_combiner_promote(combiner, targ->cache, req) != NULL) {
+    n_wrong += 1;
+  }
+
+  free_request(req);
+  return (void *)n_wrong;
+}
+
+static void test_promotionCombiner_fallback(void) {
+  cache_t *cache = create_test_struct_cache(1);
+  reset_combiner_test();
+
+  /* without the number of threads every promotion takes the lock */
+  promotion_combiner_t *combiner =
+      promotion_combiner_create(0, combiner_test_apply);
+  g_assert_true(combiner->slots == NULL);
+  g_assert_cmpint(combiner->n_slot, ==, 0);
+  g_assert_cmpuint(
+      run_test_threads(cache, combiner, 1, combiner_fallback_thread), ==, 0);
+
+  g_assert_cmpuint(combiner_n_applied, ==, 2);
+  g_assert_cmpuint(combiner_n_unlocked, ==, 0);
+  g_assert_cmpuint(cache->thread_stats[0].n_lock, ==, 2);
+  g_assert_cmpuint(cache->thread_stats[0].n_promotion, ==, 1);
+  g_assert_cmpuint(cache->thread_stats[0].n_combined, ==, 0);
+  promotion_combiner_free(combiner);
+
+  /* a thread that is not attached to the cache has no slot */
+  combiner = promotion_combiner_create(1, combiner_test_apply);
+  request_t *req = new_request();
+  req->obj_id = 2;
+  g_assert_true(promotion_combiner_promote(combiner, cache, req) ==
+                &combiner_objs[2]);
+  g_assert_cmpint(combiner->slots[0].state, ==, COMBINER_SLOT_EMPTY);
+  g_assert_cmpuint(combiner_n_applied, ==, 3);
+  free_request(req);
+
+  promotion_combiner_free(combiner);
+  cache_struct_free(cache);
+}
+
+static void *combiner_promote_thread(void *arg) {
+  test_thread_arg_t *targ = arg;
+  promotion_combiner_t *combiner = targ->shared;
+  cache_attach_thread_stat(targ->cache, targ->thread_id);
+  request_t *req = new_request();
+  uint64_t n_wrong = 0;
+
+  for (uint64_t i = 0; i < N_TEST_PROMOTION; i++) {
+    req->obj_id = targ->thread_id * N_TEST_PROMOTION + i;
+    if (promotion_combiner_promote(combiner, targ->cache, req) !=
+        &combiner_objs[req->obj_id]) {
+      n_wrong += 1;
+    }
+  }
+
+  free_request(req);
+  return (void *)n_wrong;
+}
+
+static void test_promotionCombiner_threads(void) {
+  cache_t *cache = create_test_struct_cache(N_TEST_THREAD);
+  promotion_combiner_t *combiner =
+      promotion_combiner_create(N_TEST_THREAD, combiner_test_apply);
+  reset_combiner_test();
+
+  g_assert_cmpuint(run_test_threads(cache, combiner, N_TEST_THREAD,
+                                    combiner_promote_thread),
+                   ==, 0);
+
+  /* every promotion is applied once, under the lock, and returns the object
+   * of its own request */
+  g_assert_cmpuint(combiner_n_applied, ==, N_TEST_THREAD * N_TEST_PROMOTION);
+  g_assert_cmpuint(combiner_n_unlocked, ==, 0);
+  uint64_t n_combined = 0;
+  for (int i = 0; i < N_TEST_THREAD; i++) {
+    g_assert_cmpuint(cache->thread_stats[i].n_promotion, ==,
+                     N_TEST_PROMOTION);
+    g_assert_cmpint(combiner->slots[i].state, ==, COMBINER_SLOT_EMPTY);
+    n_combined += cache->thread_stats[i].n_combined;
+  }
+  g_assert_cmpuint(n_combined, >, 0);
+  g_assert_cmpuint(n_combined, <, N_TEST_THREAD * N_TEST_PROMOTION);
+
+  promotion_combiner_free(combiner);
+  cache_struct_free(cache);
+}
+
+typedef struct {
+  pthread_barrier_t barrier;
+  int64_t n_obj;
+  int64_t n_byte;
+} occupancy_test_t;
+
+static int64_t occupancy_test_obj_size(uint64_t i) { return 64 * (1 + i % 8); }
+
+/* the objects and bytes left in the cache after every thread runs
+ * occupancy_thread */
+static void occupancy_test_expected(occupancy_test_t *test, int n_thread) {
+  test->n_obj = 0;
+  test->n_byte = 0;
+  for (uint64_t i = 0; i < N_TEST_OCC_OP; i++) {
+    test->n_obj += 1;
+    test->n_byte += occupancy_test_obj_size(i);
+    if (i % 3 == 2) {
+      test->n_obj -= 1;
+      test->n_byte -= occupancy_test_obj_size(i - 1);
+    }
+  }
+  test->n_obj *= n_thread;
+  test->n_byte *= n_thread;
+}
+
+/* insert objects of different sizes and remove every third one, the changes
+ * that are not folded must stay below the slack, once every thread is done
+ * the view of each thread may only miss the shards of the other threads */
+static void *occupancy_thread(void *arg) {
+  test_thread_arg_t *targ = arg;
+  occupancy_test_t *test = targ->shared;
+  cache_t *cache = targ->cache;
+  cache_attach_thread_stat(cache, targ->thread_id);
+  request_t *req = new_request();
+  uint64_t n_wrong = 0;
+
+  cache_obj_t *prev_obj = NULL;
+  for (uint64_t i = 0; i < N_TEST_OCC_OP; i++) {
+    req->obj_id = targ->thread_id * N_TEST_OCC_OP + i + 1;
+    req->obj_size = occupancy_test_obj_size(i);
+    cache_obj_t *obj = cache_insert_base(cache, req);
+    if (i % 3 == 2) cache_remove_obj_base(cache, prev_obj, true);
+    prev_obj = obj;
+
+    if (llabs(curr_occupancy_shard->occupied_byte) >= cache->occupancy_slack ||
+        llabs(curr_occupancy_shard->n_obj) >= cache->occupancy_slack_obj) {
+      n_wrong += 1;
+    }
+  }
+
+  pthread_barrier_wait(&test->barrier);
+  int64_t max_diff = cache->occupancy_slack * (cache->n_thread_stats - 1);
+  int64_t max_diff_obj =
+      cache->occupancy_slack_obj * (cache->n_thread_stats - 1);
+  if (llabs(cache->get_occupied_byte(cache) - test->n_byte) > max_diff ||
+      llabs(cache->get_n_obj(cache) - test->n_obj) > max_diff_obj) {
+    n_wrong += 1;
+  }
+  /* no thread folds its shard before every thread has read its view */
+  pthread_barrier_wait(&test->barrier);
+
+  cache_flush_occupancy_shard(cache);
+  if (curr_occupancy_shard->occupied_byte != 0 ||
+      curr_occupancy_shard->n_obj != 0) {
+    n_wrong += 1;
+  }
+
+  free_request(req);
+  return (void *)n_wrong;
+}
+
+static void test_occupancyShard_threads(void) {
+  cache_t *cache = create_test_struct_cache(N_TEST_THREAD);
+  /* a warm cache, the object slack follows its mean object size */
+  cache->n_obj = TEST_OCC_WARM_OBJ;
+  cache->occupied_byte = TEST_OCC_WARM_OBJ * TEST_OCC_WARM_OBJ_SIZE;
+  cache_init_occupancy_shard(cache, N_TEST_THREAD,
+                             TEST_OCC_SLACK * N_TEST_THREAD);
+  g_assert_true(cache->occupancy_shards != NULL);
+  g_assert_cmpint(cache->occupancy_slack, ==, TEST_OCC_SLACK);
+  g_assert_cmpint(cache->occupancy_slack_obj, ==,
+                  TEST_OCC_SLACK / TEST_OCC_WARM_OBJ_SIZE);
+
+  occupancy_test_t test;
+  occupancy_test_expected(&test, N_TEST_THREAD);
+  test.n_obj += TEST_OCC_WARM_OBJ;
+  test.n_byte += TEST_OCC_WARM_OBJ * TEST_OCC_WARM_OBJ_SIZE;
+  pthread_barrier_init(&test.barrier, NULL, N_TEST_THREAD);
+  g_assert_cmpuint(
+      run_test_threads(cache, &test, N_TEST_THREAD, occupancy_thread), ==, 0);
+  pthread_barrier_destroy(&test.barrier);
+
+  /* after every shard is folded the shared counters are exact */
+  g_assert_cmpint(cache->n_obj, ==, test.n_obj);
+  g_assert_cmpint(cache->occupied_byte, ==, test.n_byte);
+
+  cache_struct_free(cache);
+}
+
+static void test_occupancyShard_clamp(void) {
+  cache_t *cache = create_test_struct_cache(N_TEST_THREAD);
+
+  /* a slack larger than the cache is cut to a fraction of it */
+  cache_init_occupancy_shard(cache, N_TEST_THREAD, CACHE_SIZE * 2);
+  g_assert_true(cache->occupancy_shards != NULL);
+  g_assert_cmpint(cache->occupancy_slack, ==,
+                  CACHE_SIZE / OCCUPANCY_SLACK_MAX_FRACTION / N_TEST_THREAD);
+  /* an empty cache bounds the objects by one byte each */
+  g_assert_cmpint(cache->occupancy_slack_obj, ==, cache->occupancy_slack);
+
+  /* without slack every change goes to the shared counters */
+  cache_init_occupancy_shard(cache, N_TEST_THREAD, 0);
+  g_assert_true(cache->occupancy_shards == NULL);
+
+  cache_struct_free(cache);
+}
+
+static cache_obj_t *new_test_objs(uint64_t n) {
+  cache_obj_t *objs = g_new0(cache_obj_t, n);
+  for (uint64_t i = 0; i < n; i++) {
+    objs[i].obj_id = i;
+  }
+  return objs;
+}
+
+/* the objects of the segment from the head, the links agree in both
+ * directions and the count is the length of the list */
+static uint64_t verify_segment(const queue_segment_t *seg, cache_obj_t **out) {
+  uint64_t n = 0;
+  cache_obj_t *prev = NULL;
+  for (cache_obj_t *obj = seg->q_head; obj != NULL; obj = obj->queue.next) {
+    g_assert_true(obj->queue.prev == prev);
+    if (out != NULL) out[n] = obj;
+    prev = obj;
+    n += 1;
+  }
+  g_assert_true(seg->q_tail == prev);
+  g_assert_cmpint(seg->n_obj, ==, n);
+  return n;
+}
+
+static void test_segmentedQueue_warmup_pop(void) {
+  cache_t *cache = create_test_struct_cache(1);
+  segmented_queue_t *sq = segmented_queue_create(4);
+  cache_obj_t *objs = new_test_objs(16);
+
+  /* warmup inserts rotate over the segments */
+  for (int i = 0; i < 16; i++) {
+    segmented_queue_insert(sq, cache, &objs[i]);
+  }
+  for (int s = 0; s < 4; s++) {
+    g_assert_cmpuint(verify_segment(&sq->segs[s], NULL), ==, 4);
+    g_assert_true(sq->segs[s].q_head == &objs[12 + s]);
+    g_assert_true(sq->segs[s].q_tail == &objs[s]);
+  }
+
+  /* the hand stays in its segment */
+  int seg_id = 2;
+  g_assert_true(segmented_queue_pop(sq, cache, &seg_id) == &objs[2]);
+  g_assert_cmpint(seg_id, ==, 2);
+  g_assert_cmpint(sq->segs[2].n_obj, ==, 3);
+  segmented_queue_reinsert(sq, seg_id, &objs[2]);
+  g_assert_true(sq->segs[2].q_head == &objs[2]);
+  g_assert_cmpuint(verify_segment(&sq->segs[2], NULL), ==, 4);
+
+  g_assert_true(segmented_queue_pop(sq, cache, &seg_id) == &objs[6]);
+  g_assert_true(segmented_queue_pop(sq, cache, &seg_id) == &objs[10]);
+  g_assert_true(segmented_queue_pop(sq, cache, &seg_id) == &objs[14]);
+  g_assert_cmpint(seg_id, ==, 2);
+
+  /* the last object of a segment is not popped */
+  cache_obj_t *obj = segmented_queue_pop(sq, cache, &seg_id);
+  g_assert_cmpint(seg_id, !=, 2);
+  g_assert_true(obj == &objs[seg_id]);
+  g_assert_cmpuint(verify_segment(&sq->segs[2], NULL), ==, 1);
+  g_assert_true(sq->segs[2].q_head == &objs[2]);
+  g_assert_cmpuint(verify_segment(&sq->segs[seg_id], NULL), ==, 3);
+
+  g_assert_cmpint(segmented_queue_largest(sq)->n_obj, ==, 4);
+
+  segmented_queue_free(sq);
+  cache_struct_free(cache);
+  g_free(objs);
+}
+
+static void test_segmentedQueue_pop_larger(void) {
+  cache_t *cache = create_test_struct_cache(1);
+  segmented_queue_t *sq = segmented_queue_create(2);
+  cache_obj_t *objs = new_test_objs(5);
+
+  for (int i = 0; i < 5; i++) {
+    segmented_queue_insert(sq, cache, &objs[i]);
+  }
+  g_assert_true(segmented_queue_largest(sq) == &sq->segs[0]);
+
+  /* segment 0 has three objects, segment 1 has two */
+  int seg_id = -1;
+  g_assert_true(segmented_queue_pop(sq, cache, &seg_id) == &objs[0]);
+  g_assert_cmpint(seg_id, ==, 0);
+  g_assert_cmpuint(verify_segment(&sq->segs[0], NULL), ==, 2);
+  g_assert_cmpuint(verify_segment(&sq->segs[1], NULL), ==, 2);
+
+  segmented_queue_free(sq);
+  cache_struct_free(cache);
+  g_free(objs);
+}
+
+static void test_segmentedQueue_remove(void) {
+  cache_t *cache = create_test_struct_cache(1);
+  segmented_queue_t *sq = segmented_queue_create(2);
+  cache_obj_t *objs = new_test_objs(8);
+  cache_obj_t *list[8];
+
+  for (int i = 0; i < 8; i++) {
+    segmented_queue_insert(sq, cache, &objs[i]);
+  }
+
+  /* from the middle, the head and the tail */
+  segmented_queue_remove(sq, &objs[2]);
+  segmented_queue_remove(sq, &objs[7]);
+  segmented_queue_remove(sq, &objs[0]);
+
+  g_assert_cmpuint(verify_segment(&sq->segs[0], list), ==, 2);
+  g_assert_true(list[0] == &objs[6]);
+  g_assert_true(list[1] == &objs[4]);
+  g_assert_cmpuint(verify_segment(&sq->segs[1], list), ==, 3);
+  g_assert_true(list[0] == &objs[5]);
+  g_assert_true(list[1] == &objs[3]);
+  g_assert_true(list[2] == &objs[1]);
+
+  segmented_queue_free(sq);
+  cache_struct_free(cache);
+  g_free(objs);
+}
+
+static void test_segmentedQueue_insert_after_warmup(void) {
+  cache_t *cache = create_test_struct_cache(1);
+  segmented_queue_t *sq = segmented_queue_create(4);
+  cache_obj_t *objs = new_test_objs(46);
+
+  for (int i = 0; i < 6; i++) {
+    segmented_queue_insert(sq, cache, &objs[i]);
+  }
+  segmented_queue_remove(sq, &objs[3]);
+  g_assert_cmpuint(verify_segment(&sq->segs[3], NULL), ==, 0);
+
+  /* the inserts rotate over the segments that are not empty */
+  cache->warmup_complete = true;
+  for (int i = 6; i < 46; i++) {
+    segmented_queue_insert(sq, cache, &objs[i]);
+  }
+  uint64_t n_obj = 0;
+  for (int s = 0; s < 3; s++) {
+    uint64_t n = verify_segment(&sq->segs[s], NULL);
+    g_assert_cmpuint(n, >, 2);
+    n_obj += n;
+  }
+  g_assert_cmpuint(n_obj, ==, 45);
+  g_assert_cmpuint(verify_segment(&sq->segs[3], NULL), ==, 0);
+
+  segmented_queue_free(sq);
+  cache_struct_free(cache);
+  g_free(objs);
+}
+
+typedef struct {
+  segmented_queue_t *sq;
+  cache_obj_t *objs;
+  /* the number of times each object is popped and not reinserted */
+  uint64_t *n_evicted;
+} segmented_queue_test_t;
+
+/* insert a new object, pop an object and reinsert it as a hand does, then
+ * pop another one and keep it out of the queue */
+static void *segmented_queue_thread(void *arg) {
+  test_thread_arg_t *targ = arg;
+  segmented_queue_test_t *test = targ->shared;
+  cache_attach_thread_stat(targ->cache, targ->thread_id);
+  cache_obj_t *objs =
+      &test->objs[N_TEST_SEG * 4 + targ->thread_id * N_TEST_SEG_OP];
+
+  for (int i = 0; i < N_TEST_SEG_OP; i++) {
+    segmented_queue_insert(test->sq, targ->cache, &objs[i]);
+    int seg_id = -1;
+    cache_obj_t *obj = segmented_queue_pop(test->sq, targ->cache, &seg_id);
+    segmented_queue_reinsert(test->sq, seg_id, obj);
+    obj = segmented_queue_pop(test->sq, targ->cache, &seg_id);
+    __atomic_fetch_add(&test->n_evicted[obj->obj_id], 1, __ATOMIC_RELAXED);
+  }
+  return NULL;
+}
+
+static void test_segmentedQueue_threads(void) {
+  uint64_t n_total = N_TEST_SEG * 4 + N_TEST_THREAD * N_TEST_SEG_OP;
+  cache_t *cache = create_test_struct_cache(N_TEST_THREAD);
+  segmented_queue_test_t test = {.sq = segmented_queue_create(N_TEST_SEG),
+                                 .objs = new_test_objs(n_total),
+                                 .n_evicted = g_new0(uint64_t, n_total)};
+
+  for (int i = 0; i < N_TEST_SEG * 4; i++) {
+    segmented_queue_insert(test.sq, cache, &test.objs[i]);
+  }
+  cache->warmup_complete = true;
+  g_assert_cmpuint(
+      run_test_threads(cache, &test, N_TEST_THREAD, segmented_queue_thread),
+      ==, 0);
+
+  /* every object is either in one segment or evicted once */
+  uint64_t n_queued = 0;
+  for (int s = 0; s < N_TEST_SEG; s++) {
+    queue_segment_t *seg = &test.sq->segs[s];
+    n_queued += verify_segment(seg, NULL);
+    for (cache_obj_t *obj = seg->q_head; obj != NULL; obj = obj->queue.next) {
+      test.n_evicted[obj->obj_id] += 1;
+    }
+  }
+  g_assert_cmpuint(n_queued, ==, N_TEST_SEG * 4);
+  for (uint64_t i = 0; i < n_total; i++) {
+    g_assert_cmpuint(test.n_evicted[i], ==, 1);
+  }
+
+  segmented_queue_free(test.sq);
+  cache_struct_free(cache);
+  g_free(test.objs);
+  g_free(test.n_evicted);
+}
+
+int main(int argc, char *argv[]) {
+  g_test_init(&argc, &argv, NULL);
+
+  g_test_add_func("/libCacheSim/occupancyShard_threads",
+                  test_occupancyShard_threads);
+  g_test_add_func("/libCacheSim/occupancyShard_clamp",
+                  test_occupancyShard_clamp);
+
+  g_test_add_func("/libCacheSim/promotionCombiner_fallback",
+                  test_promotionCombiner_fallback);
+  g_test_add_func("/libCacheSim/promotionCombiner_threads",
+                  test_promotionCombiner_threads);
+
+  g_test_add_func("/libCacheSim/segmentedQueue_warmup_pop",
+                  test_segmentedQueue_warmup_pop);
+  g_test_add_func("/libCacheSim/segmentedQueue_pop_larger",
+                  test_segmentedQueue_pop_larger);
+  g_test_add_func("/libCacheSim/segmentedQueue_remove",
+                  test_segmentedQueue_remove);
+  g_test_add_func("/libCacheSim/segmentedQueue_insert_after_warmup",
+                  test_segmentedQueue_insert_after_warmup);
+  g_test_add_func("/libCacheSim/segmentedQueue_threads",
+                  test_segmentedQueue_threads);
+
+  return g_test_run();
+}
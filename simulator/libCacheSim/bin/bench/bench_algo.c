@@ -0,0 +1,220 @@
+//
+// the cost of cache->get of each eviction algorithm,
+// hit: requests to objects that were requested twice and fill half of the
+// cache, so every request should hit (see the miss_ratio column)
+// miss: every request is a new object, so each get inserts and evicts
+// zipf: a synthetic Zipf stream over twice the cache size
+// trace: the first n_op requests of a recorded trace
+//
+// object sizes are ignored so that the cache size is the number of objects,
+// the hit, miss and zipf streams are warmed up and then timed separately,
+// the zipf and trace streams are replayed once to warm up the cache
+//
+
+#define _GNU_SOURCE
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/libCacheSim/logging.h"
+#include "../cachesim/cache_init.h"
+#include "../cli_reader_utils.h"
+#include "internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+obj_id_t *gen_zipf_ids(double alpha, int64_t n_obj, int64_t n) {
+  double *cdf = malloc(sizeof(double) * n_obj);
+  obj_id_t *ids = malloc(sizeof(obj_id_t) * n);
+  if (cdf == NULL || ids == NULL) {
+    ERROR("cannot allocate the Zipf stream of %ld requests\n", (long)n);
+  }
+
+  double sum = 0;
+  for (int64_t i = 0; i < n_obj; i++) {
+    sum += 1.0 / pow((double)(i + 1), alpha);
+    cdf[i] = sum;
+  }
+
+  for (int64_t i = 0; i < n; i++) {
+    double r = (double)(next_rand() >> 11) / (double)(1ULL << 53) * sum;
+    int64_t lo = 0, hi = n_obj - 1;
+    while (lo < hi) {
+      int64_t mid = (lo + hi) / 2;
+      if (cdf[mid] < r) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    ids[i] = lo + 1;
+  }
+
+  free(cdf);
+  return ids;
+}
+
+/**
+ * @brief load the first n requests of a trace, the timestamps are kept
+ * relative to the first request
+ */
+static void load_trace_stream(const struct arguments *args,
+                              bench_stream_t *stream) {
+  reader_t *reader =
+      create_reader(args->trace_type_str, args->trace_path,
+                    args->trace_type_params, args->n_op, true, 0);
+  stream->name = "trace";
+  stream->obj_ids = malloc(sizeof(obj_id_t) * args->n_op);
+  stream->clock_times = malloc(sizeof(int64_t) * args->n_op);
+  stream->n_req = 0;
+
+  request_t *req = new_request();
+  int64_t start_time = -1;
+  while (stream->n_req < args->n_op && read_one_req(reader, req) == 0) {
+    if (start_time == -1) start_time = req->clock_time;
+    stream->obj_ids[stream->n_req] = req->obj_id;
+    stream->clock_times[stream->n_req] = req->clock_time - start_time;
+    stream->n_req += 1;
+  }
+  free_request(req);
+  close_reader(reader);
+
+  if (stream->n_req == 0) {
+    ERROR("trace %s has no request\n", args->trace_path);
+  }
+  INFO("loaded %ld requests from %s\n", (long)stream->n_req,
+       args->trace_path);
+}
+
+static void free_stream(bench_stream_t *stream) {
+  free(stream->obj_ids);
+  free(stream->clock_times);
+  memset(stream, 0, sizeof(bench_stream_t));
+}
+
+/**
+ * @brief serve the stream, synthetic streams advance the clock by one
+ * per request, recorded streams use their own timestamps after *clock
+ *
+ * @return the number of misses
+ */
+static int64_t replay(cache_t *cache, request_t *req,
+                      const bench_stream_t *stream, int64_t *clock) {
+  int64_t n_miss = 0, base = *clock;
+  for (int64_t i = 0; i < stream->n_req; i++) {
+    req->obj_id = stream->obj_ids[i];
+    req->hv = 0;
+    req->clock_time = stream->clock_times == NULL
+                          ? base + i
+                          : base + stream->clock_times[i];
+    if (!cache->get(cache, req)) n_miss++;
+  }
+  *clock = req->clock_time + 1;
+  return n_miss;
+}
+
+/* serve ids [first, first + n) once */
+static void fill(cache_t *cache, request_t *req, obj_id_t first, int64_t n,
+                 int64_t *clock) {
+  for (int64_t i = 0; i < n; i++) {
+    req->obj_id = first + i;
+    req->hv = 0;
+    req->clock_time = (*clock)++;
+    cache->get(cache, req);
+  }
+}
+
+/**
+ * @brief create a fresh cache, warm it up for the workload and time the
+ * measured stream
+ *
+ * @return the time of the measured stream in nanoseconds
+ */
+static uint64_t run_algo(const char *algo, int64_t cache_size, uint64_t seed,
+                         const bench_stream_t *stream, double *miss_ratio) {
+  /* the runs of randomized algorithms make the same decisions */
+  set_rand_seed(seed);
+  cache_t *cache = create_cache(NULL, algo, cache_size, NULL, false);
+  request_t *req = new_request();
+  int64_t clock = 0;
+
+  if (strcmp(stream->name, "hit") == 0) {
+    /* twice, so that algorithms with a probationary queue (e.g., S3FIFO)
+     * move the objects to the main queue */
+    fill(cache, req, 1, cache_size / 2, &clock);
+    fill(cache, req, 1, cache_size / 2, &clock);
+  } else if (strcmp(stream->name, "miss") == 0) {
+    /* ids above the measured ones, at least as many as the measured
+     * requests, so that the hash table pages are faulted in before timing */
+    fill(cache, req, cache_size + stream->n_req + 1,
+         MAX(cache_size, stream->n_req), &clock);
+  } else {
+    replay(cache, req, stream, &clock);
+  }
+
+  uint64_t start = bench_now_ns();
+  int64_t n_miss = replay(cache, req, stream, &clock);
+  uint64_t ns = bench_now_ns() - start;
+
+  *miss_ratio = (double)n_miss / (double)stream->n_req;
+  free_request(req);
+  cache->cache_free(cache);
+  return ns;
+}
+
+void bench_algo(const struct arguments *args, bench_report_t *report) {
+  int64_t cache_size = args->cache_size;
+  int64_t n_op = args->n_op;
+  bench_stream_t streams[4];
+  int n_stream = 0;
+  memset(streams, 0, sizeof(streams));
+
+  bench_stream_t *s = &streams[n_stream++];
+  s->name = "hit";
+  s->n_req = n_op;
+  s->obj_ids = malloc(sizeof(obj_id_t) * n_op);
+  for (int64_t i = 0; i < n_op; i++) {
+    s->obj_ids[i] = bench_rand_below(cache_size / 2) + 1;
+  }
+
+  s = &streams[n_stream++];
+  s->name = "miss";
+  s->n_req = n_op;
+  s->obj_ids = malloc(sizeof(obj_id_t) * n_op);
+  for (int64_t i = 0; i < n_op; i++) s->obj_ids[i] = cache_size + i + 1;
+
+  s = &streams[n_stream++];
+  s->name = "zipf";
+  s->n_req = n_op;
+  s->obj_ids = gen_zipf_ids(args->zipf_alpha, cache_size * 2, n_op);
+
+  if (args->trace_path != NULL) {
+    load_trace_stream(args, &streams[n_stream++]);
+  }
+
+  for (int i = 0; i < args->n_eviction_algo; i++) {
+    const char *algo = args->eviction_algo[i];
+    for (int j = 0; j < n_stream; j++) {
+      uint64_t ns[N_MAX_REPEAT];
+      double miss_ratio = 0;
+      for (int r = 0; r < args->n_repeat; r++) {
+        ns[r] = run_algo(algo, cache_size, args->seed, &streams[j],
+                         &miss_ratio);
+      }
+
+      char param[64];
+      snprintf(param, sizeof(param), "%s/c%ld", streams[j].name,
+               (long)cache_size);
+      bench_report_add(report, "algo", algo, param, streams[j].n_req, ns,
+                       args->n_repeat, miss_ratio);
+    }
+  }
+
+  for (int j = 0; j < n_stream; j++) free_stream(&streams[j]);
+}
+
+#ifdef __cplusplus
+}
+#endif
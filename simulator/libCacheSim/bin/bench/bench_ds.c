@@ -0,0 +1,195 @@
+//
+// microbenchmarks of the data structures on the request path,
+// the object index (whichever hashtable is compiled in) at several load
+// factors, and the intrusive doubly-linked list
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../dataStructure/hashtable/hashtable.h"
+#include "../../include/libCacheSim/logging.h"
+#include "internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if HASHTABLE_TYPE == SWISS_HASHTABLE
+#define HASHTABLE_NAME "swiss"
+#elif HASHTABLE_TYPE == CHAINED_HASHTABLEV2
+#define HASHTABLE_NAME "chainedV2"
+#else
+#define HASHTABLE_NAME "chained"
+#endif
+
+/* both the chained and the Swiss table grow before a load factor of 0.875,
+ * so the table stays at its initial size for all of them */
+static const double load_factors[] = {0.25, 0.5, 0.75, 0.85};
+#define N_LOAD_FACTOR (sizeof(load_factors) / sizeof(load_factors[0]))
+
+enum { HT_INSERT, HT_FIND_HIT, HT_FIND_MISS, HT_REPLACE, N_HT_OP };
+static const char *ht_op_names[N_HT_OP] = {"insert", "find_hit", "find_miss",
+                                           "delete_insert"};
+
+static int hashpower_of(int64_t n) {
+  int hashpower = 1;
+  while (((int64_t)1 << hashpower) < n) hashpower++;
+  return hashpower;
+}
+
+/**
+ * @brief fill a table of 2^hashpower buckets to the load factor, then
+ * time random lookups of resident and absent ids, and the deletion of a
+ * random resident object followed by the insertion of a new one
+ *
+ * @param hashpower
+ * @param load_factor
+ * @param n_op
+ * @param ns the time of each operation type
+ * @return the number of objects inserted
+ */
+static int64_t run_hashtable(int hashpower, double load_factor, int64_t n_op,
+                             uint64_t ns[N_HT_OP]) {
+  int64_t n_obj = (int64_t)((double)((int64_t)1 << hashpower) * load_factor);
+  hashtable_t *hashtable = create_hashtable(hashpower);
+  cache_obj_t **objs = malloc(sizeof(cache_obj_t *) * n_obj);
+  obj_id_t *ids = malloc(sizeof(obj_id_t) * n_op);
+  int64_t *idx = malloc(sizeof(int64_t) * n_op);
+  request_t *req = new_request();
+  cache_obj_t *volatile sink = NULL;
+
+  uint64_t start = bench_now_ns();
+  for (int64_t i = 0; i < n_obj; i++) {
+    req->obj_id = i + 1;
+    req->hv = 0;
+    objs[i] = hashtable_insert(hashtable, req);
+  }
+  ns[HT_INSERT] = bench_now_ns() - start;
+
+  for (int64_t i = 0; i < n_op; i++) ids[i] = bench_rand_below(n_obj) + 1;
+  start = bench_now_ns();
+  for (int64_t i = 0; i < n_op; i++) {
+    req->obj_id = ids[i];
+    req->hv = 0;
+    sink = hashtable_find(hashtable, req);
+  }
+  ns[HT_FIND_HIT] = bench_now_ns() - start;
+  DEBUG_ASSERT(sink != NULL);
+
+  for (int64_t i = 0; i < n_op; i++) ids[i] = bench_rand_below(n_obj) + n_obj + 1;
+  start = bench_now_ns();
+  for (int64_t i = 0; i < n_op; i++) {
+    req->obj_id = ids[i];
+    req->hv = 0;
+    sink = hashtable_find(hashtable, req);
+  }
+  ns[HT_FIND_MISS] = bench_now_ns() - start;
+  DEBUG_ASSERT(sink == NULL);
+
+  /* new ids start above all ids used so far */
+  for (int64_t i = 0; i < n_op; i++) idx[i] = bench_rand_below(n_obj);
+  start = bench_now_ns();
+  for (int64_t i = 0; i < n_op; i++) {
+    hashtable_delete(hashtable, objs[idx[i]]);
+    req->obj_id = 2 * n_obj + i + 1;
+    req->hv = 0;
+    objs[idx[i]] = hashtable_insert(hashtable, req);
+  }
+  ns[HT_REPLACE] = bench_now_ns() - start;
+
+  free_request(req);
+  free(idx);
+  free(ids);
+  free(objs);
+  free_hashtable(hashtable);
+
+  return n_obj;
+}
+
+void bench_hashtable(const struct arguments *args, bench_report_t *report) {
+  int hashpower = hashpower_of(args->cache_size);
+
+  for (size_t i = 0; i < N_LOAD_FACTOR; i++) {
+    uint64_t ns[N_HT_OP][N_MAX_REPEAT];
+    int64_t n_obj = 0;
+    for (int r = 0; r < args->n_repeat; r++) {
+      uint64_t run_ns[N_HT_OP];
+      n_obj = run_hashtable(hashpower, load_factors[i], args->n_op, run_ns);
+      for (int op = 0; op < N_HT_OP; op++) ns[op][r] = run_ns[op];
+    }
+
+    char param[64];
+    snprintf(param, sizeof(param), "%s/hp%d/lf%.2lf", HASHTABLE_NAME,
+             hashpower, load_factors[i]);
+    for (int op = 0; op < N_HT_OP; op++) {
+      uint64_t n_op = op == HT_INSERT ? (uint64_t)n_obj : (uint64_t)args->n_op;
+      bench_report_add(report, "hashtable", ht_op_names[op], param, n_op,
+                       ns[op], args->n_repeat, -1);
+    }
+  }
+}
+
+enum { Q_APPEND, Q_PROMOTE, Q_EVICT, N_Q_OP };
+static const char *q_op_names[N_Q_OP] = {"append", "promote", "evict"};
+
+/**
+ * @brief time the operations of an LRU-style list, append at the head,
+ * move a random object to the head, and remove the tail
+ */
+static void run_list(cache_obj_t *objs, int64_t n_obj, const int64_t *idx,
+                     int64_t n_op, uint64_t ns[N_Q_OP]) {
+  cache_obj_t *head = NULL, *tail = NULL;
+
+  uint64_t start = bench_now_ns();
+  for (int64_t i = 0; i < n_obj; i++) {
+    prepend_obj_to_head(&head, &tail, &objs[i]);
+  }
+  ns[Q_APPEND] = bench_now_ns() - start;
+
+  start = bench_now_ns();
+  for (int64_t i = 0; i < n_op; i++) {
+    move_obj_to_head(&head, &tail, &objs[idx[i]]);
+  }
+  ns[Q_PROMOTE] = bench_now_ns() - start;
+
+  start = bench_now_ns();
+  for (int64_t i = 0; i < n_obj; i++) {
+    remove_obj_from_list(&head, &tail, tail);
+  }
+  ns[Q_EVICT] = bench_now_ns() - start;
+  DEBUG_ASSERT(head == NULL);
+}
+
+void bench_queue(const struct arguments *args, bench_report_t *report) {
+  int64_t n_obj = args->cache_size;
+  cache_obj_t *objs = calloc(n_obj, sizeof(cache_obj_t));
+  int64_t *idx = malloc(sizeof(int64_t) * args->n_op);
+  if (objs == NULL || idx == NULL) {
+    ERROR("cannot allocate %ld objects\n", (long)n_obj);
+  }
+  for (int64_t i = 0; i < n_obj; i++) objs[i].obj_id = i + 1;
+
+  uint64_t ns[N_Q_OP][N_MAX_REPEAT];
+  for (int r = 0; r < args->n_repeat; r++) {
+    uint64_t run_ns[N_Q_OP];
+    for (int64_t i = 0; i < args->n_op; i++) idx[i] = bench_rand_below(n_obj);
+    run_list(objs, n_obj, idx, args->n_op, run_ns);
+    for (int op = 0; op < N_Q_OP; op++) ns[op][r] = run_ns[op];
+  }
+
+  char param[64];
+  snprintf(param, sizeof(param), "list/n%ld", (long)n_obj);
+  for (int op = 0; op < N_Q_OP; op++) {
+    uint64_t n_op = op == Q_PROMOTE ? (uint64_t)args->n_op : (uint64_t)n_obj;
+    bench_report_add(report, "queue", q_op_names[op], param, n_op, ns[op],
+                     args->n_repeat, -1);
+  }
+
+  free(idx);
+  free(objs);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../../include/libCacheSim/cache.h"
+#include "../../include/libCacheSim/reader.h"
+#include "../../utils/include/mymath.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define N_MAX_ALGO 64
+#define N_MAX_REPEAT 64
+#define OFILEPATH_LEN 128
+
+/* This structure is used to communicate with parse_opt. */
+struct arguments {
+  /* comma separated, hashtable, queue and algo */
+  char *suites;
+  char *eviction_algo[N_MAX_ALGO];
+  int n_eviction_algo;
+  /* the number of operations measured in each run */
+  int64_t n_op;
+  /* the cache size and the number of queue/hashtable entries, in objects */
+  int64_t cache_size;
+  int n_repeat;
+  uint64_t seed;
+  double zipf_alpha;
+
+  /* an optional recorded request stream, replayed by the algo suite */
+  char *trace_path;
+  char *trace_type_str;
+  char *trace_type_params;
+
+  char *baseline_path;
+  /* a case is a regression if it is this much slower than the baseline */
+  double regression_pct;
+  char ofilepath[OFILEPATH_LEN];
+};
+
+/* one row of the output, also used to hold the rows of the baseline */
+typedef struct {
+  char suite[16];
+  char name[32];
+  char param[64];
+  uint64_t n_op;
+  double ns_per_op;     /* median over the runs */
+  double min_ns_per_op; /* the fastest run */
+  double miss_ratio;    /* only for the algo suite, -1 otherwise */
+} bench_result_t;
+
+typedef struct {
+  FILE *ofile;
+  bench_result_t *baseline;
+  int n_baseline;
+  double regression_pct;
+  int n_result;
+  int n_regression;
+} bench_report_t;
+
+/* a request stream kept as flat arrays so that it can be replayed
+ * many times without touching a reader */
+typedef struct {
+  const char *name;
+  obj_id_t *obj_ids;
+  int64_t *clock_times;
+  int64_t n_req;
+} bench_stream_t;
+
+void parse_cmd(int argc, char *argv[], struct arguments *args);
+
+void bench_report_open(bench_report_t *report, const struct arguments *args);
+
+/**
+ * @brief summarize the per-run timings of one case, print it as a CSV row,
+ * and compare it with the same case in the baseline
+ *
+ * @param report
+ * @param suite
+ * @param name
+ * @param param
+ * @param n_op the number of operations in each run
+ * @param ns the total nanoseconds of each run
+ * @param n_run
+ * @param miss_ratio
+ */
+void bench_report_add(bench_report_t *report, const char *suite,
+                      const char *name, const char *param, uint64_t n_op,
+                      const uint64_t *ns, int n_run, double miss_ratio);
+
+void bench_report_close(bench_report_t *report);
+
+void bench_hashtable(const struct arguments *args, bench_report_t *report);
+
+void bench_queue(const struct arguments *args, bench_report_t *report);
+
+void bench_algo(const struct arguments *args, bench_report_t *report);
+
+/* generate n ids in [1, n_obj] following a Zipf distribution */
+obj_id_t *gen_zipf_ids(double alpha, int64_t n_obj, int64_t n);
+
+static inline uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* a uniform integer in [0, n) */
+static inline uint64_t bench_rand_below(uint64_t n) {
+  return ((next_rand() >> 32) * n) >> 32;
+}
+
+#ifdef __cplusplus
+}
+#endif
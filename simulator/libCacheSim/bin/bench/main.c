@@ -0,0 +1,43 @@
+//
+// microbenchmarks of the hot paths of the simulator,
+// see the Microbenchmarks section of the README
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/libCacheSim/logging.h"
+#include "internal.h"
+
+static bool has_suite(const char *suites, const char *suite) {
+  size_t len = strlen(suite);
+  const char *p = suites;
+  while ((p = strstr(p, suite)) != NULL) {
+    bool start_ok = p == suites || p[-1] == ',';
+    bool end_ok = p[len] == '\0' || p[len] == ',';
+    if (start_ok && end_ok) return true;
+    p += len;
+  }
+  return false;
+}
+
+int main(int argc, char **argv) {
+  struct arguments args;
+  parse_cmd(argc, argv, &args);
+  set_rand_seed(args.seed);
+
+  bench_report_t report;
+  bench_report_open(&report, &args);
+
+  if (has_suite(args.suites, "hashtable")) bench_hashtable(&args, &report);
+  if (has_suite(args.suites, "queue")) bench_queue(&args, &report);
+  if (has_suite(args.suites, "algo")) bench_algo(&args, &report);
+
+  if (report.n_result == 0) {
+    ERROR("no benchmark in suite %s\n", args.suites);
+  }
+
+  bench_report_close(&report);
+
+  return report.n_regression > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -25,6 +25,8 @@ static int conv_cache_sizes(char *cache_size_str, struct arguments *args);
 
 static void parse_eviction_algo(struct arguments *args, const char *arg);
 
+static unsigned long conv_size_str_to_byte_ul(char *cache_size_str);
+
 const char *argp_program_version = "cachesim 0.0.1";
 const char *argp_program_bug_address = "https://groups.google.com/g/libcachesim";
 
@@ -46,6 +48,18 @@ enum argp_option_short {
 
   OPTION_PREFETCH_ALGO = 'p',
   OPTION_PREFETCH_PARAMS = 0x109,
+  OPTION_OUTPUT_FORMAT = 0x10a,
+  OPTION_INTERVAL_STAT = 0x10b,
+  OPTION_CHECKPOINT_SAVE = 0x10c,
+  OPTION_CHECKPOINT_AT = 0x10d,
+  OPTION_CHECKPOINT_LOAD = 0x10e,
+  OPTION_FORK_AT = 0x10f,
+  OPTION_FORK_PARAMS = 0x110,
+  OPTION_LOOKAHEAD = 0x111,
+  OPTION_PERF_COUNTER = 0x113,
+  OPTION_SHM_TRACE_CACHE = 0x114,
+  OPTION_DIRECT_IO = 0x115,
+  OPTION_DIRECT_IO_CPU = 0x116,
 };
 
 /*
@@ -59,6 +73,12 @@ static struct argp_option options[] = {
     {"num-req", OPTION_NUM_REQ, "-1", 0, "Num of requests to process, default -1 means all requests in the trace", 2},
     {"sample-ratio", OPTION_SAMPLE_RATIO, "1", 0, "Sample ratio, 1 means no sampling, 0.01 means sample 1% of objects",
      2},
+    {"shm-trace-cache", OPTION_SHM_TRACE_CACHE, "16GB", 0,
+     "decode the trace once into shared memory for the jobs on this host, keep at most this size of decoded traces",
+     2},
+    {"direct-io", OPTION_DIRECT_IO, "4", 0,
+     "read binary traces with O_DIRECT and io_uring into this many 8 MiB buffers instead of mmap, 0 to use mmap", 2},
+    {"direct-io-cpu", OPTION_DIRECT_IO_CPU, "0", 0, "pin the io_uring submission thread of direct-io to this cpu", 2},
 
     {NULL, 0, NULL, 0, "cache related parameters:", 0},
     {"eviction-params", OPTION_EVICTION_PARAMS, "\"n-seg=4\"", 0,
@@ -72,11 +92,28 @@ static struct argp_option options[] = {
     {0, 0, 0, 0, "Other options:"},
     {"ignore-obj-size", OPTION_IGNORE_OBJ_SIZE, "false", 0, "specify to ignore the object size from the trace", 6},
     {"output", OPTION_OUTPUT_PATH, "output", 0, "Output path", 6},
+    {"output-format", OPTION_OUTPUT_FORMAT, "txt", 0,
+     "Output format: txt/json/csv, json and csv append one record per cache to the output path", 6},
     {"num-thread", OPTION_NUM_THREAD, "16", 0, "Number of threads if running when using default cache sizes", 6},
 
     {0, 0, 0, 0, "Other less common options:"},
     {"report-interval", OPTION_REPORT_INTERVAL, "3600", 0, "how often to report stat when running one cache", 10},
+    {"interval-stat", OPTION_INTERVAL_STAT, "path", 0,
+     "write per report-interval miss ratio, promotion, eviction and queue occupancy to a csv file", 10},
     {"warmup-sec", OPTION_WARMUP_SEC, "0", 0, "warm up time in seconds", 10},
+    {"lookahead", OPTION_LOOKAHEAD, "0", 0,
+     "read and prefetch the hash buckets of this many requests ahead, 0 to disable", 10},
+    {"perf-counter", OPTION_PERF_COUNTER, "false", 0,
+     "count cycles, instructions, LLC/dTLB/branch misses and context switches after warmup with perf_event_open",
+     10},
+    {"checkpoint-save", OPTION_CHECKPOINT_SAVE, "path", 0,
+     "save the cache and the trace position to path after checkpoint-at requests", 10},
+    {"checkpoint-at", OPTION_CHECKPOINT_AT, "0", 0, "number of requests to replay before saving the checkpoint", 10},
+    {"checkpoint-load", OPTION_CHECKPOINT_LOAD, "path", 0,
+     "start from a checkpoint created by the same algorithm and cache size", 10},
+    {"fork-at", OPTION_FORK_AT, "0", 0, "number of requests to replay before forking the fork-params variants", 10},
+    {"fork-params", OPTION_FORK_PARAMS, "\"prob=0.1|prob=0.2\"", 0,
+     "eviction params of the variants that continue from the fork-at point, separated by |", 10},
     {"use-ttl", OPTION_USE_TTL, "false", 0, "specify to use ttl from the trace", 10},
     {"consider-obj-metadata", OPTION_CONSIDER_OBJ_METADATA, "false", 0,
      "Whether consider per object metadata size in the simulated cache", 10},
@@ -125,6 +162,17 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
     case OPTION_OUTPUT_PATH:
       strncpy(arguments->ofilepath, arg, OFILEPATH_LEN);
       break;
+    case OPTION_OUTPUT_FORMAT:
+      if (strcasecmp(arg, "txt") == 0) {
+        arguments->output_format = OUTPUT_FORMAT_TXT;
+      } else if (strcasecmp(arg, "json") == 0) {
+        arguments->output_format = OUTPUT_FORMAT_JSON;
+      } else if (strcasecmp(arg, "csv") == 0) {
+        arguments->output_format = OUTPUT_FORMAT_CSV;
+      } else {
+        ERROR("unknown output format %s, supported: txt/json/csv\n", arg);
+      }
+      break;
     case OPTION_NUM_REQ:
       arguments->n_req = atoi(arg);
       break;
@@ -137,6 +185,41 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
     case OPTION_REPORT_INTERVAL:
       arguments->report_interval = atol(arg);
       break;
+    case OPTION_CHECKPOINT_SAVE:
+      arguments->checkpoint_save_path = arg;
+      break;
+    case OPTION_CHECKPOINT_AT:
+      arguments->checkpoint_at = atoll(arg);
+      break;
+    case OPTION_CHECKPOINT_LOAD:
+      arguments->checkpoint_load_path = arg;
+      break;
+    case OPTION_LOOKAHEAD:
+      arguments->lookahead = atoi(arg);
+      break;
+    case OPTION_PERF_COUNTER:
+      arguments->use_perf_counter = is_true(arg) ? true : false;
+      break;
+    case OPTION_DIRECT_IO:
+      arguments->direct_io_n_buf = atoi(arg);
+      break;
+    case OPTION_DIRECT_IO_CPU:
+      arguments->direct_io_cpu = atoi(arg);
+      break;
+    case OPTION_SHM_TRACE_CACHE:
+      arguments->shm_trace_cache_size = conv_size_str_to_byte_ul(arg);
+      break;
+    case OPTION_FORK_AT:
+      arguments->fork_at = atoll(arg);
+      break;
+    case OPTION_FORK_PARAMS:
+      arguments->fork_params = strdup(arg);
+      replace_char(arguments->fork_params, ';', ',');
+      replace_char(arguments->fork_params, '_', '-');
+      break;
+    case OPTION_INTERVAL_STAT:
+      arguments->interval_stat_path = arg;
+      break;
     case OPTION_SAMPLE_RATIO:
       arguments->sample_ratio = atof(arg);
       if (arguments->sample_ratio < 0 || arguments->sample_ratio > 1) {
@@ -206,6 +289,18 @@ static void init_arg(struct arguments *args) {
   args->trace_type_params = NULL;
   args->verbose = true;
   args->use_ttl = false;
+  args->output_format = OUTPUT_FORMAT_TXT;
+  args->interval_stat_path = NULL;
+  args->checkpoint_save_path = NULL;
+  args->checkpoint_at = 0;
+  args->checkpoint_load_path = NULL;
+  args->fork_at = 0;
+  args->fork_params = NULL;
+  args->lookahead = 0;
+  args->use_perf_counter = false;
+  args->shm_trace_cache_size = 0;
+  args->direct_io_n_buf = 0;
+  args->direct_io_cpu = -1;
   args->ignore_obj_size = false;
   args->consider_obj_metadata = false;
   args->report_interval = 3600 * 24;
@@ -230,6 +325,9 @@ void free_arg(struct arguments *args) {
   if (args->eviction_params) {
     free(args->eviction_params);
   }
+  if (args->fork_params) {
+    free(args->fork_params);
+  }
   if (args->admission_params) {
     free(args->admission_params);
   }
@@ -269,8 +367,11 @@ void parse_cmd(int argc, char *argv[], struct arguments *args) {
 
   if (args->ofilepath[0] == '\0') {
     char *trace_filename = rindex(args->trace_path, '/');
-    snprintf(args->ofilepath, OFILEPATH_LEN, "%s.cachesim",
-             trace_filename == NULL ? args->trace_path : trace_filename + 1);
+    const char *ext = args->output_format == OUTPUT_FORMAT_JSON  ? ".json"
+                      : args->output_format == OUTPUT_FORMAT_CSV ? ".csv"
+                                                                 : "";
+    snprintf(args->ofilepath, OFILEPATH_LEN, "%s.cachesim%s",
+             trace_filename == NULL ? args->trace_path : trace_filename + 1, ext);
   }
 
   /* convert trace type string to enum */
@@ -283,6 +384,12 @@ void parse_cmd(int argc, char *argv[], struct arguments *args) {
   reader_init_params.obj_id_is_num = true;
   reader_init_params.cap_at_n_req = args->n_req;
   reader_init_params.sampler = NULL;
+  /* the hash table, the sampler and look-ahead use the hash from the reader */
+  reader_init_params.offload_hash = true;
+  reader_init_params.shm_cache_size = args->shm_trace_cache_size;
+  reader_init_params.direct_io_n_buf = args->direct_io_n_buf;
+  reader_init_params.direct_io_sq_thread = args->direct_io_cpu >= 0;
+  reader_init_params.direct_io_cpu = args->direct_io_cpu;
 
   parse_reader_params(args->trace_type_params, &reader_init_params);
 
@@ -506,6 +613,30 @@ void print_parsed_args(struct arguments *args) {
   if (args->eviction_params != NULL)
     n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", eviction-params: %s", args->eviction_params);
 
+  if (args->output_format == OUTPUT_FORMAT_JSON)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", output format json");
+  else if (args->output_format == OUTPUT_FORMAT_CSV)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", output format csv");
+
+  if (args->interval_stat_path != NULL)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", interval stat %s every %d sec", args->interval_stat_path,
+                  args->report_interval);
+
+  if (args->checkpoint_save_path != NULL)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", save checkpoint %s after %ld req",
+                  args->checkpoint_save_path, (long)args->checkpoint_at);
+
+  if (args->checkpoint_load_path != NULL)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", load checkpoint %s", args->checkpoint_load_path);
+
+  if (args->lookahead > 1)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", lookahead %d req", args->lookahead);
+  if (args->use_perf_counter) n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", perf counters");
+
+  if (args->fork_params != NULL)
+    n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", fork %s after %ld req", args->fork_params,
+                  (long)args->fork_at);
+
   if (args->use_ttl) n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", use ttl");
 
   if (args->ignore_obj_size) n += snprintf(output_str + n, OUTPUT_STR_LEN - n - 1, ", ignore object size");
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <inttypes.h>
+#include <stdio.h>
 
 #include "../../include/libCacheSim/admissionAlgo.h"
 #include "../../include/libCacheSim/cache.h"
 #include "../../include/libCacheSim/enum.h"
 #include "../../include/libCacheSim/evictionAlgo.h"
 #include "../../include/libCacheSim/reader.h"
+#include "../../utils/include/perfCounter.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,6 +19,76 @@ extern "C" {
 #define N_MAX_CACHE_SIZE 128
 #define OFILEPATH_LEN 128
 
+typedef enum {
+  OUTPUT_FORMAT_TXT = 0,
+  OUTPUT_FORMAT_JSON,
+  OUTPUT_FORMAT_CSV,
+} output_format_e;
+
+/* the result of simulating one cache, used to write machine-readable records */
+typedef struct {
+  const char *trace_path;
+  const cache_t *cache;
+  uint64_t n_req;
+  uint64_t n_miss;
+  uint64_t n_req_byte;
+  uint64_t n_miss_byte;
+  int64_t n_promotion;
+  double runtime;
+  int n_thread;
+  bool ignore_obj_size;
+  /* the counters of the measured part, NULL if not collected */
+  const perf_counter_t *perf;
+  /* n_thread counters of the worker threads, NULL if single threaded */
+  const perf_counter_t *perf_per_thread;
+} sim_result_t;
+
+/* cumulative counters snapshotted at the window boundaries */
+typedef struct {
+  uint64_t n_req;
+  uint64_t n_miss;
+  uint64_t n_req_byte;
+  uint64_t n_miss_byte;
+  int64_t n_promotion;
+  int64_t n_reinsertion;
+  int64_t n_insert;
+  int64_t n_obj;
+} interval_counter_t;
+
+typedef struct {
+  int fd;
+  /* the trace, algorithm, cache name and params columns of every row */
+  char *row_id;
+  char *row;
+  int row_len;
+  int64_t n_window;
+  interval_counter_t last;
+} interval_stat_t;
+
+/* a ring of requests read ahead of the one being served */
+typedef struct {
+  reader_t *reader;
+  const cache_t *cache;
+  request_t *reqs;
+  uint64_t *buckets;
+  int n_lookahead;
+  int head;
+  int n_buffered;
+  bool eof;
+} lookahead_reader_t;
+
+/* the options of one simulation, filled from the arguments by sim_config_init */
+typedef struct {
+  int report_interval;
+  int warmup_sec;
+  char *ofilepath;
+  bool ignore_obj_size;
+  output_format_e output_format;
+  const char *interval_stat_path; /* NULL to disable */
+  int lookahead;                  /* 0 or 1 to disable */
+  bool use_perf_counter;
+} sim_config_t;
+
 /* This structure is used to communicate with parse_opt. */
 struct arguments {
   /* argument from the user */
@@ -46,6 +118,18 @@ struct arguments {
   bool ignore_obj_size;
   bool consider_obj_metadata;
   bool use_ttl;
+  output_format_e output_format;
+  char *interval_stat_path;
+  char *checkpoint_save_path;
+  int64_t checkpoint_at; /* number of requests to replay before saving */
+  char *checkpoint_load_path;
+  int64_t fork_at; /* number of requests to replay before forking */
+  char *fork_params; /* eviction params of the variants separated by '|' */
+  int lookahead;     /* number of requests to read and prefetch ahead */
+  bool use_perf_counter; /* collect hardware counters of the measured part */
+  int64_t shm_trace_cache_size; /* 0 to read the trace file, see shmTrace.h */
+  int direct_io_n_buf;  /* 0 to mmap the trace, see directReader.h */
+  int direct_io_cpu;    /* -1 for no io_uring submission thread */
 
   /* arguments generated */
   reader_t *reader;
@@ -58,8 +142,38 @@ void cache_reset(struct arguments *args, int version_num);
 
 void free_arg(struct arguments *args);
 
-void simulate(reader_t *reader, cache_t *cache, int report_interval,
-              int warmup_sec, char *ofilepath, bool ignore_obj_size);
+void sim_config_init(sim_config_t *config, const struct arguments *args);
+
+void simulate(reader_t *reader, cache_t *cache, const sim_config_t *config);
+
+void write_result_record(const char *ofilepath, output_format_e format,
+                         const sim_result_t *res);
+
+char *format_result_id_csv(const char *trace_path, const cache_t *cache);
+
+void create_csv_with_header(const char *ofilepath, const char *header);
+
+void replay_n_req(reader_t *reader, cache_t *cache, int64_t n_req);
+
+void simulate_fork_sweep(struct arguments *args, cache_t *cache);
+
+interval_stat_t *interval_stat_open(const char *ofilepath,
+                                    const char *trace_path,
+                                    const cache_t *cache);
+
+void interval_stat_start(interval_stat_t *stat, const cache_t *cache);
+
+void interval_stat_record(interval_stat_t *stat, const cache_t *cache,
+                          int64_t end_time, const interval_counter_t *curr);
+
+void interval_stat_close(interval_stat_t *stat);
+
+lookahead_reader_t *lookahead_open(reader_t *reader, const cache_t *cache,
+                                   int n_lookahead);
+
+int lookahead_read(lookahead_reader_t *la, request_t *req);
+
+void lookahead_close(lookahead_reader_t *la);
 
 void print_parsed_args(struct arguments *args);
 
@@ -0,0 +1,131 @@
+/**
+ * per-window time series of a single-cache simulation
+ *
+ * the simulator only snapshots counters that the cache already maintains
+ * at the end of each report interval, so the per-request cost is zero,
+ * each window becomes one CSV row, which starts with the columns that
+ * identify the run and is appended with a single write(2), so the
+ * processes of a fork sweep can share one file
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../include/libCacheSim/logging.h"
+#include "internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the counter columns of a row */
+#define INTERVAL_STAT_ROW_LEN 512
+
+static const char *interval_stat_header =
+    "trace,algorithm,cache_name,params,window,end_time,n_req,n_miss,miss_ratio,n_req_byte,n_miss_byte,byte_miss_ratio,n_promotion,n_reinsertion,"
+    "n_eviction,n_obj,occupied_frac,small_frac,main_frac,ghost_frac\n";
+
+/**
+ * @brief open (append to) the interval stat file
+ *
+ * @param ofilepath
+ * @param trace_path
+ * @param cache
+ * @return interval_stat_t*
+ */
+interval_stat_t *interval_stat_open(const char *ofilepath, const char *trace_path, const cache_t *cache) {
+  interval_stat_t *stat = calloc(1, sizeof(interval_stat_t));
+  create_csv_with_header(ofilepath, interval_stat_header);
+  stat->fd = open(ofilepath, O_WRONLY | O_APPEND);
+  if (stat->fd < 0) {
+    ERROR("cannot open file %s %s\n", ofilepath, strerror(errno));
+    exit(1);
+  }
+
+  stat->row_id = format_result_id_csv(trace_path, cache);
+  stat->row_len = (int)strlen(stat->row_id) + INTERVAL_STAT_ROW_LEN;
+  stat->row = malloc(stat->row_len);
+
+  return stat;
+}
+
+/**
+ * @brief mark the beginning of the measured region (after warmup),
+ * the counters of the cache at this point are the base of the first window
+ *
+ * @param stat
+ * @param cache
+ */
+void interval_stat_start(interval_stat_t *stat, const cache_t *cache) {
+  memset(&stat->last, 0, sizeof(stat->last));
+  stat->last.n_promotion = cache->n_promotion;
+  stat->last.n_reinsertion = cache->n_reinsertion;
+  stat->last.n_insert = cache->n_insert;
+  stat->last.n_obj = cache->get_n_obj(cache);
+  stat->n_window = 0;
+}
+
+/**
+ * @brief close the current window and write one row
+ *
+ * @param stat
+ * @param cache
+ * @param end_time the trace time at the end of the window
+ * @param curr the cumulative request counters of the simulation
+ */
+void interval_stat_record(interval_stat_t *stat, const cache_t *cache, int64_t end_time,
+                          const interval_counter_t *curr) {
+  interval_counter_t now = *curr;
+  now.n_promotion = cache->n_promotion;
+  now.n_reinsertion = cache->n_reinsertion;
+  now.n_insert = cache->n_insert;
+  now.n_obj = cache->get_n_obj(cache);
+
+  const interval_counter_t *last = &stat->last;
+  uint64_t n_req = now.n_req - last->n_req;
+  uint64_t n_miss = now.n_miss - last->n_miss;
+  uint64_t n_req_byte = now.n_req_byte - last->n_req_byte;
+  uint64_t n_miss_byte = now.n_miss_byte - last->n_miss_byte;
+  /* every insertion either grows the cache or is paid for by evictions */
+  int64_t n_eviction = (now.n_insert - last->n_insert) - (now.n_obj - last->n_obj);
+
+  double cache_size = (double)cache->cache_size;
+  int n = snprintf(stat->row, stat->row_len, "%s,%ld,%ld,%lu,%lu,%.6lf,%lu,%lu,%.6lf,%ld,%ld,%ld,%ld,%.4lf,",
+                   stat->row_id, (long)stat->n_window, (long)end_time, (unsigned long)n_req, (unsigned long)n_miss,
+                   n_req == 0 ? 0.0 : (double)n_miss / (double)n_req, (unsigned long)n_req_byte,
+                   (unsigned long)n_miss_byte, n_req_byte == 0 ? 0.0 : (double)n_miss_byte / (double)n_req_byte,
+                   (long)(now.n_promotion - last->n_promotion), (long)(now.n_reinsertion - last->n_reinsertion),
+                   (long)n_eviction, (long)now.n_obj, (double)cache->get_occupied_byte(cache) / cache_size);
+
+  if (cache->get_queue_occupancy != NULL) {
+    int64_t small_byte, main_byte, ghost_byte;
+    cache->get_queue_occupancy(cache, &small_byte, &main_byte, &ghost_byte);
+    n += snprintf(stat->row + n, stat->row_len - n, "%.4lf,%.4lf,%.4lf\n", (double)small_byte / cache_size,
+                  (double)main_byte / cache_size, (double)ghost_byte / cache_size);
+  } else {
+    n += snprintf(stat->row + n, stat->row_len - n, ",,\n");
+  }
+
+  if (write(stat->fd, stat->row, n) != n) {
+    ERROR("failed to write interval stat %s\n", strerror(errno));
+    exit(1);
+  }
+
+  stat->last = now;
+  stat->n_window += 1;
+}
+
+void interval_stat_close(interval_stat_t *stat) {
+  close(stat->fd);
+  free(stat->row_id);
+  free(stat->row);
+  free(stat);
+}
+
+#ifdef __cplusplus
+}
+#endif
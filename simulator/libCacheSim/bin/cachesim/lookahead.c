@@ -0,0 +1,102 @@
+/**
+ * look-ahead replay for single-cache simulation
+ *
+ * the trace is known ahead of time, so the simulator reads the next K
+ * requests into a ring buffer, prefetches the hash bucket of each request
+ * when it enters the ring, and prefetches the first object of the bucket
+ * K/2 requests before it is served, the requests are still served one at a
+ * time in trace order, so the results are the same as without look-ahead
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/libCacheSim/logging.h"
+#include "internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* read one request from the trace into the ring slot */
+static void fill_slot(lookahead_reader_t *la, int slot) {
+  if (read_one_req(la->reader, &la->reqs[slot]) != 0) {
+    la->eof = true;
+    return;
+  }
+  la->buckets[slot] = cache_prefetch_bucket(la->cache, &la->reqs[slot]);
+  la->n_buffered += 1;
+}
+
+/**
+ * @brief create a look-ahead reader that reads n_lookahead requests ahead
+ *
+ * @param reader
+ * @param cache the cache that serves the requests
+ * @param n_lookahead
+ * @return lookahead_reader_t*
+ */
+lookahead_reader_t *lookahead_open(reader_t *reader, const cache_t *cache, int n_lookahead) {
+  if (n_lookahead < 2) {
+    ERROR("look-ahead distance should be at least 2, but got %d\n", n_lookahead);
+  }
+
+  lookahead_reader_t *la = calloc(1, sizeof(lookahead_reader_t));
+  la->reader = reader;
+  la->cache = cache;
+  la->n_lookahead = n_lookahead;
+  la->reqs = calloc(n_lookahead, sizeof(request_t));
+  la->buckets = calloc(n_lookahead, sizeof(uint64_t));
+  /* readers do not set every field, so each slot starts from a new request */
+  request_t *req = new_request();
+  for (int i = 0; i < n_lookahead; i++) {
+    memcpy(&la->reqs[i], req, sizeof(request_t));
+  }
+  free_request(req);
+
+  for (int i = 0; i < n_lookahead && !la->eof; i++) {
+    fill_slot(la, i);
+  }
+
+  return la;
+}
+
+/**
+ * @brief read the next request in trace order
+ *
+ * @param la
+ * @param req
+ * @return 0 on success and 1 if reach the end of the trace
+ */
+int lookahead_read(lookahead_reader_t *la, request_t *req) {
+  if (la->n_buffered == 0) {
+    req->valid = false;
+    return 1;
+  }
+
+  int slot = la->head;
+  memcpy(req, &la->reqs[slot], sizeof(request_t));
+  la->n_buffered -= 1;
+  if (!la->eof) {
+    fill_slot(la, slot);
+  }
+  la->head = (slot + 1) % la->n_lookahead;
+
+  /* by now the bucket of the request half way through the ring has arrived */
+  if (la->n_buffered > la->n_lookahead / 2) {
+    int mid = (la->head + la->n_lookahead / 2) % la->n_lookahead;
+    cache_prefetch_chain(la->cache, la->buckets[mid]);
+  }
+
+  return 0;
+}
+
+void lookahead_close(lookahead_reader_t *la) {
+  free(la->reqs);
+  free(la->buckets);
+  free(la);
+}
+
+#ifdef __cplusplus
+}
+#endif
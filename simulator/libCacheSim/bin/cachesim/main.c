@@ -9,6 +9,7 @@
 #include <libgen.h>
 
 #include "../../include/libCacheSim/cache.h"
+#include "../../include/libCacheSim/checkpoint.h"
 #include "../../include/libCacheSim/reader.h"
 #include "../../include/libCacheSim/simulator.h"
 #include "../../utils/include/mystr.h"
@@ -77,8 +78,24 @@ int main(int argc, char **argv) {
     cache_t *cache = args.caches[0];
     if (cache->n_iterations == 0) cache->n_iterations = 1;
 
+    /* the simulation starts from the checkpoint, i.e., the checkpoint is the warmup */
+    if (args.checkpoint_load_path != NULL) {
+      cache_checkpoint_load(cache, args.reader, args.checkpoint_load_path);
+    }
+    if (args.checkpoint_save_path != NULL) {
+      replay_n_req(args.reader, cache, args.checkpoint_at);
+      cache_checkpoint_save(cache, args.reader, args.checkpoint_save_path);
+    }
+    if (args.fork_params != NULL) {
+      simulate_fork_sweep(&args, cache);
+      free_arg(&args);
+      return 0;
+    }
+
+    sim_config_t config;
+    sim_config_init(&config, &args);
     for (int i = 0; i < cache->n_iterations; i++) {
-      simulate(args.reader, cache, args.report_interval, args.warmup_sec, args.ofilepath, args.ignore_obj_size);
+      simulate(args.reader, cache, &config);
       reset_reader(args.reader);
       if (cache->reset_cache) cache->reset_cache(cache);
     }
@@ -1,17 +1,149 @@
 
 
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include "../../include/libCacheSim/cache.h"
+#include "../../include/libCacheSim/checkpoint.h"
 #include "../../include/libCacheSim/reader.h"
 #include "../../utils/include/mymath.h"
 #include "../../utils/include/mystr.h"
 #include "../../utils/include/mysys.h"
+#include "internal.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void simulate(reader_t *reader, cache_t *cache, int report_interval, int warmup_sec, char *ofilepath,
-              bool ignore_obj_size) {
+/**
+ * @brief feed the first n_req requests to the cache without collecting stat,
+ * used to build the common prefix of a checkpoint
+ *
+ * @param reader
+ * @param cache
+ * @param n_req
+ */
+void replay_n_req(reader_t *reader, cache_t *cache, int64_t n_req) {
+  request_t *req = new_request();
+  for (int64_t i = 0; i < n_req; i++) {
+    if (read_one_req(reader, req) != 0) {
+      WARN("trace ends after %ld requests before the checkpoint\n", (long)i);
+      break;
+    }
+    cache->get(cache, req);
+  }
+  free_request(req);
+}
+
+/**
+ * @brief run one variant of a fork sweep in the child process
+ */
+static void run_fork_variant(struct arguments *args, cache_t *parent_cache, const char *params, long file_offset) {
+  /* the child has its own copy (copy-on-write) of the parent reader,
+   * but the file offset of text and zstd traces is shared with the parent,
+   * so the child reopens the trace at the offset of the fork point,
+   * mapped traces use a separate reader at the same position */
+  reader_t *reader = args->reader;
+  if (file_offset >= 0) {
+    reader_reopen_at_offset(reader, file_offset);
+  } else {
+    reader = clone_reader(args->reader);
+    reader_seek_to_req(reader, args->reader->n_read_req, args->reader->mmap_offset);
+  }
+
+  cache_t *cache = clone_cache_with_state(parent_cache, params);
+  /* the variants share the output and interval stat files, every record and
+   * interval row carries the params of its variant and is appended with a
+   * single write, and stdout is flushed per line so results do not mix */
+  setvbuf(stdout, NULL, _IOLBF, 0);
+  sim_config_t config;
+  sim_config_init(&config, args);
+  simulate(reader, cache, &config);
+
+  cache->cache_free(cache);
+  if (reader != args->reader) close_reader(reader);
+}
+
+/**
+ * @brief replay the first fork_at requests once, then simulate every
+ * parameter variant in fork_params from this point, each variant runs in a
+ * forked process, so the warm cache of the parent is shared copy-on-write
+ * and each child only copies it into a cache with the new parameters
+ *
+ * @param args fork_params is a list of eviction params separated by '|',
+ *  e.g., "prob=0.1|prob=0.2", at most n_thread variants run concurrently
+ * @param cache the cache to warm up
+ */
+void simulate_fork_sweep(struct arguments *args, cache_t *cache) {
+  if (!cache_support_checkpoint(cache)) {
+    ERROR("%s does not support fork sweep\n", cache->cache_name);
+  }
+  if (args->reader->txt_parallel != NULL) {
+    /* the parser threads do not exist in the forked processes */
+    ERROR("fork sweep does not support parsing the trace with several threads\n");
+  }
+
+  replay_n_req(args->reader, cache, args->fork_at);
+  INFO("fork %s after %lu requests\n", cache->cache_name, (unsigned long)args->reader->n_read_req);
+  fflush(NULL);
+  long file_offset = reader_file_offset(args->reader);
+
+  char *fork_params = strdup(args->fork_params);
+  char *saveptr = NULL;
+  int n_running = 0, n_failed = 0;
+  for (char *params = strtok_r(fork_params, "|", &saveptr); params != NULL; params = strtok_r(NULL, "|", &saveptr)) {
+    if (n_running >= args->n_thread) {
+      int status;
+      if (wait(&status) > 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) n_failed += 1;
+      n_running -= 1;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      ERROR("fork failed %s\n", strerror(errno));
+    } else if (pid == 0) {
+      run_fork_variant(args, cache, params, file_offset);
+      exit(0);
+    }
+    n_running += 1;
+  }
+
+  while (n_running > 0) {
+    int status;
+    if (wait(&status) > 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) n_failed += 1;
+    n_running -= 1;
+  }
+  free(fork_params);
+
+  if (n_failed > 0) {
+    WARN("%d fork sweep variants failed\n", n_failed);
+  }
+}
+
+/* read the next request, either directly or through the look-ahead ring */
+static inline int sim_read_req(reader_t *reader, lookahead_reader_t *la, request_t *req) {
+  return la == NULL ? read_one_req(reader, req) : lookahead_read(la, req);
+}
+
+/**
+ * @brief fill the options of a simulation from the command line arguments
+ *
+ * @param config
+ * @param args
+ */
+void sim_config_init(sim_config_t *config, const struct arguments *args) {
+  config->report_interval = args->report_interval;
+  config->warmup_sec = args->warmup_sec;
+  config->ofilepath = args->ofilepath;
+  config->ignore_obj_size = args->ignore_obj_size;
+  config->output_format = args->output_format;
+  config->interval_stat_path = args->interval_stat_path;
+  config->lookahead = args->lookahead;
+  config->use_perf_counter = args->use_perf_counter;
+}
+
+void simulate(reader_t *reader, cache_t *cache, const sim_config_t *config) {
   /* random seed */
   srand(time(NULL));
   set_rand_seed(rand());
@@ -20,21 +152,29 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval, int warmup_
   uint64_t req_cnt = 0, miss_cnt = 0;
   uint64_t last_req_cnt = 0, last_miss_cnt = 0;
   uint64_t req_byte = 0, miss_byte = 0;
+  interval_stat_t *interval_stat =
+      config->interval_stat_path == NULL ? NULL : interval_stat_open(config->interval_stat_path, reader->trace_path, cache);
+  lookahead_reader_t *la = config->lookahead > 1 ? lookahead_open(reader, cache, config->lookahead) : NULL;
+  /* counts the calling thread from the first request after warmup */
+  perf_counter_t perf_storage, *perf = NULL;
+  if (config->use_perf_counter && perf_counter_open(&perf_storage) > 0) perf = &perf_storage;
 
-  read_one_req(reader, req);
+  sim_read_req(reader, la, req);
   uint64_t start_ts = (uint64_t)req->clock_time;
-  uint64_t last_report_ts = warmup_sec;
+  uint64_t last_report_ts = config->warmup_sec;
 
   double start_time = -1;
   while (req->valid) {
     req->clock_time -= start_ts;
-    if (req->clock_time <= warmup_sec) {
+    if (req->clock_time <= config->warmup_sec) {
       cache->get(cache, req);
-      read_one_req(reader, req);
+      sim_read_req(reader, la, req);
       continue;
     } else {
       if (start_time < 0) {
         start_time = gettime();
+        if (perf != NULL) perf_counter_start(perf);
+        if (interval_stat != NULL) interval_stat_start(interval_stat, cache);
       }
     }
 
@@ -44,7 +184,7 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval, int warmup_
       miss_cnt++;
       miss_byte += req->obj_size;
     }
-    if (req->clock_time - last_report_ts >= report_interval && req->clock_time != 0) {
+    if (req->clock_time - last_report_ts >= config->report_interval && req->clock_time != 0) {
       // INFO(
       //     "%s %s %.2lf hour: %lu requests, miss ratio %.4lf, interval miss "
       //     "ratio "
@@ -53,13 +193,19 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval, int warmup_
       //     (double)req->clock_time / 3600, (unsigned long)req_cnt,
       //     (double)miss_cnt / req_cnt,
       //     (double)(miss_cnt - last_miss_cnt) / (req_cnt - last_req_cnt));
+      if (interval_stat != NULL) {
+        interval_counter_t curr = {
+            .n_req = req_cnt, .n_miss = miss_cnt, .n_req_byte = req_byte, .n_miss_byte = miss_byte};
+        interval_stat_record(interval_stat, cache, (int64_t)req->clock_time, &curr);
+      }
       last_miss_cnt = miss_cnt;
       last_req_cnt = req_cnt;
       last_report_ts = (int64_t)req->clock_time;
     }
 
-    read_one_req(reader, req);
+    sim_read_req(reader, la, req);
   }
+  if (la != NULL) lookahead_close(la);
 
   // while (cache->n_obj > 0) {
   //   cache->n_insert++;
@@ -67,13 +213,24 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval, int warmup_
   // }
 
   double runtime = gettime() - start_time;
+  if (perf != NULL) perf_counter_stop(perf);
+
+  if (interval_stat != NULL) {
+    /* the last partial window */
+    if (req_cnt > last_req_cnt) {
+      interval_counter_t curr = {
+          .n_req = req_cnt, .n_miss = miss_cnt, .n_req_byte = req_byte, .n_miss_byte = miss_byte};
+      interval_stat_record(interval_stat, cache, (int64_t)req->clock_time, &curr);
+    }
+    interval_stat_close(interval_stat);
+  }
 
   char output_str[1024];
   char size_str[8];
-  if (!ignore_obj_size) convert_size_to_str(cache->cache_size, size_str);
+  if (!config->ignore_obj_size) convert_size_to_str(cache->cache_size, size_str);
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wformat-truncation"
-  if (!ignore_obj_size) {
+  if (!config->ignore_obj_size) {
     snprintf(output_str, 1024,
              "%s %s cache size %8s, %16lu req, miss ratio %.4lf, throughput "
              "%.2lf MQPS\n",
@@ -88,16 +245,45 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval, int warmup_
   }
 
 #pragma GCC diagnostic pop
+  if (perf != NULL) {
+    /* replace the newline with the counters */
+    int len = (int)strlen(output_str) - 1;
+    len += snprintf(output_str + len, 1024 - len, ", ");
+    len += perf_counter_snprint(output_str + len, 1024 - len - 1, perf, req_cnt);
+    snprintf(output_str + len, 1024 - len, "\n");
+  }
   printf("%s", output_str);
   // printf("hit count %ld\n", req_cnt - miss_cnt);
 
-  FILE *output_file = fopen(ofilepath, "a");
-  if (output_file == NULL) {
-    ERROR("cannot open file %s %s\n", ofilepath, strerror(errno));
-    exit(1);
+  if (config->output_format != OUTPUT_FORMAT_TXT) {
+    sim_result_t res = {.trace_path = reader->trace_path,
+                        .cache = cache,
+                        .n_req = req_cnt,
+                        .n_miss = miss_cnt,
+                        .n_req_byte = req_byte,
+                        .n_miss_byte = miss_byte,
+                        .n_promotion = cache->n_promotion,
+                        .runtime = runtime,
+                        .n_thread = 1,
+                        .ignore_obj_size = config->ignore_obj_size,
+                        .perf = perf,
+                        .perf_per_thread = NULL};
+    write_result_record(config->ofilepath, config->output_format, &res);
+  } else {
+    /* one write so that the processes of a fork sweep do not interleave */
+    int fd = open(config->ofilepath, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd < 0) {
+      ERROR("cannot open file %s %s\n", config->ofilepath, strerror(errno));
+      exit(1);
+    }
+    int len = (int)strlen(output_str);
+    output_str[len++] = '\n';
+    if (write(fd, output_str, len) != len) {
+      ERROR("failed to write result to %s %s\n", config->ofilepath, strerror(errno));
+      exit(1);
+    }
+    close(fd);
   }
-  fprintf(output_file, "%s\n", output_str);
-  fclose(output_file);
 
 #if defined(TRACK_EVICTION_V_AGE)
   while (cache->get_occupied_byte(cache) > 0) {
@@ -105,6 +291,7 @@ void simulate(reader_t *reader, cache_t *cache, int report_interval, int warmup_
   }
 
 #endif
+  if (perf != NULL) perf_counter_close(perf);
   free_request(req);
   // cache->cache_free(cache);
 }
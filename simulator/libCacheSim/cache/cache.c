@@ -3,6 +3,7 @@
 //
 
 #include "../dataStructure/hashtable/hashtable.h"
+#include "../dataStructure/objArray.h"
 #include "../include/libCacheSim/cache.h"
 #include "../include/libCacheSim/prefetchAlgo.h"
 
@@ -26,6 +27,7 @@ cache_t *cache_struct_init(const char *const cache_name,
   cache_t *cache = my_malloc(cache_t);
   memset(cache, 0, sizeof(cache_t));
   strncpy(cache->cache_name, cache_name, CACHE_NAME_ARRAY_LEN);
+  strncpy(cache->algo_name, cache_name, CACHE_NAME_ARRAY_LEN - 1);
 
   if (init_params != NULL) {
     strncpy(cache->init_params, init_params, CACHE_INIT_PARAMS_LEN);
@@ -38,6 +40,7 @@ cache_t *cache_struct_init(const char *const cache_name,
   cache->future_stack_dist_array_size = 0;
   cache->default_ttl = params.default_ttl;
   cache->n_req = 0;
+  cache->sample_array = NULL;
   cache->to_evict_candidate = NULL;
   cache->to_evict_candidate_gen_vtime = -1;
 
@@ -57,6 +60,11 @@ cache_t *cache_struct_init(const char *const cache_name,
 
   cache->evicted = -1;
   cache->n_promotion = 0;
+  cache->n_reinsertion = 0;
+  cache->get_queue_occupancy = NULL;
+  cache->get_queue_tail = NULL;
+  cache->get_logical_time = NULL;
+  cache->set_logical_time = NULL;
 
   /* this option works only when eviction age tracking
    * is on in config.h */
@@ -84,6 +92,7 @@ cache_t *cache_struct_init(const char *const cache_name,
  */
 void cache_struct_free(cache_t *cache) {
   free_hashtable(cache->hashtable);
+  if (cache->sample_array != NULL) free_obj_array(cache->sample_array);
   if (cache->admissioner != NULL) cache->admissioner->free(cache->admissioner);
   if (cache->prefetcher != NULL) cache->prefetcher->free(cache->prefetcher);
   my_free(sizeof(cache_t), cache);
@@ -288,6 +297,9 @@ cache_obj_t *cache_insert_base(cache_t *cache, const request_t *req) {
   cache->occupied_byte +=
       (int64_t)cache_obj->obj_size + (int64_t)cache->obj_md_size;
   cache->n_obj += 1;
+  if (cache->sample_array != NULL) {
+    obj_array_append(cache->sample_array, cache_obj);
+  }
   cache_obj -> last_access_time = cache -> n_insert;
 
 #ifdef SUPPORT_TTL
@@ -358,11 +370,62 @@ void cache_remove_obj_base(cache_t *cache, cache_obj_t *obj,
   // prevent overflow
   // assert(cache -> sum_demotion_time >= (cache -> n_insert - obj -> last_access_time));
 
+  if (cache->sample_array != NULL) {
+    obj_array_remove(cache->sample_array, obj);
+  }
+
   if (remove_from_hashtable) {
     hashtable_delete(cache->hashtable, obj);
   }
 }
 
+/**
+ * @brief keep a dense array of the resident objects for cache_rand_obj
+ *
+ * @param cache
+ */
+void cache_enable_sample_array(cache_t *cache) {
+  DEBUG_ASSERT(cache->n_obj == 0);
+  if (cache->sample_array == NULL) {
+    cache->sample_array = create_obj_array(0);
+  }
+}
+
+/**
+ * @brief return a resident object chosen uniformly at random
+ *
+ * @param cache
+ * @return cache_obj_t*
+ */
+cache_obj_t *cache_rand_obj(const cache_t *cache) {
+  if (cache->sample_array != NULL) {
+    return obj_array_rand(cache->sample_array);
+  }
+  return hashtable_rand_obj(cache->hashtable);
+}
+
+/**
+ * @brief prefetch the hash bucket of a request that will be served soon
+ *
+ * @param cache
+ * @param req
+ * @return the bucket index, which is passed to cache_prefetch_chain
+ */
+uint64_t cache_prefetch_bucket(const cache_t *cache, const request_t *req) {
+  return hashtable_prefetch_bucket(cache->hashtable, req);
+}
+
+/**
+ * @brief prefetch the first object of a bucket returned by
+ * cache_prefetch_bucket, this should be called after the bucket has arrived
+ *
+ * @param cache
+ * @param bucket
+ */
+void cache_prefetch_chain(const cache_t *cache, uint64_t bucket) {
+  hashtable_prefetch_chain(cache->hashtable, bucket);
+}
+
 /**
  * @brief print the recorded eviction age
  *
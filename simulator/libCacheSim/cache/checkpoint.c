@@ -0,0 +1,391 @@
+//
+//  checkpoint.c
+//  libCacheSim
+//
+//  a checkpoint file has a fixed-size header followed by one record per
+//  object in queue order from the tail (oldest) to the head, restoring a
+//  checkpoint inserts the objects in the same order so that the queue order
+//  is preserved, then overwrites the per-object metadata
+//
+
+#include "../include/libCacheSim/checkpoint.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../dataStructure/hashtable/hashtable.h"
+#ifdef SUPPORT_ZSTD_TRACE
+#include "../traceReader/generalReader/zstdReader.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHECKPOINT_MAGIC "LCSCKPT"
+#define CHECKPOINT_VERSION 2
+#define CHECKPOINT_BUF_SIZE (4 * 1024 * 1024)
+
+/* the per-object metadata that is copied as raw bytes,
+ * it starts from misc and covers the union of algorithm metadata */
+#define OBJ_MD_OFFSET (offsetof(cache_obj_t, misc))
+#define OBJ_MD_SIZE (sizeof(cache_obj_t) - OBJ_MD_OFFSET)
+
+typedef struct {
+  char magic[8];
+  int32_t version;
+  int32_t obj_md_size;
+  char algo_name[CACHE_NAME_ARRAY_LEN];
+  char cache_name[CACHE_NAME_ARRAY_LEN];
+  char init_params[CACHE_INIT_PARAMS_LEN];
+  int64_t cache_size;
+
+  int64_t n_req;
+  int64_t n_insert;
+  int64_t n_promotion;
+  int64_t n_reinsertion;
+  int64_t logical_time;
+  int64_t n_obj;
+
+  /* reader position */
+  int32_t has_reader;
+  int32_t trace_format;
+  uint64_t n_read_req;
+  uint64_t mmap_offset;
+  uint64_t file_size;
+} checkpoint_header_t;
+
+typedef struct {
+  obj_id_t obj_id;
+  uint32_t obj_size;
+  uint32_t exp_time;
+  uint64_t last_access_time;
+  uint64_t last_access_itime;
+  uint64_t last_promote_itime;
+  uint64_t last_promote_time;
+  int64_t create_time;
+  int32_t is_promoted;
+  int32_t pad;
+} checkpoint_obj_t;
+
+static void obj_to_record(const cache_obj_t *obj, checkpoint_obj_t *rec) {
+  memset(rec, 0, sizeof(checkpoint_obj_t));
+  rec->obj_id = obj->obj_id;
+  rec->obj_size = obj->obj_size;
+#ifdef SUPPORT_TTL
+  rec->exp_time = obj->exp_time;
+#endif
+  rec->last_access_time = obj->last_access_time;
+  rec->last_access_itime = obj->last_access_itime;
+  rec->last_promote_itime = obj->last_promote_itime;
+  rec->last_promote_time = obj->last_promote_time;
+#if defined(TRACK_EVICTION_V_AGE) || defined(TRACK_DEMOTION) || defined(TRACK_CREATE_TIME)
+  rec->create_time = obj->create_time;
+#endif
+  rec->is_promoted = obj->is_promoted;
+}
+
+static void write_obj(FILE *ofile, const cache_obj_t *obj, const char *path) {
+  checkpoint_obj_t rec;
+  obj_to_record(obj, &rec);
+
+  size_t n_written = fwrite(&rec, sizeof(rec), 1, ofile);
+  n_written += fwrite((const char *)obj + OBJ_MD_OFFSET, OBJ_MD_SIZE, 1, ofile);
+  if (n_written != 2) {
+    ERROR("cannot write checkpoint %s %s\n", path, strerror(errno));
+  }
+}
+
+static void restore_obj(cache_t *cache, request_t *req, const checkpoint_obj_t *rec, const char *md) {
+  req->obj_id = rec->obj_id;
+  req->hv = 0;
+  req->obj_size = rec->obj_size;
+  req->next_access_vtime = -1;
+  req->valid = true;
+
+  cache_obj_t *obj = cache->insert(cache, req);
+  DEBUG_ASSERT(obj != NULL);
+#ifdef SUPPORT_TTL
+  obj->exp_time = rec->exp_time;
+#endif
+  obj->last_access_time = rec->last_access_time;
+  obj->last_access_itime = rec->last_access_itime;
+  obj->last_promote_itime = rec->last_promote_itime;
+  obj->last_promote_time = rec->last_promote_time;
+#if defined(TRACK_EVICTION_V_AGE) || defined(TRACK_DEMOTION) || defined(TRACK_CREATE_TIME)
+  obj->create_time = rec->create_time;
+#endif
+  obj->is_promoted = rec->is_promoted;
+  memcpy((char *)obj + OBJ_MD_OFFSET, md, OBJ_MD_SIZE);
+  /* pointers into the data structures of the old cache are not valid */
+  obj->misc.pq_node = NULL;
+  if (cache->restore_obj != NULL) {
+    cache->restore_obj(cache, obj);
+  }
+}
+
+/**
+ * @brief write the cache state and the reader position to path
+ *
+ * @param cache
+ * @param reader
+ * @param path
+ */
+void cache_checkpoint_save(const cache_t *cache, const reader_t *reader, const char *path) {
+  if (!cache_support_checkpoint(cache)) {
+    ERROR("%s does not support checkpoint\n", cache->cache_name);
+  }
+
+  FILE *ofile = fopen(path, "wb");
+  if (ofile == NULL) {
+    ERROR("cannot open checkpoint %s %s\n", path, strerror(errno));
+  }
+  char *buf = malloc(CHECKPOINT_BUF_SIZE);
+  setvbuf(ofile, buf, _IOFBF, CHECKPOINT_BUF_SIZE);
+
+  checkpoint_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+  header.version = CHECKPOINT_VERSION;
+  header.obj_md_size = (int32_t)OBJ_MD_SIZE;
+  strncpy(header.algo_name, cache->algo_name, CACHE_NAME_ARRAY_LEN - 1);
+  strncpy(header.cache_name, cache->cache_name, CACHE_NAME_ARRAY_LEN - 1);
+  strncpy(header.init_params, cache->init_params, CACHE_INIT_PARAMS_LEN - 1);
+  header.cache_size = cache->cache_size;
+  header.n_req = cache->n_req;
+  header.n_insert = cache->n_insert;
+  header.n_promotion = cache->n_promotion;
+  header.n_reinsertion = cache->n_reinsertion;
+  header.logical_time = cache->get_logical_time == NULL ? 0 : cache->get_logical_time(cache);
+  header.n_obj = cache->get_n_obj(cache);
+  if (reader != NULL) {
+    header.has_reader = 1;
+    header.trace_format = reader->trace_format;
+    header.n_read_req = reader->n_read_req;
+    header.mmap_offset = reader->mmap_offset;
+    header.file_size = reader->file_size;
+  }
+  if (fwrite(&header, sizeof(header), 1, ofile) != 1) {
+    ERROR("cannot write checkpoint %s %s\n", path, strerror(errno));
+  }
+
+  int64_t n_obj = 0;
+  for (cache_obj_t *obj = cache->get_queue_tail(cache); obj != NULL; obj = obj->queue.prev) {
+    write_obj(ofile, obj, path);
+    n_obj += 1;
+  }
+  if (n_obj != header.n_obj) {
+    ERROR("checkpoint %s: queue has %ld objects, but the cache has %ld objects\n", path, (long)n_obj,
+          (long)header.n_obj);
+  }
+
+  if (fclose(ofile) != 0) {
+    ERROR("cannot write checkpoint %s %s\n", path, strerror(errno));
+  }
+  free(buf);
+
+  INFO("save checkpoint %s: %s %ld objects, %lu requests read\n", path, cache->cache_name, (long)n_obj,
+       (unsigned long)header.n_read_req);
+}
+
+/**
+ * @brief move the reader to the position after n_read_req requests
+ *
+ * @param reader
+ * @param n_read_req
+ * @param mmap_offset the offset of uncompressed binary traces at that position
+ */
+void reader_seek_to_req(reader_t *reader, uint64_t n_read_req, size_t mmap_offset) {
+  reset_reader(reader);
+  if (reader->trace_format == BINARY_TRACE_FORMAT && !reader->is_zstd_file) {
+    reader->mmap_offset = mmap_offset;
+    reader->n_read_req = n_read_req;
+  } else {
+    /* text and compressed traces do not have an offset that can be restored,
+     * so we read the same number of requests again */
+    request_t *req = new_request();
+    while (reader->n_read_req < n_read_req) {
+      if (read_one_req(reader, req) != 0) {
+        ERROR("the trace ends before request %lu\n", (unsigned long)n_read_req);
+      }
+    }
+    free_request(req);
+  }
+}
+
+/* the stream a text or zstd trace is read through, NULL if the trace is mapped */
+static FILE *reader_trace_file(const reader_t *reader) {
+#ifdef SUPPORT_ZSTD_TRACE
+  if (reader->is_zstd_file) return reader->zstd_reader_p->ifile;
+#endif
+  if (reader->trace_format == TXT_TRACE_FORMAT) return reader->file;
+  return NULL;
+}
+
+/**
+ * @brief the offset of the file descriptor of the trace, -1 if the trace is
+ * mapped and the reader is repositioned with mmap_offset
+ *
+ * @param reader
+ */
+long reader_file_offset(const reader_t *reader) {
+  FILE *file = reader_trace_file(reader);
+  if (file == NULL) return -1;
+  return (long)lseek(fileno(file), 0, SEEK_CUR);
+}
+
+/**
+ * @brief give the reader its own file descriptor of the trace at offset,
+ * a process forked from the reader keeps the stream buffer and the zstd
+ * decompression state, only the file descriptor is shared with the parent,
+ * so the reader continues from the fork point without reading the prefix again
+ *
+ * @param reader
+ * @param offset the offset returned by reader_file_offset before the fork
+ */
+void reader_reopen_at_offset(reader_t *reader, long offset) {
+  FILE *file = reader_trace_file(reader);
+  int fd = open(reader->trace_path, O_RDONLY);
+  if (fd < 0 || lseek(fd, offset, SEEK_SET) != offset) {
+    ERROR("cannot reopen %s at offset %ld %s\n", reader->trace_path, offset, strerror(errno));
+  }
+  if (dup2(fd, fileno(file)) < 0) {
+    ERROR("cannot reopen %s %s\n", reader->trace_path, strerror(errno));
+  }
+  close(fd);
+}
+
+/**
+ * @brief move the reader to the position recorded in the checkpoint
+ */
+static void restore_reader(reader_t *reader, const checkpoint_header_t *header, const char *path) {
+  if (!header->has_reader) {
+    WARN("checkpoint %s does not have reader position, the reader is not moved\n", path);
+    return;
+  }
+  if (header->trace_format != reader->trace_format || header->file_size != reader->file_size) {
+    ERROR("checkpoint %s is created from a different trace\n", path);
+  }
+
+  reader_seek_to_req(reader, header->n_read_req, header->mmap_offset);
+}
+
+/**
+ * @brief restore a checkpoint into an empty cache and move the reader
+ *
+ * @param cache
+ * @param reader
+ * @param path
+ */
+void cache_checkpoint_load(cache_t *cache, reader_t *reader, const char *path) {
+  if (!cache_support_checkpoint(cache)) {
+    ERROR("%s does not support checkpoint\n", cache->cache_name);
+  }
+  if (cache->get_n_obj(cache) != 0) {
+    ERROR("checkpoint can only be loaded into an empty cache, %s has %ld objects\n", cache->cache_name,
+          (long)cache->get_n_obj(cache));
+  }
+
+  FILE *ifile = fopen(path, "rb");
+  if (ifile == NULL) {
+    ERROR("cannot open checkpoint %s %s\n", path, strerror(errno));
+  }
+  char *buf = malloc(CHECKPOINT_BUF_SIZE);
+  setvbuf(ifile, buf, _IOFBF, CHECKPOINT_BUF_SIZE);
+
+  checkpoint_header_t header;
+  if (fread(&header, sizeof(header), 1, ifile) != 1 || memcmp(header.magic, CHECKPOINT_MAGIC, 8) != 0) {
+    ERROR("%s is not a checkpoint\n", path);
+  }
+  if (header.version != CHECKPOINT_VERSION || header.obj_md_size != (int32_t)OBJ_MD_SIZE) {
+    ERROR("checkpoint %s is created by a different version of libCacheSim\n", path);
+  }
+  if (strcmp(header.algo_name, cache->algo_name) != 0) {
+    ERROR("checkpoint %s is created by %s, cannot be loaded into %s\n", path, header.cache_name, cache->cache_name);
+  }
+  if (header.cache_size != cache->cache_size) {
+    ERROR("checkpoint %s has cache size %ld, but the cache size is %ld\n", path, (long)header.cache_size,
+          (long)cache->cache_size);
+  }
+
+  request_t *req = new_request();
+  char *md = malloc(OBJ_MD_SIZE);
+  checkpoint_obj_t rec;
+  for (int64_t i = 0; i < header.n_obj; i++) {
+    if (fread(&rec, sizeof(rec), 1, ifile) != 1 || fread(md, OBJ_MD_SIZE, 1, ifile) != 1) {
+      ERROR("checkpoint %s is truncated at object %ld/%ld\n", path, (long)i, (long)header.n_obj);
+    }
+    restore_obj(cache, req, &rec, md);
+  }
+  free(md);
+  free_request(req);
+  fclose(ifile);
+  free(buf);
+
+  cache->n_req = header.n_req;
+  cache->n_insert = header.n_insert;
+  cache->n_promotion = header.n_promotion;
+  cache->n_reinsertion = header.n_reinsertion;
+  if (cache->set_logical_time != NULL) {
+    cache->set_logical_time(cache, header.logical_time);
+  }
+
+  if (reader != NULL) {
+    restore_reader(reader, &header, path);
+  }
+
+  INFO("load checkpoint %s (%s) into %s: %ld objects, %lu requests read\n", path, header.cache_name,
+       cache->cache_name, (long)header.n_obj, (unsigned long)header.n_read_req);
+}
+
+/**
+ * @brief create a new cache that has the same content as old_cache
+ *
+ * @param old_cache
+ * @param init_params
+ * @return cache_t*
+ */
+cache_t *clone_cache_with_state(const cache_t *old_cache, const char *init_params) {
+  if (!cache_support_checkpoint(old_cache)) {
+    ERROR("%s does not support clone with state\n", old_cache->cache_name);
+  }
+
+  common_cache_params_t cc_params = {
+      .cache_size = old_cache->cache_size,
+      .hashpower = old_cache->hashtable->hashpower,
+      .default_ttl = old_cache->default_ttl,
+      .consider_obj_metadata = old_cache->obj_md_size == 0 ? false : true,
+  };
+  cache_t *cache = old_cache->cache_init(cc_params, init_params == NULL ? old_cache->init_params : init_params);
+  if (old_cache->admissioner != NULL) {
+    cache->admissioner = old_cache->admissioner->clone(old_cache->admissioner);
+  }
+  cache->future_stack_dist = old_cache->future_stack_dist;
+  cache->future_stack_dist_array_size = old_cache->future_stack_dist_array_size;
+
+  request_t *req = new_request();
+  checkpoint_obj_t rec;
+  for (cache_obj_t *obj = old_cache->get_queue_tail(old_cache); obj != NULL; obj = obj->queue.prev) {
+    obj_to_record(obj, &rec);
+    restore_obj(cache, req, &rec, (const char *)obj + OBJ_MD_OFFSET);
+  }
+  free_request(req);
+
+  cache->n_req = old_cache->n_req;
+  cache->n_insert = old_cache->n_insert;
+  cache->n_promotion = old_cache->n_promotion;
+  cache->n_reinsertion = old_cache->n_reinsertion;
+  if (cache->set_logical_time != NULL) {
+    cache->set_logical_time(cache, old_cache->get_logical_time(old_cache));
+  }
+
+  DEBUG_ASSERT(cache->get_n_obj(cache) == old_cache->get_n_obj(old_cache));
+  return cache;
+}
+
+#ifdef __cplusplus
+}
+#endif
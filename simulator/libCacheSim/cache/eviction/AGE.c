@@ -30,6 +30,7 @@ static int total_negative = 0;
 // ***********************************************************************
 
 static void AGE_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *AGE_effective_params(const cache_t *cache);
 static void AGE_free(cache_t *cache);
 static bool AGE_get(cache_t *cache, const request_t *req);
 static cache_obj_t *AGE_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -58,6 +59,7 @@ static bool is_retained3(cache_t *cache, cache_obj_t *obj_to_evict, const double
 cache_t *AGE_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("AGE", ccache_params, cache_specific_params);
   cache->cache_init = AGE_init;
+  cache->current_params = AGE_effective_params;
   cache->cache_free = AGE_free;
   cache->get = AGE_get;
   cache->find = AGE_find;
@@ -340,6 +342,10 @@ static const char *AGE_current_params(cache_t *cache, AGE_params_t *params) {
   return params_str;
 }
 
+static const char *AGE_effective_params(const cache_t *cache) {
+  return AGE_current_params((cache_t *)cache, (AGE_params_t *)cache->eviction_params);
+}
+
 static void AGE_parse_params(cache_t *cache, const char *cache_specific_params) {
   AGE_params_t *params = (AGE_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
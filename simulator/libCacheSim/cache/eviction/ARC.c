@@ -59,7 +59,10 @@ typedef struct ARC_params {
 // ***********************************************************************
 
 static void ARC_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *ARC_effective_params(const cache_t *cache);
 static void ARC_free(cache_t *cache);
+static void ARC_get_queue_occupancy(const cache_t *cache, int64_t *small_byte,
+                                    int64_t *main_byte, int64_t *ghost_byte);
 static bool ARC_get(cache_t *cache, const request_t *req);
 static cache_obj_t *ARC_find(cache_t *cache, const request_t *req,
                              const bool update_cache);
@@ -69,6 +72,15 @@ static void ARC_evict(cache_t *cache, const request_t *req);
 static bool ARC_remove(cache_t *cache, const obj_id_t obj_id);
 
 /* internal functions */
+/* T1 is the small queue, T2 is the main queue, B1 and B2 are the ghosts */
+static void ARC_get_queue_occupancy(const cache_t *cache, int64_t *small_byte,
+                                    int64_t *main_byte, int64_t *ghost_byte) {
+  ARC_params_t *params = (ARC_params_t *)(cache->eviction_params);
+  *small_byte = params->L1_data_size;
+  *main_byte = params->L2_data_size;
+  *ghost_byte = params->L1_ghost_size + params->L2_ghost_size;
+}
+
 /* this is the case IV in the paper */
 static void _ARC_evict_miss_on_all_queues(cache_t *cache, const request_t *req);
 static void _ARC_replace(cache_t *cache, const request_t *req);
@@ -101,6 +113,7 @@ cache_t *ARC_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("ARC", ccache_params, cache_specific_params);
   cache->cache_init = ARC_init;
+  cache->current_params = ARC_effective_params;
   cache->cache_free = ARC_free;
   cache->get = ARC_get;
   cache->find = ARC_find;
@@ -111,6 +124,7 @@ cache_t *ARC_init(const common_cache_params_t ccache_params,
   cache->can_insert = cache_can_insert_default;
   cache->get_occupied_byte = cache_get_occupied_byte_default;
   cache->get_n_obj = cache_get_n_obj_default;
+  cache->get_queue_occupancy = ARC_get_queue_occupancy;
 
   if (ccache_params.consider_obj_metadata) {
     // two pointer + ghost metadata
@@ -605,6 +619,10 @@ static const char *ARC_current_params(ARC_params_t *params) {
   return params_str;
 }
 
+static const char *ARC_effective_params(const cache_t *cache) {
+  return ARC_current_params((ARC_params_t *)cache->eviction_params);
+}
+
 static void ARC_parse_params(cache_t *cache,
                              const char *cache_specific_params) {
   ARC_params_t *params = (ARC_params_t *)(cache->eviction_params);
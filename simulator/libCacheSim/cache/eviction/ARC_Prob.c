@@ -42,6 +42,7 @@ typedef struct ARC_Prob_params {
 // ***********************************************************************
 
 static void ARC_Prob_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *ARC_Prob_effective_params(const cache_t *cache);
 static void ARC_Prob_free(cache_t *cache);
 static bool ARC_Prob_get(cache_t *cache, const request_t *req);
 static cache_obj_t *ARC_Prob_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -79,6 +80,7 @@ static bool ARC_Prob_get_debug(cache_t *cache, const request_t *req);
 cache_t *ARC_Prob_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("ARC_Prob", ccache_params, cache_specific_params);
   cache->cache_init = ARC_Prob_init;
+  cache->current_params = ARC_Prob_effective_params;
   cache->cache_free = ARC_Prob_free;
   cache->get = ARC_Prob_get;
   cache->find = ARC_Prob_find;
@@ -468,6 +470,10 @@ static const char *ARC_Prob_current_params(ARC_Prob_params_t *params) {
   return params_str;
 }
 
+static const char *ARC_Prob_effective_params(const cache_t *cache) {
+  return ARC_Prob_current_params((ARC_Prob_params_t *)cache->eviction_params);
+}
+
 static void ARC_Prob_parse_params(cache_t *cache, const char *cache_specific_params) {
   ARC_Prob_params_t *params = (ARC_Prob_params_t *)(cache->eviction_params);
 
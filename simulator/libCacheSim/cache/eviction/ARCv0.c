@@ -52,6 +52,7 @@ typedef struct ARCv0_params {
 
 static void ARCv0_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *ARCv0_effective_params(const cache_t *cache);
 static void ARCv0_free(cache_t *cache);
 static bool ARCv0_get(cache_t *cache, const request_t *req);
 static cache_obj_t *ARCv0_find(cache_t *cache, const request_t *req,
@@ -94,6 +95,7 @@ cache_t *ARCv0_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("ARCv0", ccache_params, cache_specific_params);
   cache->cache_init = ARCv0_init;
+  cache->current_params = ARCv0_effective_params;
   cache->cache_free = ARCv0_free;
   cache->get = ARCv0_get;
   cache->find = ARCv0_find;
@@ -521,6 +523,10 @@ static const char *ARCv0_current_params(ARCv0_params_t *params) {
   return params_str;
 }
 
+static const char *ARCv0_effective_params(const cache_t *cache) {
+  return ARCv0_current_params((ARCv0_params_t *)cache->eviction_params);
+}
+
 static void ARCv0_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   ARCv0_params_t *params = (ARCv0_params_t *)(cache->eviction_params);
@@ -30,6 +30,7 @@ static const char *DEFAULT_PARAMS = "scaler=1.5";
 
 static void BeladyClock_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *BeladyClock_effective_params(const cache_t *cache);
 static void BeladyClock_free(cache_t *cache);
 static bool BeladyClock_get(cache_t *cache, const request_t *req);
 static cache_obj_t *BeladyClock_find(cache_t *cache, const request_t *req,
@@ -56,6 +57,7 @@ cache_t *BeladyClock_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("BeladyClock", ccache_params, cache_specific_params);
   cache->cache_init = BeladyClock_init;
+  cache->current_params = BeladyClock_effective_params;
   cache->cache_free = BeladyClock_free;
   cache->get = BeladyClock_get;
   cache->find = BeladyClock_find;
@@ -318,6 +320,10 @@ static const char *BeladyClock_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *BeladyClock_effective_params(const cache_t *cache) {
+  return BeladyClock_current_params((cache_t *)cache, (BeladyClock_params_t *)cache->eviction_params);
+}
+
 static void BeladyClock_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   BeladyClock_params_t *params = (BeladyClock_params_t *)cache->eviction_params;
@@ -58,6 +58,7 @@ cache_t *BeladyRandomLRU_init(const common_cache_params_t ccache_params, const c
   ccache_params_copy.hashpower = MAX(12, ccache_params_copy.hashpower - 8);
 
   cache_t *cache = cache_struct_init("BeladyRandomLRU-2", ccache_params_copy, cache_specific_params);
+  cache_enable_sample_array(cache);
   cache->cache_init = BeladyRandomLRU_init;
   cache->cache_free = BeladyRandomLRU_free;
   cache->get = BeladyRandomLRU_get;
@@ -181,10 +182,10 @@ static cache_obj_t *BeladyRandomLRU_insert(cache_t *cache, const request_t *req)
 // }
 static cache_obj_t *BeladyRandomLRU_to_evict(cache_t *cache, const request_t *req) {
 #define K 16
-  cache_obj_t *lru_obj = hashtable_rand_obj(cache->hashtable), *curr_obj = NULL;
+  cache_obj_t *lru_obj = cache_rand_obj(cache), *curr_obj = NULL;
 
   for (int i = 0; i < K - 1; i++) {
-    curr_obj = hashtable_rand_obj(cache->hashtable);
+    curr_obj = cache_rand_obj(cache);
     if (curr_obj->Random.last_access_vtime < lru_obj->Random.last_access_vtime) {
       lru_obj = curr_obj;
     }
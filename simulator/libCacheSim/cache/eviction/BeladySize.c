@@ -30,6 +30,7 @@ typedef struct {
 
 static void BeladySize_parse_params(cache_t *cache,
                                     const char *cache_specific_params);
+static const char *BeladySize_effective_params(const cache_t *cache);
 static void BeladySize_free(cache_t *cache);
 static bool BeladySize_get(cache_t *cache, const request_t *req);
 static cache_obj_t *BeladySize_find(cache_t *cache, const request_t *req,
@@ -56,8 +57,12 @@ static void BeladySize_remove_obj(cache_t *cache, cache_obj_t *obj);
 cache_t *BeladySize_init(const common_cache_params_t ccache_params,
                          const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("BeladySize", ccache_params, cache_specific_params);
+#ifndef EXACT_Belady
+  cache_enable_sample_array(cache);
+#endif
 
   cache->cache_init = BeladySize_init;
+  cache->current_params = BeladySize_effective_params;
   cache->cache_free = BeladySize_free;
   cache->get = BeladySize_get;
   cache->find = BeladySize_find;
@@ -221,7 +226,7 @@ static cache_obj_t *BeladySize_to_evict(cache_t *cache, const request_t *req) {
   cache_obj_t *obj_to_evict = NULL, *sampled_obj;
   int64_t obj_to_evict_score = -1, sampled_obj_score;
   for (int i = 0; i < params->n_sample; i++) {
-    sampled_obj = hashtable_rand_obj(cache->hashtable);
+    sampled_obj = cache_rand_obj(cache);
     sampled_obj_score =
         (int64_t)sampled_obj->obj_size *
         (int64_t)(sampled_obj->Belady.next_access_vtime - cache->n_req);
@@ -279,6 +284,10 @@ static const char *BeladySize_current_params(BeladySize_params_t *params) {
   return params_str;
 }
 
+static const char *BeladySize_effective_params(const cache_t *cache) {
+  return BeladySize_current_params((BeladySize_params_t *)cache->eviction_params);
+}
+
 /**
  * parse the given parameters
  * input parameter is a string,
@@ -317,6 +317,7 @@ static void Cacheus_evict(cache_t *cache, const request_t *req) {
 static bool Cacheus_remove(cache_t *cache, const obj_id_t obj_id) {
   Cacheus_params_t *params = (Cacheus_params_t *)(cache->eviction_params);
   params->req_local->obj_id = obj_id;
+  params->req_local->hv = 0;
   bool lru_removed = params->LRU->remove(params->LRU, obj_id);
   bool lfu_removed = params->LFU->remove(params->LFU, obj_id);
   DEBUG_ASSERT(lru_removed == lfu_removed);
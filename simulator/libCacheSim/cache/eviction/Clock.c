@@ -31,7 +31,10 @@ static const char *DEFAULT_PARAMS = "n-bit-counter=1,decrease-rate=1,scale=1.0";
 // ***********************************************************************
 
 static void Clock_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *Clock_effective_params(const cache_t *cache);
 static void Clock_free(cache_t *cache);
+static cache_obj_t *Clock_get_queue_tail(const cache_t *cache);
+static void Clock_restore_obj(cache_t *cache, cache_obj_t *obj);
 static bool Clock_get(cache_t *cache, const request_t *req);
 static cache_obj_t *Clock_find(cache_t *cache, const request_t *req, const bool update_cache);
 static cache_obj_t *Clock_insert(cache_t *cache, const request_t *req);
@@ -54,6 +57,7 @@ static bool Clock_remove(cache_t *cache, const obj_id_t obj_id);
 cache_t *Clock_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("Clock", ccache_params, cache_specific_params);
   cache->cache_init = Clock_init;
+  cache->current_params = Clock_effective_params;
   cache->cache_free = Clock_free;
   cache->get = Clock_get;
   cache->find = Clock_find;
@@ -64,6 +68,8 @@ cache_t *Clock_init(const common_cache_params_t ccache_params, const char *cache
   cache->get_n_obj = cache_get_n_obj_default;
   cache->get_occupied_byte = cache_get_occupied_byte_default;
   cache->to_evict = Clock_to_evict;
+  cache->get_queue_tail = Clock_get_queue_tail;
+  cache->restore_obj = Clock_restore_obj;
   cache->obj_md_size = 0;
   cache->num_stats = 0;
   cache->num_stats2 = 0;
@@ -256,6 +262,7 @@ static void Clock_evict(cache_t *cache, const request_t *req) {
     params->n_byte_rewritten += obj_to_evict->obj_size;
     move_obj_to_head(&params->q_head, &params->q_tail, obj_to_evict);
     cache->n_promotion += 1;
+    cache->n_reinsertion += 1;
     // obj_to_evict->last_promote_itime = cache->n_insert;
     // obj_to_evict->is_promoted = true;
     obj_to_evict = params->q_tail;
@@ -329,6 +336,10 @@ static const char *Clock_current_params(cache_t *cache, Clock_params_t *params)
   return params_str;
 }
 
+static const char *Clock_effective_params(const cache_t *cache) {
+  return Clock_current_params((cache_t *)cache, (Clock_params_t *)cache->eviction_params);
+}
+
 static void Clock_parse_params(cache_t *cache, const char *cache_specific_params) {
   Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
@@ -374,6 +385,17 @@ static void Clock_parse_params(cache_t *cache, const char *cache_specific_params
   free(old_params_str);
 }
 
+static cache_obj_t *Clock_get_queue_tail(const cache_t *cache) {
+  Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
+  return params->q_tail;
+}
+
+/* the state may come from a cache with a wider counter */
+static void Clock_restore_obj(cache_t *cache, cache_obj_t *obj) {
+  Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
+  if (obj->clock.freq > params->max_freq) obj->clock.freq = params->max_freq;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,7 @@ static const char *DEFAULT_PARAMS = "n-bit-counter=1,decrease-rate=1,scale=1.0";
 // ***********************************************************************
 
 static void DelayClock_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *DelayClock_effective_params(const cache_t *cache);
 static void DelayClock_free(cache_t *cache);
 static bool DelayClock_get(cache_t *cache, const request_t *req);
 static cache_obj_t *DelayClock_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -52,6 +53,7 @@ static bool DelayClock_remove(cache_t *cache, const obj_id_t obj_id);
 cache_t *DelayClock_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("DelayClock", ccache_params, cache_specific_params);
   cache->cache_init = DelayClock_init;
+  cache->current_params = DelayClock_effective_params;
   cache->cache_free = DelayClock_free;
   cache->get = DelayClock_get;
   cache->find = DelayClock_find;
@@ -344,6 +346,10 @@ static const char *DelayClock_current_params(cache_t *cache, Clock_params_t *par
   return params_str;
 }
 
+static const char *DelayClock_effective_params(const cache_t *cache) {
+  return DelayClock_current_params((cache_t *)cache, (Clock_params_t *)cache->eviction_params);
+}
+
 static void DelayClock_parse_params(cache_t *cache, const char *cache_specific_params) {
   Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
@@ -31,7 +31,12 @@ static const char *DEFAULT_PARAMS = "n-bit-counter=1,delay-ratio=0.05";
 // ***********************************************************************
 
 static void DelayFR_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *DelayFR_effective_params(const cache_t *cache);
 static void DelayFR_free(cache_t *cache);
+static cache_obj_t *DelayFR_get_queue_tail(const cache_t *cache);
+static void DelayFR_restore_obj(cache_t *cache, cache_obj_t *obj);
+static int64_t DelayFR_get_logical_time(const cache_t *cache);
+static void DelayFR_set_logical_time(cache_t *cache, int64_t time);
 static bool DelayFR_get(cache_t *cache, const request_t *req);
 static cache_obj_t *DelayFR_find(cache_t *cache, const request_t *req, const bool update_cache);
 static cache_obj_t *DelayFR_insert(cache_t *cache, const request_t *req);
@@ -54,6 +59,7 @@ static bool DelayFR_remove(cache_t *cache, const obj_id_t obj_id);
 cache_t *DelayFR_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("DelayFR", ccache_params, cache_specific_params);
   cache->cache_init = DelayFR_init;
+  cache->current_params = DelayFR_effective_params;
   cache->cache_free = DelayFR_free;
   cache->get = DelayFR_get;
   cache->find = DelayFR_find;
@@ -64,6 +70,10 @@ cache_t *DelayFR_init(const common_cache_params_t ccache_params, const char *cac
   cache->get_n_obj = cache_get_n_obj_default;
   cache->get_occupied_byte = cache_get_occupied_byte_default;
   cache->to_evict = DelayFR_to_evict;
+  cache->get_queue_tail = DelayFR_get_queue_tail;
+  cache->restore_obj = DelayFR_restore_obj;
+  cache->get_logical_time = DelayFR_get_logical_time;
+  cache->set_logical_time = DelayFR_set_logical_time;
   cache->obj_md_size = 0;
   cache->num_stats = 0;
   cache->num_stats2 = 0;
@@ -221,6 +231,7 @@ static void DelayFR_evict(cache_t *cache, const request_t *req) {
   params->n_byte_rewritten += obj_to_evict->obj_size;
 
   cache->n_promotion += 1;
+  cache->n_reinsertion += 1;
   params->current_time += 1;
 }
 
@@ -283,6 +294,10 @@ static const char *DelayFR_current_params(cache_t *cache, DelayFR_params_t *para
   return params_str;
 }
 
+static const char *DelayFR_effective_params(const cache_t *cache) {
+  return DelayFR_current_params((cache_t *)cache, (DelayFR_params_t *)cache->eviction_params);
+}
+
 static void DelayFR_parse_params(cache_t *cache, const char *cache_specific_params) {
   DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
@@ -325,6 +340,27 @@ static void DelayFR_parse_params(cache_t *cache, const char *cache_specific_para
   free(old_params_str);
 }
 
+static cache_obj_t *DelayFR_get_queue_tail(const cache_t *cache) {
+  DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
+  return params->q_tail;
+}
+
+/* the state may come from a cache with a wider counter */
+static void DelayFR_restore_obj(cache_t *cache, cache_obj_t *obj) {
+  DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
+  if (obj->delay_FR.freq > params->max_freq) obj->delay_FR.freq = params->max_freq;
+}
+
+static int64_t DelayFR_get_logical_time(const cache_t *cache) {
+  DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
+  return (int64_t)params->current_time;
+}
+
+static void DelayFR_set_logical_time(cache_t *cache, int64_t time) {
+  DelayFR_params_t *params = (DelayFR_params_t *)cache->eviction_params;
+  params->current_time = time;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,7 @@ extern "C" {
 // ***********************************************************************
 
 static void Delay_offline_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *Delay_offline_effective_params(const cache_t *cache);
 static void Delay_offline_free(cache_t *cache);
 static bool Delay_offline_get(cache_t *cache, const request_t *req);
 static cache_obj_t *Delay_offline_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -66,6 +67,7 @@ static double percentile = 0.5; //parameter
 cache_t *Delay_offline_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("Delay_offline", ccache_params, cache_specific_params);
   cache->cache_init = Delay_offline_init;
+  cache->current_params = Delay_offline_effective_params;
   cache->cache_free = Delay_offline_free;
   cache->get = Delay_offline_get;
   cache->find = Delay_offline_find;
@@ -325,6 +327,10 @@ static const char *Delay_offline_current_params(LRU_delay_params_t *params) {
   return params_str;
 }
 
+static const char *Delay_offline_effective_params(const cache_t *cache) {
+  return Delay_offline_current_params((LRU_delay_params_t *)cache->eviction_params);
+}
+
 static void Delay_offline_parse_params(cache_t *cache, const char *cache_specific_params) {
   LRU_delay_params_t *params = (LRU_delay_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
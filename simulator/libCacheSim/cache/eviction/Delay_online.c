@@ -46,6 +46,7 @@ extern "C" {
 // ***********************************************************************
 
 static void Delay_online_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *Delay_online_effective_params(const cache_t *cache);
 static void Delay_online_free(cache_t *cache);
 static bool Delay_online_get(cache_t *cache, const request_t *req);
 static cache_obj_t *Delay_online_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -70,6 +71,7 @@ double next_access_time(double prev_arrival, double mean_interarrival, double pe
 cache_t *Delay_online_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("Delay_online", ccache_params, cache_specific_params);
   cache->cache_init = Delay_online_init;
+  cache->current_params = Delay_online_effective_params;
   cache->cache_free = Delay_online_free;
   cache->get = Delay_online_get;
   cache->find = Delay_online_find;
@@ -357,6 +359,10 @@ static const char *Delay_online_current_params(LRU_delay_params_t *params) {
   return params_str;
 }
 
+static const char *Delay_online_effective_params(const cache_t *cache) {
+  return Delay_online_current_params((LRU_delay_params_t *)cache->eviction_params);
+}
+
 static void Delay_online_parse_params(cache_t *cache, const char *cache_specific_params) {
   LRU_delay_params_t *params = (LRU_delay_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
@@ -25,6 +25,7 @@ extern "C" {
 static void FIFO_parse_params(cache_t *cache,
                               const char *cache_specific_params);
 static void FIFO_free(cache_t *cache);
+static cache_obj_t *FIFO_get_queue_tail(const cache_t *cache);
 static bool FIFO_get(cache_t *cache, const request_t *req);
 static cache_obj_t *FIFO_find(cache_t *cache, const request_t *req,
                               const bool update_cache);
@@ -58,6 +59,7 @@ cache_t *FIFO_init(const common_cache_params_t ccache_params,
   cache->evict = FIFO_evict;
   cache->remove = FIFO_remove;
   cache->to_evict = FIFO_to_evict;
+  cache->get_queue_tail = FIFO_get_queue_tail;
   cache->get_occupied_byte = cache_get_occupied_byte_default;
   cache->get_n_obj = cache_get_n_obj_default;
   cache->can_insert = cache_can_insert_default;
@@ -233,6 +235,11 @@ static void print_FIFO(cache_t *cache) {
   printf("\n");
 }
 
+static cache_obj_t *FIFO_get_queue_tail(const cache_t *cache) {
+  FIFO_params_t *params = (FIFO_params_t *)cache->eviction_params;
+  return params->q_tail;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,6 +57,7 @@ typedef struct FIFO_Merge_params {
 
 static void FIFO_Merge_parse_params(cache_t *cache,
                                      const char *cache_specific_params);
+static const char *FIFO_Merge_effective_params(const cache_t *cache);
 static void FIFO_Merge_free(cache_t *cache);
 static bool FIFO_Merge_get(cache_t *cache, const request_t *req);
 static cache_obj_t *FIFO_Merge_find(cache_t *cache, const request_t *req,
@@ -92,6 +93,7 @@ cache_t *FIFO_Merge_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("FIFO_Merge", ccache_params, cache_specific_params);
   cache->cache_init = FIFO_Merge_init;
+  cache->current_params = FIFO_Merge_effective_params;
   cache->cache_free = FIFO_Merge_free;
   cache->get = FIFO_Merge_get;
   cache->find = FIFO_Merge_find;
@@ -342,6 +344,10 @@ static const char *FIFO_Merge_current_params(FIFO_Merge_params_t *params) {
   return params_str;
 }
 
+static const char *FIFO_Merge_effective_params(const cache_t *cache) {
+  return FIFO_Merge_current_params((FIFO_Merge_params_t *)cache->eviction_params);
+}
+
 static void FIFO_Merge_parse_params(cache_t *cache,
                                      const char *cache_specific_params) {
   FIFO_Merge_params_t *params = (FIFO_Merge_params_t *)cache->eviction_params;
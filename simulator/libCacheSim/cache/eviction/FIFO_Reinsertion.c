@@ -60,6 +60,7 @@ typedef struct FIFO_Reinsertion_params {
 
 static void FIFO_Reinsertion_parse_params(cache_t *cache,
                                            const char *cache_specific_params);
+static const char *FIFO_Reinsertion_effective_params(const cache_t *cache);
 static void FIFO_Reinsertion_free(cache_t *cache);
 static bool FIFO_Reinsertion_get(cache_t *cache, const request_t *req);
 static cache_obj_t *FIFO_Reinsertion_find(cache_t *cache, const request_t *req,
@@ -97,6 +98,7 @@ cache_t *FIFO_Reinsertion_init(const common_cache_params_t ccache_params,
                                 const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("FIFO_Reinsertion", ccache_params, cache_specific_params);
   cache->cache_init = FIFO_Reinsertion_init;
+  cache->current_params = FIFO_Reinsertion_effective_params;
   cache->cache_free = FIFO_Reinsertion_free;
   cache->get = FIFO_Reinsertion_get;
   cache->find = FIFO_Reinsertion_find;
@@ -311,6 +313,7 @@ static void FIFO_Reinsertion_evict(cache_t *cache, const request_t *req) {
 
     params->n_obj_rewritten += 1;
     params->n_byte_rewritten += cache_obj->obj_size;
+    cache->n_reinsertion += 1;
   }
 }
 
@@ -361,6 +364,10 @@ static const char *FIFO_Reinsertion_current_params(
   return params_str;
 }
 
+static const char *FIFO_Reinsertion_effective_params(const cache_t *cache) {
+  return FIFO_Reinsertion_current_params((FIFO_Reinsertion_params_t *)cache->eviction_params);
+}
+
 static void FIFO_Reinsertion_parse_params(cache_t *cache,
                                            const char *cache_specific_params) {
   FIFO_Reinsertion_params_t *params =
@@ -375,10 +375,14 @@ static void construction(void* c){
   params->regular_cache_miss = 0;
   // // destroy any previous hashtable
   if (params->hash_table_f != NULL){
+#if HASHTABLE_TYPE == SWISS_HASHTABLE
+    free_chained_hashtable_f(params->hash_table_f);
+#else
     free_chained_hashtable_f_v2(params->hash_table_f);
     my_free(sizeof(cache_obj_t *) * hashsize(params->hash_table_f->hashpower),
           params->hash_table_f->ptr_table);
     my_free(sizeof(hashtable_t), params->hash_table_f);
+#endif
   }
   params->hash_table_f = create_hashtable(16);
   // // split the list
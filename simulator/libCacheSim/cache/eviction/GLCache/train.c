@@ -1,4 +1,5 @@
 
+#include <errno.h>
 #include <math.h>
 #include <xgboost/c_api.h>
 
@@ -19,42 +20,54 @@ static void debug_print_feature_matrix(const DMatrixHandle handle,
   printf("\n");
 }
 
-static void train_xgboost(cache_t *cache) {
+/* free the matrices of the last training and build new ones from the
+ * snapshot, this runs on the cache thread because it reads the segments */
+static void prepare_xgboost_data(cache_t *cache) {
   GLCache_params_t *params = cache->eviction_params;
   learner_t *learner = &params->learner;
 
   if (learner->n_train != 0) {
-    safe_call(XGBoosterFree(learner->booster));
     safe_call(XGDMatrixFree(learner->train_dm));
     safe_call(XGDMatrixFree(learner->valid_dm));
   }
 
   prepare_training_data(cache);
   // debug_print_feature_matrix(learner->train_dm, 20);
+}
+
+/* train a model from train_dm and valid_dm, it does not touch the cache, so
+ * it can run on the training thread */
+static BoosterHandle fit_xgboost(GLCache_params_t *params) {
+  learner_t *learner = &params->learner;
+  BoosterHandle booster;
 
   DMatrixHandle eval_dmats[2] = {learner->train_dm, learner->valid_dm};
   static const char *eval_names[2] = {"train", "valid"};
   const char *eval_result;
   double train_loss, valid_loss, last_valid_loss = 0;
   int n_stable_iter = 0;
+  bst_ulong n_valid_samples;
+  char n_thread_str[16];
 
-  safe_call(XGBoosterCreate(eval_dmats, 1, &learner->booster));
-  safe_call(XGBoosterSetParam(learner->booster, "booster", "gbtree"));
-  safe_call(XGBoosterSetParam(learner->booster, "verbosity", "1"));
-  safe_call(XGBoosterSetParam(learner->booster, "nthread", "1"));
+  safe_call(XGDMatrixNumRow(learner->valid_dm, &n_valid_samples));
+  snprintf(n_thread_str, sizeof(n_thread_str), "%d", params->n_train_thread);
+
+  safe_call(XGBoosterCreate(eval_dmats, 1, &booster));
+  safe_call(XGBoosterSetParam(booster, "booster", "gbtree"));
+  safe_call(XGBoosterSetParam(booster, "verbosity", "1"));
+  safe_call(XGBoosterSetParam(booster, "nthread", n_thread_str));
 #if OBJECTIVE == REG
-  safe_call(
-      XGBoosterSetParam(learner->booster, "objective", "reg:squarederror"));
+  safe_call(XGBoosterSetParam(booster, "objective", "reg:squarederror"));
 #elif OBJECTIVE == LTR
-  safe_call(XGBoosterSetParam(learner->booster, "objective", "rank:pairwise"));
+  safe_call(XGBoosterSetParam(booster, "objective", "rank:pairwise"));
 #endif
 
   for (int i = 0; i < N_TRAIN_ITER; ++i) {
     // Update the model performance for each iteration
-    safe_call(XGBoosterUpdateOneIter(learner->booster, i, learner->train_dm));
-    if (learner->n_valid_samples < 10) continue;
-    safe_call(XGBoosterEvalOneIter(learner->booster, i, eval_dmats, eval_names,
-                                   2, &eval_result));
+    safe_call(XGBoosterUpdateOneIter(booster, i, learner->train_dm));
+    if (n_valid_samples < 10) continue;
+    safe_call(XGBoosterEvalOneIter(booster, i, eval_dmats, eval_names, 2,
+                                   &eval_result));
 #if OBJECTIVE == REG
     char *train_pos = strstr(eval_result, "train-rmse:") + 11;
     char *valid_pos = strstr(eval_result, "valid-rmse") + 11;
@@ -84,18 +97,35 @@ static void train_xgboost(cache_t *cache) {
 #error
 #endif
   }
+
+  return booster;
+}
+
+/* replace the model used by the cache with a newly trained one */
+static void use_new_model(cache_t *cache, BoosterHandle booster) {
+  GLCache_params_t *params = cache->eviction_params;
+  learner_t *learner = &params->learner;
+
+  if (learner->n_train != 0) {
+    safe_call(XGBoosterFree(learner->booster));
+  }
+  learner->booster = booster;
+
 #ifndef __APPLE__
   safe_call(XGBoosterBoostedRounds(learner->booster, &learner->n_trees));
 #endif
 
+  bst_ulong n_train_samples, n_valid_samples;
+  safe_call(XGDMatrixNumRow(learner->train_dm, &n_train_samples));
+  safe_call(XGDMatrixNumRow(learner->valid_dm, &n_valid_samples));
   DEBUG(
       "%.2lf hour, cache size %.2lf MB, vtime %ld, train/valid %d/%d samples, "
       "%d trees, "
       "rank intvl %.4lf\n",
       (double)params->curr_rtime / 3600.0,
       (double)cache->cache_size / 1024.0 / 1024.0, (long)params->curr_vtime,
-      (int)learner->n_train_samples, (int)learner->n_valid_samples,
-      learner->n_trees, params->rank_intvl);
+      (int)n_train_samples, (int)n_valid_samples, learner->n_trees,
+      params->rank_intvl);
 
 #ifdef DUMP_MODEL
   {
@@ -105,10 +135,44 @@ static void train_xgboost(cache_t *cache) {
     INFO("dump model %s\n", s);
   }
 #endif
+
+  learner->n_train += 1;
+}
+
+static void *train_thread_func(void *arg) {
+  GLCache_params_t *params = arg;
+  learner_t *learner = &params->learner;
+
+  learner->new_booster = fit_xgboost(params);
+  __atomic_store_n(&learner->train_done, true, __ATOMIC_RELEASE);
+
+  return NULL;
+}
+
+/**
+ * @brief use the model trained in the background if it is ready
+ *
+ * @param cache
+ * @param wait whether to wait for the training to finish
+ */
+void install_trained_model(cache_t *cache, bool wait) {
+  GLCache_params_t *params = cache->eviction_params;
+  learner_t *learner = &params->learner;
+
+  if (!learner->training) return;
+  if (!wait && !__atomic_load_n(&learner->train_done, __ATOMIC_ACQUIRE)) {
+    return;
+  }
+
+  pthread_join(learner->train_thread, NULL);
+  learner->training = false;
+  use_new_model(cache, learner->new_booster);
+  learner->new_booster = NULL;
 }
 
 void train(cache_t *cache) {
   GLCache_params_t *params = (GLCache_params_t *)cache->eviction_params;
+  learner_t *learner = &params->learner;
 
   uint64_t start_time = gettime_usec();
 #ifdef LOAD_MODEL
@@ -118,15 +182,30 @@ void train(cache_t *cache) {
 
     safe_call(XGBoosterLoadModel(learner->booster, s));
     INFO("Load model %s\n", s);
+    learner->n_train += 1;
   }
 #else
-  train_xgboost(cache);
+  if (params->async_train) {
+    /* one model is trained at a time, the matrices of the last one cannot be
+     * freed before it finishes */
+    install_trained_model(cache, true);
+    prepare_xgboost_data(cache);
+
+    learner->training = true;
+    __atomic_store_n(&learner->train_done, false, __ATOMIC_RELAXED);
+    if (pthread_create(&learner->train_thread, NULL, train_thread_func,
+                       params) != 0) {
+      ERROR("cannot create the training thread: %s\n", strerror(errno));
+    }
+  } else {
+    prepare_xgboost_data(cache);
+    use_new_model(cache, fit_xgboost(params));
+  }
 #endif
 
   uint64_t end_time = gettime_usec();
   // INFO("training time %.4lf sec\n", (end_time - start_time) / 1000000.0);
-  params->learner.n_train += 1;
-  params->learner.last_train_rtime = params->curr_rtime;
-  params->learner.n_train_samples = 0;
-  params->learner.n_valid_samples = 0;
+  learner->last_train_rtime = params->curr_rtime;
+  learner->n_train_samples = 0;
+  learner->n_valid_samples = 0;
 }
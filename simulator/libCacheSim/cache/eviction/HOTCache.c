@@ -85,6 +85,7 @@ static inline int64_t HOTCache_get_n_obj(const cache_t *cache);
 static inline bool HOTCache_can_insert(cache_t *cache, const request_t *req);
 static void HOTCache_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *HOTCache_effective_params(const cache_t *cache);
 static void incr_freq(cache_obj_t *obj, int epoch_cur);
 
 // ***********************************************************************
@@ -97,6 +98,7 @@ cache_t *HOTCache_init(const common_cache_params_t ccache_params,
                      const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("HOTCache", ccache_params, cache_specific_params);
   cache->cache_init = HOTCache_init;
+  cache->current_params = HOTCache_effective_params;
   cache->cache_free = HOTCache_free;
   cache->get = HOTCache_get;
   cache->find = HOTCache_find;
@@ -501,6 +503,10 @@ static const char *HOTCache_current_params(HOTCache_params_t *params) {
   return params_str;
 }
 
+static const char *HOTCache_effective_params(const cache_t *cache) {
+  return HOTCache_current_params((HOTCache_params_t *)cache->eviction_params);
+}
+
 static void incr_freq(cache_obj_t *obj, int epoch_cur){
   if (obj -> misc.epoch_freq == epoch_cur){
     obj -> misc.freq++;
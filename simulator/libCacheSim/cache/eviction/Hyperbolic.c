@@ -19,6 +19,7 @@ typedef struct Hyperbolic_params {
 
 static void Hyperbolic_parse_params(cache_t *cache,
                                     const char *cache_specific_params);
+static const char *Hyperbolic_effective_params(const cache_t *cache);
 static void Hyperbolic_free(cache_t *cache);
 static bool Hyperbolic_get(cache_t *cache, const request_t *req);
 static cache_obj_t *Hyperbolic_find(cache_t *cache, const request_t *req,
@@ -47,7 +48,9 @@ cache_t *Hyperbolic_init(const common_cache_params_t ccache_params,
   ccache_params_local.hashpower = MAX(12, ccache_params_local.hashpower - 8);
 
   cache_t *cache = cache_struct_init("Hyperbolic", ccache_params_local, cache_specific_params);
+  cache_enable_sample_array(cache);
   cache->cache_init = Hyperbolic_init;
+  cache->current_params = Hyperbolic_effective_params;
   cache->cache_free = Hyperbolic_free;
   cache->get = Hyperbolic_get;
   cache->find = Hyperbolic_find;
@@ -169,7 +172,7 @@ static cache_obj_t *Hyperbolic_to_evict(cache_t *cache, const request_t *req) {
   cache_obj_t *best_candidate = NULL, *sampled_obj;
   double best_candidate_score = 1.0e16, sampled_obj_score;
   for (int i = 0; i < params->n_sample; i++) {
-    sampled_obj = hashtable_rand_obj(cache->hashtable);
+    sampled_obj = cache_rand_obj(cache);
     double age =
         (double)(cache->n_req - sampled_obj->hyperbolic.vtime_enter_cache);
     sampled_obj_score = 1.0e8 * (double)sampled_obj->hyperbolic.freq / age;
@@ -251,6 +254,10 @@ static const char *Hyperbolic_current_params(Hyperbolic_params_t *params) {
   return params_str;
 }
 
+static const char *Hyperbolic_effective_params(const cache_t *cache) {
+  return Hyperbolic_current_params((Hyperbolic_params_t *)cache->eviction_params);
+}
+
 static void Hyperbolic_parse_params(cache_t *cache,
                                     const char *cache_specific_params) {
   char *end;
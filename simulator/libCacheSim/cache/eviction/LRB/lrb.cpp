@@ -11,69 +11,109 @@ using namespace chrono;
 using namespace std;
 using namespace lrb;
 
-void LRBCache::train() {
-    ++n_retrain;
-    auto timeBegin = chrono::system_clock::now();
-    if (booster) LGBM_BoosterFree(booster);
+BoosterHandle LRBCache::fit(TrainingData *data, const string &params_str, int n_iter, double &se) {
+    BoosterHandle model;
     // create training dataset
     DatasetHandle trainData;
     LGBM_DatasetCreateFromCSR(
-            static_cast<void *>(training_data->indptr.data()),
+            static_cast<void *>(data->indptr.data()),
             C_API_DTYPE_INT32,
-            training_data->indices.data(),
-            static_cast<void *>(training_data->data.data()),
+            data->indices.data(),
+            static_cast<void *>(data->data.data()),
             C_API_DTYPE_FLOAT64,
-            training_data->indptr.size(),
-            training_data->data.size(),
+            data->indptr.size(),
+            data->data.size(),
             n_feature,  //remove future t
-            map_to_string(training_params).c_str(),
+            params_str.c_str(),
             nullptr,
             &trainData);
 
     LGBM_DatasetSetField(trainData,
                          "label",
-                         static_cast<void *>(training_data->labels.data()),
-                         training_data->labels.size(),
+                         static_cast<void *>(data->labels.data()),
+                         data->labels.size(),
                          C_API_DTYPE_FLOAT32);
 
     // init booster
-    LGBM_BoosterCreate(trainData, map_to_string(training_params).c_str(), &booster);
+    LGBM_BoosterCreate(trainData, params_str.c_str(), &model);
     // train
-    for (int i = 0; i < stoi(training_params["num_iterations"]); i++) {
+    for (int i = 0; i < n_iter; i++) {
         int isFinished;
-        LGBM_BoosterUpdateOneIter(booster, &isFinished);
+        LGBM_BoosterUpdateOneIter(model, &isFinished);
         if (isFinished) {
             break;
         }
     }
 
     int64_t len;
-    vector<double> result(training_data->indptr.size() - 1);
-    LGBM_BoosterPredictForCSR(booster,
-                              static_cast<void *>(training_data->indptr.data()),
+    vector<double> result(data->indptr.size() - 1);
+    LGBM_BoosterPredictForCSR(model,
+                              static_cast<void *>(data->indptr.data()),
                               C_API_DTYPE_INT32,
-                              training_data->indices.data(),
-                              static_cast<void *>(training_data->data.data()),
+                              data->indices.data(),
+                              static_cast<void *>(data->data.data()),
                               C_API_DTYPE_FLOAT64,
-                              training_data->indptr.size(),
-                              training_data->data.size(),
+                              data->indptr.size(),
+                              data->data.size(),
                               n_feature,  //remove future t
                               C_API_PREDICT_NORMAL,
                               0,
-                              atoi(training_params["num_iterations"].c_str()),
-                              map_to_string(training_params).c_str(),
+                              n_iter,
+                              params_str.c_str(),
                               &len,
                               result.data());
 
 
-    double se = 0;
+    se = 0;
     for (int i = 0; i < result.size(); ++i) {
-        auto diff = result[i] - training_data->labels[i];
+        auto diff = result[i] - data->labels[i];
         se += diff * diff;
     }
-    training_loss = training_loss * 0.99 + se / batch_size * 0.01;
 
     LGBM_DatasetFree(trainData);
+    return model;
+}
+
+void LRBCache::install_model(bool wait) {
+    if (!train_thread.joinable()) return;
+    if (!wait && !train_done.load(memory_order_acquire)) return;
+
+    train_thread.join();
+    if (booster) LGBM_BoosterFree(booster);
+    booster = bg_booster;
+    bg_booster = nullptr;
+    training_loss = training_loss * 0.99 + bg_se / batch_size * 0.01;
+    training_time = 0.95 * training_time + 0.05 * bg_training_time;
+}
+
+void LRBCache::train() {
+    ++n_retrain;
+    // the thread only reads the parameters as a string, not the map
+    string params_str = map_to_string(training_params);
+    int n_iter = stoi(training_params["num_iterations"]);
+
+    if (async_train) {
+        //one batch is trained at a time, the buffer of the last one is reused
+        install_model(true);
+        if (!bg_training_data) bg_training_data = new TrainingData(n_feature, memory_window);
+        //the caller clears training_data after train() returns
+        swap(training_data, bg_training_data);
+        train_done.store(false, memory_order_relaxed);
+        train_thread = thread([this, params_str, n_iter]() {
+            auto timeBegin = chrono::system_clock::now();
+            bg_booster = fit(bg_training_data, params_str, n_iter, bg_se);
+            bg_training_time = chrono::duration_cast<chrono::milliseconds>(
+                    chrono::system_clock::now() - timeBegin).count();
+            train_done.store(true, memory_order_release);
+        });
+        return;
+    }
+
+    auto timeBegin = chrono::system_clock::now();
+    if (booster) LGBM_BoosterFree(booster);
+    double se;
+    booster = fit(training_data, params_str, n_iter, se);
+    training_loss = training_loss * 0.99 + se / batch_size * 0.01;
     training_time = 0.95 * training_time +
                     0.05 * chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now() - timeBegin).count();
 }
@@ -128,6 +168,8 @@ bool LRBCache::lookup(const SimpleRequest &req) {
     bool ret;
     ++current_seq;
 
+    if (async_train) install_model(false);
+
     forget();
 
     //first update the metadata: insert/update, which can trigger pending data.mature
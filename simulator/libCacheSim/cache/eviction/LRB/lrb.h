@@ -17,6 +17,8 @@
 #include <sstream>
 #include <fstream>
 #include <list>
+#include <atomic>
+#include <thread>
 
 using namespace webcachesim;
 using namespace std;
@@ -285,7 +287,7 @@ public:
 
     InCacheLRUQueue in_cache_lru_queue;
     shared_ptr<sparse_hash_map<uint64_t, uint64_t>> negative_candidate_queue;
-    TrainingData *training_data;
+    TrainingData *training_data = nullptr;
 
     // sample_size: use n_memorize keys + random choose (sample_rate - n_memorize) keys
     uint sample_rate = 64;
@@ -298,6 +300,17 @@ public:
 
     BoosterHandle booster = nullptr;
 
+    /* async training: a full batch is swapped into bg_training_data and
+     * trained on train_thread, rank() keeps using booster until the new
+     * model is installed on a later lookup */
+    bool async_train = false;
+    TrainingData *bg_training_data = nullptr;
+    std::thread train_thread;
+    std::atomic<bool> train_done{false};
+    BoosterHandle bg_booster = nullptr;
+    double bg_se = 0;
+    double bg_training_time = 0;
+
     unordered_map<string, string> training_params = {
             //don't use alias here. C api may not recognize
             {"boosting",         "gbdt"},
@@ -348,6 +361,15 @@ public:
                 training_params["learning_rate"] = it.second;
             } else if (it.first == "num_threads") {
                 training_params["num_threads"] = it.second;
+            } else if (it.first == "train_mode") {
+                if (it.second == "sync")
+                    async_train = false;
+                else if (it.second == "async")
+                    async_train = true;
+                else {
+                    cerr << "error: unknown train_mode, support sync/async" << endl;
+                    exit(-1);
+                }
             } else if (it.first == "num_leaves") {
                 training_params["num_leaves"] = it.second;
             } else if (it.first == "byte_million_req") {
@@ -400,6 +422,13 @@ public:
         training_data = new TrainingData(n_feature, memory_window);
     }
 
+    ~LRBCache() override {
+        install_model(true);
+        if (booster) LGBM_BoosterFree(booster);
+        delete training_data;
+        delete bg_training_data;
+    }
+
     string map_to_string(unordered_map<string, string> &map) {
         stringstream ss;
         for (auto &it: map) {
@@ -424,6 +453,12 @@ public:
 
     void train();
 
+    //train on data and return the model, se is the squared error on data
+    BoosterHandle fit(TrainingData *data, const string &params_str, int n_iter, double &se);
+
+    //use the model trained in the background if it is ready (or wait for it)
+    void install_model(bool wait);
+
     void sample();
 
     void update_stat_periodic() override;
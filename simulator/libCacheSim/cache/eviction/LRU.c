@@ -25,6 +25,7 @@ extern "C" {
 // ***********************************************************************
 
 static void LRU_free(cache_t *cache);
+static cache_obj_t *LRU_get_queue_tail(const cache_t *cache);
 static bool LRU_get(cache_t *cache, const request_t *req);
 static cache_obj_t *LRU_find(cache_t *cache, const request_t *req,
                              const bool update_cache);
@@ -58,6 +59,7 @@ cache_t *LRU_init(const common_cache_params_t ccache_params,
   cache->evict = LRU_evict;
   cache->remove = LRU_remove;
   cache->to_evict = LRU_to_evict;
+  cache->get_queue_tail = LRU_get_queue_tail;
   cache->get_occupied_byte = cache_get_occupied_byte_default;
   cache->can_insert = cache_can_insert_default;
   cache->get_n_obj = cache_get_n_obj_default;
@@ -288,6 +290,11 @@ static void LRU_print_cache(const cache_t *cache) {
   printf("END\n");
 }
 
+static cache_obj_t *LRU_get_queue_tail(const cache_t *cache) {
+  LRU_params_t *params = (LRU_params_t *)cache->eviction_params;
+  return params->q_tail;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -32,7 +32,9 @@ typedef struct LRU_Prob_params {
 // ***********************************************************************
 
 static void LRU_Prob_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *LRU_Prob_effective_params(const cache_t *cache);
 static void LRU_Prob_free(cache_t *cache);
+static cache_obj_t *LRU_Prob_get_queue_tail(const cache_t *cache);
 static bool LRU_Prob_get(cache_t *cache, const request_t *req);
 static cache_obj_t *LRU_Prob_find(cache_t *cache, const request_t *req,
                              const bool update_cache);
@@ -59,6 +61,7 @@ cache_t *LRU_Prob_init(const common_cache_params_t ccache_params,
                        const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LRU_Prob", ccache_params, cache_specific_params);
   cache->cache_init = LRU_Prob_init;
+  cache->current_params = LRU_Prob_effective_params;
   cache->cache_free = LRU_Prob_free;
   cache->get = LRU_Prob_get;
   cache->find = LRU_Prob_find;
@@ -66,6 +69,7 @@ cache_t *LRU_Prob_init(const common_cache_params_t ccache_params,
   cache->evict = LRU_Prob_evict;
   cache->remove = LRU_Prob_remove;
   cache->to_evict = LRU_Prob_to_evict;
+  cache->get_queue_tail = LRU_Prob_get_queue_tail;
   if (ccache_params.consider_obj_metadata) {
     cache->obj_md_size = 8 * 2;
   } else {
@@ -249,6 +253,10 @@ static const char *LRU_Prob_current_params(LRU_Prob_params_t *params) {
   return params_str;
 }
 
+static const char *LRU_Prob_effective_params(const cache_t *cache) {
+  return LRU_Prob_current_params((LRU_Prob_params_t *)cache->eviction_params);
+}
+
 static void LRU_Prob_parse_params(cache_t *cache,
                                   const char *cache_specific_params) {
   LRU_Prob_params_t *params = (LRU_Prob_params_t *)cache->eviction_params;
@@ -285,6 +293,11 @@ static void LRU_Prob_parse_params(cache_t *cache,
 }
 
 
+static cache_obj_t *LRU_Prob_get_queue_tail(const cache_t *cache) {
+  LRU_Prob_params_t *params = (LRU_Prob_params_t *)cache->eviction_params;
+  return params->q_tail;
+}
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -36,7 +36,11 @@ extern "C" {
 // ***********************************************************************
 
 static void LRU_delay_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *LRU_delay_effective_params(const cache_t *cache);
 static void LRU_delay_free(cache_t *cache);
+static cache_obj_t *LRU_delay_get_queue_tail(const cache_t *cache);
+static int64_t LRU_delay_get_logical_time(const cache_t *cache);
+static void LRU_delay_set_logical_time(cache_t *cache, int64_t time);
 static bool LRU_delay_get(cache_t *cache, const request_t *req);
 static cache_obj_t *LRU_delay_find(cache_t *cache, const request_t *req,
                              const bool update_cache);
@@ -61,6 +65,7 @@ cache_t *LRU_delay_init(const common_cache_params_t ccache_params,
                   const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LRU_delay", ccache_params, cache_specific_params);
   cache->cache_init = LRU_delay_init;
+  cache->current_params = LRU_delay_effective_params;
   cache->cache_free = LRU_delay_free;
   cache->get = LRU_delay_get;
   cache->find = LRU_delay_find;
@@ -68,6 +73,9 @@ cache_t *LRU_delay_init(const common_cache_params_t ccache_params,
   cache->evict = LRU_delay_evict;
   cache->remove = LRU_delay_remove;
   cache->to_evict = LRU_delay_to_evict;
+  cache->get_queue_tail = LRU_delay_get_queue_tail;
+  cache->get_logical_time = LRU_delay_get_logical_time;
+  cache->set_logical_time = LRU_delay_set_logical_time;
   cache->get_occupied_byte = cache_get_occupied_byte_default;
 
   if (ccache_params.consider_obj_metadata) {
@@ -295,6 +303,10 @@ static const char *LRU_delay_current_params(
   return params_str;
 }
 
+static const char *LRU_delay_effective_params(const cache_t *cache) {
+  return LRU_delay_current_params((LRU_delay_params_t *)cache->eviction_params);
+}
+
 static void LRU_delay_parse_params(cache_t *cache,
                                   const char *cache_specific_params) {
   LRU_delay_params_t *params = (LRU_delay_params_t *)cache->eviction_params;
@@ -337,6 +349,21 @@ static void LRU_delay_parse_params(cache_t *cache,
   free(old_params_str);
 }
 
+static cache_obj_t *LRU_delay_get_queue_tail(const cache_t *cache) {
+  LRU_delay_params_t *params = (LRU_delay_params_t *)cache->eviction_params;
+  return params->q_tail;
+}
+
+static int64_t LRU_delay_get_logical_time(const cache_t *cache) {
+  LRU_delay_params_t *params = (LRU_delay_params_t *)cache->eviction_params;
+  return (int64_t)params->n_insertion;
+}
+
+static void LRU_delay_set_logical_time(cache_t *cache, int64_t time) {
+  LRU_delay_params_t *params = (LRU_delay_params_t *)cache->eviction_params;
+  params->n_insertion = time;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,6 +37,7 @@ extern "C" {
 // ***********************************************************************
 
 static void LRU_delayv1_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *LRU_delayv1_effective_params(const cache_t *cache);
 static void LRU_delayv1_free(cache_t *cache);
 static bool LRU_delayv1_get(cache_t *cache, const request_t *req);
 static cache_obj_t *LRU_delayv1_find(cache_t *cache, const request_t *req,
@@ -62,6 +63,7 @@ cache_t *LRU_delayv1_init(const common_cache_params_t ccache_params,
                   const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LRU_delayv1", ccache_params, cache_specific_params);
   cache->cache_init = LRU_delayv1_init;
+  cache->current_params = LRU_delayv1_effective_params;
   cache->cache_free = LRU_delayv1_free;
   cache->get = LRU_delayv1_get;
   cache->find = LRU_delayv1_find;
@@ -322,6 +324,10 @@ static const char *LRU_delayv1_current_params(
   return params_str;
 }
 
+static const char *LRU_delayv1_effective_params(const cache_t *cache) {
+  return LRU_delayv1_current_params((LRU_delayv1_params_t *)cache->eviction_params);
+}
+
 static void LRU_delayv1_parse_params(cache_t *cache,
                                   const char *cache_specific_params) {
   LRU_delayv1_params_t *params = (LRU_delayv1_params_t *)cache->eviction_params;
@@ -63,6 +63,7 @@ static void free_freq_node(void *list_node) {
 
 static void LeCaR_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *LeCaR_effective_params(const cache_t *cache);
 static void LeCaR_free(cache_t *cache);
 static bool LeCaR_get(cache_t *cache, const request_t *req);
 static cache_obj_t *LeCaR_find(cache_t *cache, const request_t *req,
@@ -108,6 +109,7 @@ cache_t *LeCaR_init(const common_cache_params_t ccache_params,
       cache_struct_init("LeCaR", ccache_params, cache_specific_params);
 #endif
   cache->cache_init = LeCaR_init;
+  cache->current_params = LeCaR_effective_params;
   cache->cache_free = LeCaR_free;
   cache->get = LeCaR_get;
   cache->find = LeCaR_find;
@@ -591,6 +593,10 @@ static const char *LeCaR_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *LeCaR_effective_params(const cache_t *cache) {
+  return LeCaR_current_params((cache_t *)cache, (LeCaR_params_t *)cache->eviction_params);
+}
+
 static void LeCaR_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   LeCaR_params_t *params = (LeCaR_params_t *)cache->eviction_params;
@@ -34,6 +34,7 @@ static const char *DEFAULT_PARAMS = "n-bit-counter=1,iter=2";
 // ***********************************************************************
 
 static void OptClock_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *OptClock_effective_params(const cache_t *cache);
 static void OptClock_free(cache_t *cache);
 static bool OptClock_get(cache_t *cache, const request_t *req);
 static cache_obj_t *OptClock_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -75,6 +76,7 @@ struct OptClock_params_t {
 cache_t *OptClock_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("OptClock", ccache_params, cache_specific_params);
   cache->cache_init = OptClock_init;
+  cache->current_params = OptClock_effective_params;
   cache->cache_free = OptClock_free;
   cache->get = OptClock_get;
   cache->find = OptClock_find;
@@ -214,6 +216,10 @@ static const char *OptClock_current_params(cache_t *cache, OptClock_params_t *pa
   return params_str;
 }
 
+static const char *OptClock_effective_params(const cache_t *cache) {
+  return OptClock_current_params((cache_t *)cache, (OptClock_params_t *)cache->eviction_params);
+}
+
 static void OptClock_parse_params(cache_t *cache, const char *cache_specific_params) {
   OptClock_params_t *params = (OptClock_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
@@ -62,9 +62,12 @@ static void QDLP_evict(cache_t *cache, const request_t *req);
 static bool QDLP_remove(cache_t *cache, const obj_id_t obj_id);
 static inline int64_t QDLP_get_occupied_byte(const cache_t *cache);
 static inline int64_t QDLP_get_n_obj(const cache_t *cache);
+static void QDLP_get_queue_occupancy(const cache_t *cache, int64_t *small_byte,
+                                     int64_t *main_byte, int64_t *ghost_byte);
 static inline bool QDLP_can_insert(cache_t *cache, const request_t *req);
 static void QDLP_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *QDLP_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -77,6 +80,7 @@ cache_t *QDLP_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("QDLP", ccache_params, cache_specific_params);
   cache->cache_init = QDLP_init;
+  cache->current_params = QDLP_effective_params;
   cache->cache_free = QDLP_free;
   cache->get = QDLP_get;
   cache->find = QDLP_find;
@@ -87,6 +91,7 @@ cache_t *QDLP_init(const common_cache_params_t ccache_params,
   cache->get_n_obj = QDLP_get_n_obj;
   cache->get_occupied_byte = QDLP_get_occupied_byte;
   cache->can_insert = QDLP_can_insert;
+  cache->get_queue_occupancy = QDLP_get_queue_occupancy;
 
   cache->obj_md_size = 0;
 
@@ -346,6 +351,7 @@ static void QDLP_evict(cache_t *cache, const request_t *req) {
     assert(main->get_occupied_byte(main) <= cache->cache_size);
     // evict from main cache
     main->evict(main, req);
+    cache->n_reinsertion = params->n_obj_move_to_main + main->n_reinsertion;
 
     return;
   }
@@ -378,6 +384,7 @@ static void QDLP_evict(cache_t *cache, const request_t *req) {
   // remove from fifo, but do not update stat
   // bool removed = fifo->remove(fifo, params->req_local->obj_id);
   fifo->evict(fifo, req);
+  cache->n_reinsertion = params->n_obj_move_to_main + main->n_reinsertion;
 }
 
 /**
@@ -416,6 +423,16 @@ static inline int64_t QDLP_get_n_obj(const cache_t *cache) {
          params->main_cache->get_n_obj(params->main_cache);
 }
 
+static void QDLP_get_queue_occupancy(const cache_t *cache, int64_t *small_byte,
+                                     int64_t *main_byte, int64_t *ghost_byte) {
+  QDLP_params_t *params = (QDLP_params_t *)cache->eviction_params;
+  *small_byte = params->fifo->get_occupied_byte(params->fifo);
+  *main_byte = params->main_cache->get_occupied_byte(params->main_cache);
+  *ghost_byte = params->fifo_ghost == NULL
+                    ? 0
+                    : params->fifo_ghost->get_occupied_byte(params->fifo_ghost);
+}
+
 static inline bool QDLP_can_insert(cache_t *cache, const request_t *req) {
   QDLP_params_t *params = (QDLP_params_t *)cache->eviction_params;
 
@@ -434,6 +451,10 @@ static const char *QDLP_current_params(QDLP_params_t *params) {
   return params_str;
 }
 
+static const char *QDLP_effective_params(const cache_t *cache) {
+  return QDLP_current_params((QDLP_params_t *)cache->eviction_params);
+}
+
 static void QDLP_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   QDLP_params_t *params = (QDLP_params_t *)(cache->eviction_params);
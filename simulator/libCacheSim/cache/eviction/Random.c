@@ -50,6 +50,7 @@ cache_t *Random_init(const common_cache_params_t ccache_params,
 
   cache_t *cache =
       cache_struct_init("Random", ccache_params_copy, cache_specific_params);
+  cache_enable_sample_array(cache);
   cache->cache_init = Random_init;
   cache->cache_free = Random_free;
   cache->get = Random_get;
@@ -138,7 +139,7 @@ static cache_obj_t *Random_insert(cache_t *cache, const request_t *req) {
  * @return the object to be evicted
  */
 static cache_obj_t *Random_to_evict(cache_t *cache, const request_t *req) {
-  return hashtable_rand_obj(cache->hashtable);
+  return cache_rand_obj(cache);
 }
 
 /**
@@ -62,6 +62,7 @@ cache_t *RandomBelady_init(const common_cache_params_t ccache_params, const char
   ccache_params_copy.hashpower = MAX(12, ccache_params_copy.hashpower - 8);
 
   cache_t *cache = cache_struct_init("RandomBelady-2", ccache_params_copy, cache_specific_params);
+  cache_enable_sample_array(cache);
   cache->cache_init = RandomBelady_init;
   cache->cache_free = RandomBelady_free;
   cache->get = RandomBelady_get;
@@ -184,7 +185,7 @@ static cache_obj_t *RandomBelady_insert(cache_t *cache, const request_t *req) {
  * @return the object to be evicted
  */
 static cache_obj_t *RandomBelady_to_evict(cache_t *cache, const request_t *req) {
-  return hashtable_rand_obj(cache->hashtable);
+  return cache_rand_obj(cache);
 }
 // static cache_obj_t *RandomBelady_to_evict(cache_t *cache, const request_t *req) {
 // #define K 16
@@ -32,6 +32,7 @@ static const char *DEFAULT_PARAMS = "k=1";
 // ***********************************************************************
 
 static void RandomK_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *RandomK_effective_params(const cache_t *cache);
 static void RandomK_free(cache_t *cache);
 static bool RandomK_get(cache_t *cache, const request_t *req);
 static cache_obj_t *RandomK_find(cache_t *cache, const request_t *req,
@@ -61,7 +62,9 @@ cache_t *RandomK_init(const common_cache_params_t ccache_params,
 
   cache_t *cache =
       cache_struct_init("RandomK", ccache_params_copy, cache_specific_params);
+  cache_enable_sample_array(cache);
   cache->cache_init = RandomK_init;
+  cache->current_params = RandomK_effective_params;
   cache->cache_free = RandomK_free;
   cache->get = RandomK_get;
   cache->find = RandomK_find;
@@ -238,10 +241,10 @@ static cache_obj_t *RandomK_to_evict(cache_t *cache, const request_t *req) {
 
 //this is only a sequential version for now
 static cache_obj_t *RandomK_select(cache_t *cache, const int k) {
-  cache_obj_t *obj_to_evict = hashtable_rand_obj(cache->hashtable);
+  cache_obj_t *obj_to_evict = cache_rand_obj(cache);
 
   for (int i = 1; i < k; i++) {
-    cache_obj_t *obj = hashtable_rand_obj(cache->hashtable);
+    cache_obj_t *obj = cache_rand_obj(cache);
     if (obj->RandomTwo.last_access_vtime < obj_to_evict->RandomTwo.last_access_vtime)
       obj_to_evict = obj;
   }
@@ -296,6 +299,10 @@ static const char *RandomK_current_params(RandomK_params_t *params) {
   return params_str;
 }
 
+static const char *RandomK_effective_params(const cache_t *cache) {
+  return RandomK_current_params((RandomK_params_t *)cache->eviction_params);
+}
+
 static void RandomK_parse_params(cache_t *cache,
                                   const char *cache_specific_params) {
   RandomK_params_t *params = (RandomK_params_t *)cache->eviction_params;
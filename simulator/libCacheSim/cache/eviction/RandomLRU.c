@@ -58,6 +58,7 @@ cache_t *RandomLRU_init(const common_cache_params_t ccache_params, const char *c
   ccache_params_copy.hashpower = MAX(12, ccache_params_copy.hashpower - 8);
 
   cache_t *cache = cache_struct_init("RandomLRU", ccache_params_copy, cache_specific_params);
+  cache_enable_sample_array(cache);
   cache->cache_init = RandomLRU_init;
   cache->cache_free = RandomLRU_free;
   cache->get = RandomLRU_get;
@@ -210,7 +211,7 @@ static int compare_access_time(const void *p1, const void *p2) {
 static void RandomLRU_evict(cache_t *cache, const request_t *req) {
   RandomLRU_params_t *params = (RandomLRU_params_t *)(cache->eviction_params);
   for (int i = 0; i < params->n_samples; i++) {
-    params->eviction_candidates[i] = hashtable_rand_obj(cache->hashtable);
+    params->eviction_candidates[i] = cache_rand_obj(cache);
   }
   qsort(params->eviction_candidates, params->n_samples, sizeof(cache_obj_t *), compare_access_time);
   cache_evict_base(cache, params->eviction_candidates[0], true);
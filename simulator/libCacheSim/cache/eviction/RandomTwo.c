@@ -51,6 +51,7 @@ cache_t *RandomTwo_init(const common_cache_params_t ccache_params,
 
   cache_t *cache =
       cache_struct_init("RandomTwo", ccache_params_copy, cache_specific_params);
+  cache_enable_sample_array(cache);
   cache->cache_init = RandomTwo_init;
   cache->cache_free = RandomTwo_free;
   cache->get = RandomTwo_get;
@@ -137,9 +138,9 @@ static cache_obj_t *RandomTwo_insert(cache_t *cache, const request_t *req) {
 }
 //this is only a sequential version for now
 static cache_obj_t *RandomTwo_selectk(cache_t *cache, const int k) {
-  cache_obj_t *obj_to_evict = hashtable_rand_obj(cache->hashtable);
+  cache_obj_t *obj_to_evict = cache_rand_obj(cache);
   for (int i = 1; i < k; i++) {
-    cache_obj_t *obj = hashtable_rand_obj(cache->hashtable);
+    cache_obj_t *obj = cache_rand_obj(cache);
     if (obj->RandomTwo.last_access_vtime < obj_to_evict->RandomTwo.last_access_vtime)
       obj_to_evict = obj;
   }
@@ -69,9 +69,13 @@ static void S3FIFO_evict(cache_t *cache, const request_t *req);
 static bool S3FIFO_remove(cache_t *cache, const obj_id_t obj_id);
 static inline int64_t S3FIFO_get_occupied_byte(const cache_t *cache);
 static inline int64_t S3FIFO_get_n_obj(const cache_t *cache);
+static void S3FIFO_get_queue_occupancy(const cache_t *cache,
+                                       int64_t *small_byte, int64_t *main_byte,
+                                       int64_t *ghost_byte);
 static inline bool S3FIFO_can_insert(cache_t *cache, const request_t *req);
 static void S3FIFO_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *S3FIFO_effective_params(const cache_t *cache);
 
 static void S3FIFO_evict_fifo(cache_t *cache, const request_t *req);
 static void S3FIFO_evict_main(cache_t *cache, const request_t *req);
@@ -87,6 +91,7 @@ cache_t *S3FIFO_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("S3FIFO", ccache_params, cache_specific_params);
   cache->cache_init = S3FIFO_init;
+  cache->current_params = S3FIFO_effective_params;
   cache->cache_free = S3FIFO_free;
   cache->get = S3FIFO_get;
   cache->find = S3FIFO_find;
@@ -97,6 +102,7 @@ cache_t *S3FIFO_init(const common_cache_params_t ccache_params,
   cache->get_n_obj = S3FIFO_get_n_obj;
   cache->get_occupied_byte = S3FIFO_get_occupied_byte;
   cache->can_insert = S3FIFO_can_insert;
+  cache->get_queue_occupancy = S3FIFO_get_queue_occupancy;
 
   cache->obj_md_size = 0;
 
@@ -339,6 +345,7 @@ static void S3FIFO_evict_fifo(cache_t *cache, const request_t *req) {
       // freq is updated in cache_find_base
       params->n_obj_move_to_main += 1;
       params->n_byte_move_to_main += obj_to_evict->obj_size;
+      cache->n_reinsertion += 1;
 
       cache_obj_t *new_obj = main->insert(main, params->req_local);
       new_obj->misc.freq = obj_to_evict->misc.freq;
@@ -392,6 +399,7 @@ static void S3FIFO_evict_main(cache_t *cache, const request_t *req) {
       obj_to_evict = NULL;
 
       cache_obj_t *new_obj = main->insert(main, params->req_local);
+      cache->n_reinsertion += 1;
       // clock with 2-bit counter
       new_obj->S3FIFO.freq = MIN(freq, 3) - 1;
       new_obj->misc.freq = freq;
@@ -475,6 +483,17 @@ static inline int64_t S3FIFO_get_n_obj(const cache_t *cache) {
          params->main_cache->get_n_obj(params->main_cache);
 }
 
+static void S3FIFO_get_queue_occupancy(const cache_t *cache,
+                                       int64_t *small_byte, int64_t *main_byte,
+                                       int64_t *ghost_byte) {
+  S3FIFO_params_t *params = (S3FIFO_params_t *)cache->eviction_params;
+  *small_byte = params->fifo->get_occupied_byte(params->fifo);
+  *main_byte = params->main_cache->get_occupied_byte(params->main_cache);
+  *ghost_byte = params->fifo_ghost == NULL
+                    ? 0
+                    : params->fifo_ghost->get_occupied_byte(params->fifo_ghost);
+}
+
 static inline bool S3FIFO_can_insert(cache_t *cache, const request_t *req) {
   S3FIFO_params_t *params = (S3FIFO_params_t *)cache->eviction_params;
 
@@ -493,6 +512,10 @@ static const char *S3FIFO_current_params(S3FIFO_params_t *params) {
   return params_str;
 }
 
+static const char *S3FIFO_effective_params(const cache_t *cache) {
+  return S3FIFO_current_params((S3FIFO_params_t *)cache->eviction_params);
+}
+
 static void S3FIFO_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   S3FIFO_params_t *params = (S3FIFO_params_t *)(cache->eviction_params);
@@ -66,6 +66,7 @@ static inline int64_t S3FIFOd_get_n_obj(const cache_t *cache);
 static inline bool S3FIFOd_can_insert(cache_t *cache, const request_t *req);
 static void S3FIFOd_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *S3FIFOd_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -77,6 +78,7 @@ cache_t *S3FIFOd_init(const common_cache_params_t ccache_params,
                      const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("S3FIFOd", ccache_params, cache_specific_params);
   cache->cache_init = S3FIFOd_init;
+  cache->current_params = S3FIFOd_effective_params;
   cache->cache_free = S3FIFOd_free;
   cache->get = S3FIFOd_get;
   cache->find = S3FIFOd_find;
@@ -530,6 +532,10 @@ static const char *S3FIFOd_current_params(S3FIFOd_params_t *params) {
   return params_str;
 }
 
+static const char *S3FIFOd_effective_params(const cache_t *cache) {
+  return S3FIFOd_current_params((S3FIFOd_params_t *)cache->eviction_params);
+}
+
 static void S3FIFOd_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   S3FIFOd_params_t *params = (S3FIFOd_params_t *)(cache->eviction_params);
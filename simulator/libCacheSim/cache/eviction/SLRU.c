@@ -50,6 +50,7 @@ static void SLRU_cool(cache_t *cache, const request_t *req, const int id);
 bool SLRU_can_insert(cache_t *cache, const request_t *req);
 static void SLRU_parse_params(cache_t *cache,
                               const char *cache_specific_params);
+static const char *SLRU_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -105,6 +106,7 @@ cache_t *SLRU_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("SLRU", ccache_params, cache_specific_params);
   cache->cache_init = SLRU_init;
+  cache->current_params = SLRU_effective_params;
   cache->cache_free = SLRU_free;
   cache->get = SLRU_get;
   cache->find = SLRU_find;
@@ -414,6 +416,10 @@ static const char *SLRU_current_params(cache_t *cache, SLRU_params_t *params) {
   return params_str;
 }
 
+static const char *SLRU_effective_params(const cache_t *cache) {
+  return SLRU_current_params((cache_t *)cache, (SLRU_params_t *)cache->eviction_params);
+}
+
 static void SLRU_parse_params(cache_t *cache,
                               const char *cache_specific_params) {
   SLRU_params_t *params = (SLRU_params_t *)cache->eviction_params;
@@ -31,6 +31,7 @@ static const char *DEFAULT_CACHE_PARAMS = "n-seg=4";
 
 static void SLRUv0_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *SLRUv0_effective_params(const cache_t *cache);
 static void SLRUv0_free(cache_t *cache);
 static bool SLRUv0_get(cache_t *cache, const request_t *req);
 static cache_obj_t *SLRUv0_find(cache_t *cache, const request_t *req,
@@ -64,6 +65,7 @@ cache_t *SLRUv0_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("SLRUv0", ccache_params, cache_specific_params);
   cache->cache_init = SLRUv0_init;
+  cache->current_params = SLRUv0_effective_params;
   cache->cache_free = SLRUv0_free;
   cache->get = SLRUv0_get;
   cache->find = SLRUv0_find;
@@ -348,6 +350,10 @@ static const char *SLRUv0_current_params(SLRUv0_params_t *params) {
   return params_str;
 }
 
+static const char *SLRUv0_effective_params(const cache_t *cache) {
+  return SLRUv0_current_params((SLRUv0_params_t *)cache->eviction_params);
+}
+
 static void SLRUv0_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   SLRUv0_params_t *params = (SLRUv0_params_t *)cache->eviction_params;
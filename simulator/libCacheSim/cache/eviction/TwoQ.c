@@ -56,9 +56,12 @@ static void TwoQ_evict(cache_t *cache, const request_t *req);
 static bool TwoQ_remove(cache_t *cache, const obj_id_t obj_id);
 static inline int64_t TwoQ_get_occupied_byte(const cache_t *cache);
 static inline int64_t TwoQ_get_n_obj(const cache_t *cache);
+static void TwoQ_get_queue_occupancy(const cache_t *cache, int64_t *small_byte,
+                                     int64_t *main_byte, int64_t *ghost_byte);
 static inline bool TwoQ_can_insert(cache_t *cache, const request_t *req);
 static void TwoQ_parse_params(cache_t *cache,
                               const char *cache_specific_params);
+static const char *TwoQ_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -71,6 +74,7 @@ cache_t *TwoQ_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("TwoQ", ccache_params, cache_specific_params);
   cache->cache_init = TwoQ_init;
+  cache->current_params = TwoQ_effective_params;
   cache->cache_free = TwoQ_free;
   cache->get = TwoQ_get;
   cache->find = TwoQ_find;
@@ -81,6 +85,7 @@ cache_t *TwoQ_init(const common_cache_params_t ccache_params,
   cache->get_n_obj = TwoQ_get_n_obj;
   cache->get_occupied_byte = TwoQ_get_occupied_byte;
   cache->can_insert = TwoQ_can_insert;
+  cache->get_queue_occupancy = TwoQ_get_queue_occupancy;
 
   cache->obj_md_size = 0;
 
@@ -311,6 +316,14 @@ static inline int64_t TwoQ_get_n_obj(const cache_t *cache) {
          params->Am->get_n_obj(params->Am);
 }
 
+static void TwoQ_get_queue_occupancy(const cache_t *cache, int64_t *small_byte,
+                                     int64_t *main_byte, int64_t *ghost_byte) {
+  TwoQ_params_t *params = (TwoQ_params_t *)cache->eviction_params;
+  *small_byte = params->Ain->get_occupied_byte(params->Ain);
+  *main_byte = params->Am->get_occupied_byte(params->Am);
+  *ghost_byte = params->Aout->get_occupied_byte(params->Aout);
+}
+
 static inline bool TwoQ_can_insert(cache_t *cache, const request_t *req) {
   TwoQ_params_t *params = (TwoQ_params_t *)cache->eviction_params;
 
@@ -329,6 +342,10 @@ static const char *TwoQ_current_params(TwoQ_params_t *params) {
   return params_str;
 }
 
+static const char *TwoQ_effective_params(const cache_t *cache) {
+  return TwoQ_current_params((TwoQ_params_t *)cache->eviction_params);
+}
+
 static void TwoQ_parse_params(cache_t *cache,
                               const char *cache_specific_params) {
   TwoQ_params_t *params = (TwoQ_params_t *)(cache->eviction_params);
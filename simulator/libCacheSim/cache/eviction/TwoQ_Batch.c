@@ -55,6 +55,7 @@ static inline int64_t TwoQ_Batch_get_occupied_byte(const cache_t *cache);
 static inline int64_t TwoQ_Batch_get_n_obj(const cache_t *cache);
 static inline bool TwoQ_Batch_can_insert(cache_t *cache, const request_t *req);
 static void TwoQ_Batch_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *TwoQ_Batch_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -71,6 +72,7 @@ static void TwoQ_Batch_parse_params(cache_t *cache, const char *cache_specific_p
 cache_t *TwoQ_Batch_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LP-TwoQv2", ccache_params, cache_specific_params);
   cache->cache_init = TwoQ_Batch_init;
+  cache->current_params = TwoQ_Batch_effective_params;
   cache->cache_free = TwoQ_Batch_free;
   cache->get = TwoQ_Batch_get;
   cache->find = TwoQ_Batch_find;
@@ -333,6 +335,10 @@ static const char *TwoQ_Batch_current_params(TwoQ_Batch_params_t *params) {
   return params_str;
 }
 
+static const char *TwoQ_Batch_effective_params(const cache_t *cache) {
+  return TwoQ_Batch_current_params((TwoQ_Batch_params_t *)cache->eviction_params);
+}
+
 static void TwoQ_Batch_parse_params(cache_t *cache, const char *cache_specific_params) {
   TwoQ_Batch_params_t *params = (TwoQ_Batch_params_t *)(cache->eviction_params);
 
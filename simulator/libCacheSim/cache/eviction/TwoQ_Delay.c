@@ -55,6 +55,7 @@ static inline int64_t TwoQ_Delay_get_occupied_byte(const cache_t *cache);
 static inline int64_t TwoQ_Delay_get_n_obj(const cache_t *cache);
 static inline bool TwoQ_Delay_can_insert(cache_t *cache, const request_t *req);
 static void TwoQ_Delay_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *TwoQ_Delay_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -71,6 +72,7 @@ static void TwoQ_Delay_parse_params(cache_t *cache, const char *cache_specific_p
 cache_t *TwoQ_Delay_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LP-TwoQv2", ccache_params, cache_specific_params);
   cache->cache_init = TwoQ_Delay_init;
+  cache->current_params = TwoQ_Delay_effective_params;
   cache->cache_free = TwoQ_Delay_free;
   cache->get = TwoQ_Delay_get;
   cache->find = TwoQ_Delay_find;
@@ -333,6 +335,10 @@ static const char *TwoQ_Delay_current_params(TwoQ_Delay_params_t *params) {
   return params_str;
 }
 
+static const char *TwoQ_Delay_effective_params(const cache_t *cache) {
+  return TwoQ_Delay_current_params((TwoQ_Delay_params_t *)cache->eviction_params);
+}
+
 static void TwoQ_Delay_parse_params(cache_t *cache, const char *cache_specific_params) {
   TwoQ_Delay_params_t *params = (TwoQ_Delay_params_t *)(cache->eviction_params);
 
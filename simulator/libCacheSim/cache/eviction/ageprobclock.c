@@ -29,6 +29,7 @@ static const char *DEFAULT_PARAMS = "n-bit-counter=1,decrease-rate=1,scale=0.1";
 // ***********************************************************************
 
 static void AgeprobClock_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *AgeprobClock_effective_params(const cache_t *cache);
 static void AgeprobClock_free(cache_t *cache);
 static bool AgeprobClock_get(cache_t *cache, const request_t *req);
 static cache_obj_t *AgeprobClock_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -52,6 +53,7 @@ static bool AgeprobClock_remove(cache_t *cache, const obj_id_t obj_id);
 cache_t *AgeprobClock_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("AgeprobClock", ccache_params, cache_specific_params);
   cache->cache_init = AgeprobClock_init;
+  cache->current_params = AgeprobClock_effective_params;
   cache->cache_free = AgeprobClock_free;
   cache->get = AgeprobClock_get;
   cache->find = AgeprobClock_find;
@@ -328,6 +330,10 @@ static const char *AgeprobClock_current_params(cache_t *cache, Clock_params_t *p
   return params_str;
 }
 
+static const char *AgeprobClock_effective_params(const cache_t *cache) {
+  return AgeprobClock_current_params((cache_t *)cache, (Clock_params_t *)cache->eviction_params);
+}
+
 static void AgeprobClock_parse_params(cache_t *cache, const char *cache_specific_params) {
   Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
@@ -52,6 +52,7 @@ static const char *DEFAULT_PARAMS = "batch-size=0.2";
 
 static void bc_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *bc_effective_params(const cache_t *cache);
 static void bc_free(cache_t *cache);
 static bool bc_get(cache_t *cache, const request_t *req);
 static cache_obj_t *bc_find(cache_t *cache, const request_t *req,
@@ -79,6 +80,7 @@ cache_t *bc_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("bc", ccache_params, cache_specific_params);
   cache->cache_init = bc_init;
+  cache->current_params = bc_effective_params;
   cache->cache_free = bc_free;
   cache->get = bc_get;
   cache->find = bc_find;
@@ -374,6 +376,10 @@ static const char *bc_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *bc_effective_params(const cache_t *cache) {
+  return bc_current_params((cache_t *)cache, (bc_params_t *)cache->eviction_params);
+}
+
 static void bc_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   bc_params_t *params = (bc_params_t *)cache->eviction_params;
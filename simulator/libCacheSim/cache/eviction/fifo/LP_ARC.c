@@ -43,6 +43,7 @@ typedef struct LP_ARC_params {
 
 static void LP_ARC_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *LP_ARC_effective_params(const cache_t *cache);
 static void LP_ARC_free(cache_t *cache);
 static bool LP_ARC_get(cache_t *cache, const request_t *req);
 static cache_obj_t *LP_ARC_find(cache_t *cache, const request_t *req,
@@ -84,6 +85,7 @@ cache_t *LP_ARC_init(const common_cache_params_t ccache_params,
                      const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LP_ARC", ccache_params, cache_specific_params);
   cache->cache_init = LP_ARC_init;
+  cache->current_params = LP_ARC_effective_params;
   cache->cache_free = LP_ARC_free;
   cache->get = LP_ARC_get;
   cache->find = LP_ARC_find;
@@ -479,6 +481,10 @@ static const char *LP_ARC_current_params(LP_ARC_params_t *params) {
   return params_str;
 }
 
+static const char *LP_ARC_effective_params(const cache_t *cache) {
+  return LP_ARC_current_params((LP_ARC_params_t *)cache->eviction_params);
+}
+
 static void LP_ARC_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   LP_ARC_params_t *params = (LP_ARC_params_t *)(cache->eviction_params);
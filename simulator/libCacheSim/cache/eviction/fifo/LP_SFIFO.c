@@ -33,6 +33,7 @@ static const char *DEFAULT_PARAMS = "n-seg=4,seg-size=1:1:1:1";
 // ***********************************************************************
 static void LP_SFIFO_parse_params(cache_t *cache,
                                  const char *cache_specific_params);
+static const char *LP_SFIFO_effective_params(const cache_t *cache);
 static void LP_SFIFO_parse_params(cache_t *cache,
                                  const char *cache_specific_params);
 static void LP_SFIFO_free(cache_t *cache);
@@ -64,6 +65,7 @@ cache_t *LP_SFIFO_init(const common_cache_params_t ccache_params,
                       const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("LP-SFIFO", ccache_params, cache_specific_params);
   cache->cache_init = LP_SFIFO_init;
+  cache->current_params = LP_SFIFO_effective_params;
   cache->cache_free = LP_SFIFO_free;
   cache->get = LP_SFIFO_get;
   cache->find = LP_SFIFO_find;
@@ -359,6 +361,10 @@ static const char *LP_SFIFO_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *LP_SFIFO_effective_params(const cache_t *cache) {
+  return LP_SFIFO_current_params((cache_t *)cache, (LP_SFIFO_params_t *)cache->eviction_params);
+}
+
 static void LP_SFIFO_parse_params(cache_t *cache,
                                  const char *cache_specific_params) {
   LP_SFIFO_params_t *params = (LP_SFIFO_params_t *)cache->eviction_params;
@@ -70,6 +70,7 @@ typedef struct SFIFO_params {
 // ***********************************************************************
 static void SFIFO_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *SFIFO_effective_params(const cache_t *cache);
 static void SFIFO_parse_params(cache_t *cache, const char *cache_specific_params);
 static void SFIFO_free(cache_t *cache);
 static bool SFIFO_get(cache_t *cache, const request_t *req);
@@ -121,6 +122,7 @@ cache_t *SFIFO_init(const common_cache_params_t ccache_params,
                     const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("SFIFO", ccache_params, cache_specific_params);
   cache->cache_init = SFIFO_init;
+  cache->current_params = SFIFO_effective_params;
   cache->cache_free = SFIFO_free;
   cache->get = SFIFO_get;
   cache->find = SFIFO_find;
@@ -367,6 +369,10 @@ static const char *SFIFO_current_params(SFIFO_params_t *params) {
   return params_str;
 }
 
+static const char *SFIFO_effective_params(const cache_t *cache) {
+  return SFIFO_current_params((SFIFO_params_t *)cache->eviction_params);
+}
+
 static void SFIFO_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   SFIFO_params_t *params = (SFIFO_params_t *)cache->eviction_params;
@@ -29,6 +29,7 @@ static const char *DEFAULT_PARAMS = "n-bit-counter=1,decrease-rate=1,scale=0.1";
 // ***********************************************************************
 
 static void FreqprobClock_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *FreqprobClock_effective_params(const cache_t *cache);
 static void FreqprobClock_free(cache_t *cache);
 static bool FreqprobClock_get(cache_t *cache, const request_t *req);
 static cache_obj_t *FreqprobClock_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -52,6 +53,7 @@ static bool FreqprobClock_remove(cache_t *cache, const obj_id_t obj_id);
 cache_t *FreqprobClock_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("FreqprobClock", ccache_params, cache_specific_params);
   cache->cache_init = FreqprobClock_init;
+  cache->current_params = FreqprobClock_effective_params;
   cache->cache_free = FreqprobClock_free;
   cache->get = FreqprobClock_get;
   cache->find = FreqprobClock_find;
@@ -331,6 +333,10 @@ static const char *FreqprobClock_current_params(cache_t *cache, Clock_params_t *
   return params_str;
 }
 
+static const char *FreqprobClock_effective_params(const cache_t *cache) {
+  return FreqprobClock_current_params((cache_t *)cache, (Clock_params_t *)cache->eviction_params);
+}
+
 static void FreqprobClock_parse_params(cache_t *cache, const char *cache_specific_params) {
   Clock_params_t *params = (Clock_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
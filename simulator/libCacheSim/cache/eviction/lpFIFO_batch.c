@@ -48,6 +48,7 @@ static const char *DEFAULT_PARAMS = "batch-size=0.2";
 static void lpFIFO_print(cache_t *cache);
 static void lpFIFO_batch_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *lpFIFO_batch_effective_params(const cache_t *cache);
 static void lpFIFO_batch_free(cache_t *cache);
 static bool lpFIFO_batch_get(cache_t *cache, const request_t *req);
 static cache_obj_t *lpFIFO_batch_find(cache_t *cache, const request_t *req,
@@ -74,6 +75,7 @@ cache_t *lpFIFO_batch_init(const common_cache_params_t ccache_params,
                     const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("lpFIFO_batch", ccache_params, cache_specific_params);
   cache->cache_init = lpFIFO_batch_init;
+  cache->current_params = lpFIFO_batch_effective_params;
   cache->cache_free = lpFIFO_batch_free;
   cache->get = lpFIFO_batch_get;
   cache->find = lpFIFO_batch_find;
@@ -387,6 +389,10 @@ static const char *lpFIFO_batch_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *lpFIFO_batch_effective_params(const cache_t *cache) {
+  return lpFIFO_batch_current_params((cache_t *)cache, (lpFIFO_batch_params_t *)cache->eviction_params);
+}
+
 static void lpFIFO_batch_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   lpFIFO_batch_params_t *params = (lpFIFO_batch_params_t *)cache->eviction_params;
@@ -36,6 +36,7 @@ static const char *DEFAULT_CACHE_PARAMS = "n-shards=4";
 
 static void lpFIFO_shards_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *lpFIFO_shards_effective_params(const cache_t *cache);
 static void lpFIFO_shards_free(cache_t *cache);
 static bool lpFIFO_shards_get(cache_t *cache, const request_t *req);
 static cache_obj_t *lpFIFO_shards_find(cache_t *cache, const request_t *req,
@@ -68,6 +69,7 @@ cache_t *lpFIFO_shards_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("lpFIFO_shards", ccache_params, cache_specific_params);
   cache->cache_init = lpFIFO_shards_init;
+  cache->current_params = lpFIFO_shards_effective_params;
   cache->cache_free = lpFIFO_shards_free;
   cache->get = lpFIFO_shards_get;
   cache->find = lpFIFO_shards_find;
@@ -183,7 +185,7 @@ static cache_obj_t *lpFIFO_shards_find(cache_t *cache, const request_t *req,
   cache_obj_t *obj = NULL;
 
   // Check shard of hashed id for quick lookup
-  uint64_t hashed_id = get_hash_value_int_64(&(req->obj_id)) % (params->n_shards);
+  uint64_t hashed_id = get_hash_value_req(req) % (params->n_shards);
   cache_t *shard = params->shards[hashed_id];
   obj = shard->find(shard, req, false);
 
@@ -246,7 +248,7 @@ static cache_obj_t *lpFIFO_shards_insert(cache_t *cache, const request_t *req) {
   // params->shards[0]->n_req = cache->n_req;
 
   // Choose shard based on hashed obj_id
-  uint64_t hashed_id = get_hash_value_int_64(&(req->obj_id)) % (params->n_shards);
+  uint64_t hashed_id = get_hash_value_req(req) % (params->n_shards);
   cache_t *shard = params->shards[hashed_id];
   while (shard->get_occupied_byte(shard) + req->obj_size + cache->obj_md_size >
          shard->cache_size) {
@@ -286,7 +288,7 @@ static cache_obj_t *lpFIFO_shards_to_evict(cache_t *cache, const request_t *req)
 static void lpFIFO_shards_evict(cache_t *cache, const request_t *req) {
   // Deprecate, do NOT use! eviction dependent on find/insert
   lpFIFO_shards_params_t *params = (lpFIFO_shards_params_t *)(cache->eviction_params);
-  uint64_t hashed_id = get_hash_value_int_64(&(req->obj_id)) % (params->n_shards);
+  uint64_t hashed_id = get_hash_value_req(req) % (params->n_shards);
   cache_t *shard = params->shards[hashed_id];
   shard->evict(shard, req);
 }
@@ -352,6 +354,10 @@ static const char *lpFIFO_shards_current_params(lpFIFO_shards_params_t *params)
   return params_str;
 }
 
+static const char *lpFIFO_shards_effective_params(const cache_t *cache) {
+  return lpFIFO_shards_current_params((lpFIFO_shards_params_t *)cache->eviction_params);
+}
+
 static void lpFIFO_shards_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   lpFIFO_shards_params_t *params = (lpFIFO_shards_params_t *)cache->eviction_params;
@@ -35,6 +35,7 @@ static const char *DEFAULT_CACHE_PARAMS = "prob=0.5";
 
 static void lpLRU_prob_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *lpLRU_prob_effective_params(const cache_t *cache);
 static void lpLRU_prob_free(cache_t *cache);
 static bool lpLRU_prob_get(cache_t *cache, const request_t *req);
 static cache_obj_t *lpLRU_prob_find(cache_t *cache, const request_t *req,
@@ -61,6 +62,7 @@ cache_t *lpLRU_prob_init(const common_cache_params_t ccache_params,
                   const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("lpLRU_prob", ccache_params, cache_specific_params);
   cache->cache_init = lpLRU_prob_init;
+  cache->current_params = lpLRU_prob_effective_params;
   cache->cache_free = lpLRU_prob_free;
   cache->get = lpLRU_prob_get;
   cache->find = lpLRU_prob_find;
@@ -316,6 +318,10 @@ static const char *lpLRU_prob_current_params(lpLRU_prob_params_t *params) {
   return params_str;
 }
 
+static const char *lpLRU_prob_effective_params(const cache_t *cache) {
+  return lpLRU_prob_current_params((lpLRU_prob_params_t *)cache->eviction_params);
+}
+
 static void lpLRU_prob_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   lpLRU_prob_params_t *params = (lpLRU_prob_params_t *)cache->eviction_params;
@@ -46,6 +46,7 @@ static const char *DEFAULT_PARAMS = "scaler=1.5";
 
 static void offlineFR_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *offlineFR_effective_params(const cache_t *cache);
 static void offlineFR_free(cache_t *cache);
 static bool offlineFR_get(cache_t *cache, const request_t *req);
 static cache_obj_t *offlineFR_find(cache_t *cache, const request_t *req,
@@ -72,6 +73,7 @@ cache_t *offlineFR_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("offlineFR", ccache_params, cache_specific_params);
   cache->cache_init = offlineFR_init;
+  cache->current_params = offlineFR_effective_params;
   cache->cache_free = offlineFR_free;
   cache->get = offlineFR_get;
   cache->find = offlineFR_find;
@@ -339,6 +341,10 @@ static const char *offlineFR_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *offlineFR_effective_params(const cache_t *cache) {
+  return offlineFR_current_params((cache_t *)cache, (offlineFR_params_t *)cache->eviction_params);
+}
+
 static void offlineFR_parse_params(cache_t *cache,
                                const char *cache_specific_params) {
   offlineFR_params_t *params = (offlineFR_params_t *)cache->eviction_params;
@@ -58,6 +58,7 @@ static inline int64_t flashProb_get_occupied_byte(const cache_t *cache);
 static inline int64_t flashProb_get_n_obj(const cache_t *cache);
 static void flashProb_parse_params(cache_t *cache,
                                    const char *cache_specific_params);
+static const char *flashProb_effective_params(const cache_t *cache);
 
 // ***********************************************************************
 // ****                                                               ****
@@ -69,6 +70,7 @@ cache_t *flashProb_init(const common_cache_params_t ccache_params,
                         const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("flashProb", ccache_params, cache_specific_params);
   cache->cache_init = flashProb_init;
+  cache->current_params = flashProb_effective_params;
   cache->cache_free = flashProb_free;
   cache->get = flashProb_get;
   cache->find = flashProb_find;
@@ -361,6 +363,10 @@ static const char *flashProb_current_params(flashProb_params_t *params) {
   return params_str;
 }
 
+static const char *flashProb_effective_params(const cache_t *cache) {
+  return flashProb_current_params((flashProb_params_t *)cache->eviction_params);
+}
+
 static void flashProb_parse_params(cache_t *cache,
                                    const char *cache_specific_params) {
   flashProb_params_t *params = (flashProb_params_t *)(cache->eviction_params);
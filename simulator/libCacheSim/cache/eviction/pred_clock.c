@@ -29,6 +29,7 @@ static int total_negative = 0;
 // ***********************************************************************
 
 static void PredClock_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *PredClock_effective_params(const cache_t *cache);
 static void PredClock_free(cache_t *cache);
 static bool PredClock_get(cache_t *cache, const request_t *req);
 static cache_obj_t *PredClock_find(cache_t *cache, const request_t *req, const bool update_cache);
@@ -56,6 +57,7 @@ static bool is_retained3(cache_t *cache, cache_obj_t *obj_to_evict, const double
 cache_t *PredClock_init(const common_cache_params_t ccache_params, const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("PredClock", ccache_params, cache_specific_params);
   cache->cache_init = PredClock_init;
+  cache->current_params = PredClock_effective_params;
   cache->cache_free = PredClock_free;
   cache->get = PredClock_get;
   cache->find = PredClock_find;
@@ -416,6 +418,10 @@ static const char *PredClock_current_params(cache_t *cache, PredClock_params_t *
   return params_str;
 }
 
+static const char *PredClock_effective_params(const cache_t *cache) {
+  return PredClock_current_params((cache_t *)cache, (PredClock_params_t *)cache->eviction_params);
+}
+
 static void PredClock_parse_params(cache_t *cache, const char *cache_specific_params) {
   PredClock_params_t *params = (PredClock_params_t *)cache->eviction_params;
   char *params_str = strdup(cache_specific_params);
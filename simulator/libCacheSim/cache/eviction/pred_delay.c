@@ -35,6 +35,7 @@ extern "C" {
 // ***********************************************************************
 
 static void PredDelay_parse_params(cache_t *cache, const char *cache_specific_params);
+static const char *PredDelay_effective_params(const cache_t *cache);
 static void PredDelay_free(cache_t *cache);
 static bool PredDelay_get(cache_t *cache, const request_t *req);
 static cache_obj_t *PredDelay_find(cache_t *cache, const request_t *req,
@@ -60,6 +61,7 @@ cache_t *PredDelay_init(const common_cache_params_t ccache_params,
                   const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("PredDelay", ccache_params, cache_specific_params);
   cache->cache_init = PredDelay_init;
+  cache->current_params = PredDelay_effective_params;
   cache->cache_free = PredDelay_free;
   cache->get = PredDelay_get;
   cache->find = PredDelay_find;
@@ -313,6 +315,10 @@ static const char *PredDelay_current_params(
   return params_str;
 }
 
+static const char *PredDelay_effective_params(const cache_t *cache) {
+  return PredDelay_current_params((PredDelay_params_t *)cache->eviction_params);
+}
+
 static void PredDelay_parse_params(cache_t *cache,
                                   const char *cache_specific_params) {
   PredDelay_params_t *params = (PredDelay_params_t *)cache->eviction_params;
@@ -34,6 +34,7 @@ static const char *DEFAULT_CACHE_PARAMS = "prob=0.5";
 
 static void PredProb_parse_params(cache_t *cache,
                                const char *cache_specific_params);
+static const char *PredProb_effective_params(const cache_t *cache);
 static void PredProb_free(cache_t *cache);
 static bool PredProb_get(cache_t *cache, const request_t *req);
 static cache_obj_t *PredProb_find(cache_t *cache, const request_t *req,
@@ -60,6 +61,7 @@ cache_t *PredProb_init(const common_cache_params_t ccache_params,
                   const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("PredProb", ccache_params, cache_specific_params);
   cache->cache_init = PredProb_init;
+  cache->current_params = PredProb_effective_params;
   cache->cache_free = PredProb_free;
   cache->get = PredProb_get;
   cache->find = PredProb_find;
@@ -322,6 +324,10 @@ static const char *PredProb_current_params(PredProb_params_t *params) {
   return params_str;
 }
 
+static const char *PredProb_effective_params(const cache_t *cache) {
+  return PredProb_current_params((PredProb_params_t *)cache->eviction_params);
+}
+
 static void PredProb_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   PredProb_params_t *params = (PredProb_params_t *)cache->eviction_params;
@@ -74,6 +74,7 @@ typedef struct {
 
 static void QDLPv0_parse_params(cache_t *cache,
                               const char *cache_specific_params);
+static const char *QDLPv0_effective_params(const cache_t *cache);
 static void QDLPv0_free(cache_t *cache);
 static bool QDLPv0_get(cache_t *cache, const request_t *req);
 static cache_obj_t *QDLPv0_find(cache_t *cache, const request_t *req,
@@ -105,6 +106,7 @@ cache_t *QDLPv0_init(const common_cache_params_t ccache_params,
                    const char *cache_specific_params) {
   cache_t *cache = cache_struct_init("QDLPv0", ccache_params, cache_specific_params);
   cache->cache_init = QDLPv0_init;
+  cache->current_params = QDLPv0_effective_params;
   cache->cache_free = QDLPv0_free;
   cache->get = QDLPv0_get;
   cache->find = QDLPv0_find;
@@ -474,6 +476,10 @@ static const char *QDLPv0_current_params(QDLPv0_params_t *params) {
   return params_str;
 }
 
+static const char *QDLPv0_effective_params(const cache_t *cache) {
+  return QDLPv0_current_params((QDLPv0_params_t *)cache->eviction_params);
+}
+
 static void QDLPv0_parse_params(cache_t *cache,
                               const char *cache_specific_params) {
   QDLPv0_params_t *params = (QDLPv0_params_t *)cache->eviction_params;
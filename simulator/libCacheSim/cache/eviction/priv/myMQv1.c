@@ -43,6 +43,7 @@ static const char *DEFAULT_PARAMS =
 
 static void myMQv1_parse_params(cache_t *cache,
                                 const char *cache_specific_params);
+static const char *myMQv1_effective_params(const cache_t *cache);
 static void myMQv1_free(cache_t *cache);
 static bool myMQv1_get(cache_t *cache, const request_t *req);
 static cache_obj_t *myMQv1_find(cache_t *cache, const request_t *req,
@@ -72,6 +73,7 @@ cache_t *myMQv1_init(const common_cache_params_t ccache_params,
   cache_t *cache =
       cache_struct_init("myMQv1", ccache_params, cache_specific_params);
   cache->cache_init = myMQv1_init;
+  cache->current_params = myMQv1_effective_params;
   cache->cache_free = myMQv1_free;
   cache->get = myMQv1_get;
   cache->find = myMQv1_find;
@@ -293,6 +295,10 @@ static const char *myMQv1_current_params(cache_t *cache,
   return params_str;
 }
 
+static const char *myMQv1_effective_params(const cache_t *cache) {
+  return myMQv1_current_params((cache_t *)cache, (myMQv1_params_t *)cache->eviction_params);
+}
+
 static void myMQv1_parse_params(cache_t *cache,
                                 const char *cache_specific_params) {
   myMQv1_params_t *params = (myMQv1_params_t *)cache->eviction_params;
@@ -350,6 +350,7 @@ void Mithril_prefetch(cache_t *cache, const request_t *req) {
         break;
       }
       new_req->obj_id = Mithril_params->ptable_array[dim1][dim2 + i];
+      new_req->hv = 0;
       new_req->obj_size = GPOINTER_TO_INT(g_hash_table_lookup(
           Mithril_params->cache_size_map, GINT_TO_POINTER(new_req->obj_id)));
 
@@ -383,6 +384,7 @@ void Mithril_prefetch(cache_t *cache, const request_t *req) {
   if (Mithril_params->sequential_type == 1 &&
       _Mithril_check_sequential(cache, req)) {
     new_req->obj_id = req->obj_id + 1;
+    new_req->hv = 0;
     new_req->obj_size = req->obj_size;  // same size
 
     if (cache->find(cache, new_req, false)) {
@@ -165,6 +165,7 @@ void PG_prefetch(cache_t *cache, const request_t *req) {
     copy_request(new_req, req);
     while (node) {
       new_req->obj_id = GPOINTER_TO_INT(node->data);
+      new_req->hv = 0;
       new_req->obj_size =
           GPOINTER_TO_INT(g_hash_table_lookup(PG_params->cache_size_map, GINT_TO_POINTER(new_req->obj_id)));
       if (!cache->find(cache, new_req, false)) {
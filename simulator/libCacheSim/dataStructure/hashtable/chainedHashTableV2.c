@@ -36,6 +36,10 @@ extern "C" {
 #include "../hash/hash.h"
 #include "chainedHashTableV2.h"
 
+/* the chained tables use hash_next, which does not exist in the objects
+ * when the object index is the open-addressing table */
+#if HASHTABLE_TYPE != SWISS_HASHTABLE
+
 #define OBJ_EMPTY(cache_obj) ((cache_obj)->obj_size == 0)
 #define NEXT_OBJ(cur_obj) (((cache_obj_t *)(cur_obj))->hash_next)
 
@@ -69,11 +73,10 @@ static inline void add_to_bucket_f(hashtable_t *hashtable,
   hashtable->ptr_table[hv] = cache_obj;
                                    }
 
-/* add an object to the hashtable */
-static inline void add_to_bucket(hashtable_t *hashtable,
-                                 cache_obj_t *cache_obj) {
-  uint64_t hv = get_hash_value_int_64(&cache_obj->obj_id) &
-                hashmask(hashtable->hashpower);
+/* add an object to the hashtable, hv is the hash value of the object */
+static inline void add_to_bucket(hashtable_t *hashtable, cache_obj_t *cache_obj,
+                                 uint64_t hv) {
+  hv = hv & hashmask(hashtable->hashpower);
   if (hashtable->ptr_table[hv] == NULL) {
     hashtable->ptr_table[hv] = cache_obj;
     return;
@@ -122,12 +125,11 @@ hashtable_t *create_chained_hashtable_v2(const uint16_t hashpower) {
   return hashtable;
 }
 
-cache_obj_t *chained_hashtable_find_obj_id_v2(const hashtable_t *hashtable,
-                                              const obj_id_t obj_id) {
-  cache_obj_t *cache_obj = NULL;
-  uint64_t hv = get_hash_value_int_64(&obj_id);
-  hv = hv & hashmask(hashtable->hashpower);
-  cache_obj = hashtable->ptr_table[hv];
+/* find obj_id in the bucket of hash value hv */
+static inline cache_obj_t *find_in_bucket(const hashtable_t *hashtable,
+                                          const obj_id_t obj_id, uint64_t hv) {
+  cache_obj_t *cache_obj =
+      hashtable->ptr_table[hv & hashmask(hashtable->hashpower)];
 
   while (cache_obj) {
     if (cache_obj->obj_id == obj_id) {
@@ -138,9 +140,15 @@ cache_obj_t *chained_hashtable_find_obj_id_v2(const hashtable_t *hashtable,
   return cache_obj;
 }
 
+cache_obj_t *chained_hashtable_find_obj_id_v2(const hashtable_t *hashtable,
+                                              const obj_id_t obj_id) {
+  return find_in_bucket(hashtable, obj_id, get_hash_value_int_64(&obj_id));
+}
+
+/* the hash value computed by the reader is used if there is one */
 cache_obj_t *chained_hashtable_find_v2(const hashtable_t *hashtable,
                                        const request_t *req) {
-  return chained_hashtable_find_obj_id_v2(hashtable, req->obj_id);
+  return find_in_bucket(hashtable, req->obj_id, get_hash_value_req(req));
 }
 
 cache_obj_t *chained_hashtable_find_obj_v2(const hashtable_t *hashtable,
@@ -148,6 +156,31 @@ cache_obj_t *chained_hashtable_find_obj_v2(const hashtable_t *hashtable,
   return chained_hashtable_find_obj_id_v2(hashtable, obj_to_find->obj_id);
 }
 
+/**
+ * prefetch the bucket of an object that will be looked up soon,
+ * the returned bucket index can be passed to chained_hashtable_prefetch_chain_v2
+ * once the bucket is in the CPU cache
+ */
+uint64_t chained_hashtable_prefetch_bucket_v2(const hashtable_t *hashtable,
+                                              const request_t *req) {
+  uint64_t hv = get_hash_value_req(req) & hashmask(hashtable->hashpower);
+  __builtin_prefetch(&hashtable->ptr_table[hv], 0, 1);
+  return hv;
+}
+
+/**
+ * prefetch the first object in the bucket, the table only grows,
+ * so a bucket computed before an expansion is still a valid index,
+ * it may point to a different chain, which only wastes the prefetch
+ */
+void chained_hashtable_prefetch_chain_v2(const hashtable_t *hashtable,
+                                         const uint64_t bucket) {
+  cache_obj_t *cache_obj = hashtable->ptr_table[bucket];
+  if (cache_obj != NULL) {
+    __builtin_prefetch(cache_obj, 0, 1);
+  }
+}
+
 /* the user needs to make sure the added object is not in the hash table */
 cache_obj_t *chained_hashtable_insert_v2(hashtable_t *hashtable,
                                          const request_t *req) {
@@ -157,7 +190,7 @@ cache_obj_t *chained_hashtable_insert_v2(hashtable_t *hashtable,
   }
 
   cache_obj_t *new_cache_obj = create_cache_obj_from_request(req);
-  add_to_bucket(hashtable, new_cache_obj);
+  add_to_bucket(hashtable, new_cache_obj, get_hash_value_req(req));
   hashtable->n_obj += 1;
   return new_cache_obj;
 }
@@ -170,7 +203,8 @@ cache_obj_t *chained_hashtable_insert_obj_v2(hashtable_t *hashtable,
   //                                   CHAINED_HASHTABLE_EXPAND_THRESHOLD))
   //   _chained_hashtable_expand_v2(hashtable);
 
-  add_to_bucket(hashtable, cache_obj);
+  add_to_bucket(hashtable, cache_obj,
+                get_hash_value_int_64(&cache_obj->obj_id));
   hashtable->n_obj += 1;
   return cache_obj;
 }
@@ -426,7 +460,8 @@ static void _chained_hashtable_expand_v2(hashtable_t *hashtable) {
     while (cur_obj != NULL) {
       next_obj = cur_obj->hash_next;
       cur_obj->hash_next = NULL;
-      add_to_bucket(hashtable, cur_obj);
+      add_to_bucket(hashtable, cur_obj,
+                    get_hash_value_int_64(&cur_obj->obj_id));
       cur_obj = next_obj;
     }
   }
@@ -506,6 +541,8 @@ static void print_hashbucket_item_distribution(const hashtable_t *hashtable) {
   printf("\n #################### %d \n", n_obj);
 }
 
+#endif /* HASHTABLE_TYPE != SWISS_HASHTABLE */
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -30,6 +30,14 @@ cache_obj_t *chained_hashtable_find_v2(const hashtable_t *hashtable,
 cache_obj_t *chained_hashtable_find_obj_v2(const hashtable_t *hashtable,
                                            const cache_obj_t *obj_to_evict);
 
+/* prefetch the bucket of the request and return the bucket index */
+uint64_t chained_hashtable_prefetch_bucket_v2(const hashtable_t *hashtable,
+                                              const request_t *req);
+
+/* prefetch the first object in a bucket returned by prefetch_bucket */
+void chained_hashtable_prefetch_chain_v2(const hashtable_t *hashtable,
+                                         const uint64_t bucket);
+
 /* return an empty cache_obj_t */
 cache_obj_t *chained_hashtable_insert_v2(hashtable_t *hashtable,
                                          const request_t *req);
@@ -17,6 +17,10 @@
 #include "../hash/hash.h"
 #include "hashtableStruct.h"
 
+/* the chained tables use hash_next, which does not exist in the objects
+ * when the object index is the open-addressing table */
+#if HASHTABLE_TYPE != SWISS_HASHTABLE
+
 #define OBJ_EMPTY(cache_obj) ((cache_obj)->obj_size == 0)
 
 static void chained_hashtable_remove_ptr_from_monitoring(
@@ -178,8 +182,7 @@ cache_obj_t *chained_hashtable_insert(hashtable_t *hashtable, request_t *req) {
                                     CHAINED_HASHTABLE_EXPAND_THRESHOLD))
     _chained_hashtable_expand(hashtable);
 
-  uint64_t hv =
-      get_hash_value_int_64(&req->obj_id) & hashmask(hashtable->hashpower);
+  uint64_t hv = get_hash_value_req(req) & hashmask(hashtable->hashpower);
   cache_obj_t *cache_obj = &hashtable->table[hv];
   if (OBJ_EMPTY(cache_obj)) {
     // this place is available
@@ -423,6 +426,8 @@ void check_chained_hashtable_integrity2(hashtable_t *hashtable,
   }
 }
 
+#endif /* HASHTABLE_TYPE != SWISS_HASHTABLE */
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
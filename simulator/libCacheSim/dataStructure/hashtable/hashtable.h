@@ -27,6 +27,8 @@
 #define hashtable_foreach(hashtable, iter_func, user_data) chained_hashtable_foreach(hashtable, iter_func, user_data)
 #define free_hashtable(hashtable) free_chained_hashtable(hashtable)
 #define hashtable_add_ptr_to_monitoring(hashtable, ptr) chained_hashtable_add_ptr_to_monitoring(hashtable, ptr)
+#define hashtable_prefetch_bucket(hashtable, req) 0
+#define hashtable_prefetch_chain(hashtable, bucket)
 #define HASHTABLE_VER 1
 
 #elif HASHTABLE_TYPE == CHAINED_HASHTABLEV2
@@ -47,8 +49,34 @@
 #define free_hashtable(hashtable) free_chained_hashtable_v2(hashtable)
 #define free_chained_hashtable_f(hashtable) free_chained_hashtable_f_v2(hashtable)
 #define hashtable_add_ptr_to_monitoring(hashtable, ptr)
+#define hashtable_prefetch_bucket(hashtable, req) chained_hashtable_prefetch_bucket_v2(hashtable, req)
+#define hashtable_prefetch_chain(hashtable, bucket) chained_hashtable_prefetch_chain_v2(hashtable, bucket)
 #define HASHTABLE_VER 2
 
+#elif HASHTABLE_TYPE == SWISS_HASHTABLE
+#include "swissHashTable.h"
+/* objects are not chained, so an object can be in several tables
+ * and the _f_ variants are the same as the regular ones */
+#define create_hashtable(hashpower) create_swiss_hashtable(hashpower)
+#define hashtable_find(hashtable, req) swiss_hashtable_find(hashtable, req)
+#define hashtable_find_obj_id(hashtable, obj_id) swiss_hashtable_find_obj_id(hashtable, obj_id)
+#define hashtable_f_find_obj_id(hashtable, obj_id) swiss_hashtable_find_obj_id(hashtable, obj_id)
+#define hashtable_find_obj(hashtable, cache_obj) swiss_hashtable_find_obj(hashtable, cache_obj)
+#define hashtable_insert(hashtable, req) swiss_hashtable_insert(hashtable, req)
+#define hashtable_insert_obj(hashtable, cache_obj) swiss_hashtable_insert_obj(hashtable, cache_obj)
+#define hashtable_f_insert_obj(hashtable, cache_obj) swiss_hashtable_insert_obj(hashtable, cache_obj)
+#define hashtable_delete(hashtable, cache_obj) swiss_hashtable_delete(hashtable, cache_obj)
+#define hashtable_try_delete(hashtable, cache_obj) swiss_hashtable_try_delete(hashtable, cache_obj)
+#define hashtable_delete_obj_id(hashtable, obj_id) swiss_hashtable_delete_obj_id(hashtable, obj_id)
+#define hashtable_rand_obj(hashtable) swiss_hashtable_rand_obj(hashtable)
+#define hashtable_foreach(hashtable, iter_func, user_data) swiss_hashtable_foreach(hashtable, iter_func, user_data)
+#define free_hashtable(hashtable) free_swiss_hashtable(hashtable)
+#define free_chained_hashtable_f(hashtable) free_swiss_hashtable_f(hashtable)
+#define hashtable_add_ptr_to_monitoring(hashtable, ptr)
+#define hashtable_prefetch_bucket(hashtable, req) swiss_hashtable_prefetch_bucket(hashtable, req)
+#define hashtable_prefetch_chain(hashtable, bucket) swiss_hashtable_prefetch_chain(hashtable, bucket)
+#define HASHTABLE_VER 3
+
 #elif HASHTABLE_TYPE == CUCKCOO_HASHTABLE
 #include "cuckooHashTable.h"
 #error not implemented
@@ -0,0 +1,437 @@
+//
+// This hash table is an open-addressing table of pointers to cache_obj_t,
+// the slots are organized in groups of 16, each slot has a one-byte control
+// word that is either empty, deleted, or the top 7 bits of the hash value
+// of the object in the slot.
+// A lookup compares the 7-bit tag with the 16 control words of a group in one
+// SIMD instruction and only dereferences the objects whose tag matches, so
+// in the common case a hit touches the control group, the slot and the
+// object, three cache lines, and a miss touches only the control group.
+//
+// The control words and the slots are two separate arrays, group i is
+// ctrl[16i..16i+15] and slots[16i..16i+15]:
+//
+// ctrl  |-------------|-------------|-----|
+//       | 16 B grp 0  | 16 B grp 1  | ... |   (uint8_t)
+//       |-------------|-------------|-----|
+// slots |-----------------------------|-----------------------------|-----|
+//       | 16 cache_obj_t * (grp 0)    | 16 cache_obj_t * (grp 1)    | ... |
+//       |-----------------------------|-----------------------------|-----|
+//
+// The table grows incrementally, when the table is too full, a new table is
+// allocated and each following insertion moves a few groups from the old
+// table, lookups check the new table first and then the old table.
+// Deletions never move objects, so objects can be deleted in hashtable_foreach.
+// The object does not need a hash_next pointer.
+//
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "swissHashTable.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "../../include/libCacheSim/logging.h"
+#include "../../include/libCacheSim/macro.h"
+#include "../../utils/include/mymath.h"
+#include "../hash/hash.h"
+
+#define GROUP_SIZE 16
+#define CTRL_EMPTY ((uint8_t)0x80)
+#define CTRL_DELETED ((uint8_t)0xFE)
+#define IS_FULL(ctrl) ((ctrl) < 0x80)
+/* the table is rehashed when full and deleted slots reach 7/8 */
+#define MAX_LOAD_NUM 7
+#define MAX_LOAD_DEN 8
+/* the number of old groups moved to the new table in each insertion */
+#define N_MIGRATE_GROUP 8
+
+typedef struct {
+  uint8_t *ctrl;
+  cache_obj_t **slots;
+  uint64_t n_group;
+  uint64_t n_used; /* full and deleted slots */
+} swiss_array_t;
+
+typedef struct {
+  swiss_array_t cur;
+  /* the table being migrated, n_group is 0 if there is no migration */
+  swiss_array_t old;
+  uint64_t migrate_pos;
+} swiss_table_t;
+
+#define SWISS(hashtable) ((swiss_table_t *)(hashtable)->extra_data)
+
+/************************ helper func ************************/
+static inline uint8_t hv_to_tag(uint64_t hv) { return (uint8_t)(hv >> 57); }
+
+/* the bit mask of the slots in the group whose control word is ctrl_word */
+static inline uint32_t group_match(const uint8_t *ctrl, uint8_t ctrl_word) {
+#ifdef __SSE2__
+  __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+  __m128i match = _mm_cmpeq_epi8(group, _mm_set1_epi8((char)ctrl_word));
+  return (uint32_t)_mm_movemask_epi8(match);
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < GROUP_SIZE; i++) {
+    if (ctrl[i] == ctrl_word) mask |= 1u << i;
+  }
+  return mask;
+#endif
+}
+
+/* the bit mask of the empty or deleted slots in the group */
+static inline uint32_t group_match_free(const uint8_t *ctrl) {
+#ifdef __SSE2__
+  __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+  return (uint32_t)_mm_movemask_epi8(group);
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < GROUP_SIZE; i++) {
+    if (!IS_FULL(ctrl[i])) mask |= 1u << i;
+  }
+  return mask;
+#endif
+}
+
+static void array_alloc(swiss_array_t *array, uint64_t n_group) {
+  uint64_t n_slot = n_group * GROUP_SIZE;
+  array->n_group = n_group;
+  array->n_used = 0;
+  array->ctrl = my_malloc_n(uint8_t, n_slot);
+  array->slots = my_malloc_n(cache_obj_t *, n_slot);
+  if (array->ctrl == NULL || array->slots == NULL) {
+    ERROR("allocate hash table %lu slots = %ld MiB failed\n",
+          (unsigned long)n_slot,
+          (long)(n_slot * (sizeof(cache_obj_t *) + 1) / 1024 / 1024));
+    exit(1);
+  }
+#ifdef USE_HUGEPAGE
+  madvise(array->slots, sizeof(cache_obj_t *) * n_slot, MADV_HUGEPAGE);
+#endif
+  memset(array->ctrl, CTRL_EMPTY, n_slot);
+  memset(array->slots, 0, sizeof(cache_obj_t *) * n_slot);
+}
+
+static void array_free(swiss_array_t *array) {
+  uint64_t n_slot = array->n_group * GROUP_SIZE;
+  my_free(sizeof(uint8_t) * n_slot, array->ctrl);
+  my_free(sizeof(cache_obj_t *) * n_slot, array->slots);
+  memset(array, 0, sizeof(swiss_array_t));
+}
+
+/* return the slot of obj_id in the array or -1 */
+static inline int64_t array_find(const swiss_array_t *array, uint64_t hv,
+                                 obj_id_t obj_id) {
+  if (array->n_group == 0) return -1;
+
+  uint64_t group_mask = array->n_group - 1;
+  uint64_t group = hv & group_mask;
+  uint8_t tag = hv_to_tag(hv);
+  /* triangular probing visits every group when n_group is a power of 2 */
+  for (uint64_t i = 1;; i++) {
+    const uint8_t *ctrl = array->ctrl + group * GROUP_SIZE;
+    uint32_t match = group_match(ctrl, tag);
+    while (match != 0) {
+      uint64_t pos = group * GROUP_SIZE + __builtin_ctz(match);
+      if (array->slots[pos]->obj_id == obj_id) return (int64_t)pos;
+      match &= match - 1;
+    }
+    /* a probe sequence never passes a group with an empty slot */
+    if (group_match(ctrl, CTRL_EMPTY) != 0) return -1;
+    group = (group + i) & group_mask;
+  }
+}
+
+/* the object must not be in the array */
+static inline void array_insert(swiss_array_t *array, uint64_t hv,
+                                cache_obj_t *cache_obj) {
+  uint64_t group_mask = array->n_group - 1;
+  uint64_t group = hv & group_mask;
+  for (uint64_t i = 1;; i++) {
+    uint8_t *ctrl = array->ctrl + group * GROUP_SIZE;
+    uint32_t match = group_match_free(ctrl);
+    if (match != 0) {
+      int idx = __builtin_ctz(match);
+      if (ctrl[idx] == CTRL_EMPTY) array->n_used += 1;
+      ctrl[idx] = hv_to_tag(hv);
+      array->slots[group * GROUP_SIZE + idx] = cache_obj;
+      return;
+    }
+    group = (group + i) & group_mask;
+  }
+}
+
+static inline void array_erase(swiss_array_t *array, uint64_t pos) {
+  uint8_t *ctrl = array->ctrl + (pos / GROUP_SIZE) * GROUP_SIZE;
+  /* if the group has an empty slot, no probe sequence continues past it,
+   * so the slot can become empty instead of a tombstone */
+  if (group_match(ctrl, CTRL_EMPTY) != 0) {
+    array->ctrl[pos] = CTRL_EMPTY;
+    array->n_used -= 1;
+  } else {
+    array->ctrl[pos] = CTRL_DELETED;
+  }
+  array->slots[pos] = NULL;
+}
+
+/* move a few groups from the old array to the current array */
+static void migrate(hashtable_t *hashtable, uint64_t n_group) {
+  swiss_table_t *table = SWISS(hashtable);
+  swiss_array_t *old = &table->old;
+  if (old->n_group == 0) return;
+
+  uint64_t end = MIN(table->migrate_pos + n_group, old->n_group);
+  for (uint64_t group = table->migrate_pos; group < end; group++) {
+    for (uint64_t pos = group * GROUP_SIZE; pos < (group + 1) * GROUP_SIZE;
+         pos++) {
+      if (IS_FULL(old->ctrl[pos])) {
+        cache_obj_t *cache_obj = old->slots[pos];
+        array_insert(&table->cur, get_hash_value_int_64(&cache_obj->obj_id),
+                     cache_obj);
+        /* keep the probe sequences of the remaining objects intact */
+        old->ctrl[pos] = CTRL_DELETED;
+        old->slots[pos] = NULL;
+      }
+    }
+  }
+  table->migrate_pos = end;
+
+  if (table->migrate_pos == old->n_group) {
+    VERBOSE("hashtable migration to %llu slots finished\n",
+            hashsizeULL(hashtable->hashpower));
+    array_free(old);
+    table->migrate_pos = 0;
+  }
+}
+
+/* start a migration if the current array is too full */
+static void maybe_grow(hashtable_t *hashtable) {
+  swiss_table_t *table = SWISS(hashtable);
+  uint64_t n_slot = table->cur.n_group * GROUP_SIZE;
+  if ((table->cur.n_used + 1) * MAX_LOAD_DEN <= n_slot * MAX_LOAD_NUM) return;
+
+  /* the previous migration must finish before the next one starts */
+  migrate(hashtable, table->old.n_group);
+  if ((table->cur.n_used + 1) * MAX_LOAD_DEN <= n_slot * MAX_LOAD_NUM) return;
+
+  /* double the table if more than half of the slots are in use,
+   * otherwise the table is full of tombstones, rehash to the same size */
+  uint64_t n_group = table->cur.n_group;
+  if (hashtable->n_obj * 2 >= n_slot) {
+    n_group *= 2;
+    hashtable->hashpower += 1;
+  }
+
+  VERBOSE("hashtable resized from %llu to %llu\n",
+          (unsigned long long)n_slot,
+          (unsigned long long)(n_group * GROUP_SIZE));
+  table->old = table->cur;
+  table->migrate_pos = 0;
+  array_alloc(&table->cur, n_group);
+  migrate(hashtable, N_MIGRATE_GROUP);
+}
+
+/* find the array and slot of obj_id, hv is the hash value of obj_id */
+static inline swiss_array_t *find_pos_hv(const hashtable_t *hashtable,
+                                         obj_id_t obj_id, uint64_t hv,
+                                         int64_t *pos) {
+  swiss_table_t *table = SWISS(hashtable);
+  *pos = array_find(&table->cur, hv, obj_id);
+  if (*pos >= 0) return &table->cur;
+
+  *pos = array_find(&table->old, hv, obj_id);
+  if (*pos >= 0) return &table->old;
+  return NULL;
+}
+
+static inline swiss_array_t *find_pos(const hashtable_t *hashtable,
+                                      obj_id_t obj_id, int64_t *pos) {
+  return find_pos_hv(hashtable, obj_id, get_hash_value_int_64(&obj_id), pos);
+}
+
+static void remove_at(hashtable_t *hashtable, swiss_array_t *array,
+                      int64_t pos) {
+  cache_obj_t *cache_obj = array->slots[pos];
+  array_erase(array, pos);
+  hashtable->n_obj -= 1;
+  if (!hashtable->external_obj) free_cache_obj(cache_obj);
+}
+
+/************************ hashtable func ************************/
+hashtable_t *create_swiss_hashtable(const uint16_t hashpower) {
+  hashtable_t *hashtable = my_malloc(hashtable_t);
+  memset(hashtable, 0, sizeof(hashtable_t));
+
+  swiss_table_t *table = my_malloc(swiss_table_t);
+  memset(table, 0, sizeof(swiss_table_t));
+  uint16_t power = MAX(hashpower, 4);
+  array_alloc(&table->cur, hashsize(power) / GROUP_SIZE);
+
+  hashtable->extra_data = table;
+  hashtable->external_obj = false;
+  hashtable->hashpower = power;
+  hashtable->n_obj = 0;
+  return hashtable;
+}
+
+cache_obj_t *swiss_hashtable_find_obj_id(const hashtable_t *hashtable,
+                                         const obj_id_t obj_id) {
+  int64_t pos;
+  swiss_array_t *array = find_pos(hashtable, obj_id, &pos);
+  return array == NULL ? NULL : array->slots[pos];
+}
+
+/* the hash value computed by the reader is used if there is one */
+cache_obj_t *swiss_hashtable_find(const hashtable_t *hashtable,
+                                  const request_t *req) {
+  int64_t pos;
+  swiss_array_t *array =
+      find_pos_hv(hashtable, req->obj_id, get_hash_value_req(req), &pos);
+  return array == NULL ? NULL : array->slots[pos];
+}
+
+cache_obj_t *swiss_hashtable_find_obj(const hashtable_t *hashtable,
+                                      const cache_obj_t *cache_obj) {
+  return swiss_hashtable_find_obj_id(hashtable, cache_obj->obj_id);
+}
+
+/* the user needs to make sure the added object is not in the hash table */
+static cache_obj_t *insert_obj_hv(hashtable_t *hashtable,
+                                  cache_obj_t *cache_obj, uint64_t hv) {
+  maybe_grow(hashtable);
+  swiss_table_t *table = SWISS(hashtable);
+  array_insert(&table->cur, hv, cache_obj);
+  hashtable->n_obj += 1;
+  migrate(hashtable, N_MIGRATE_GROUP);
+  return cache_obj;
+}
+
+cache_obj_t *swiss_hashtable_insert(hashtable_t *hashtable,
+                                    const request_t *req) {
+  cache_obj_t *cache_obj = create_cache_obj_from_request(req);
+  return insert_obj_hv(hashtable, cache_obj, get_hash_value_req(req));
+}
+
+/* the user needs to make sure the added object is not in the hash table */
+cache_obj_t *swiss_hashtable_insert_obj(hashtable_t *hashtable,
+                                        cache_obj_t *cache_obj) {
+  return insert_obj_hv(hashtable, cache_obj,
+                       get_hash_value_int_64(&cache_obj->obj_id));
+}
+
+/* you need to free the extra_metadata before deleting from hash table */
+void swiss_hashtable_delete(hashtable_t *hashtable, cache_obj_t *cache_obj) {
+  bool deleted = swiss_hashtable_try_delete(hashtable, cache_obj);
+  // the object to remove is not in the hash table
+  DEBUG_ASSERT(deleted);
+  (void)deleted;
+}
+
+bool swiss_hashtable_try_delete(hashtable_t *hashtable,
+                                cache_obj_t *cache_obj) {
+  int64_t pos;
+  swiss_array_t *array = find_pos(hashtable, cache_obj->obj_id, &pos);
+  if (array == NULL || array->slots[pos] != cache_obj) return false;
+
+  remove_at(hashtable, array, pos);
+  return true;
+}
+
+bool swiss_hashtable_delete_obj_id(hashtable_t *hashtable,
+                                   const obj_id_t obj_id) {
+  int64_t pos;
+  swiss_array_t *array = find_pos(hashtable, obj_id, &pos);
+  if (array == NULL) return false;
+
+  remove_at(hashtable, array, pos);
+  return true;
+}
+
+cache_obj_t *swiss_hashtable_rand_obj(hashtable_t *hashtable) {
+  swiss_table_t *table = SWISS(hashtable);
+  DEBUG_ASSERT(hashtable->n_obj > 0);
+  /* during migration, a position is drawn over the slots of both arrays, so
+   * each array is drawn in proportion to its size and every object has the
+   * same probability */
+  uint64_t n_cur_slot = table->cur.n_group * GROUP_SIZE;
+  uint64_t n_slot = n_cur_slot + table->old.n_group * GROUP_SIZE;
+  while (true) {
+    uint64_t pos = next_rand() % n_slot;
+    if (pos < n_cur_slot) {
+      if (IS_FULL(table->cur.ctrl[pos])) return table->cur.slots[pos];
+    } else {
+      pos -= n_cur_slot;
+      if (IS_FULL(table->old.ctrl[pos])) return table->old.slots[pos];
+    }
+  }
+}
+
+static void array_foreach(swiss_array_t *array, hashtable_iter iter_func,
+                          void *user_data) {
+  for (uint64_t pos = 0; pos < array->n_group * GROUP_SIZE; pos++) {
+    if (IS_FULL(array->ctrl[pos])) {
+      iter_func(array->slots[pos], user_data);
+    }
+  }
+}
+
+void swiss_hashtable_foreach(hashtable_t *hashtable, hashtable_iter iter_func,
+                             void *user_data) {
+  swiss_table_t *table = SWISS(hashtable);
+  array_foreach(&table->cur, iter_func, user_data);
+  if (table->old.n_group > 0) {
+    array_foreach(&table->old, iter_func, user_data);
+  }
+}
+
+/* prefetch the control group of the request and return the group index */
+uint64_t swiss_hashtable_prefetch_bucket(const hashtable_t *hashtable,
+                                         const request_t *req) {
+  swiss_table_t *table = SWISS(hashtable);
+  uint64_t group = get_hash_value_req(req) & (table->cur.n_group - 1);
+  __builtin_prefetch(table->cur.ctrl + group * GROUP_SIZE, 0, 1);
+  return group;
+}
+
+/* prefetch the slots of the group, if the table has been resized since the
+ * group was computed, the prefetch may be for a different group, which only
+ * wastes the prefetch */
+void swiss_hashtable_prefetch_chain(const hashtable_t *hashtable,
+                                    const uint64_t bucket) {
+  swiss_table_t *table = SWISS(hashtable);
+  if (bucket >= table->cur.n_group) return;
+  __builtin_prefetch(table->cur.slots + bucket * GROUP_SIZE, 0, 1);
+}
+
+static inline void foreach_free_obj(cache_obj_t *cache_obj, void *user_data) {
+  free_cache_obj(cache_obj);
+}
+
+void free_swiss_hashtable_f(hashtable_t *hashtable) {
+  swiss_table_t *table = SWISS(hashtable);
+  array_free(&table->cur);
+  if (table->old.n_group > 0) array_free(&table->old);
+  my_free(sizeof(swiss_table_t), table);
+  my_free(sizeof(hashtable_t), hashtable);
+}
+
+void free_swiss_hashtable(hashtable_t *hashtable) {
+  if (!hashtable->external_obj)
+    swiss_hashtable_foreach(hashtable, foreach_free_obj, NULL);
+  free_swiss_hashtable_f(hashtable);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,66 @@
+//
+// open-addressing object index with SIMD group probing (SwissTable style)
+//
+
+#ifndef libCacheSim_SWISSHASHTABLE_H
+#define libCacheSim_SWISSHASHTABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include "../../include/libCacheSim/cacheObj.h"
+#include "../../include/libCacheSim/request.h"
+#include "hashtableStruct.h"
+
+hashtable_t *create_swiss_hashtable(const uint16_t hashpower_init);
+
+cache_obj_t *swiss_hashtable_find_obj_id(const hashtable_t *hashtable,
+                                         const obj_id_t obj_id);
+
+cache_obj_t *swiss_hashtable_find(const hashtable_t *hashtable,
+                                  const request_t *req);
+
+cache_obj_t *swiss_hashtable_find_obj(const hashtable_t *hashtable,
+                                      const cache_obj_t *cache_obj);
+
+/* return an empty cache_obj_t */
+cache_obj_t *swiss_hashtable_insert(hashtable_t *hashtable,
+                                    const request_t *req);
+
+cache_obj_t *swiss_hashtable_insert_obj(hashtable_t *hashtable,
+                                        cache_obj_t *cache_obj);
+
+bool swiss_hashtable_try_delete(hashtable_t *hashtable,
+                                cache_obj_t *cache_obj);
+
+void swiss_hashtable_delete(hashtable_t *hashtable, cache_obj_t *cache_obj);
+
+bool swiss_hashtable_delete_obj_id(hashtable_t *hashtable,
+                                   const obj_id_t obj_id);
+
+cache_obj_t *swiss_hashtable_rand_obj(hashtable_t *hashtable);
+
+void swiss_hashtable_foreach(hashtable_t *hashtable, hashtable_iter iter_func,
+                             void *user_data);
+
+uint64_t swiss_hashtable_prefetch_bucket(const hashtable_t *hashtable,
+                                         const request_t *req);
+
+void swiss_hashtable_prefetch_chain(const hashtable_t *hashtable,
+                                    const uint64_t bucket);
+
+void free_swiss_hashtable(hashtable_t *hashtable);
+
+/* free the table but not the objects, the objects are owned by another table
+ */
+void free_swiss_hashtable_f(hashtable_t *hashtable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // libCacheSim_SWISSHASHTABLE_H
@@ -0,0 +1,78 @@
+//
+// dense array of resident objects for uniform random sampling,
+// see objArray.h
+//
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "objArray.h"
+
+#include <string.h>
+
+#include "../include/libCacheSim/logging.h"
+#include "../include/libCacheSim/macro.h"
+
+#define OBJ_ARRAY_MIN_CAPACITY 1024
+
+obj_array_t *create_obj_array(uint64_t init_capacity) {
+  obj_array_t *arr = my_malloc(obj_array_t);
+  memset(arr, 0, sizeof(obj_array_t));
+  arr->capacity = MAX(init_capacity, OBJ_ARRAY_MIN_CAPACITY);
+  arr->objs = my_malloc_n(cache_obj_t *, arr->capacity);
+  if (arr->objs == NULL) {
+    ERROR("allocate object array of %lu slots failed\n",
+          (unsigned long)arr->capacity);
+  }
+
+  return arr;
+}
+
+void free_obj_array(obj_array_t *arr) {
+  my_free(sizeof(cache_obj_t *) * arr->capacity, arr->objs);
+  my_free(sizeof(obj_array_t), arr);
+}
+
+/* double the capacity */
+static void grow(obj_array_t *arr) {
+  cache_obj_t **old_objs = arr->objs;
+  uint64_t old_capacity = arr->capacity;
+
+  arr->capacity = old_capacity * 2;
+  arr->objs = my_malloc_n(cache_obj_t *, arr->capacity);
+  if (arr->objs == NULL) {
+    ERROR("allocate object array of %lu slots failed\n",
+          (unsigned long)arr->capacity);
+  }
+  memcpy(arr->objs, old_objs, sizeof(cache_obj_t *) * arr->n_obj);
+
+  my_free(sizeof(cache_obj_t *) * old_capacity, old_objs);
+}
+
+void obj_array_append(obj_array_t *arr, cache_obj_t *obj) {
+  if (arr->n_obj == arr->capacity) {
+    grow(arr);
+  }
+  if (arr->n_obj >= UINT32_MAX) {
+    ERROR("object array cannot hold more than %u objects\n", UINT32_MAX);
+  }
+
+  obj->sample_pos = (uint32_t)arr->n_obj;
+  arr->objs[arr->n_obj] = obj;
+  arr->n_obj += 1;
+}
+
+void obj_array_remove(obj_array_t *arr, cache_obj_t *obj) {
+  uint32_t pos = obj->sample_pos;
+  DEBUG_ASSERT(pos < arr->n_obj && arr->objs[pos] == obj);
+
+  arr->n_obj -= 1;
+  cache_obj_t *last = arr->objs[arr->n_obj];
+  arr->objs[pos] = last;
+  last->sample_pos = pos;
+}
+
+#ifdef __cplusplus
+}
+#endif
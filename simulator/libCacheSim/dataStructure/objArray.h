@@ -0,0 +1,66 @@
+//
+// a dense array of the objects resident in a cache, used by sampling-based
+// eviction algorithms (e.g., Random, RandomK, Hyperbolic) to draw objects
+// uniformly at random with one array read per sample
+//
+// each object stores its index in the array (cache_obj_t.sample_pos), so
+// removing an object moves the last object into its slot in O(1)
+//
+
+#ifndef libCacheSim_OBJARRAY_H
+#define libCacheSim_OBJARRAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "../include/libCacheSim/cacheObj.h"
+#include "../utils/include/mymath.h"
+
+typedef struct obj_array {
+  cache_obj_t **objs;
+  uint64_t n_obj;
+  uint64_t capacity;
+} obj_array_t;
+
+obj_array_t *create_obj_array(uint64_t init_capacity);
+
+void free_obj_array(obj_array_t *arr);
+
+/**
+ * @brief append an object to the array, the array grows when it is full
+ *
+ * @param arr
+ * @param obj
+ */
+void obj_array_append(obj_array_t *arr, cache_obj_t *obj);
+
+/**
+ * @brief remove an object from the array, the last object is moved into
+ * its slot
+ *
+ * @param arr
+ * @param obj
+ */
+void obj_array_remove(obj_array_t *arr, cache_obj_t *obj);
+
+/**
+ * @brief return an object chosen uniformly at random, the array must not be
+ * empty, the index is computed from the high bits of the random number
+ * because the low bits of the LCG in next_rand are weak
+ *
+ * @param arr
+ * @return cache_obj_t*
+ */
+static inline cache_obj_t *obj_array_rand(const obj_array_t *arr) {
+  uint64_t idx = ((next_rand() >> 32) * arr->n_obj) >> 32;
+  return arr->objs[idx];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // libCacheSim_OBJARRAY_H
@@ -8,6 +8,7 @@
 #include "config.h"
 #include "libCacheSim/cache.h"
 #include "libCacheSim/cacheObj.h"
+#include "libCacheSim/checkpoint.h"
 #include "libCacheSim/const.h"
 #include "libCacheSim/enum.h"
 #include "libCacheSim/logging.h"
@@ -15,6 +16,7 @@
 #include "libCacheSim/reader.h"
 #include "libCacheSim/request.h"
 #include "libCacheSim/sampling.h"
+#include "libCacheSim/traceManifest.h"
 
 /* admission */
 #include "libCacheSim/admissionAlgo.h"
@@ -68,6 +68,24 @@ typedef int64_t (*cache_get_n_obj_func_ptr)(const cache_t *);
 
 typedef void (*cache_print_cache_func_ptr)(const cache_t *);
 
+/* the parameters the algorithm runs with, including the defaults */
+typedef const char *(*cache_current_params_func_ptr)(const cache_t *);
+
+/* occupied bytes of the small, main and ghost queue of multi-queue algorithms */
+typedef void (*cache_get_queue_occupancy_func_ptr)(const cache_t *, int64_t *small_byte, int64_t *main_byte,
+                                                   int64_t *ghost_byte);
+
+/* the oldest object of a single-queue cache, the queue is walked towards the head using obj->queue.prev */
+typedef cache_obj_t *(*cache_get_queue_tail_func_ptr)(const cache_t *);
+
+/* the logical clock kept by some algorithms in their params, e.g., the number of insertions */
+typedef int64_t (*cache_get_logical_time_func_ptr)(const cache_t *);
+
+typedef void (*cache_set_logical_time_func_ptr)(cache_t *, int64_t);
+
+/* fit the per-object metadata copied from a checkpoint or a cloned cache to the parameters of this cache */
+typedef void (*cache_restore_obj_func_ptr)(cache_t *, cache_obj_t *);
+
 typedef void (*cache_reset_cache_func_ptr)(cache_t *);
 
 // #define EVICTION_AGE_ARRAY_SZE 40
@@ -105,8 +123,12 @@ typedef struct {
 } cache_stat_t;
 
 struct hashtable;
+struct obj_array;
 struct cache {
   struct hashtable *hashtable;
+  /* optional, the resident objects for uniform sampling, NULL unless the
+   * algorithm calls cache_enable_sample_array */
+  struct obj_array *sample_array;
 
   cache_init_func_ptr cache_init;
   cache_free_func_ptr cache_free;
@@ -122,7 +144,18 @@ struct cache {
   cache_get_occupied_byte_func_ptr get_occupied_byte;
   cache_get_n_obj_func_ptr get_n_obj;
   cache_print_cache_func_ptr print_cache;
+  /* optional, NULL if the algorithm has no parameters */
+  cache_current_params_func_ptr current_params;
   cache_reset_cache_func_ptr reset_cache;
+  /* optional, NULL if the algorithm does not have small/main/ghost queues */
+  cache_get_queue_occupancy_func_ptr get_queue_occupancy;
+  /* optional, set by single-queue algorithms that support checkpoint */
+  cache_get_queue_tail_func_ptr get_queue_tail;
+  /* optional, only needed if the algorithm has its own logical clock */
+  cache_get_logical_time_func_ptr get_logical_time;
+  cache_set_logical_time_func_ptr set_logical_time;
+  /* optional, only needed if the metadata depends on the parameters, e.g., the Clock counter */
+  cache_restore_obj_func_ptr restore_obj;
 
   admissioner_t *admissioner;
 
@@ -154,6 +187,8 @@ struct cache {
   uint8_t n_iterations;
 
   int64_t n_promotion;
+  /* number of objects reinserted at eviction time instead of being evicted */
+  int64_t n_reinsertion;
 
   int evicted;  // used for special random
 
@@ -186,6 +221,9 @@ struct cache {
    * some situations */
   // cache_stat_t stat;
   char cache_name[CACHE_NAME_ARRAY_LEN];
+  /* the name given to cache_struct_init, cache_name may have a suffix of the
+   * parameters, e.g., Clock-2 */
+  char algo_name[CACHE_NAME_ARRAY_LEN];
   char init_params[CACHE_INIT_PARAMS_LEN];
 
   void *last_request_metadata;
@@ -301,6 +339,45 @@ void cache_remove_obj_base(cache_t *cache, cache_obj_t *obj, bool remove_from_ha
  */
 void cache_evict_base(cache_t *cache, cache_obj_t *obj, bool remove_from_hashtable);
 
+/**
+ * @brief keep a dense array of the resident objects so that cache_rand_obj
+ * costs one array read, it is maintained by cache_insert_base and
+ * cache_remove_obj_base and should be called in the init function of
+ * sampling-based algorithms before any object is inserted
+ *
+ * @param cache
+ */
+void cache_enable_sample_array(cache_t *cache);
+
+/**
+ * @brief return a resident object chosen uniformly at random,
+ * it falls back to sampling the hash table if the sample array is not enabled
+ *
+ * @param cache
+ * @return cache_obj_t*
+ */
+cache_obj_t *cache_rand_obj(const cache_t *cache);
+
+/**
+ * @brief prefetch the hash bucket of a future request, the simulator calls
+ * it a few requests ahead so that the lookup does not wait for DRAM,
+ * it only uses the hashtable of the cache, so it does not help composite
+ * caches that look up their sub-caches (e.g., S3FIFO)
+ *
+ * @param cache
+ * @param req the request, its hash value is used if the reader computed it
+ * @return the bucket index, which is passed to cache_prefetch_chain
+ */
+uint64_t cache_prefetch_bucket(const cache_t *cache, const request_t *req);
+
+/**
+ * @brief prefetch the first object in the bucket from cache_prefetch_bucket
+ *
+ * @param cache
+ * @param bucket
+ */
+void cache_prefetch_chain(const cache_t *cache, uint64_t bucket);
+
 /**
  * @brief get the number of bytes occupied, this is the default
  * for most algorithms, but some algorithms may have different implementation
@@ -244,10 +244,13 @@ typedef struct {
 // ############################## cache obj ###################################
 struct cache_obj;
 typedef struct cache_obj {
+#if HASHTABLE_TYPE != SWISS_HASHTABLE
   struct cache_obj *hash_next;
   struct cache_obj *hash_f_next;
+#endif
   obj_id_t obj_id;
   uint32_t obj_size;
+  uint32_t sample_pos;  // index in cache->sample_array, see dataStructure/objArray.h
   uint64_t last_access_time;   // measured as the number of requests
   uint64_t last_access_itime;  // measured as the number of insertions
   uint64_t last_promote_itime;
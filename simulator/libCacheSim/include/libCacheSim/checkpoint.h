@@ -0,0 +1,95 @@
+//
+//  checkpoint.h
+//  libCacheSim
+//
+//  save the state of a warmed-up cache together with the reader position,
+//  so that many simulations that share the same prefix can start from it
+//
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "cache.h"
+#include "reader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief check whether the cache can be checkpointed, only single-queue
+ * algorithms that provide get_queue_tail are supported, e.g.,
+ * FIFO, LRU, Clock, LRU_Prob, LRU_delay, DelayFR
+ *
+ * @param cache
+ */
+static inline bool cache_support_checkpoint(const cache_t *cache) { return cache->get_queue_tail != NULL; }
+
+/**
+ * @brief write the cache state (queue order, per-object metadata and cache
+ * counters) and the reader position to path
+ *
+ * @param cache
+ * @param reader can be NULL if the reader position is not needed
+ * @param path
+ */
+void cache_checkpoint_save(const cache_t *cache, const reader_t *reader, const char *path);
+
+/**
+ * @brief restore a checkpoint into an empty cache, the cache must use the
+ * same algorithm and cache size, but the algorithm parameters can differ,
+ * so one checkpoint can be loaded into many caches, e.g., LRU_Prob with
+ * different prob
+ *
+ * @param cache an empty cache
+ * @param reader if not NULL, it is moved to the position at checkpoint time
+ * @param path
+ */
+void cache_checkpoint_load(cache_t *cache, reader_t *reader, const char *path);
+
+/**
+ * @brief deep clone a populated cache, the new cache has the same objects,
+ * queue order, per-object metadata (e.g., Clock frequency, LRU_Prob scaler)
+ * and counters as old_cache, and it does not share memory with old_cache,
+ * the metadata is fitted to the new parameters by cache->restore_obj, e.g.,
+ * the Clock frequency is capped at the new counter width
+ *
+ * @param old_cache
+ * @param init_params algorithm parameters of the new cache,
+ *  NULL to use the same parameters as old_cache
+ * @return cache_t*
+ */
+cache_t *clone_cache_with_state(const cache_t *old_cache, const char *init_params);
+
+/**
+ * @brief move the reader to the position after n_read_req requests,
+ * binary traces seek to mmap_offset directly, other traces are read again
+ *
+ * @param reader
+ * @param n_read_req
+ * @param mmap_offset
+ */
+void reader_seek_to_req(reader_t *reader, uint64_t n_read_req, size_t mmap_offset);
+
+/**
+ * @brief the offset of the file descriptor of a text or zstd trace,
+ * -1 if the trace is mapped
+ *
+ * @param reader
+ */
+long reader_file_offset(const reader_t *reader);
+
+/**
+ * @brief used by a forked process, give the reader its own file descriptor
+ * of the trace at offset so that it continues from the fork point
+ *
+ * @param reader
+ * @param offset returned by reader_file_offset before the fork
+ */
+void reader_reopen_at_offset(reader_t *reader, long offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHECKPOINT_H */
@@ -28,6 +28,8 @@ extern "C" {
 
 #define CHAINED_HASHTABLE 0xc1
 #define CUCKOO_HASHTABLE 0xc2
+#define CHAINED_HASHTABLEV2 0xc3
+#define SWISS_HASHTABLE 0xc4
 
 #define MEM_ALIGN_SIZE 128
 
@@ -39,6 +39,8 @@ typedef struct {
   bool ignore_obj_size;
   bool ignore_size_zero_req;
   bool obj_id_is_num;
+  /* compute req->hv when reading so that the cache does not hash again */
+  bool offload_hash;
   int64_t cap_at_n_req;  // only process at most n_req requests
 
   int time_field;
@@ -64,6 +66,25 @@ typedef struct {
 
   // sample some requests in the trace
   sampler_t *sampler;
+
+  // decode the trace once per host into shared memory and read from it,
+  // the decoded traces that are not in use are evicted when they use more
+  // than this many bytes, 0 reads the trace file directly
+  int64_t shm_cache_size;
+
+  // read binary traces with large O_DIRECT reads into this many buffers
+  // instead of mmap, the reads go through io_uring when it is supported,
+  // 0 uses mmap
+  int direct_io_n_buf;
+  // pin the io_uring submission thread to direct_io_cpu, otherwise the
+  // reading thread submits the reads
+  bool direct_io_sq_thread;
+  int direct_io_cpu;
+
+  // parse csv and txt traces with this many threads, the trace is indexed
+  // when the reader is set up and parsed a window of chunks at a time,
+  // 0 parses one line at a time
+  int n_parse_thread;
 } reader_init_param_t;
 
 enum read_direction {
@@ -72,6 +93,10 @@ enum read_direction {
 };
 
 struct zstd_reader;
+struct direct_reader;
+struct trace_manifest;
+struct shm_trace;
+struct txt_parallel;
 typedef struct reader {
   /************* common fields *************/
   uint64_t n_read_req;
@@ -102,6 +127,8 @@ typedef struct reader {
   size_t mmap_offset;
   struct zstd_reader *zstd_reader_p;
   bool is_zstd_file;
+  /* not NULL if the trace is read with direct io instead of mmap */
+  struct direct_reader *direct_reader_p;
   /* the size of one request in binary trace */
   size_t item_size;
   /************* used by txt trace *************/
@@ -112,10 +139,14 @@ typedef struct reader {
   bool csv_has_header;
   /* whether the object id is hashed */
   bool obj_id_is_num;
+  /* not NULL if the csv or txt trace is parsed with several threads */
+  struct txt_parallel *txt_parallel;
 
   bool ignore_size_zero_req;
   /* if true, ignore the obj_size in the trace, and use size one */
   bool ignore_obj_size;
+  /* if true, the reader computes the hash value of each request */
+  bool offload_hash;
 
 
   /* this is used when
@@ -127,6 +158,12 @@ typedef struct reader {
   /* used for trace sampling */
   sampler_t *sampler;
   enum read_direction read_direction;
+
+  /* the summary of the trace, computed or loaded on first use */
+  struct trace_manifest *manifest;
+
+  /* the decoded trace in shared memory, NULL if reading the trace file */
+  struct shm_trace *shm_trace;
 } reader_t;
 
 static inline void set_default_reader_init_params(reader_init_param_t *params) {
@@ -153,6 +190,11 @@ static inline void set_default_reader_init_params(reader_init_param_t *params) {
   params->binary_fmt_str = NULL;
 
   params->sampler = NULL;
+  params->shm_cache_size = 0;
+  params->direct_io_n_buf = 0;
+  params->direct_io_sq_thread = false;
+  params->direct_io_cpu = -1;
+  params->n_parse_thread = 0;
 }
 
 static inline reader_init_param_t default_reader_init_params(void) {
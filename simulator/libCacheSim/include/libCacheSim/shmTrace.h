@@ -0,0 +1,59 @@
+//
+//  shmTrace.h
+//  libCacheSim
+//
+//  a decoded trace shared by the processes on one host, e.g., the jobs of
+//  a parameter sweep, the first process that opens the trace decodes it into
+//  shared memory and the others replay from shared memory without reading or
+//  decompressing the trace file
+//
+//  enabled by setting reader_init_param_t.shm_cache_size, which caps the
+//  total size of the decoded traces kept in shared memory
+//
+
+#ifndef SHM_TRACE_H
+#define SHM_TRACE_H
+
+#include "reader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the names of the shared memory segments start with this */
+#define SHM_TRACE_PREFIX "libCacheSim."
+
+/**
+ * @brief serve the reader from the decoded trace in shared memory, decode
+ * the trace into shared memory if no process on the host has done it, or
+ * wait if another process is decoding it
+ *
+ * @param reader the reader after the init params are set, the trace file is
+ * not opened yet
+ * @return true if the reader reads from shared memory, false if the shared
+ * memory cannot be used and the reader should open the trace file
+ */
+bool shm_trace_attach(reader_t *reader);
+
+/**
+ * @brief release the reference of the reader on the decoded trace, the
+ * trace stays in shared memory until it is evicted
+ */
+void shm_trace_detach(reader_t *reader);
+
+int shm_trace_read_one_req(reader_t *reader, request_t *req);
+
+/**
+ * @brief remove the least recently attached decoded traces that no live
+ * process uses until the decoded traces use at most max_byte
+ *
+ * @param max_byte
+ * @return the number of bytes removed
+ */
+int64_t shm_trace_evict(int64_t max_byte);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHM_TRACE_H */
@@ -13,8 +13,14 @@
  */
 
 
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "../include/libCacheSim/logging.h"
 #include "../include/libCacheSim/request.h"
+#include "sketch.h"
 #include "struct.h"
 
 using namespace std;
@@ -58,4 +64,70 @@ class AccessPattern {
   unordered_map<obj_id_t, vector<uint32_t>> access_rtime_map_;
   unordered_map<obj_id_t, vector<uint32_t>> access_vtime_map_;
 };
+
+/**
+ * the access pattern with a fixed memory, it samples the objects with the
+ * smallest hashes (bottom-k), an object that is in the final sample has one
+ * of the k smallest hashes among all objects, so it was admitted at its
+ * first request and never dropped, and its accesses are complete,
+ * this avoids the bias of changing the sample ratio over time
+ *
+ * the accesses of an object are stored in a fixed number of slots of a flat
+ * arena, the first access is always kept, and the rest are reservoir sampled
+ * once the slots are full
+ */
+class BoundedAccessPattern {
+ public:
+  /**
+   * @param mem_size the memory of the arena in bytes
+   * @param max_n_access the number of accesses stored per object
+   */
+  explicit BoundedAccessPattern(uint64_t mem_size, int max_n_access = 512)
+      : max_n_access_(std::max(max_n_access, 2)) {
+    n_slot_ = mem_size / (max_n_access_ * sizeof(uint32_t) * 2);
+    if (n_slot_ < 1) n_slot_ = 1;
+    rtime_arena_.resize(n_slot_ * max_n_access_);
+    vtime_arena_.resize(n_slot_ * max_n_access_);
+    slots_.reserve(n_slot_);
+    slot_map_.reserve(n_slot_);
+  };
+
+  ~BoundedAccessPattern() = default;
+
+  void add_req(const request_t *req);
+
+  void dump(string &path_base);
+
+ private:
+  struct slot {
+    obj_id_t obj_id;
+    uint64_t hash;
+    /* the number of accesses seen, only max_n_access_ are stored */
+    uint32_t n_access;
+  };
+
+  /* a slot for a new object, or -1 if the object is not sampled */
+  int64_t admit(obj_id_t obj_id, uint64_t hash);
+
+  inline uint64_t next_rand() {
+    rand_state_ ^= rand_state_ << 13;
+    rand_state_ ^= rand_state_ >> 7;
+    rand_state_ ^= rand_state_ << 17;
+    return rand_state_;
+  }
+
+  int64_t n_seen_req_ = 0;
+  int64_t start_rtime_ = -1;
+
+  const int max_n_access_;
+  uint64_t n_slot_;
+  vector<uint32_t> rtime_arena_;
+  vector<uint32_t> vtime_arena_;
+  vector<struct slot> slots_;
+  robin_hood::unordered_flat_map<obj_id_t, uint32_t> slot_map_;
+  /* the sampled objects by hash, the largest hash on top */
+  std::priority_queue<std::pair<uint64_t, uint32_t>> hash_heap_;
+
+  uint64_t rand_state_ = 0x2545F4914F6CDD1DULL;
+};
 }  // namespace traceAnalyzer
@@ -0,0 +1,98 @@
+//
+// a ring of request batches with one producer (the decoder) and several
+// consumers (the analysis workers), every consumer reads every batch in
+// order, so each consumer sees the same request sequence as the serial
+// analyzer
+//
+// the producer and each consumer only write their own cursor, a batch slot
+// is reused once every consumer has moved past it, so no lock is needed
+//
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../include/libCacheSim/request.h"
+
+namespace traceAnalyzer {
+
+class BatchRing {
+ public:
+  BatchRing(int n_consumer, int n_batch, int batch_size)
+      : n_batch_(n_batch),
+        batch_size_(batch_size),
+        reqs_(static_cast<size_t>(n_batch) * batch_size),
+        batch_n_req_(n_batch, 0),
+        consumed_(n_consumer) {}
+
+  int batch_size() const { return batch_size_; }
+
+  /* producer: the slot of the next batch, waits until every consumer is
+   * done with the batch that used the slot before */
+  request_t *next_to_fill() {
+    uint64_t n = produced_.v.load(std::memory_order_relaxed);
+    while (n >= n_batch_ + min_consumed()) {
+      std::this_thread::yield();
+    }
+    return &reqs_[(n % n_batch_) * batch_size_];
+  }
+
+  /* producer: make the filled batch visible to the consumers */
+  void publish(int n_req) {
+    uint64_t n = produced_.v.load(std::memory_order_relaxed);
+    batch_n_req_[n % n_batch_] = n_req;
+    produced_.v.store(n + 1, std::memory_order_release);
+  }
+
+  /* producer: no more batch */
+  void close() { closed_.store(true, std::memory_order_release); }
+
+  /* consumer: wait for the next batch,
+   * return false when the ring is closed and every batch is read */
+  bool next(int consumer, request_t **reqs, int *n_req) {
+    uint64_t n = consumed_[consumer].v.load(std::memory_order_relaxed);
+    while (produced_.v.load(std::memory_order_acquire) <= n) {
+      if (closed_.load(std::memory_order_acquire) &&
+          produced_.v.load(std::memory_order_acquire) <= n) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    *reqs = &reqs_[(n % n_batch_) * batch_size_];
+    *n_req = batch_n_req_[n % n_batch_];
+    return true;
+  }
+
+  /* consumer: done with the batch returned by next */
+  void release(int consumer) {
+    consumed_[consumer].v.fetch_add(1, std::memory_order_release);
+  }
+
+ private:
+  /* each cursor on its own cache line */
+  struct alignas(64) cursor_t {
+    std::atomic<uint64_t> v{0};
+  };
+
+  uint64_t min_consumed() const {
+    uint64_t m = UINT64_MAX;
+    for (auto &c : consumed_) {
+      uint64_t v = c.v.load(std::memory_order_acquire);
+      if (v < m) m = v;
+    }
+    return m;
+  }
+
+  const uint64_t n_batch_;
+  const int batch_size_;
+  std::vector<request_t> reqs_;
+  std::vector<int> batch_n_req_;
+
+  cursor_t produced_;
+  std::vector<cursor_t> consumed_;
+  std::atomic<bool> closed_{false};
+};
+
+};  // namespace traceAnalyzer
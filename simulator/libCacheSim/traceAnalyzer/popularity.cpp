@@ -67,24 +67,53 @@ void Popularity::run(obj_info_map_type &obj_map) {
   }
 
   /* calculate Zipf alpha using linear regression */
-  vector<double> log_freq(obj_map.size());
-  vector<double> log_rank(obj_map.size());
-
-  int i = 0;
-  for_each(log_freq.begin(), log_freq.end(),
-           [&](double &item) { item = log(freq_vec_[i++]); });
-  i = 0;
-  for_each(log_rank.begin(), log_rank.end(), [&](double &item) {
-    ++i;
-    item = log(i);
-  });
-
   /* TODO: a better linear regression with intercept and R2 */
-  slope_ = -PopularityUtils::slope(log_rank, log_freq);
+  slope_ = PopularityUtils::zipf_slope(freq_vec_);
 
   has_run = true;
 }
 
+void PopularitySketch::run() {
+  freq_vec_ = top_k_.sorted_cnt();
+
+  if (freq_vec_.size() < 200) {
+    fit_fail_reason_ = "popularity: too few objects (" +
+                       to_string(freq_vec_.size()) +
+                       "), skip the popularity computation";
+    WARN("%s\n", fit_fail_reason_.c_str());
+    return;
+  }
+
+  slope_ = PopularityUtils::zipf_slope(freq_vec_);
+}
+
+void PopularitySketch::dump(string &path_base) {
+  if (freq_vec_.empty()) {
+    ERROR("popularity has not been computed\n");
+    return;
+  }
+
+  string ofile_path = path_base + ".popularity";
+  ofstream ofs(ofile_path, ios::out | ios::trunc);
+  ofs << "# " << path_base << "\n";
+  ofs << "# freq (sorted):cnt - for Zipf plot, the estimated freq of the "
+      << freq_vec_.size() << " most popular objects\n";
+
+  uint32_t last_freq = freq_vec_[0];
+  uint32_t freq_cnt = 0;
+  for (auto &cnt : freq_vec_) {
+    if (cnt == last_freq) {
+      freq_cnt += 1;
+    } else {
+      ofs << last_freq << ":" << freq_cnt << "\n";
+      freq_cnt = 1;
+      last_freq = cnt;
+    }
+  }
+  ofs << last_freq << ":" << freq_cnt << "\n";
+  ofs.close();
+}
+
 vector<uint32_t> freq_vec_{};
 double slope_, intercept_, r2_;
 bool has_run = false;
@@ -9,6 +9,8 @@
 #include <vector>
 
 #include "../include/libCacheSim/logging.h"
+#include "../include/libCacheSim/request.h"
+#include "sketch.h"
 #include "struct.h"
 #include "utils/include/linReg.h"
 
@@ -27,6 +29,22 @@ class PopularityUtils {
     const auto a = (n * s_xy - s_x * s_y) / (n * s_xx - s_x * s_x);
     return a;
   }
+
+  /* the Zipf alpha of a frequency list sorted in descending order, the
+   * negated slope of log(freq) over log(rank), the sums are accumulated on
+   * the fly to avoid two more per-object vectors */
+  static double zipf_slope(const std::vector<uint32_t> &sorted_freq) {
+    const auto n = sorted_freq.size();
+    double s_x = 0, s_y = 0, s_xx = 0, s_xy = 0;
+    for (size_t i = 0; i < n; i++) {
+      double x = log(i + 1), y = log(sorted_freq[i]);
+      s_x += x;
+      s_y += y;
+      s_xx += x * x;
+      s_xy += x * y;
+    }
+    return -(n * s_xy - s_x * s_y) / (n * s_xx - s_x * s_x);
+  }
 };
 
 class Popularity {
@@ -67,4 +85,52 @@ class Popularity {
   double slope_ = -1, intercept_ = -1, r2_ = -1;
   bool has_run = false;
 };
+
+/**
+ * popularity with a fixed memory, a Count-Min sketch estimates the frequency
+ * of each object and a heap keeps the top_k most frequent objects, the Zipf
+ * fit and the dump only cover the top_k objects
+ */
+class PopularitySketch {
+ public:
+  /**
+   * @param mem_size the memory of the Count-Min sketch in bytes
+   * @param top_k the number of most popular objects to track
+   */
+  PopularitySketch(uint64_t mem_size, int top_k)
+      : cms_(mem_size), top_k_(top_k) {}
+  ~PopularitySketch() = default;
+
+  void add_req(const request_t *req) {
+    top_k_.update(req->obj_id, cms_.add(req->obj_id));
+  }
+
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const PopularitySketch &popularity) {
+    if (popularity.fit_fail_reason_.size() > 0)
+      os << popularity.fit_fail_reason_ << "\n";
+    else
+      os << std::setprecision(4)
+         << "popularity: Zipf linear fitting slope=" << popularity.slope_
+         << " (top " << popularity.freq_vec_.size() << " objects)\n";
+
+    return os;
+  }
+
+  /* sort the top objects and fit the Zipf alpha, call after the trace */
+  void run();
+
+  std::vector<uint32_t> &get_sorted_freq() { return freq_vec_; }
+
+  void dump(std::string &path_base);
+
+  std::string fit_fail_reason_ = "";
+
+ private:
+  CountMinSketch cms_;
+  TopK top_k_;
+
+  std::vector<uint32_t> freq_vec_{};
+  double slope_ = -1;
+};
 }  // namespace traceAnalyzer
\ No newline at end of file
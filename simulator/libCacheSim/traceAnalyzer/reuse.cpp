@@ -26,7 +26,7 @@ void ReuseDistribution::add_req(request_t *req) {
     return;
   }
 
-  int pos_rt = (int)(req->rtime_since_last_access / rtime_granularity_);
+  int pos_rt = rtime_pos(req->rtime_since_last_access);
   int pos_vt = (int)(log(double(req->vtime_since_last_access)) / log_log_base_);
 
   reuse_rtime_req_cnt_[pos_rt] += 1;
@@ -66,8 +66,13 @@ void ReuseDistribution::add_req(request_t *req) {
 void ReuseDistribution::dump(string &path_base) {
   ofstream ofs(path_base + ".reuse", ios::out | ios::trunc);
   ofs << "# " << path_base << "\n";
-  ofs << "# reuse real time: freq (time granularity " << rtime_granularity_
-      << ")\n";
+  if (log_rtime_) {
+    ofs << "# reuse real time: freq (log base " << log_base_
+        << " of reuse time + 1)\n";
+  } else {
+    ofs << "# reuse real time: freq (time granularity " << rtime_granularity_
+        << ")\n";
+  }
   for (auto &p : reuse_rtime_req_cnt_) {
     ofs << p.first << ":" << p.second << "\n";
   }
@@ -93,10 +98,16 @@ void ReuseDistribution::turn_on_stream_dump(string &path_base) {
       path_base + ".reuseWindow_w" + to_string(time_window_) + "_rt",
       ios::out | ios::trunc);
   stream_dump_rt_ofs << "# " << path_base << "\n";
-  stream_dump_rt_ofs
-      << "# reuse real time distribution per window (time granularity ";
-  stream_dump_rt_ofs << rtime_granularity_ << ", time window " << time_window_
-                     << ")\n";
+  if (log_rtime_) {
+    stream_dump_rt_ofs
+        << "# reuse real time distribution per window (log base " << log_base_
+        << " of reuse time + 1";
+  } else {
+    stream_dump_rt_ofs
+        << "# reuse real time distribution per window (time granularity "
+        << rtime_granularity_;
+  }
+  stream_dump_rt_ofs << ", time window " << time_window_ << ")\n";
 
   stream_dump_vt_ofs.open(
       path_base + ".reuseWindow_w" + to_string(time_window_) + "_vt",
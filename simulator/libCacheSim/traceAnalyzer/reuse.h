@@ -17,10 +17,12 @@ class ReuseDistribution {
  public:
   explicit ReuseDistribution(std::string output_path, int time_window = 300,
                              int rtime_granularity = 5,
-                             int vtime_granularity = 1000)
+                             int vtime_granularity = 1000,
+                             bool log_rtime = false)
       : time_window_(time_window),
         rtime_granularity_(rtime_granularity),
-        vtime_granularity_(vtime_granularity) {
+        vtime_granularity_(vtime_granularity),
+        log_rtime_(log_rtime) {
     turn_on_stream_dump(output_path);
   };
 
@@ -47,6 +49,9 @@ class ReuseDistribution {
   const double log_log_base_ = log(log_base_);
   const int rtime_granularity_;
   const int vtime_granularity_;
+  /* bucket the real time reuse by log_base_ instead of rtime_granularity_,
+   * the number of buckets no longer grows with the trace time span */
+  const bool log_rtime_;
   const int time_window_;
   int64_t next_window_ts_ = -1;
 
@@ -58,6 +63,11 @@ class ReuseDistribution {
 
   void turn_on_stream_dump(std::string &path_base);
 
+  inline int rtime_pos(int64_t rtime) {
+    if (log_rtime_) return (int)(log(double(rtime + 1)) / log_log_base_);
+    return (int)(rtime / rtime_granularity_);
+  }
+
   void stream_dump_window_reuse_distribution();
 };
 
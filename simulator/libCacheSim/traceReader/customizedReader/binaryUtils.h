@@ -5,6 +5,7 @@
 #endif
 
 #include "../../include/libCacheSim/reader.h"
+#include "../generalReader/directReader.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,6 +40,20 @@ static inline char *_read_bytes_zstd(reader_t *reader) {
 }
 #endif
 
+/* read with direct io, mmap_offset is still the position in the trace */
+static inline char *_read_bytes_direct(reader_t *reader) {
+  if (reader->mmap_offset >= reader->file_size) {
+    return NULL;
+  }
+
+  char *start = direct_reader_read_bytes(
+      reader->direct_reader_p, reader->mmap_offset, reader->item_size);
+  if (start != NULL) {
+    reader->mmap_offset += reader->item_size;
+  }
+  return start;
+}
+
 static inline char *read_bytes(reader_t *reader) {
   char *start = NULL;
 #ifdef SUPPORT_ZSTD_TRACE
@@ -46,7 +61,9 @@ static inline char *read_bytes(reader_t *reader) {
     start = _read_bytes_zstd(reader);
   } else
 #endif
-  {
+  if (reader->direct_reader_p != NULL) {
+    start = _read_bytes_direct(reader);
+  } else {
     start = _read_bytes(reader);
   }
   return start;
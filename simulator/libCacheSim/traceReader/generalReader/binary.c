@@ -17,6 +17,7 @@
 
 #include <string.h>
 
+#include "../customizedReader/binaryUtils.h"
 #include "readerInternal.h"
 
 #ifdef __cplusplus
@@ -212,7 +213,11 @@ static inline int64_t read_data(char *src, char format) {
 int binary_read_one_req(reader_t *reader, request_t *req) {
   binary_params_t *params = (binary_params_t *)reader->reader_params;
 
-  char *start = (reader->mapped_file + reader->mmap_offset);
+  char *start = read_bytes(reader);
+  if (start == NULL) {
+    req->valid = false;
+    return 1;
+  }
 
   /* read object id */
   req->obj_id = read_data(start + params->obj_id_offset, params->obj_id_format);
@@ -247,7 +252,6 @@ int binary_read_one_req(reader_t *reader, request_t *req) {
                                        params->next_access_vtime_format);
   }
 
-  (reader->mmap_offset) += reader->item_size;
   return 0;
 }
 
@@ -0,0 +1,431 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "directReader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../include/libCacheSim/logging.h"
+
+#ifdef SUPPORT_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* O_DIRECT needs the buffer, the offset and the length aligned to the
+ * logical block size, 4 KiB covers the common devices */
+#define DIRECT_READER_ALIGN 4096
+
+/* a buffer with no data and no read in flight */
+#define BUF_EMPTY_OFFSET (-1)
+#define BUF_IN_FLIGHT (-1)
+
+/************************** io_uring **************************/
+
+#ifdef SUPPORT_IO_URING
+/* the rings are used without liburing, there is one submitter and one
+ * reaper (the reading thread), so only the kernel side needs barriers */
+struct direct_ring {
+  int fd;
+  bool sqpoll;
+
+  unsigned *sq_head;
+  unsigned *sq_tail;
+  unsigned *sq_mask;
+  unsigned *sq_flags;
+  unsigned *sq_array;
+  struct io_uring_sqe *sqes;
+
+  unsigned *cq_head;
+  unsigned *cq_tail;
+  unsigned *cq_mask;
+  struct io_uring_cqe *cqes;
+
+  void *sq_ptr;
+  size_t sq_size;
+  void *cq_ptr;
+  size_t cq_size;
+  size_t sqes_size;
+};
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params *p) {
+  return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags) {
+  return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                      NULL, 0);
+}
+
+static void ring_free(struct direct_ring *ring) {
+  if (ring->sqes != NULL) munmap(ring->sqes, ring->sqes_size);
+  if (ring->cq_ptr != NULL && ring->cq_ptr != ring->sq_ptr)
+    munmap(ring->cq_ptr, ring->cq_size);
+  if (ring->sq_ptr != NULL) munmap(ring->sq_ptr, ring->sq_size);
+  close(ring->fd);
+  free(ring);
+}
+
+static struct direct_ring *ring_create(unsigned entries, int sq_cpu) {
+  struct io_uring_params p;
+  memset(&p, 0, sizeof(p));
+  if (sq_cpu >= 0) {
+    /* a kernel thread on sq_cpu submits the reads, so the reading thread
+     * does not enter the kernel while the ring is busy */
+    p.flags = IORING_SETUP_SQPOLL | IORING_SETUP_SQ_AFF;
+    p.sq_thread_cpu = sq_cpu;
+    p.sq_thread_idle = 1000;
+  }
+
+  int fd = sys_io_uring_setup(entries, &p);
+  if (fd < 0 && sq_cpu >= 0) {
+    WARN("cannot create io_uring submission thread on cpu %d: %s\n", sq_cpu,
+         strerror(errno));
+    memset(&p, 0, sizeof(p));
+    fd = sys_io_uring_setup(entries, &p);
+  }
+  if (fd < 0) {
+    WARN("io_uring is not available (%s), read the trace synchronously\n",
+         strerror(errno));
+    return NULL;
+  }
+
+  struct direct_ring *ring = calloc(1, sizeof(struct direct_ring));
+  ring->fd = fd;
+  ring->sqpoll = (p.flags & IORING_SETUP_SQPOLL) != 0;
+  ring->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  ring->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    if (ring->cq_size > ring->sq_size) ring->sq_size = ring->cq_size;
+    ring->cq_size = ring->sq_size;
+  }
+
+  ring->sq_ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (ring->sq_ptr == MAP_FAILED) {
+    ring->sq_ptr = NULL;
+    ring_free(ring);
+    return NULL;
+  }
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    ring->cq_ptr = ring->sq_ptr;
+  } else {
+    ring->cq_ptr = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (ring->cq_ptr == MAP_FAILED) {
+      ring->cq_ptr = NULL;
+      ring_free(ring);
+      return NULL;
+    }
+  }
+  ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (ring->sqes == MAP_FAILED) {
+    ring->sqes = NULL;
+    ring_free(ring);
+    return NULL;
+  }
+
+  char *sq = ring->sq_ptr, *cq = ring->cq_ptr;
+  ring->sq_head = (unsigned *)(sq + p.sq_off.head);
+  ring->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+  ring->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+  ring->sq_flags = (unsigned *)(sq + p.sq_off.flags);
+  ring->sq_array = (unsigned *)(sq + p.sq_off.array);
+  ring->cq_head = (unsigned *)(cq + p.cq_off.head);
+  ring->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+  ring->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+
+  return ring;
+}
+
+static void ring_submit(struct direct_ring *ring, int fd, char *buf,
+                        unsigned len, int64_t offset, int buf_idx) {
+  /* at most n_buf reads are in flight, which is the ring size */
+  unsigned tail = *ring->sq_tail;
+  unsigned idx = tail & *ring->sq_mask;
+  struct io_uring_sqe *sqe = &ring->sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = fd;
+  sqe->addr = (uint64_t)(uintptr_t)buf;
+  sqe->len = len;
+  sqe->off = (uint64_t)offset;
+  sqe->user_data = (uint64_t)buf_idx;
+  ring->sq_array[idx] = idx;
+  __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+  if (ring->sqpoll) {
+    /* the submission thread sleeps after being idle */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(ring->sq_flags, __ATOMIC_RELAXED) &
+        IORING_SQ_NEED_WAKEUP) {
+      sys_io_uring_enter(ring->fd, 0, 0, IORING_ENTER_SQ_WAKEUP);
+    }
+  } else {
+    while (sys_io_uring_enter(ring->fd, 1, 0, 0) < 0) {
+      if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+        ERROR("io_uring submit failed: %s\n", strerror(errno));
+      }
+    }
+  }
+}
+
+/* wait for one completed read, return its result and buffer */
+static int ring_reap(struct direct_ring *ring, int *buf_idx) {
+  unsigned head = *ring->cq_head;
+  while (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+    if (sys_io_uring_enter(ring->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 &&
+        errno != EINTR) {
+      ERROR("io_uring wait failed: %s\n", strerror(errno));
+    }
+  }
+  struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+  *buf_idx = (int)cqe->user_data;
+  int res = cqe->res;
+  __atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+  return res;
+}
+#endif
+
+/************************** buffers **************************/
+
+/* read until the buffer is full or the end of the trace */
+static int64_t read_sync(direct_reader_t *reader, int buf_idx, int64_t done) {
+  int64_t offset = reader->buf_offsets[buf_idx];
+  while (done < DIRECT_READER_BUF_SIZE && offset + done < reader->file_size) {
+    ssize_t n = pread(reader->fd, reader->bufs[buf_idx] + done,
+                      DIRECT_READER_BUF_SIZE - done, offset + done);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      ERROR("cannot read trace at offset %ld: %s\n", (long)(offset + done),
+            strerror(errno));
+    }
+    if (n == 0) break;
+    done += n;
+  }
+  return done;
+}
+
+/* start reading the next part of the trace into the buffer */
+static void submit_buf(direct_reader_t *reader, int buf_idx) {
+  int64_t offset = reader->next_offset;
+  reader->buf_offsets[buf_idx] = offset;
+  reader->next_offset += DIRECT_READER_BUF_SIZE;
+
+  if (offset >= reader->file_size) {
+    reader->buf_lens[buf_idx] = 0;
+    return;
+  }
+#ifdef SUPPORT_IO_URING
+  if (reader->ring != NULL) {
+    reader->buf_lens[buf_idx] = BUF_IN_FLIGHT;
+    ring_submit(reader->ring, reader->fd, reader->bufs[buf_idx],
+                DIRECT_READER_BUF_SIZE, offset, buf_idx);
+    return;
+  }
+#endif
+  reader->buf_lens[buf_idx] = read_sync(reader, buf_idx, 0);
+}
+
+static void wait_buf(direct_reader_t *reader, int buf_idx) {
+#ifdef SUPPORT_IO_URING
+  while (reader->buf_lens[buf_idx] == BUF_IN_FLIGHT) {
+    int idx;
+    int res = ring_reap(reader->ring, &idx);
+    if (res < 0) {
+      ERROR("cannot read trace at offset %ld: %s\n",
+            (long)reader->buf_offsets[idx], strerror(-res));
+    }
+    /* a short read before the end of the trace, read the rest */
+    reader->buf_lens[idx] = read_sync(reader, idx, res);
+  }
+#else
+  (void)reader;
+  (void)buf_idx;
+#endif
+}
+
+/* the next buffer becomes the head, the old head reads the data after the
+ * last buffer */
+static void advance(direct_reader_t *reader) {
+  int old = reader->head;
+  if (!reader->o_direct && reader->buf_lens[old] > 0) {
+    posix_fadvise(reader->fd, reader->buf_offsets[old], reader->buf_lens[old],
+                  POSIX_FADV_DONTNEED);
+  }
+  submit_buf(reader, old);
+  reader->head = (old + 1) % reader->n_buf;
+  wait_buf(reader, reader->head);
+}
+
+/* drop the buffers and read from the block that holds offset */
+static void restart(direct_reader_t *reader, int64_t offset) {
+  for (int i = 0; i < reader->n_buf; i++) wait_buf(reader, i);
+
+  reader->next_offset = offset - offset % DIRECT_READER_ALIGN;
+  for (int i = 0; i < reader->n_buf; i++) submit_buf(reader, i);
+  reader->head = 0;
+  wait_buf(reader, 0);
+}
+
+/* the ring and the in-flight reads belong to the parent, start over */
+static void reset_after_fork(direct_reader_t *reader) {
+#ifdef SUPPORT_IO_URING
+  if (reader->ring != NULL) {
+    /* unmapping and closing only affects this process */
+    ring_free(reader->ring);
+    reader->ring = ring_create(reader->n_buf, reader->sq_cpu);
+  }
+#endif
+  for (int i = 0; i < reader->n_buf; i++) {
+    reader->buf_offsets[i] = BUF_EMPTY_OFFSET;
+    reader->buf_lens[i] = 0;
+  }
+  reader->owner_pid = getpid();
+}
+
+/************************** interface **************************/
+
+direct_reader_t *create_direct_reader(const char *trace_path, int n_buf,
+                                      int sq_cpu) {
+  bool o_direct = true;
+#ifdef O_DIRECT
+  int fd = open(trace_path, O_RDONLY | O_DIRECT);
+  if (fd < 0 && errno == EINVAL) {
+    /* e.g., tmpfs */
+    o_direct = false;
+    fd = open(trace_path, O_RDONLY);
+  }
+#else
+  int fd = open(trace_path, O_RDONLY);
+#ifdef F_NOCACHE
+  if (fd >= 0) fcntl(fd, F_NOCACHE, 1);
+#else
+  o_direct = false;
+#endif
+#endif
+  if (fd < 0) {
+    WARN("cannot open %s: %s\n", trace_path, strerror(errno));
+    return NULL;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return NULL;
+  }
+
+  direct_reader_t *reader = calloc(1, sizeof(direct_reader_t));
+  reader->fd = fd;
+  reader->file_size = st.st_size;
+  reader->o_direct = o_direct;
+  reader->n_buf = n_buf < 2 ? 2 : n_buf;
+  if (reader->n_buf > DIRECT_READER_MAX_BUF)
+    reader->n_buf = DIRECT_READER_MAX_BUF;
+  for (int i = 0; i < reader->n_buf; i++) {
+    if (posix_memalign((void **)&reader->bufs[i], DIRECT_READER_ALIGN,
+                       DIRECT_READER_BUF_SIZE) != 0) {
+      ERROR("cannot allocate direct read buffer\n");
+    }
+    reader->buf_offsets[i] = BUF_EMPTY_OFFSET;
+    reader->buf_lens[i] = 0;
+  }
+  reader->sq_cpu = sq_cpu;
+#ifdef SUPPORT_IO_URING
+  reader->ring = ring_create(reader->n_buf, sq_cpu);
+#endif
+  reader->owner_pid = getpid();
+
+  VERBOSE("direct read %s with %d x %d MiB buffers, %s, %s\n", trace_path,
+          reader->n_buf, DIRECT_READER_BUF_SIZE / 1024 / 1024,
+          reader->ring != NULL ? "io_uring" : "pread",
+          o_direct ? "O_DIRECT" : "page cache");
+
+  return reader;
+}
+
+void free_direct_reader(direct_reader_t *reader) {
+  if (reader->owner_pid == getpid()) {
+    /* the kernel may still write to the buffers */
+    for (int i = 0; i < reader->n_buf; i++) wait_buf(reader, i);
+  }
+#ifdef SUPPORT_IO_URING
+  if (reader->ring != NULL) ring_free(reader->ring);
+#endif
+  for (int i = 0; i < reader->n_buf; i++) free(reader->bufs[i]);
+  free(reader->spill);
+  close(reader->fd);
+  free(reader);
+}
+
+char *direct_reader_read_bytes(direct_reader_t *reader, int64_t offset,
+                               size_t n_byte) {
+  if (offset < 0 || offset + (int64_t)n_byte > reader->file_size) {
+    return NULL;
+  }
+
+  int64_t buf_start = reader->buf_offsets[reader->head];
+  int64_t buf_end = buf_start + reader->buf_lens[reader->head];
+  if (buf_start != BUF_EMPTY_OFFSET && offset >= buf_start &&
+      offset + (int64_t)n_byte <= buf_end) {
+    return reader->bufs[reader->head] + (offset - buf_start);
+  }
+
+  if (reader->owner_pid != getpid()) {
+    reset_after_fork(reader);
+  }
+
+  /* find the buffer that holds offset, reading forward only moves the head
+   * over the buffers that are already read or in flight */
+  while (true) {
+    buf_start = reader->buf_offsets[reader->head];
+    buf_end = buf_start + reader->buf_lens[reader->head];
+    if (buf_start == BUF_EMPTY_OFFSET || offset < buf_start ||
+        offset >= reader->next_offset) {
+      restart(reader, offset);
+    } else if (offset >= buf_end) {
+      advance(reader);
+    } else {
+      break;
+    }
+  }
+
+  char *start = reader->bufs[reader->head] + (offset - buf_start);
+  size_t n_avail = buf_end - offset;
+  if (n_avail >= n_byte) return start;
+
+  /* the request spans two buffers */
+  if (reader->spill_size < n_byte) {
+    reader->spill = realloc(reader->spill, n_byte);
+    reader->spill_size = n_byte;
+  }
+  memcpy(reader->spill, start, n_avail);
+  size_t n_copied = n_avail;
+  while (n_copied < n_byte) {
+    advance(reader);
+    size_t n = reader->buf_lens[reader->head];
+    if (n == 0) return NULL;
+    if (n > n_byte - n_copied) n = n_byte - n_copied;
+    memcpy(reader->spill + n_copied, reader->bufs[reader->head], n);
+    n_copied += n;
+  }
+  return reader->spill;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,83 @@
+#pragma once
+
+//
+//  read a binary trace with large O_DIRECT reads into a ring of aligned
+//  buffers instead of mmap, so replaying a cold trace does not page fault on
+//  every 4 KiB and does not fill the page cache that other jobs use
+//
+//  the reads are submitted through io_uring when libCacheSim is built with
+//  SUPPORT_IO_URING, so the next buffers are read while the current one is
+//  decoded, otherwise each buffer is read with pread when it is needed
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the size of one read, a multiple of the block size */
+#define DIRECT_READER_BUF_SIZE (8 * 1024 * 1024)
+#define DIRECT_READER_MAX_BUF 16
+
+struct direct_ring;
+
+typedef struct direct_reader {
+  int fd;
+  int64_t file_size;
+  /* false if the file system does not support O_DIRECT, the pages that
+   * have been read are dropped from the page cache instead */
+  bool o_direct;
+
+  int n_buf;
+  char *bufs[DIRECT_READER_MAX_BUF];
+  /* the file offset of the data in each buffer */
+  int64_t buf_offsets[DIRECT_READER_MAX_BUF];
+  /* the number of valid bytes in each buffer, -1 if the read is in flight */
+  int64_t buf_lens[DIRECT_READER_MAX_BUF];
+  /* the buffer being decoded, the others hold the data after it in order */
+  int head;
+  /* the file offset of the next read */
+  int64_t next_offset;
+
+  /* holds a request that spans two buffers */
+  char *spill;
+  size_t spill_size;
+
+  /* NULL if the reads are synchronous */
+  struct direct_ring *ring;
+  int sq_cpu;
+  /* a child forked by the simulator cannot use the ring of its parent */
+  pid_t owner_pid;
+} direct_reader_t;
+
+/**
+ * @brief open the trace for direct reads
+ *
+ * @param trace_path
+ * @param n_buf the number of buffers, 2 for double buffering
+ * @param sq_cpu pin the io_uring submission thread to this cpu, -1 to submit
+ * from the reading thread
+ * @return NULL if the trace cannot be opened
+ */
+direct_reader_t *create_direct_reader(const char *trace_path, int n_buf,
+                                      int sq_cpu);
+
+void free_direct_reader(direct_reader_t *reader);
+
+/**
+ * @brief get n_byte of the trace at offset, reading forward is the fast
+ * path, other offsets restart the reads from there
+ *
+ * @return a pointer that is valid until the next call, NULL if the trace has
+ * fewer than offset + n_byte bytes
+ */
+char *direct_reader_read_bytes(direct_reader_t *reader, int64_t offset,
+                               size_t n_byte);
+
+#ifdef __cplusplus
+}
+#endif
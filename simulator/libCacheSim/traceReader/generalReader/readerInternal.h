@@ -53,6 +53,17 @@ bool check_delimiter(const reader_t *reader, char delimiter);
 /**************** txt ****************/
 int txt_read_one_req(reader_t *const reader, request_t *const req);
 
+/**************** csv and txt with several threads ****************/
+/**
+ * @brief index the csv or txt trace with init_params.n_parse_thread threads,
+ * the reader then reads the trace like a binary trace with one-byte items
+ */
+void txtParallel_setup(reader_t *const reader);
+
+int txtParallel_read_one_req(reader_t *const reader, request_t *const req);
+
+void txtParallel_free(reader_t *const reader);
+
 /**************** binary ****************/
 static inline int format_to_size(char format) {
   switch (format) {
@@ -0,0 +1,424 @@
+//
+//  generate a synthetic trace from a workload spec, see synthetic.h
+//
+//  each random number is a hash of (seed, request index, draw index), so
+//  request i does not depend on the requests before it, the Zipf
+//  generator uses rejection-inversion sampling, which needs neither a CDF
+//  table nor a search, see
+//  "Rejection-inversion to generate variates from monotone discrete
+//  distributions", Wolfgang Hormann and Gerhard Derflinger,
+//  ACM TOMACS 6.3 (1996): 169-184
+//
+//  synthetic.c
+//  libCacheSim
+//
+
+#include "synthetic.h"
+
+#include "../../include/libCacheSim/macro.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+#include <strings.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* scan and onehit ids are above the ids of the finite generators */
+#define SYNTHETIC_SCAN_BASE (1ULL << 48)
+#define SYNTHETIC_ONEHIT_BASE (1ULL << 56)
+#define SYNTHETIC_EPSILON 1e-8
+
+static inline uint64_t mix64(uint64_t z) {
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+/* the draw-th random number of request idx */
+static inline uint64_t counter_rand(uint64_t seed, uint64_t idx,
+                                    uint64_t draw) {
+  return mix64(mix64(idx ^ seed) + draw * 0x9e3779b97f4a7c15ULL);
+}
+
+/* a uniform double in [0, 1) */
+static inline double counter_rand_double(uint64_t seed, uint64_t idx,
+                                         uint64_t draw) {
+  return (double)(counter_rand(seed, idx, draw) >> 11) * 0x1.0p-53;
+}
+
+/* (exp(x) - 1) / x */
+static inline double expxm1bx(double x) {
+  return fabs(x) > SYNTHETIC_EPSILON
+             ? expm1(x) / x
+             : 1.0 + x / 2.0 * (1.0 + x / 3.0 * (1.0 + x / 4.0));
+}
+
+/* log(1 + x) / x */
+static inline double log1pxbx(double x) {
+  return fabs(x) > SYNTHETIC_EPSILON
+             ? log1p(x) / x
+             : 1.0 - x * (1 / 2.0 - x * (1 / 3.0 - x * (1 / 4.0)));
+}
+
+/* the integral of the hat function h, (x^(1-q) - 1) / (1 - q) or log(x) */
+static inline double zipf_H(double x, double q) {
+  double log_x = log(x);
+  return expxm1bx((1.0 - q) * log_x) * log_x;
+}
+
+static inline double zipf_H_inv(double x, double q) {
+  double t = x * (1.0 - q);
+  if (t < -1.0) t = -1.0;
+  return exp(log1pxbx(t) * x);
+}
+
+/* the hat function h(x) = 1 / x^q */
+static inline double zipf_h(double x, double q) { return exp(-q * log(x)); }
+
+static uint64_t zipf_sample(const synthetic_gen_t *gen, uint64_t seed,
+                            uint64_t idx) {
+  double q = gen->alpha;
+  /* draw 0 selects the generator, the expected number of rounds is small */
+  for (uint64_t draw = 1;; draw++) {
+    double u = gen->h_x1 +
+               counter_rand_double(seed, idx, draw) * (gen->h_n - gen->h_x1);
+    double x = zipf_H_inv(u, q);
+    double k = round(x);
+    if (k < 1) k = 1;
+    if (k > (double)gen->n_obj) k = (double)gen->n_obj;
+    if (u >= zipf_H(k + 0.5, q) - zipf_h(k, q)) return (uint64_t)k;
+  }
+}
+
+/* parse a number with an optional k/m/g suffix */
+static bool parse_num(const char *s, double *v) {
+  char *end = NULL;
+  while (*s == ' ') s++;
+  *v = strtod(s, &end);
+  if (end == s) return false;
+
+  switch (*end) {
+    case 'k':
+    case 'K':
+      *v *= 1e3;
+      end++;
+      break;
+    case 'm':
+    case 'M':
+      *v *= 1e6;
+      end++;
+      break;
+    case 'g':
+    case 'G':
+      *v *= 1e9;
+      end++;
+      break;
+    default:
+      break;
+  }
+  while (*end == ' ') end++;
+  return *end == '\0';
+}
+
+static bool parse_gen(char *gen_str, synthetic_gen_t *gen, double *weight) {
+  *weight = 1.0;
+  char *star = strchr(gen_str, '*');
+  if (star != NULL) {
+    *star = '\0';
+    if (!parse_num(gen_str, weight) || *weight <= 0) {
+      WARN("invalid weight \"%s\"\n", gen_str);
+      return false;
+    }
+    gen_str = star + 1;
+  }
+
+  char *lparen = strchr(gen_str, '(');
+  char *rparen = strrchr(gen_str, ')');
+  if (lparen == NULL || rparen == NULL || rparen < lparen) {
+    WARN("generator \"%s\" should look like name(args)\n", gen_str);
+    return false;
+  }
+  *lparen = '\0';
+  *rparen = '\0';
+  while (*gen_str == ' ') gen_str++;
+
+  double args[3];
+  int n_arg = 0;
+  char *saveptr = NULL;
+  for (char *arg = strtok_r(lparen + 1, ",", &saveptr); arg != NULL;
+       arg = strtok_r(NULL, ",", &saveptr)) {
+    if (n_arg >= 3 || !parse_num(arg, &args[n_arg])) {
+      WARN("invalid arguments of %s\n", gen_str);
+      return false;
+    }
+    n_arg++;
+  }
+
+  memset(gen, 0, sizeof(synthetic_gen_t));
+  int n_obj_arg = 0, min_arg = 1;
+  if (strcasecmp(gen_str, "zipf") == 0) {
+    gen->type = SYNTHETIC_ZIPF;
+    gen->alpha = n_arg > 0 ? args[0] : 0;
+    n_obj_arg = 1;
+    min_arg = 2;
+  } else if (strcasecmp(gen_str, "uniform") == 0) {
+    gen->type = SYNTHETIC_UNIFORM;
+  } else if (strcasecmp(gen_str, "loop") == 0) {
+    gen->type = SYNTHETIC_LOOP;
+  } else if (strcasecmp(gen_str, "scan") == 0) {
+    gen->type = SYNTHETIC_SCAN;
+    min_arg = 0;
+  } else if (strcasecmp(gen_str, "onehit") == 0) {
+    gen->type = SYNTHETIC_ONEHIT;
+    min_arg = 0;
+  } else {
+    WARN("unknown generator %s, supported: zipf/uniform/loop/scan/onehit\n",
+         gen_str);
+    return false;
+  }
+
+  if (min_arg == 0) {
+    if (n_arg != 0) {
+      WARN("%s does not take arguments\n", gen_str);
+      return false;
+    }
+    return true;
+  }
+  if (n_arg < min_arg || n_arg > min_arg + 1) {
+    WARN("wrong number of arguments of %s\n", gen_str);
+    return false;
+  }
+
+  gen->n_obj = (uint64_t)args[n_obj_arg];
+  gen->base = n_arg > min_arg ? (uint64_t)args[n_arg - 1] : 0;
+  if (gen->n_obj == 0 || gen->base + gen->n_obj >= SYNTHETIC_SCAN_BASE) {
+    WARN("the number of objects of %s should be in [1, 2^48)\n", gen_str);
+    return false;
+  }
+  if (gen->type == SYNTHETIC_ZIPF) {
+    if (gen->alpha < 0) {
+      WARN("the alpha of zipf should not be negative\n");
+      return false;
+    }
+    gen->h_x1 = zipf_H(1.5, gen->alpha) - 1.0;
+    gen->h_n = zipf_H((double)gen->n_obj + 0.5, gen->alpha);
+  }
+  return true;
+}
+
+static bool parse_phase(char *phase_str, synthetic_phase_t *phase) {
+  char *colon = strchr(phase_str, ':');
+  double n_req = 0;
+  if (colon == NULL) {
+    WARN("phase \"%s\" should start with the number of requests\n",
+         phase_str);
+    return false;
+  }
+  *colon = '\0';
+  if (!parse_num(phase_str, &n_req) || n_req < 1) {
+    WARN("invalid number of requests \"%s\"\n", phase_str);
+    return false;
+  }
+  phase->n_req = (uint64_t)n_req;
+
+  double weights[SYNTHETIC_MAX_GEN], sum = 0;
+  phase->n_gen = 0;
+  char *saveptr = NULL;
+  for (char *gen_str = strtok_r(colon + 1, "+", &saveptr); gen_str != NULL;
+       gen_str = strtok_r(NULL, "+", &saveptr)) {
+    if (phase->n_gen >= SYNTHETIC_MAX_GEN) {
+      WARN("a phase has at most %d generators\n", SYNTHETIC_MAX_GEN);
+      return false;
+    }
+    if (!parse_gen(gen_str, &phase->gens[phase->n_gen],
+                   &weights[phase->n_gen])) {
+      return false;
+    }
+    sum += weights[phase->n_gen];
+    phase->n_gen++;
+  }
+  if (phase->n_gen == 0) {
+    WARN("a phase needs at least one generator\n");
+    return false;
+  }
+
+  double cum = 0;
+  for (int i = 0; i < phase->n_gen; i++) {
+    cum += weights[i] / sum;
+    phase->gens[i].cum_weight = cum;
+  }
+  phase->gens[phase->n_gen - 1].cum_weight = 1.0;
+  return true;
+}
+
+bool synthetic_parse_spec(const char *spec_str, synthetic_spec_t *spec) {
+  memset(spec, 0, sizeof(synthetic_spec_t));
+  spec->seed = 42;
+  spec->obj_size = 1;
+
+  char *copy = strdup(spec_str);
+  char *saveptr = NULL;
+  char *phases_str = strtok_r(copy, ";", &saveptr);
+  bool ok = phases_str != NULL;
+
+  /* the options after the phases */
+  for (char *opt = strtok_r(NULL, ";", &saveptr); ok && opt != NULL;
+       opt = strtok_r(NULL, ";", &saveptr)) {
+    char *eq = strchr(opt, '=');
+    double v = 0;
+    if (eq == NULL || !parse_num(eq + 1, &v)) {
+      WARN("option \"%s\" should be key=value\n", opt);
+      ok = false;
+      break;
+    }
+    *eq = '\0';
+    if (strcasecmp(opt, "seed") == 0) {
+      /* strtod loses precision above 2^53 */
+      spec->seed = strtoull(eq + 1, NULL, 10);
+    } else if (strcasecmp(opt, "obj-size") == 0) {
+      spec->obj_size = (uint32_t)v;
+    } else {
+      WARN("unknown option %s, supported: seed/obj-size\n", opt);
+      ok = false;
+    }
+  }
+
+  char *phase_saveptr = NULL;
+  for (char *phase_str = ok ? strtok_r(phases_str, "|", &phase_saveptr) : NULL;
+       phase_str != NULL; phase_str = strtok_r(NULL, "|", &phase_saveptr)) {
+    if (spec->n_phase >= SYNTHETIC_MAX_PHASE) {
+      WARN("a spec has at most %d phases\n", SYNTHETIC_MAX_PHASE);
+      ok = false;
+      break;
+    }
+    synthetic_phase_t *phase = &spec->phases[spec->n_phase];
+    if (!parse_phase(phase_str, phase)) {
+      ok = false;
+      break;
+    }
+    phase->start = spec->n_req;
+    spec->n_req += phase->n_req;
+    spec->n_phase++;
+  }
+
+  free(copy);
+  return ok && spec->n_phase > 0;
+}
+
+obj_id_t synthetic_obj_id(const synthetic_spec_t *spec, uint64_t idx) {
+  const synthetic_phase_t *phase = &spec->phases[0];
+  for (int i = spec->n_phase - 1; i > 0; i--) {
+    if (idx >= spec->phases[i].start) {
+      phase = &spec->phases[i];
+      break;
+    }
+  }
+
+  const synthetic_gen_t *gen = &phase->gens[0];
+  if (phase->n_gen > 1) {
+    double u = counter_rand_double(spec->seed, idx, 0);
+    int i = 0;
+    while (i < phase->n_gen - 1 && u >= phase->gens[i].cum_weight) i++;
+    gen = &phase->gens[i];
+  }
+
+  switch (gen->type) {
+    case SYNTHETIC_ZIPF:
+      return gen->base + zipf_sample(gen, spec->seed, idx);
+    case SYNTHETIC_UNIFORM:
+      return gen->base + 1 +
+             (uint64_t)(((unsigned __int128)counter_rand(spec->seed, idx, 1) *
+                         gen->n_obj) >>
+                        64);
+    case SYNTHETIC_LOOP:
+      return gen->base + 1 + (idx - phase->start) % gen->n_obj;
+    case SYNTHETIC_SCAN:
+      return SYNTHETIC_SCAN_BASE + idx;
+    case SYNTHETIC_ONEHIT:
+      /* mix64 is a bijection, so the ids only collide after truncation */
+      return SYNTHETIC_ONEHIT_BASE |
+             (mix64(idx ^ ~spec->seed) & (SYNTHETIC_ONEHIT_BASE - 1));
+    default:
+      ERROR("unknown synthetic generator %d\n", gen->type);
+      abort();
+  }
+}
+
+typedef struct {
+  const synthetic_spec_t *spec;
+  uint64_t start;
+  uint64_t n;
+  obj_id_t *obj_ids;
+} gen_slice_t;
+
+static void *gen_slice(void *arg) {
+  gen_slice_t *slice = (gen_slice_t *)arg;
+  for (uint64_t i = 0; i < slice->n; i++) {
+    slice->obj_ids[i] = synthetic_obj_id(slice->spec, slice->start + i);
+  }
+  return NULL;
+}
+
+void synthetic_gen_obj_ids(const synthetic_spec_t *spec, uint64_t start,
+                           uint64_t n, obj_id_t *obj_ids, int n_thread) {
+  if (n_thread < 1) n_thread = 1;
+  if ((uint64_t)n_thread > n) n_thread = n == 0 ? 1 : (int)n;
+
+  pthread_t *threads = malloc(sizeof(pthread_t) * n_thread);
+  gen_slice_t *slices = malloc(sizeof(gen_slice_t) * n_thread);
+  uint64_t slice_len = (n + n_thread - 1) / n_thread;
+  for (int i = 0; i < n_thread; i++) {
+    uint64_t begin = MIN(n, slice_len * i);
+    slices[i] = (gen_slice_t){.spec = spec,
+                              .start = start + begin,
+                              .n = MIN(n, begin + slice_len) - begin,
+                              .obj_ids = obj_ids + begin};
+    if (i > 0) pthread_create(&threads[i], NULL, gen_slice, &slices[i]);
+  }
+  /* the calling thread generates the first slice */
+  gen_slice(&slices[0]);
+  for (int i = 1; i < n_thread; i++) pthread_join(threads[i], NULL);
+
+  free(slices);
+  free(threads);
+}
+
+void syntheticReader_setup(reader_t *reader) {
+  synthetic_spec_t *spec = malloc(sizeof(synthetic_spec_t));
+  if (!synthetic_parse_spec(reader->trace_path, spec)) {
+    ERROR("invalid synthetic workload spec %s\n", reader->trace_path);
+  }
+
+  /* the reader walks over the requests like a binary trace of 1-byte
+   * records, so skipping, seeking and cloning work unchanged */
+  reader->trace_format = BINARY_TRACE_FORMAT;
+  reader->reader_params = spec;
+  reader->item_size = 1;
+  reader->file_size = spec->n_req;
+  reader->n_total_req = spec->n_req;
+  reader->trace_start_offset = 0;
+  reader->mmap_offset = 0;
+  reader->obj_id_is_num = true;
+}
+
+int synthetic_read_one_req(reader_t *reader, request_t *req) {
+  const synthetic_spec_t *spec = (synthetic_spec_t *)reader->reader_params;
+  uint64_t idx = reader->mmap_offset;
+
+  req->obj_id = synthetic_obj_id(spec, idx);
+  req->obj_size = spec->obj_size;
+  req->clock_time = (int64_t)idx;
+  req->op = OP_GET;
+  req->next_access_vtime = -2;
+  reader->mmap_offset += 1;
+
+  return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+//
+//  a trace generated on the fly from a workload spec, the spec is given as
+//  the trace path, e.g.,
+//
+//    10m:zipf(1.0,1m)|2m:0.8*zipf(1.0,1m)+0.2*scan()|10m:zipf(0.8,1m,500k)
+//
+//  is 10 million requests following Zipf(1.0) over 1 million objects, then
+//  2 million requests where 20% are a sequential scan of new objects,
+//  then 10 million requests with a flatter Zipf over a shifted object set
+//
+//  spec    := phases [';' option]*
+//  phases  := phase ['|' phase]*
+//  phase   := n_req ':' gen ['+' gen]*
+//  gen     := [weight '*'] name '(' args ')'
+//  option  := seed=<n> | obj-size=<bytes>
+//
+//  numbers accept k/m/g (10^3, 10^6, 10^9) suffixes, the generators are
+//    zipf(alpha, n_obj[, base])  ids base+1 to base+n_obj, base+1 the hottest
+//    uniform(n_obj[, base])      ids base+1 to base+n_obj
+//    loop(n_obj[, base])         base+1, base+2, ..., base+n_obj, base+1, ...
+//    scan()                      sequential ids that are never requested again
+//    onehit()                    random ids that are never requested again
+//  the weights of a phase are normalized, the clock advances by one per
+//  request
+//
+//  request i is a pure function of the spec and i (a counter-based random
+//  generator), so any range of the trace can be generated by any thread,
+//  and the reader can seek, clone and read backward like a binary trace
+//
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "../../include/libCacheSim/reader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SYNTHETIC_MAX_PHASE 16
+#define SYNTHETIC_MAX_GEN 8
+
+typedef enum {
+  SYNTHETIC_ZIPF = 0,
+  SYNTHETIC_UNIFORM,
+  SYNTHETIC_LOOP,
+  SYNTHETIC_SCAN,
+  SYNTHETIC_ONEHIT,
+} synthetic_gen_type_e;
+
+typedef struct {
+  synthetic_gen_type_e type;
+  /* the generator is used if the request's draw is below this */
+  double cum_weight;
+  uint64_t n_obj;
+  uint64_t base;
+  double alpha;
+  /* the constants of rejection-inversion sampling of zipf */
+  double h_x1;
+  double h_n;
+} synthetic_gen_t;
+
+typedef struct {
+  uint64_t n_req;
+  uint64_t start; /* the index of the first request of the phase */
+  int n_gen;
+  synthetic_gen_t gens[SYNTHETIC_MAX_GEN];
+} synthetic_phase_t;
+
+typedef struct {
+  uint64_t seed;
+  uint32_t obj_size;
+  uint64_t n_req;
+  int n_phase;
+  synthetic_phase_t phases[SYNTHETIC_MAX_PHASE];
+} synthetic_spec_t;
+
+/**
+ * @brief parse a workload spec, see the top of this file
+ *
+ * @param spec_str
+ * @param spec
+ * @return false if the spec is invalid, the reason is printed
+ */
+bool synthetic_parse_spec(const char *spec_str, synthetic_spec_t *spec);
+
+/**
+ * @brief the object id of request idx
+ */
+obj_id_t synthetic_obj_id(const synthetic_spec_t *spec, uint64_t idx);
+
+/**
+ * @brief generate the object ids of requests [start, start + n) using
+ * n_thread threads, the result does not depend on n_thread
+ *
+ * @param spec
+ * @param start
+ * @param n
+ * @param obj_ids
+ * @param n_thread
+ */
+void synthetic_gen_obj_ids(const synthetic_spec_t *spec, uint64_t start,
+                           uint64_t n, obj_id_t *obj_ids, int n_thread);
+
+void syntheticReader_setup(reader_t *reader);
+
+int synthetic_read_one_req(reader_t *reader, request_t *req);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,605 @@
+//
+//  parse csv and txt traces with several threads, the trace is mapped and
+//  cut into chunks at line ends, a first pass counts the lines of each chunk
+//  in parallel, so the index of the first request of every chunk is known,
+//  then the requests are parsed a window of chunks at a time, one chunk per
+//  thread, and served from memory like a binary trace with one-byte items
+//
+//  the delimiters and line ends of 64 bytes are found with a few SIMD
+//  compares, chunks that have quotes are parsed with libcsv so quoted
+//  fields are handled the same as the csv reader, and the chunks of csv
+//  traces are not cut inside a quoted field
+//
+//  non-numeric object ids are mapped as in the serial readers: csv traces
+//  hash them, txt traces intern them with GQuark in the reading thread in
+//  request order, so the ids are the same as with one thread
+//
+//  txtParallel.c
+//  libCacheSim
+//
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "../../dataStructure/hash/hash.h"
+#include "../../include/libCacheSim/macro.h"
+#include "libcsv.h"
+#include "readerInternal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the text one thread parses at a time */
+#define TXT_PARALLEL_CHUNK_SIZE (4 * 1024 * 1024)
+/* the number of chunks per thread that are parsed together */
+#define TXT_PARALLEL_WINDOW_CHUNK 4
+/* the longest number that is parsed with the libc functions */
+#define MAX_NUM_LEN 64
+
+typedef struct {
+  int64_t clock_time;
+  /* the offset of the id in the trace if obj_id_len is not 0 */
+  uint64_t obj_id;
+  int64_t obj_size;
+  int64_t cnt;
+  /* the length of a string id of a txt trace that is interned when read */
+  uint32_t obj_id_len;
+} txt_parallel_req_t;
+
+typedef struct txt_parallel {
+  char *data;
+  size_t data_size;
+  int n_thread;
+
+  bool is_csv;
+  char delimiter;
+  int time_field;
+  int obj_id_field;
+  int obj_size_field;
+  int cnt_field;
+  bool obj_id_is_num;
+
+  int64_t n_chunk;
+  /* the byte offset of each chunk, n_chunk + 1 entries */
+  int64_t *chunk_starts;
+  /* the index of the first request of each chunk, n_chunk + 1 entries */
+  int64_t *chunk_first_req;
+  int64_t n_req;
+
+  /* the parsed requests of chunks [win_start, win_end) */
+  int64_t win_start;
+  int64_t win_end;
+  txt_parallel_req_t *reqs;
+  int64_t reqs_cap;
+
+  /* the terminated copy of a string id passed to GQuark */
+  char *id_buf;
+  size_t id_buf_size;
+} txt_parallel_t;
+
+/************************** scan **************************/
+
+/* the bit masks of the line ends and the delimiters of 64 bytes */
+static inline void block_masks(const char *p, size_t len, char delimiter,
+                               uint64_t *nl_mask, uint64_t *delim_mask) {
+  uint64_t nl = 0, dl = 0;
+#ifdef __SSE2__
+  if (len == 64) {
+    const __m128i v_nl = _mm_set1_epi8('\n');
+    const __m128i v_dl = _mm_set1_epi8(delimiter);
+    for (int i = 0; i < 4; i++) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(p + i * 16));
+      nl |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, v_nl))
+            << (i * 16);
+      dl |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, v_dl))
+            << (i * 16);
+    }
+    *nl_mask = nl;
+    *delim_mask = dl;
+    return;
+  }
+#endif
+  for (size_t i = 0; i < len; i++) {
+    nl |= (uint64_t)(p[i] == '\n') << i;
+    dl |= (uint64_t)(p[i] == delimiter) << i;
+  }
+  *nl_mask = nl;
+  *delim_mask = dl;
+}
+
+/* the number of non-empty lines, p starts a line */
+static int64_t count_lines(const char *p, size_t len) {
+  int64_t n = 0;
+  /* whether the byte before the block ends a line */
+  uint64_t carry = 1;
+  for (size_t pos = 0; pos < len; pos += 64) {
+    size_t n_byte = MIN(64, len - pos);
+    uint64_t nl, dl;
+    block_masks(p + pos, n_byte, '\n', &nl, &dl);
+    uint64_t valid = n_byte == 64 ? ~0ULL : (1ULL << n_byte) - 1;
+    uint64_t line_start = ~nl & ((nl << 1) | carry) & valid;
+    n += __builtin_popcountll(line_start);
+    carry = nl >> 63;
+  }
+  return n;
+}
+
+/************************** parse **************************/
+
+/* parse a decimal number without a leading zero, which strtoull would parse
+ * as octal, return false if the field needs the libc parser */
+static inline bool parse_dec(const char *s, const char *e, uint64_t *v) {
+  if (s == e || e - s > 19 || (*s == '0' && e - s > 1)) return false;
+  uint64_t x = 0;
+  for (; s < e; s++) {
+    if (*s < '0' || *s > '9') return false;
+    x = x * 10 + (*s - '0');
+  }
+  *v = x;
+  return true;
+}
+
+/* copy the field so that the libc parser sees a terminated string */
+static inline const char *field_str(const char *s, const char *e, char *buf) {
+  size_t len = MIN((size_t)(e - s), MAX_NUM_LEN - 1);
+  memcpy(buf, s, len);
+  buf[len] = '\0';
+  return buf;
+}
+
+static inline void parse_field(const txt_parallel_t *tp, int field_idx,
+                               const char *s, const char *e,
+                               txt_parallel_req_t *r) {
+  char buf[MAX_NUM_LEN];
+  char *end;
+  uint64_t v;
+
+  if (tp->is_csv) {
+    /* libcsv trims the spaces around unquoted fields */
+    while (s < e && (*s == ' ' || (*s == '\t' && tp->delimiter != '\t'))) s++;
+    while (e > s && (e[-1] == ' ' || e[-1] == '\r' ||
+                     (e[-1] == '\t' && tp->delimiter != '\t')))
+      e--;
+  }
+
+  if (field_idx == tp->obj_id_field) {
+    if (!tp->obj_id_is_num && !tp->is_csv) {
+      r->obj_id = (uint64_t)(s - tp->data);
+      r->obj_id_len = (uint32_t)(e - s);
+    } else if (!tp->obj_id_is_num) {
+      r->obj_id = (uint64_t)get_hash_value_str(s, e - s);
+    } else if (parse_dec(s, e, &v)) {
+      r->obj_id = v;
+    } else {
+      const char *str = field_str(s, e, buf);
+      r->obj_id = strtoull(str, &end, 0);
+      if (r->obj_id == 0 && end == str && tp->is_csv) {
+        WARN("object id is not numeric %s\n", str);
+      } else if (r->obj_id == 0 && end == str) {
+        ERROR("invalid object id, line: \"%s\"\n", str);
+      }
+    }
+  } else if (field_idx == tp->time_field) {
+    /* the csv reader truncates a float time */
+    const char *dot = s;
+    while (dot < e && *dot != '.') dot++;
+    if (parse_dec(s, dot, &v) &&
+        (dot == e || parse_dec(dot + 1, e, &(uint64_t){0}) || dot + 1 == e)) {
+      r->clock_time = (int64_t)v;
+    } else {
+      r->clock_time = (int64_t)(uint64_t)atof(field_str(s, e, buf));
+    }
+  } else if (field_idx == tp->obj_size_field) {
+    if (parse_dec(s, e, &v)) {
+      r->obj_size = (uint32_t)v;
+    } else {
+      const char *str = field_str(s, e, buf);
+      r->obj_size = (uint32_t)strtoul(str, &end, 0);
+      if (r->obj_size == 0 && end == str) {
+        ERROR("csvReader obj_size is not a number: \"%s\"\n", str);
+      }
+    }
+  } else if (field_idx == tp->cnt_field) {
+    if (!parse_dec(s, e, &v)) v = strtoull(field_str(s, e, buf), &end, 0);
+    r->cnt = (int64_t)v;
+  }
+}
+
+/* parse the lines of a chunk that has no quote, return the number of
+ * requests */
+static int64_t parse_chunk_simd(const txt_parallel_t *tp, const char *p,
+                                size_t len, txt_parallel_req_t *out) {
+  int64_t n = 0;
+  const char *line_start = p, *field_start = p;
+  int field_idx = 1;
+  txt_parallel_req_t r = {0, 0, 0, 1};
+
+  for (size_t pos = 0; pos < len; pos += 64) {
+    const char *b = p + pos;
+    uint64_t nl, dl;
+    block_masks(b, MIN(64, len - pos), tp->delimiter, &nl, &dl);
+    uint64_t bits = tp->is_csv ? nl | dl : nl;
+    while (bits != 0) {
+      const char *q = b + __builtin_ctzll(bits);
+      bits &= bits - 1;
+      if (*q == '\n') {
+        if (q > line_start) {
+          parse_field(tp, field_idx, field_start, q, &r);
+          out[n++] = r;
+          r = (txt_parallel_req_t){0, 0, 0, 1};
+        }
+        line_start = field_start = q + 1;
+        field_idx = 1;
+      } else {
+        parse_field(tp, field_idx, field_start, q, &r);
+        field_start = q + 1;
+        field_idx += 1;
+      }
+    }
+  }
+
+  /* the last line of the trace may not end with a line end */
+  if (line_start < p + len) {
+    parse_field(tp, field_idx, field_start, p + len, &r);
+    out[n++] = r;
+  }
+  return n;
+}
+
+typedef struct {
+  const txt_parallel_t *tp;
+  int field_idx;
+  txt_parallel_req_t r;
+  txt_parallel_req_t *out;
+  int64_t n;
+} csv_chunk_ctx_t;
+
+static void chunk_csv_cb1(void *s, size_t len, void *data) {
+  csv_chunk_ctx_t *ctx = data;
+  if (ctx->out != NULL) {
+    parse_field(ctx->tp, ctx->field_idx, s, (char *)s + len, &ctx->r);
+  }
+  ctx->field_idx += 1;
+}
+
+static void chunk_csv_cb2(int c, void *data) {
+  csv_chunk_ctx_t *ctx = data;
+  if (ctx->out != NULL) ctx->out[ctx->n] = ctx->r;
+  ctx->n += 1;
+  ctx->field_idx = 1;
+  ctx->r = (txt_parallel_req_t){0, 0, 0, 1};
+}
+
+/* parse (or count if out is NULL) the rows of a chunk that has quotes */
+static int64_t parse_chunk_libcsv(const txt_parallel_t *tp, const char *p,
+                                  size_t len, txt_parallel_req_t *out) {
+  struct csv_parser parser;
+  if (csv_init(&parser, CSV_APPEND_NULL) != 0) {
+    ERROR("failed to initialize csv parser\n");
+  }
+  csv_set_delim(&parser, tp->delimiter);
+
+  csv_chunk_ctx_t ctx = {tp, 1, {0, 0, 0, 1}, out, 0};
+  if (csv_parse(&parser, p, len, chunk_csv_cb1, chunk_csv_cb2, &ctx) != len) {
+    WARN("parsing csv file error: %s\n", csv_strerror(csv_error(&parser)));
+  }
+  csv_fini(&parser, chunk_csv_cb1, chunk_csv_cb2, &ctx);
+  csv_free(&parser);
+  return ctx.n;
+}
+
+static inline bool chunk_has_quote(const txt_parallel_t *tp, const char *p,
+                                   size_t len) {
+  return tp->is_csv && memchr(p, '"', len) != NULL;
+}
+
+/************************** threads **************************/
+
+typedef struct {
+  txt_parallel_t *tp;
+  int64_t first_chunk;
+  int64_t end_chunk;
+  int tid;
+  /* the per-chunk line counts, NULL when parsing */
+  int64_t *n_lines;
+} txt_parallel_job_t;
+
+static void *count_job(void *arg) {
+  txt_parallel_job_t *job = arg;
+  txt_parallel_t *tp = job->tp;
+  for (int64_t c = job->first_chunk + job->tid; c < job->end_chunk;
+       c += tp->n_thread) {
+    const char *p = tp->data + tp->chunk_starts[c];
+    size_t len = tp->chunk_starts[c + 1] - tp->chunk_starts[c];
+    job->n_lines[c] = chunk_has_quote(tp, p, len)
+                          ? parse_chunk_libcsv(tp, p, len, NULL)
+                          : count_lines(p, len);
+  }
+  return NULL;
+}
+
+static void *quote_job(void *arg) {
+  txt_parallel_job_t *job = arg;
+  txt_parallel_t *tp = job->tp;
+  for (int64_t c = job->first_chunk + job->tid; c < job->end_chunk;
+       c += tp->n_thread) {
+    const char *p = tp->data + tp->chunk_starts[c];
+    size_t len = tp->chunk_starts[c + 1] - tp->chunk_starts[c];
+    int64_t n = 0;
+    for (size_t pos = 0; pos < len; pos += 64) {
+      uint64_t nl, quote;
+      block_masks(p + pos, MIN(64, len - pos), '"', &nl, &quote);
+      n += __builtin_popcountll(quote);
+    }
+    job->n_lines[c] = n;
+  }
+  return NULL;
+}
+
+static void *parse_job(void *arg) {
+  txt_parallel_job_t *job = arg;
+  txt_parallel_t *tp = job->tp;
+  for (int64_t c = job->first_chunk + job->tid; c < job->end_chunk;
+       c += tp->n_thread) {
+    const char *p = tp->data + tp->chunk_starts[c];
+    size_t len = tp->chunk_starts[c + 1] - tp->chunk_starts[c];
+    txt_parallel_req_t *out =
+        tp->reqs + (tp->chunk_first_req[c] - tp->chunk_first_req[tp->win_start]);
+    int64_t n = chunk_has_quote(tp, p, len) ? parse_chunk_libcsv(tp, p, len, out)
+                                            : parse_chunk_simd(tp, p, len, out);
+    DEBUG_ASSERT(n == tp->chunk_first_req[c + 1] - tp->chunk_first_req[c]);
+    (void)n;
+  }
+  return NULL;
+}
+
+/* run the job on chunks [first_chunk, end_chunk) with all threads, the
+ * calling thread is thread 0 */
+static void run_jobs(txt_parallel_t *tp, void *(*func)(void *),
+                     int64_t first_chunk, int64_t end_chunk,
+                     int64_t *n_lines) {
+  pthread_t *threads = malloc(sizeof(pthread_t) * tp->n_thread);
+  txt_parallel_job_t *jobs = malloc(sizeof(txt_parallel_job_t) * tp->n_thread);
+  for (int i = 0; i < tp->n_thread; i++) {
+    jobs[i] = (txt_parallel_job_t){tp, first_chunk, end_chunk, i, n_lines};
+    if (i > 0) pthread_create(&threads[i], NULL, func, &jobs[i]);
+  }
+  func(&jobs[0]);
+  for (int i = 1; i < tp->n_thread; i++) pthread_join(threads[i], NULL);
+  free(threads);
+  free(jobs);
+}
+
+/* parse the window of chunks that has request idx, the window extends in
+ * the direction of reading */
+static void load_window(txt_parallel_t *tp, int64_t idx, bool backward) {
+  /* the last chunk whose first request is at most idx */
+  int64_t lo = 0, hi = tp->n_chunk - 1;
+  while (lo < hi) {
+    int64_t mid = (lo + hi + 1) / 2;
+    if (tp->chunk_first_req[mid] <= idx) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+
+  int64_t n_win_chunk = (int64_t)tp->n_thread * TXT_PARALLEL_WINDOW_CHUNK;
+  if (backward) {
+    tp->win_start = MAX(0, lo + 1 - n_win_chunk);
+    tp->win_end = lo + 1;
+  } else {
+    tp->win_start = lo;
+    tp->win_end = MIN(tp->n_chunk, lo + n_win_chunk);
+  }
+
+  int64_t n_req =
+      tp->chunk_first_req[tp->win_end] - tp->chunk_first_req[tp->win_start];
+  if (n_req > tp->reqs_cap) {
+    free(tp->reqs);
+    tp->reqs = malloc(sizeof(txt_parallel_req_t) * n_req);
+    tp->reqs_cap = n_req;
+  }
+  run_jobs(tp, parse_job, tp->win_start, tp->win_end, NULL);
+}
+
+/* the position after the first line end at or after pos that is not in a
+ * quoted field, in_quote is the quote state at pos */
+static int64_t next_line_start(const txt_parallel_t *tp, int64_t pos,
+                               int64_t end, bool in_quote) {
+  for (; pos < end; pos++) {
+    if (tp->is_csv && tp->data[pos] == '"') {
+      in_quote = !in_quote;
+    } else if (tp->data[pos] == '\n' && !in_quote) {
+      return pos + 1;
+    }
+  }
+  return end;
+}
+
+/* cut the trace into chunks that start at a line start, the trace is first
+ * cut at fixed offsets, the quotes of each piece are counted in parallel,
+ * and the parity of the quotes before a cut tells whether it is in a quoted
+ * field, which only matters for csv traces */
+static void cut_chunks(txt_parallel_t *tp, int64_t start, int64_t end) {
+  int64_t n_piece =
+      (end - start + TXT_PARALLEL_CHUNK_SIZE - 1) / TXT_PARALLEL_CHUNK_SIZE;
+  tp->chunk_starts = malloc(sizeof(int64_t) * (n_piece + 2));
+  if (n_piece == 0) {
+    tp->chunk_starts[0] = tp->chunk_starts[1] = end;
+    tp->n_chunk = 1;
+    return;
+  }
+  for (int64_t c = 0; c < n_piece; c++) {
+    tp->chunk_starts[c] = start + c * TXT_PARALLEL_CHUNK_SIZE;
+  }
+  tp->chunk_starts[n_piece] = end;
+
+  int64_t *n_quote = NULL;
+  if (tp->is_csv && n_piece > 1) {
+    n_quote = malloc(sizeof(int64_t) * n_piece);
+    run_jobs(tp, quote_job, 0, n_piece, n_quote);
+  }
+
+  /* chunk_starts[c] is read before it is overwritten, n_chunk <= c */
+  bool in_quote = false;
+  int64_t n_chunk = 1;
+  for (int64_t c = 1; c < n_piece; c++) {
+    if (n_quote != NULL && n_quote[c - 1] % 2 == 1) in_quote = !in_quote;
+    int64_t cut = next_line_start(tp, tp->chunk_starts[c], end, in_quote);
+    /* a quoted field can be longer than a piece */
+    if (cut > tp->chunk_starts[n_chunk - 1] && cut < end) {
+      tp->chunk_starts[n_chunk++] = cut;
+    }
+  }
+  tp->chunk_starts[n_chunk] = end;
+  tp->n_chunk = n_chunk;
+  free(n_quote);
+}
+
+/************************** interface **************************/
+
+void txtParallel_setup(reader_t *const reader) {
+  txt_parallel_t *tp = calloc(1, sizeof(txt_parallel_t));
+  tp->n_thread = reader->init_params.n_parse_thread;
+  tp->is_csv = reader->trace_type == CSV_TRACE;
+  tp->obj_id_is_num = reader->obj_id_is_num;
+  if (tp->is_csv) {
+    csv_params_t *csv_params = reader->reader_params;
+    tp->delimiter = csv_params->delimiter;
+    tp->time_field = csv_params->time_field_idx;
+    tp->obj_id_field = csv_params->obj_id_field_idx;
+    tp->obj_size_field = csv_params->obj_size_field_idx;
+    tp->cnt_field = csv_params->cnt_field_idx;
+  } else {
+    /* a txt trace has one object id per line */
+    tp->delimiter = '\n';
+    tp->obj_id_field = 1;
+  }
+
+  int fd = open(reader->trace_path, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    ERROR("Unable to open '%s', %s\n", reader->trace_path, strerror(errno));
+  }
+  tp->data_size = st.st_size;
+  tp->data = tp->data_size == 0 ? NULL
+                                : mmap(NULL, tp->data_size, PROT_READ,
+                                       MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (tp->data == MAP_FAILED) {
+    ERROR("Unable to map '%s', %s\n", reader->trace_path, strerror(errno));
+  }
+  if (tp->data != NULL) madvise(tp->data, tp->data_size, MADV_SEQUENTIAL);
+
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+
+  /* cut the trace after the header into chunks that end at a line end */
+  cut_chunks(tp, reader->trace_start_offset, tp->data_size);
+
+  /* count the lines of each chunk in parallel */
+  tp->chunk_first_req = malloc(sizeof(int64_t) * (tp->n_chunk + 1));
+  run_jobs(tp, count_job, 0, tp->n_chunk, tp->chunk_first_req);
+  int64_t n_req = 0;
+  for (int64_t c = 0; c <= tp->n_chunk; c++) {
+    int64_t n = c < tp->n_chunk ? tp->chunk_first_req[c] : 0;
+    tp->chunk_first_req[c] = n_req;
+    n_req += n;
+  }
+  tp->n_req = tp->chunk_first_req[tp->n_chunk];
+  tp->win_start = tp->win_end = 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  INFO("%s: %ld requests in %ld chunks, indexed with %d threads in %.2lf sec\n",
+       reader->trace_path, (long)tp->n_req, (long)tp->n_chunk, tp->n_thread,
+       (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9);
+
+  /* the requests are indexed like a binary trace with one-byte items, so
+   * reading backward, seeking and cloning work as before */
+  reader->txt_parallel = tp;
+  reader->trace_format = BINARY_TRACE_FORMAT;
+  reader->item_size = 1;
+  reader->trace_start_offset = 0;
+  reader->mmap_offset = 0;
+  reader->file_size = tp->n_req;
+  /* the requests of size 0 are skipped when read */
+  bool skip_size_zero = tp->is_csv && tp->obj_size_field > 0 &&
+                        reader->ignore_size_zero_req;
+  reader->n_total_req = skip_size_zero ? 0 : tp->n_req;
+}
+
+/* intern the string id of a txt trace like txt.c */
+static uint64_t intern_obj_id(txt_parallel_t *tp, const txt_parallel_req_t *r) {
+  if (r->obj_id_len + 1 > tp->id_buf_size) {
+    tp->id_buf_size = r->obj_id_len + 1;
+    tp->id_buf = realloc(tp->id_buf, tp->id_buf_size);
+  }
+  memcpy(tp->id_buf, tp->data + r->obj_id, r->obj_id_len);
+  tp->id_buf[r->obj_id_len] = '\0';
+  return (uint64_t)g_quark_from_string(tp->id_buf);
+}
+
+int txtParallel_read_one_req(reader_t *const reader, request_t *const req) {
+  txt_parallel_t *tp = reader->txt_parallel;
+  while (true) {
+    int64_t idx = reader->mmap_offset;
+    if (idx >= tp->n_req) {
+      req->valid = false;
+      return 1;
+    }
+
+    if (idx < tp->chunk_first_req[tp->win_start] ||
+        idx >= tp->chunk_first_req[tp->win_end]) {
+      load_window(tp, idx, reader->read_direction == READ_BACKWARD);
+    }
+    const txt_parallel_req_t *r =
+        &tp->reqs[idx - tp->chunk_first_req[tp->win_start]];
+    reader->mmap_offset += 1;
+
+    /* the fields that are not in the trace are not changed, as in csv.c */
+    req->obj_id = r->obj_id_len > 0 ? intern_obj_id(tp, r) : r->obj_id;
+    if (tp->time_field > 0) req->clock_time = r->clock_time;
+    if (tp->obj_size_field > 0) req->obj_size = r->obj_size;
+    if (tp->cnt_field > 0) reader->n_req_left = r->cnt - 1;
+
+    /* the requests of size 0 are skipped */
+    if (!tp->is_csv || req->obj_size != 0 || !reader->ignore_size_zero_req) {
+      break;
+    }
+    if (reader->read_direction != READ_FORWARD) {
+      return read_one_req_above(reader, req);
+    }
+  }
+
+  if (reader->n_req_left > 0) reader->last_req_clock_time = req->clock_time;
+
+  return 0;
+}
+
+void txtParallel_free(reader_t *const reader) {
+  txt_parallel_t *tp = reader->txt_parallel;
+  if (tp->data != NULL) munmap(tp->data, tp->data_size);
+  free(tp->chunk_starts);
+  free(tp->chunk_first_req);
+  free(tp->reqs);
+  free(tp->id_buf);
+  free(tp);
+  reader->txt_parallel = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,7 +8,10 @@
 
 #include <ctype.h>
 
+#include "../dataStructure/hash/hash.h"
 #include "../include/libCacheSim/macro.h"
+#include "../include/libCacheSim/shmTrace.h"
+#include "../include/libCacheSim/traceManifest.h"
 #include "customizedReader/akamaiBin.h"
 #include "customizedReader/cf1Bin.h"
 #include "customizedReader/oracle/oracleAkamaiBin.h"
@@ -23,9 +26,11 @@
 #include "customizedReader/twrNSBin.h"
 #include "customizedReader/vscsi.h"
 #include "customizedReader/wikiBin.h"
+#include "generalReader/directReader.h"
 #include "generalReader/lcs.h"
 #include "generalReader/libcsv.h"
 #include "generalReader/readerInternal.h"
+#include "generalReader/synthetic.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,21 +53,9 @@ reader_t *setup_reader(const char *const trace_path,
   reader_t *const reader = (reader_t *)malloc(sizeof(reader_t));
   reader->reader_params = NULL;
 
-  /* check whether the trace is a zstd trace file,
-   * currently zstd reader only supports a few binary trace */
   reader->is_zstd_file = false;
   reader->zstd_reader_p = NULL;
-#ifdef SUPPORT_ZSTD_TRACE
-  size_t slen = strlen(trace_path);
-  if (strncmp(trace_path + (slen - 4), ".zst", 4) == 0 ||
-      strncmp(trace_path + (slen - 7), ".zst.22", 7) == 0) {
-    reader->is_zstd_file = true;
-    reader->zstd_reader_p = create_zstd_reader(trace_path);
-    if (!_info_printed) {
-      VERBOSE("opening a zstd compressed data\n");
-    }
-  }
-#endif
+  reader->direct_reader_p = NULL;
 
   reader->trace_format = INVALID_TRACE_FORMAT;
   reader->trace_type = trace_type;
@@ -70,9 +63,11 @@ reader_t *setup_reader(const char *const trace_path,
   reader->n_read_req = 0;
   reader->ignore_size_zero_req = true;
   reader->ignore_obj_size = false;
+  reader->offload_hash = false;
   reader->cloned = false;
   reader->item_size = 0;
   reader->obj_id_is_num = false;
+  reader->txt_parallel = NULL;
   reader->mapped_file = NULL;
   reader->mmap_offset = 0;
   reader->sampler = NULL;
@@ -80,6 +75,8 @@ reader_t *setup_reader(const char *const trace_path,
   reader->read_direction = READ_FORWARD;
   reader->n_req_left = 0;
   reader->last_req_clock_time = -1;
+  reader->manifest = NULL;
+  reader->shm_trace = NULL;
 
   if (init_params != NULL) {
     memcpy(&reader->init_params, init_params, sizeof(reader_init_param_t));
@@ -87,6 +84,7 @@ reader_t *setup_reader(const char *const trace_path,
       reader->init_params.binary_fmt_str = strdup(init_params->binary_fmt_str);
 
     reader->ignore_obj_size = init_params->ignore_obj_size;
+    reader->offload_hash = init_params->offload_hash;
     reader->ignore_size_zero_req = init_params->ignore_size_zero_req;
     reader->obj_id_is_num = init_params->obj_id_is_num;
     reader->trace_start_offset = init_params->trace_start_offset;
@@ -101,6 +99,31 @@ reader_t *setup_reader(const char *const trace_path,
   assert(trace_path != NULL);
   reader->trace_path = strdup(trace_path);
 
+  if (trace_type == SYNTHETIC_TRACE) {
+    /* the trace path is the workload spec, there is no file to open */
+    syntheticReader_setup(reader);
+    return reader;
+  }
+
+  if (reader->init_params.shm_cache_size > 0 && shm_trace_attach(reader)) {
+    /* another process (or this one) has decoded the trace */
+    return reader;
+  }
+
+  /* check whether the trace is a zstd trace file,
+   * currently zstd reader only supports a few binary trace */
+#ifdef SUPPORT_ZSTD_TRACE
+  size_t slen = strlen(trace_path);
+  if (strncmp(trace_path + (slen - 4), ".zst", 4) == 0 ||
+      strncmp(trace_path + (slen - 7), ".zst.22", 7) == 0) {
+    reader->is_zstd_file = true;
+    reader->zstd_reader_p = create_zstd_reader(trace_path);
+    if (!_info_printed) {
+      VERBOSE("opening a zstd compressed data\n");
+    }
+  }
+#endif
+
   if ((fd = open(trace_path, O_RDONLY)) < 0) {
     ERROR("Unable to open '%s', %s\n", trace_path, strerror(errno));
     exit(1);
@@ -124,22 +147,39 @@ reader_t *setup_reader(const char *const trace_path,
     reader->line_buf_size = MAX_LINE_LEN;
     reader->line_buf = (char *)malloc(reader->line_buf_size);
   } else {
-    // set up mmap region
-    reader->mapped_file = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
-#ifdef MADV_HUGEPAGE
-    if (!_info_printed) {
-      VERBOSE("use hugepage\n");
+    if (reader->init_params.direct_io_n_buf > 0 && !reader->is_zstd_file) {
+      if (trace_type == VSCSI_TRACE) {
+        /* the setup reads the header from the mapped file */
+        WARN("vscsi trace does not support direct io, use mmap\n");
+      } else {
+        reader->direct_reader_p = create_direct_reader(
+            trace_path, reader->init_params.direct_io_n_buf,
+            reader->init_params.direct_io_sq_thread
+                ? reader->init_params.direct_io_cpu
+                : -1);
+      }
     }
-    madvise(reader->mapped_file, st.st_size, MADV_HUGEPAGE | MADV_SEQUENTIAL);
+
+    if (reader->direct_reader_p == NULL) {
+      // set up mmap region
+      reader->mapped_file =
+          mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+#ifdef MADV_HUGEPAGE
+      if (!_info_printed) {
+        VERBOSE("use hugepage\n");
+      }
+      madvise(reader->mapped_file, st.st_size,
+              MADV_HUGEPAGE | MADV_SEQUENTIAL);
 #endif
-    _info_printed = true;
+      _info_printed = true;
 
-    if ((reader->mapped_file) == MAP_FAILED) {
-      close(fd);
-      reader->mapped_file = NULL;
-      ERROR("Unable to allocate %llu bytes of memory, %s\n",
-            (unsigned long long)st.st_size, strerror(errno));
-      abort();
+      if ((reader->mapped_file) == MAP_FAILED) {
+        close(fd);
+        reader->mapped_file = NULL;
+        ERROR("Unable to allocate %llu bytes of memory, %s\n",
+              (unsigned long long)st.st_size, strerror(errno));
+        abort();
+      }
     }
   }
 
@@ -247,6 +287,11 @@ reader_t *setup_reader(const char *const trace_path,
     reader->n_total_req = (uint64_t)data_region_size / (reader->item_size);
   }
 
+  if (reader->trace_format == TXT_TRACE_FORMAT && !reader->is_zstd_file &&
+      reader->init_params.n_parse_thread > 0) {
+    txtParallel_setup(reader);
+  }
+
   if (reader->trace_format == INVALID_TRACE_FORMAT) {
     ERROR(
         "trace reader setup did not set "
@@ -347,90 +392,104 @@ int read_one_req(reader_t *const reader, request_t *const req) {
     req->ttl = -1;
     req->valid = true;
 
-    switch (reader->trace_type) {
-      case CSV_TRACE:
-        offset_before_read = ftell(reader->file);
-        status = csv_read_one_req(reader, req);
-        break;
-      case PLAIN_TXT_TRACE:;
-        offset_before_read = ftell(reader->file);
-        status = txt_read_one_req(reader, req);
-        break;
-      case BIN_TRACE:
-        status = binary_read_one_req(reader, req);
-        break;
-      case VSCSI_TRACE:
-        status = vscsi_read_one_req(reader, req);
-        break;
-      case TWR_TRACE:
-        status = twr_read_one_req(reader, req);
-        break;
-      case TWRNS_TRACE:
-        status = twrNS_read_one_req(reader, req);
-        break;
-      case CF1_TRACE:
-        status = cf1_read_one_req(reader, req);
-        break;
-      case AKAMAI_TRACE:
-        status = akamai_read_one_req(reader, req);
-        break;
-      case WIKI16u_TRACE:
-        status = wiki2016u_read_one_req(reader, req);
-        break;
-      case WIKI19u_TRACE:
-        status = wiki2019u_read_one_req(reader, req);
-        break;
-      case WIKI19t_TRACE:
-        status = wiki2019t_read_one_req(reader, req);
-        break;
-      case STANDARD_III_TRACE:
-        status = standardBinIII_read_one_req(reader, req);
-        break;
-      case STANDARD_IQI_TRACE:
-        status = standardBinIQI_read_one_req(reader, req);
-        break;
-      case STANDARD_IQQ_TRACE:
-        status = standardBinIQQ_read_one_req(reader, req);
-        break;
-      case STANDARD_IQIBH_TRACE:
-        status = standardBinIQIBH_read_one_req(reader, req);
-        break;
-      case ORACLE_GENERAL_TRACE:
-        status = oracleGeneralBin_read_one_req(reader, req);
-        break;
-      case ORACLE_GENERALOPNS_TRACE:
-        status = oracleGeneralOpNS_read_one_req(reader, req);
-        break;
-      case ORACLE_SIM_TWR_TRACE:
-        status = oracleSimTwrBin_read_one_req(reader, req);
-        break;
-      case ORACLE_SYS_TWRNS_TRACE:
-        status = oracleSysTwrNSBin_read_one_req(reader, req);
-        break;
-      case ORACLE_SIM_TWRNS_TRACE:
-        status = oracleSimTwrNSBin_read_one_req(reader, req);
-        break;
-      case ORACLE_CF1_TRACE:
-        status = oracleCF1_read_one_req(reader, req);
-        break;
-      case ORACLE_AKAMAI_TRACE:
-        status = oracleAkamai_read_one_req(reader, req);
-        break;
-      case ORACLE_WIKI16u_TRACE:
-        status = oracleWiki2016u_read_one_req(reader, req);
-        break;
-      case ORACLE_WIKI19u_TRACE:
-        status = oracleWiki2019u_read_one_req(reader, req);
-        break;
-      case VALPIN_TRACE:
-        status = valpin_read_one_req(reader, req);
-        break;
-      default:
-        ERROR(
-            "cannot recognize reader obj_id_type, given reader obj_id_type: "
-            "%c\n",
-            reader->trace_type);
-        abort();
+    if (reader->shm_trace != NULL) {
+      status = shm_trace_read_one_req(reader, req);
+    } else if (reader->txt_parallel != NULL) {
+      status = txtParallel_read_one_req(reader, req);
+    } else {
+      switch (reader->trace_type) {
+        case CSV_TRACE:
+          offset_before_read = ftell(reader->file);
+          status = csv_read_one_req(reader, req);
+          break;
+        case PLAIN_TXT_TRACE:;
+          offset_before_read = ftell(reader->file);
+          status = txt_read_one_req(reader, req);
+          break;
+        case BIN_TRACE:
+          status = binary_read_one_req(reader, req);
+          break;
+        case VSCSI_TRACE:
+          status = vscsi_read_one_req(reader, req);
+          break;
+        case TWR_TRACE:
+          status = twr_read_one_req(reader, req);
+          break;
+        case TWRNS_TRACE:
+          status = twrNS_read_one_req(reader, req);
+          break;
+        case CF1_TRACE:
+          status = cf1_read_one_req(reader, req);
+          break;
+        case AKAMAI_TRACE:
+          status = akamai_read_one_req(reader, req);
+          break;
+        case WIKI16u_TRACE:
+          status = wiki2016u_read_one_req(reader, req);
+          break;
+        case WIKI19u_TRACE:
+          status = wiki2019u_read_one_req(reader, req);
+          break;
+        case WIKI19t_TRACE:
+          status = wiki2019t_read_one_req(reader, req);
+          break;
+        case STANDARD_III_TRACE:
+          status = standardBinIII_read_one_req(reader, req);
+          break;
+        case STANDARD_IQI_TRACE:
+          status = standardBinIQI_read_one_req(reader, req);
+          break;
+        case STANDARD_IQQ_TRACE:
+          status = standardBinIQQ_read_one_req(reader, req);
+          break;
+        case STANDARD_IQIBH_TRACE:
+          status = standardBinIQIBH_read_one_req(reader, req);
+          break;
+        case ORACLE_GENERAL_TRACE:
+          status = oracleGeneralBin_read_one_req(reader, req);
+          break;
+        case ORACLE_GENERALOPNS_TRACE:
+          status = oracleGeneralOpNS_read_one_req(reader, req);
+          break;
+        case ORACLE_SIM_TWR_TRACE:
+          status = oracleSimTwrBin_read_one_req(reader, req);
+          break;
+        case ORACLE_SYS_TWRNS_TRACE:
+          status = oracleSysTwrNSBin_read_one_req(reader, req);
+          break;
+        case ORACLE_SIM_TWRNS_TRACE:
+          status = oracleSimTwrNSBin_read_one_req(reader, req);
+          break;
+        case ORACLE_CF1_TRACE:
+          status = oracleCF1_read_one_req(reader, req);
+          break;
+        case ORACLE_AKAMAI_TRACE:
+          status = oracleAkamai_read_one_req(reader, req);
+          break;
+        case ORACLE_WIKI16u_TRACE:
+          status = oracleWiki2016u_read_one_req(reader, req);
+          break;
+        case ORACLE_WIKI19u_TRACE:
+          status = oracleWiki2019u_read_one_req(reader, req);
+          break;
+        case VALPIN_TRACE:
+          status = valpin_read_one_req(reader, req);
+          break;
+        case SYNTHETIC_TRACE:
+          status = synthetic_read_one_req(reader, req);
+          break;
+        default:
+          ERROR(
+              "cannot recognize reader obj_id_type, given reader obj_id_type: "
+              "%c\n",
+              reader->trace_type);
+          abort();
+      }
+    }
+
+    /* the sampler, the hash table and the prefetcher share this hash */
+    if (reader->offload_hash) {
+      req->hv = get_hash_value_int_64(&req->obj_id);
     }
   }
 
@@ -608,7 +667,9 @@ int skip_n_req(reader_t *reader, const int N) {
 void reset_reader(reader_t *const reader) {
   /* rewind the reader back to beginning */
   long curr_offset = 0;
-  if (reader->trace_type == PLAIN_TXT_TRACE) {
+  if (reader->shm_trace != NULL || reader->txt_parallel != NULL) {
+    reader->mmap_offset = 0;
+  } else if (reader->trace_type == PLAIN_TXT_TRACE) {
     fseek(reader->file, 0, SEEK_SET);
     curr_offset = ftell(reader->file);
   } else if (reader->trace_type == CSV_TRACE) {
@@ -631,21 +692,10 @@ void reset_reader(reader_t *const reader) {
 uint64_t get_num_of_req(reader_t *const reader) {
   if (reader->n_total_req > 0) return reader->n_total_req;
 
-  uint64_t n_req = 0;
-
-  if (reader->trace_format == TXT_TRACE_FORMAT || reader->is_zstd_file) {
-    reader_t *reader_copy = clone_reader(reader);
-    reader_copy->mmap_offset = 0;
-    request_t *req = new_request();
-    while (read_one_req(reader_copy, req) == 0) {
-      n_req++;
-    }
-  } else {
-    ERROR("should not reach here\n");
-    abort();
-  }
-  reader->n_total_req = n_req;
-  return n_req;
+  /* txt and compressed traces need a full scan, which also computes the
+   * rest of the manifest, so later users do not scan the trace again */
+  reader->n_total_req = get_trace_manifest(reader)->n_req;
+  return reader->n_total_req;
 }
 
 reader_t *clone_reader(const reader_t *const reader_in) {
@@ -653,7 +703,8 @@ reader_t *clone_reader(const reader_t *const reader_in) {
                                   &reader_in->init_params);
   reader->n_total_req = reader_in->n_total_req;
 
-  if (reader->trace_format != TXT_TRACE_FORMAT) {
+  if (reader->trace_format != TXT_TRACE_FORMAT &&
+      reader->mapped_file != NULL) {
     munmap(reader->mapped_file, reader->file_size);
     reader->mapped_file = reader_in->mapped_file;
   }
@@ -669,7 +720,10 @@ int close_reader(reader_t *const reader) {
    indicate the error.  In either case no further
    access to the stream is possible.*/
 
-  if (reader->trace_type == PLAIN_TXT_TRACE) {
+  if (reader->shm_trace != NULL) {
+    /* the trace file is not opened */
+    shm_trace_detach(reader);
+  } else if (reader->trace_type == PLAIN_TXT_TRACE) {
     fclose(reader->file);
     free(reader->line_buf);
   } else if (reader->trace_type == CSV_TRACE) {
@@ -683,9 +737,10 @@ int close_reader(reader_t *const reader) {
     if (params != NULL && params->fmt_str != NULL) {
       free(params->fmt_str);
     }
-    if (reader->init_params.binary_fmt_str != NULL) {
-      free(reader->init_params.binary_fmt_str);
-    }
+  }
+
+  if (reader->init_params.binary_fmt_str != NULL) {
+    free(reader->init_params.binary_fmt_str);
   }
 
 #ifdef SUPPORT_ZSTD_TRACE
@@ -694,6 +749,14 @@ int close_reader(reader_t *const reader) {
   }
 #endif
 
+  if (reader->direct_reader_p != NULL) {
+    free_direct_reader(reader->direct_reader_p);
+  }
+
+  if (reader->txt_parallel != NULL) {
+    txtParallel_free(reader);
+  }
+
   if (!reader->cloned) {
     if (reader->mapped_file != NULL) {
       munmap(reader->mapped_file, reader->file_size);
@@ -711,6 +774,10 @@ int close_reader(reader_t *const reader) {
     free(reader->sampler);
   }
 
+  if (reader->manifest != NULL) {
+    free(reader->manifest);
+  }
+
   free(reader->trace_path);
   free(reader);
 
@@ -0,0 +1,646 @@
+//
+//  shmTrace.c
+//  libCacheSim
+//
+//  the decoded trace is stored in POSIX shared memory in a columnar layout,
+//  one segment per request field
+//
+//    /dev/shm/libCacheSim.<key>          the header: state, size and references
+//    /dev/shm/libCacheSim.<key>.<field>  one column, absent if the field is constant
+//
+//  a column stores value - base in 1, 2, 4 or 8 bytes, the width grows when a
+//  value does not fit, base is the value of the first request, so the clock
+//  time is relative to the start of the trace and usually fits in 4 bytes, and
+//  the op fits in 1 byte, the stored fields are clock_time, obj_id, obj_size,
+//  op, ttl and next_access_vtime
+//
+//  the key is a hash of the trace path, size, mtime and the reader parameters
+//  that change the decoded requests, the parameters applied after decoding
+//  (sampler, ignore_obj_size, cap_at_n_req and offload_hash) are applied by
+//  each reader, so jobs with different parameters share one decoded trace
+//
+//  the references are the pids of the attached readers, so a process that
+//  crashes does not pin the trace, the traces that no live process uses are
+//  evicted in the LRU order when the total size exceeds the budget
+//
+
+#include "../include/libCacheSim/shmTrace.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/libCacheSim/macro.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SHM_TRACE_MAGIC 0x6c6353686d547263ULL
+#define SHM_TRACE_VERSION 1
+#define SHM_TRACE_MAX_REF 256
+#define SHM_TRACE_NAME_LEN 96
+#define SHM_TRACE_KEY_LEN 4608
+#define SHM_TRACE_DIR "/dev/shm"
+
+/* the number of requests a column grows by at least */
+#define SHM_TRACE_MIN_CAP (1UL << 20)
+/* how long to wait for a header that another process is creating */
+#define SHM_TRACE_WAIT_US 50000
+#define SHM_TRACE_MAX_WAIT_HEADER 200
+
+typedef enum {
+  SHM_COL_TIME = 0,
+  SHM_COL_OBJ_ID,
+  SHM_COL_OBJ_SIZE,
+  SHM_COL_OP,
+  SHM_COL_TTL,
+  SHM_COL_NEXT_ACCESS_VTIME,
+
+  SHM_N_COL
+} shm_col_e;
+
+static const char *const shm_col_names[SHM_N_COL] = {"time", "id", "size", "op", "ttl", "next"};
+
+/* a zero-filled header is a trace being built */
+typedef enum {
+  SHM_TRACE_BUILDING = 0,
+  SHM_TRACE_READY = 1,
+  SHM_TRACE_FAILED = 2,
+} shm_trace_state_e;
+
+typedef struct {
+  int64_t base;
+  /* the bytes per request, 0 if every request has the value base */
+  int32_t width;
+} shm_col_desc_t;
+
+typedef struct {
+  uint64_t magic;
+  int32_t version;
+  int32_t state;
+  int32_t builder_pid;
+  uint64_t n_req;
+  /* the size of the header and the columns */
+  int64_t n_byte;
+  int64_t last_attach_time;
+  shm_col_desc_t cols[SHM_N_COL];
+  /* the full key, the name only has its hash */
+  char key[SHM_TRACE_KEY_LEN];
+  int32_t ref_pids[SHM_TRACE_MAX_REF];
+} shm_trace_header_t;
+
+struct shm_trace {
+  char name[SHM_TRACE_NAME_LEN];
+  shm_trace_header_t *header;
+  int ref_slot;
+  shm_col_desc_t desc[SHM_N_COL];
+  const char *cols[SHM_N_COL];
+  size_t col_sizes[SHM_N_COL];
+};
+
+/* a column being decoded */
+typedef struct {
+  int fd;
+  char *data;
+  /* the number of requests the segment has space for */
+  uint64_t cap;
+  int32_t width;
+  int64_t base;
+} shm_col_builder_t;
+
+static inline bool pid_alive(int32_t pid) { return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM); }
+
+static void col_name(const char *name, int col, char *buf) {
+  snprintf(buf, SHM_TRACE_NAME_LEN, "%s.%s", name, shm_col_names[col]);
+}
+
+static void unlink_trace(const char *name) {
+  char buf[SHM_TRACE_NAME_LEN];
+  for (int i = 0; i < SHM_N_COL; i++) {
+    col_name(name, i, buf);
+    shm_unlink(buf);
+  }
+  shm_unlink(name);
+}
+
+/* the reader parameters that change the decoded requests */
+static bool get_trace_key(const reader_t *reader, char *key) {
+  char abs_path[SHM_TRACE_KEY_LEN - 512];
+  struct stat st;
+  if (realpath(reader->trace_path, abs_path) == NULL || stat(abs_path, &st) != 0) return false;
+
+  const reader_init_param_t *p = &reader->init_params;
+  snprintf(key, SHM_TRACE_KEY_LEN,
+           "path=%s,size=%ld,mtime=%ld,type=%d,fmt=%s,obj-id-is-num=%d,ignore-size-zero-req=%d,"
+           "fields=%d:%d:%d:%d:%d:%d:%d,header=%d,delimiter=%d,offset=%ld",
+           abs_path, (long)st.st_size, (long)st.st_mtime, (int)reader->trace_type,
+           p->binary_fmt_str == NULL ? "" : p->binary_fmt_str, (int)reader->obj_id_is_num,
+           (int)reader->ignore_size_zero_req, p->time_field, p->obj_id_field, p->obj_size_field, p->op_field,
+           p->ttl_field, p->cnt_field, p->next_access_vtime_field, (int)p->has_header, (int)p->delimiter,
+           (long)p->trace_start_offset);
+  return true;
+}
+
+static void get_trace_name(const char *key, char *name) {
+  /* FNV-1a */
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (const char *c = key; *c != '\0'; c++) {
+    h ^= (uint8_t)*c;
+    h *= 0x100000001b3ULL;
+  }
+  snprintf(name, SHM_TRACE_NAME_LEN, "/%s%016lx", SHM_TRACE_PREFIX, (unsigned long)h);
+}
+
+/************************** decode **************************/
+
+static inline int32_t width_of(int64_t d) {
+  if (d >= INT8_MIN && d <= INT8_MAX) return 1;
+  if (d >= INT16_MIN && d <= INT16_MAX) return 2;
+  if (d >= INT32_MIN && d <= INT32_MAX) return 4;
+  return 8;
+}
+
+static inline int64_t col_load(const char *data, int32_t width, uint64_t idx) {
+  switch (width) {
+    case 1:
+      return ((const int8_t *)data)[idx];
+    case 2:
+      return ((const int16_t *)data)[idx];
+    case 4:
+      return ((const int32_t *)data)[idx];
+    default:
+      return ((const int64_t *)data)[idx];
+  }
+}
+
+static inline void col_store(char *data, int32_t width, uint64_t idx, int64_t d) {
+  switch (width) {
+    case 1:
+      ((int8_t *)data)[idx] = (int8_t)d;
+      break;
+    case 2:
+      ((int16_t *)data)[idx] = (int16_t)d;
+      break;
+    case 4:
+      ((int32_t *)data)[idx] = (int32_t)d;
+      break;
+    default:
+      ((int64_t *)data)[idx] = d;
+  }
+}
+
+/* resize the segment of the column, fallocate reports a full /dev/shm here
+ * instead of a SIGBUS when the mapping is written */
+static bool col_resize(shm_col_builder_t *col, uint64_t cap, int32_t width) {
+  size_t old_size = col->cap * col->width, new_size = cap * width;
+  if (new_size > old_size) {
+    int ret = posix_fallocate(col->fd, old_size, new_size - old_size);
+    if (ret != 0) {
+      WARN("cannot grow the shared memory trace to %zu bytes: %s\n", new_size, strerror(ret));
+      return false;
+    }
+  } else if (ftruncate(col->fd, new_size) != 0) {
+    return false;
+  }
+
+  char *data = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, col->fd, 0);
+  if (data == MAP_FAILED) {
+    WARN("cannot map the shared memory trace: %s\n", strerror(errno));
+    return false;
+  }
+  /* the old and new mappings share the pages, so the values are kept */
+  if (col->data != NULL) munmap(col->data, old_size);
+  col->data = data;
+  return true;
+}
+
+/* widen the first n values in place, from the end so no value is overwritten
+ * before it is moved */
+static bool col_widen(shm_col_builder_t *col, uint64_t n, int32_t width) {
+  int32_t old_width = col->width;
+  if (!col_resize(col, col->cap, width)) return false;
+  for (uint64_t i = n; i > 0; i--) {
+    col_store(col->data, width, i - 1, col_load(col->data, old_width, i - 1));
+  }
+  col->width = width;
+  return true;
+}
+
+static bool col_put(const char *name, int c, shm_col_builder_t *col, uint64_t idx, int64_t v) {
+  if (idx == 0) {
+    col->base = v;
+    return true;
+  }
+
+  int64_t d = (int64_t)((uint64_t)v - (uint64_t)col->base);
+  if (col->width == 0) {
+    /* constant so far */
+    if (d == 0) return true;
+    char buf[SHM_TRACE_NAME_LEN];
+    col_name(name, c, buf);
+    col->fd = shm_open(buf, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (col->fd < 0) {
+      WARN("cannot create shared memory %s: %s\n", buf, strerror(errno));
+      return false;
+    }
+    /* the requests before idx are base, which are the zeros of the new
+     * segment */
+    col->cap = 0;
+    col->width = width_of(d);
+    if (!col_resize(col, MAX(SHM_TRACE_MIN_CAP, idx * 2), col->width)) return false;
+    col->cap = MAX(SHM_TRACE_MIN_CAP, idx * 2);
+  } else if (width_of(d) > col->width) {
+    if (!col_widen(col, idx, width_of(d))) return false;
+  }
+
+  if (idx >= col->cap) {
+    if (!col_resize(col, col->cap * 2, col->width)) return false;
+    col->cap *= 2;
+  }
+  col_store(col->data, col->width, idx, d);
+  return true;
+}
+
+static bool decode_trace(reader_t *reader, shm_trace_header_t *header) {
+  reader_init_param_t params = reader->init_params;
+  params.shm_cache_size = 0;
+  params.sampler = NULL;
+  params.cap_at_n_req = -1;
+  params.ignore_obj_size = false;
+  params.offload_hash = false;
+  reader_t *src = setup_reader(reader->trace_path, reader->trace_type, &params);
+
+  shm_col_builder_t cols[SHM_N_COL];
+  memset(cols, 0, sizeof(cols));
+  for (int i = 0; i < SHM_N_COL; i++) cols[i].fd = -1;
+
+  INFO("decoding trace %s into shared memory %s...\n", reader->trace_path, reader->shm_trace->name);
+  const char *name = reader->shm_trace->name;
+  request_t *req = new_request();
+  uint64_t n_req = 0;
+  bool ok = true;
+  read_one_req(src, req);
+  while (ok && req->valid) {
+    ok = col_put(name, SHM_COL_TIME, &cols[SHM_COL_TIME], n_req, req->clock_time) &&
+         col_put(name, SHM_COL_OBJ_ID, &cols[SHM_COL_OBJ_ID], n_req, (int64_t)req->obj_id) &&
+         col_put(name, SHM_COL_OBJ_SIZE, &cols[SHM_COL_OBJ_SIZE], n_req, req->obj_size) &&
+         col_put(name, SHM_COL_OP, &cols[SHM_COL_OP], n_req, req->op) &&
+         col_put(name, SHM_COL_TTL, &cols[SHM_COL_TTL], n_req, req->ttl) &&
+         col_put(name, SHM_COL_NEXT_ACCESS_VTIME, &cols[SHM_COL_NEXT_ACCESS_VTIME], n_req, req->next_access_vtime);
+    n_req += 1;
+    read_one_req(src, req);
+  }
+  free_request(req);
+  close_reader(src);
+
+  header->n_byte = sizeof(shm_trace_header_t);
+  for (int i = 0; i < SHM_N_COL; i++) {
+    if (ok && cols[i].width > 0) {
+      /* drop the unused capacity */
+      ok = ftruncate(cols[i].fd, n_req * cols[i].width) == 0;
+    }
+    if (cols[i].data != NULL) munmap(cols[i].data, cols[i].cap * cols[i].width);
+    if (cols[i].fd >= 0) close(cols[i].fd);
+    header->cols[i].base = cols[i].base;
+    header->cols[i].width = cols[i].width;
+    header->n_byte += n_req * cols[i].width;
+  }
+  header->n_req = n_req;
+
+  if (ok && n_req == 0) {
+    WARN("trace %s has no request\n", reader->trace_path);
+    ok = false;
+  }
+
+  if (ok) {
+    INFO("decoded trace %s: %lu requests, %.2lf MiB in shared memory\n", reader->trace_path, (unsigned long)n_req,
+         (double)header->n_byte / MiB);
+  }
+  return ok;
+}
+
+/************************** attach **************************/
+
+static bool add_ref(struct shm_trace *t) {
+  int32_t pid = (int32_t)getpid();
+  for (int i = 0; i < SHM_TRACE_MAX_REF; i++) {
+    int32_t p = __atomic_load_n(&t->header->ref_pids[i], __ATOMIC_ACQUIRE);
+    /* reuse the slot of a process that exited without detaching */
+    if ((p == 0 || !pid_alive(p)) &&
+        __atomic_compare_exchange_n(&t->header->ref_pids[i], &p, pid, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      t->ref_slot = i;
+      __atomic_store_n(&t->header->last_attach_time, (int64_t)time(NULL), __ATOMIC_RELEASE);
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool map_cols(struct shm_trace *t) {
+  memcpy(t->desc, t->header->cols, sizeof(t->desc));
+  for (int i = 0; i < SHM_N_COL; i++) {
+    t->cols[i] = NULL;
+    t->col_sizes[i] = t->header->n_req * t->desc[i].width;
+    if (t->desc[i].width == 0) continue;
+
+    char buf[SHM_TRACE_NAME_LEN];
+    col_name(t->name, i, buf);
+    int fd = shm_open(buf, O_RDONLY, 0);
+    if (fd < 0) {
+      WARN("cannot open shared memory %s: %s\n", buf, strerror(errno));
+      return false;
+    }
+    void *data = mmap(NULL, t->col_sizes[i], PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      WARN("cannot map shared memory %s: %s\n", buf, strerror(errno));
+      return false;
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(data, t->col_sizes[i], MADV_HUGEPAGE);
+#endif
+    madvise(data, t->col_sizes[i], MADV_SEQUENTIAL);
+    t->cols[i] = data;
+  }
+  return true;
+}
+
+static void unmap_trace(struct shm_trace *t) {
+  for (int i = 0; i < SHM_N_COL; i++) {
+    if (t->cols[i] != NULL) munmap((void *)t->cols[i], t->col_sizes[i]);
+    t->cols[i] = NULL;
+  }
+  if (t->header != NULL) munmap(t->header, sizeof(shm_trace_header_t));
+  t->header = NULL;
+}
+
+/* map the header that another process created, NULL if it is not created
+ * yet or removed */
+static shm_trace_header_t *map_header(const char *name) {
+  int fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0) return NULL;
+
+  struct stat st;
+  shm_trace_header_t *header = NULL;
+  if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(shm_trace_header_t)) {
+    header = mmap(NULL, sizeof(shm_trace_header_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (header == MAP_FAILED) header = NULL;
+  }
+  close(fd);
+  return header;
+}
+
+/* decode the trace as the creator of the header */
+static bool build_trace(reader_t *reader, int fd, const char *key) {
+  struct shm_trace *t = reader->shm_trace;
+  if (ftruncate(fd, sizeof(shm_trace_header_t)) != 0) {
+    close(fd);
+    shm_unlink(t->name);
+    return false;
+  }
+  t->header = mmap(NULL, sizeof(shm_trace_header_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (t->header == MAP_FAILED) {
+    t->header = NULL;
+    shm_unlink(t->name);
+    return false;
+  }
+
+  shm_trace_header_t *header = t->header;
+  header->magic = SHM_TRACE_MAGIC;
+  header->version = SHM_TRACE_VERSION;
+  strncpy(header->key, key, SHM_TRACE_KEY_LEN - 1);
+  __atomic_store_n(&header->builder_pid, (int32_t)getpid(), __ATOMIC_RELEASE);
+
+  if (!decode_trace(reader, header)) {
+    /* the waiting processes see the state before the segments are gone */
+    __atomic_store_n(&header->state, SHM_TRACE_FAILED, __ATOMIC_RELEASE);
+    unlink_trace(t->name);
+    return false;
+  }
+
+  add_ref(t);
+  __atomic_store_n(&header->state, SHM_TRACE_READY, __ATOMIC_RELEASE);
+  return true;
+}
+
+/* wait until the trace that another process decodes is ready,
+ * return 1 if ready, 0 if the reader should retry, -1 if it should give up */
+static int wait_trace(reader_t *reader, const char *key) {
+  struct shm_trace *t = reader->shm_trace;
+  int n_wait = 0;
+  while ((t->header = map_header(t->name)) == NULL) {
+    if (++n_wait > SHM_TRACE_MAX_WAIT_HEADER) {
+      /* the creator died before sizing the header */
+      WARN("remove incomplete shared memory trace %s\n", t->name);
+      unlink_trace(t->name);
+      return 0;
+    }
+    usleep(SHM_TRACE_WAIT_US);
+  }
+
+  shm_trace_header_t *header = t->header;
+  bool printed = false;
+  int state;
+  n_wait = 0;
+  while ((state = __atomic_load_n(&header->state, __ATOMIC_ACQUIRE)) == SHM_TRACE_BUILDING) {
+    int32_t builder = __atomic_load_n(&header->builder_pid, __ATOMIC_ACQUIRE);
+    if (builder == 0 && ++n_wait > SHM_TRACE_MAX_WAIT_HEADER) {
+      /* the creator died between sizing the header and storing its pid */
+      WARN("remove incomplete shared memory trace %s\n", t->name);
+      unlink_trace(t->name);
+      unmap_trace(t);
+      return 0;
+    }
+    if (builder != 0 && !pid_alive(builder)) {
+      WARN("the process decoding %s into %s exited, decode again\n", reader->trace_path, t->name);
+      unlink_trace(t->name);
+      unmap_trace(t);
+      return 0;
+    }
+    if (!printed && builder != 0) {
+      INFO("waiting for process %d to decode trace %s\n", (int)builder, reader->trace_path);
+      printed = true;
+    }
+    usleep(SHM_TRACE_WAIT_US);
+  }
+
+  if (state != SHM_TRACE_READY || header->magic != SHM_TRACE_MAGIC || header->version != SHM_TRACE_VERSION) {
+    unmap_trace(t);
+    return -1;
+  }
+  if (strncmp(header->key, key, SHM_TRACE_KEY_LEN) != 0) {
+    WARN("shared memory %s is used by another trace %s\n", t->name, header->key);
+    unmap_trace(t);
+    return -1;
+  }
+  if (!add_ref(t)) {
+    WARN("shared memory trace %s has too many readers, read the trace file\n", t->name);
+    unmap_trace(t);
+    return -1;
+  }
+  return 1;
+}
+
+bool shm_trace_attach(reader_t *reader) {
+  char key[SHM_TRACE_KEY_LEN];
+  if (!get_trace_key(reader, key)) return false;
+
+  struct shm_trace *t = calloc(1, sizeof(struct shm_trace));
+  t->ref_slot = -1;
+  get_trace_name(key, t->name);
+  reader->shm_trace = t;
+
+  bool ready = false;
+  for (int n_try = 0; n_try < 3 && !ready; n_try++) {
+    int fd = shm_open(t->name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd >= 0) {
+      ready = build_trace(reader, fd, key);
+      break;
+    } else if (errno != EEXIST) {
+      WARN("cannot create shared memory %s: %s\n", t->name, strerror(errno));
+      break;
+    }
+
+    int ret = wait_trace(reader, key);
+    if (ret < 0) break;
+    ready = ret == 1;
+  }
+
+  if (ready && !map_cols(t)) {
+    shm_trace_detach(reader);
+    return false;
+  }
+  if (!ready) {
+    unmap_trace(t);
+    free(t);
+    reader->shm_trace = NULL;
+    return false;
+  }
+
+  /* the requests are indexed like a binary trace with one-byte items, so
+   * seeking, cloning and reading backward work as before */
+  reader->trace_format = BINARY_TRACE_FORMAT;
+  reader->item_size = 1;
+  reader->trace_start_offset = 0;
+  reader->mmap_offset = 0;
+  reader->file_size = t->header->n_req;
+  reader->n_total_req = t->header->n_req;
+
+  shm_trace_evict(reader->init_params.shm_cache_size);
+  return true;
+}
+
+void shm_trace_detach(reader_t *reader) {
+  struct shm_trace *t = reader->shm_trace;
+  if (t == NULL) return;
+
+  if (t->header != NULL && t->ref_slot >= 0) {
+    __atomic_store_n(&t->header->ref_pids[t->ref_slot], 0, __ATOMIC_RELEASE);
+  }
+  unmap_trace(t);
+  free(t);
+  reader->shm_trace = NULL;
+}
+
+static inline int64_t col_get(const struct shm_trace *t, int c, uint64_t idx) {
+  const shm_col_desc_t *d = &t->desc[c];
+  if (d->width == 0) return d->base;
+  return (int64_t)((uint64_t)d->base + (uint64_t)col_load(t->cols[c], d->width, idx));
+}
+
+int shm_trace_read_one_req(reader_t *reader, request_t *req) {
+  const struct shm_trace *t = reader->shm_trace;
+  uint64_t idx = reader->mmap_offset;
+
+  req->clock_time = col_get(t, SHM_COL_TIME, idx);
+  req->obj_id = (obj_id_t)col_get(t, SHM_COL_OBJ_ID, idx);
+  req->obj_size = col_get(t, SHM_COL_OBJ_SIZE, idx);
+  req->op = (req_op_e)col_get(t, SHM_COL_OP, idx);
+  req->ttl = (int32_t)col_get(t, SHM_COL_TTL, idx);
+  req->next_access_vtime = col_get(t, SHM_COL_NEXT_ACCESS_VTIME, idx);
+
+  reader->mmap_offset += 1;
+  return 0;
+}
+
+/************************** evict **************************/
+
+typedef struct {
+  char name[SHM_TRACE_NAME_LEN];
+  int64_t n_byte;
+  int64_t last_attach_time;
+  bool in_use;
+} shm_trace_info_t;
+
+static int cmp_last_attach_time(const void *a, const void *b) {
+  const shm_trace_info_t *x = a, *y = b;
+  return x->last_attach_time < y->last_attach_time ? -1 : x->last_attach_time > y->last_attach_time;
+}
+
+int64_t shm_trace_evict(int64_t max_byte) {
+  /* the POSIX shared memory of Linux is the files in /dev/shm */
+  DIR *dir = opendir(SHM_TRACE_DIR);
+  if (dir == NULL) return 0;
+
+  int n_trace = 0, n_alloc = 16;
+  shm_trace_info_t *traces = malloc(sizeof(shm_trace_info_t) * n_alloc);
+  int64_t total_byte = 0;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL) {
+    /* the headers, not the columns */
+    if (strncmp(entry->d_name, SHM_TRACE_PREFIX, strlen(SHM_TRACE_PREFIX)) != 0 ||
+        strchr(entry->d_name + strlen(SHM_TRACE_PREFIX), '.') != NULL) {
+      continue;
+    }
+
+    shm_trace_info_t info;
+    snprintf(info.name, SHM_TRACE_NAME_LEN, "/%s", entry->d_name);
+    shm_trace_header_t *header = map_header(info.name);
+    if (header == NULL) continue;
+
+    int state = __atomic_load_n(&header->state, __ATOMIC_ACQUIRE);
+    if (header->magic != SHM_TRACE_MAGIC || state != SHM_TRACE_READY) {
+      /* being built, or the builder failed */
+      munmap(header, sizeof(shm_trace_header_t));
+      continue;
+    }
+
+    info.n_byte = header->n_byte;
+    info.last_attach_time = __atomic_load_n(&header->last_attach_time, __ATOMIC_ACQUIRE);
+    info.in_use = false;
+    for (int i = 0; i < SHM_TRACE_MAX_REF && !info.in_use; i++) {
+      info.in_use = pid_alive(__atomic_load_n(&header->ref_pids[i], __ATOMIC_ACQUIRE));
+    }
+    munmap(header, sizeof(shm_trace_header_t));
+
+    if (n_trace == n_alloc) {
+      n_alloc *= 2;
+      traces = realloc(traces, sizeof(shm_trace_info_t) * n_alloc);
+    }
+    traces[n_trace++] = info;
+    total_byte += info.n_byte;
+  }
+  closedir(dir);
+
+  qsort(traces, n_trace, sizeof(shm_trace_info_t), cmp_last_attach_time);
+  int64_t n_evicted_byte = 0;
+  for (int i = 0; i < n_trace && total_byte > max_byte; i++) {
+    if (traces[i].in_use) continue;
+    INFO("evict shared memory trace %s (%.2lf MiB)\n", traces[i].name, (double)traces[i].n_byte / MiB);
+    unlink_trace(traces[i].name);
+    total_byte -= traces[i].n_byte;
+    n_evicted_byte += traces[i].n_byte;
+  }
+  free(traces);
+
+  return n_evicted_byte;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -80,6 +80,30 @@ static reader_t *setup_oracleGeneralBin_reader(void) {
   return reader_oracle;
 }
 
+static reader_t *setup_oracleGeneralBin_reader_with_hash(void) {
+  char data_path[1024];
+  _detect_data_path(data_path, "cloudPhysicsIO.oracleGeneral.bin");
+  reader_init_param_t init_params = {.ignore_size_zero_req = true,
+                                     .offload_hash = true};
+  return setup_reader(data_path, ORACLE_GENERAL_TRACE, &init_params);
+}
+
+static reader_t *setup_oracleGeneralBin_reader_shm(void) {
+  char data_path[1024];
+  _detect_data_path(data_path, "cloudPhysicsIO.oracleGeneral.bin");
+  reader_init_param_t init_params = default_reader_init_params();
+  init_params.shm_cache_size = GiB;
+  return setup_reader(data_path, ORACLE_GENERAL_TRACE, &init_params);
+}
+
+static reader_t *setup_oracleGeneralBin_reader_direct_io(void) {
+  char data_path[1024];
+  _detect_data_path(data_path, "cloudPhysicsIO.oracleGeneral.bin");
+  reader_init_param_t init_params = default_reader_init_params();
+  init_params.direct_io_n_buf = 4;
+  return setup_reader(data_path, ORACLE_GENERAL_TRACE, &init_params);
+}
+
 static reader_t *setup_GLCacheTestData_reader(void) {
   char *url =
       "https://ftp.pdl.cmu.edu/pub/datasets/twemcacheWorkload/"
@@ -172,6 +196,30 @@ static reader_t *setup_plaintxt_reader_str(void) {
   return setup_reader(data_path, PLAIN_TXT_TRACE, &init_params);
 }
 
+static reader_t *setup_csv_reader_parallel(bool obj_id_is_num) {
+  char data_path[1024];
+  _detect_data_path(data_path, "cloudPhysicsIO.csv");
+  reader_init_param_t init_params = default_reader_init_params();
+  init_params.delimiter = ',';
+  init_params.time_field = 2;
+  init_params.obj_id_field = 5;
+  init_params.obj_size_field = 4;
+  init_params.has_header = true;
+  init_params.has_header_set = true;
+  init_params.obj_id_is_num = obj_id_is_num;
+  init_params.n_parse_thread = 4;
+  return setup_reader(data_path, CSV_TRACE, &init_params);
+}
+
+static reader_t *setup_plaintxt_reader_parallel(bool obj_id_is_num) {
+  char data_path[1024];
+  _detect_data_path(data_path, "cloudPhysicsIO.txt");
+  reader_init_param_t init_params = default_reader_init_params();
+  init_params.obj_id_is_num = obj_id_is_num;
+  init_params.n_parse_thread = 4;
+  return setup_reader(data_path, PLAIN_TXT_TRACE, &init_params);
+}
+
 static void test_teardown(gpointer data) {
   reader_t *reader = (reader_t *)data;
   close_reader(reader);
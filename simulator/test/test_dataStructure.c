@@ -0,0 +1,129 @@
+//
+// tests of the data structures used by the eviction algorithms
+//
+
+#include "../libCacheSim/dataStructure/objArray.h"
+#include "common.h"
+
+#define N_TEST_OBJ 3000
+#define N_TEST_SAMPLE 100000
+
+static cache_obj_t *new_test_objs(uint64_t n) {
+  cache_obj_t *objs = g_new0(cache_obj_t, n);
+  for (uint64_t i = 0; i < n; i++) {
+    objs[i].obj_id = i;
+  }
+  return objs;
+}
+
+/* every object is at the index it stores */
+static void verify_obj_array(const obj_array_t *arr) {
+  for (uint64_t i = 0; i < arr->n_obj; i++) {
+    g_assert_cmpuint(arr->objs[i]->sample_pos, ==, i);
+  }
+}
+
+static void test_objArray_append_remove(void) {
+  obj_array_t *arr = create_obj_array(0);
+  cache_obj_t *objs = new_test_objs(N_TEST_OBJ);
+
+  for (uint64_t i = 0; i < N_TEST_OBJ; i++) {
+    obj_array_append(arr, &objs[i]);
+  }
+  g_assert_cmpuint(arr->n_obj, ==, N_TEST_OBJ);
+  g_assert_cmpuint(arr->capacity, >=, N_TEST_OBJ);
+  verify_obj_array(arr);
+
+  /* the last object moves into the slot of the removed one */
+  obj_array_remove(arr, &objs[10]);
+  g_assert_true(arr->objs[10] == &objs[N_TEST_OBJ - 1]);
+  g_assert_cmpuint(arr->n_obj, ==, N_TEST_OBJ - 1);
+
+  /* removing the last object moves nothing */
+  obj_array_remove(arr, &objs[N_TEST_OBJ - 2]);
+  g_assert_true(arr->objs[10] == &objs[N_TEST_OBJ - 1]);
+  g_assert_cmpuint(arr->n_obj, ==, N_TEST_OBJ - 2);
+  verify_obj_array(arr);
+
+  /* remove the rest from the front */
+  while (arr->n_obj > 0) {
+    obj_array_remove(arr, arr->objs[0]);
+    verify_obj_array(arr);
+  }
+
+  free_obj_array(arr);
+  g_free(objs);
+}
+
+static void test_objArray_rand(void) {
+  obj_array_t *arr = create_obj_array(0);
+  cache_obj_t *objs = new_test_objs(N_TEST_REQ * 2);
+  uint64_t cnt[N_TEST_REQ * 2] = {0};
+
+  for (int i = 0; i < N_TEST_REQ * 2; i++) {
+    obj_array_append(arr, &objs[i]);
+  }
+  for (int i = 0; i < N_TEST_REQ * 2; i += 2) {
+    obj_array_remove(arr, &objs[i]);
+  }
+
+  for (int i = 0; i < N_TEST_SAMPLE; i++) {
+    cnt[obj_array_rand(arr)->obj_id] += 1;
+  }
+  /* the removed objects are never drawn, the others equally often */
+  uint64_t expected = N_TEST_SAMPLE / N_TEST_REQ;
+  for (int i = 0; i < N_TEST_REQ * 2; i++) {
+    if (i % 2 == 0) {
+      g_assert_cmpuint(cnt[i], ==, 0);
+    } else {
+      g_assert_cmpuint(cnt[i], >, expected * 9 / 10);
+      g_assert_cmpuint(cnt[i], <, expected * 11 / 10);
+    }
+  }
+
+  free_obj_array(arr);
+  g_free(objs);
+}
+
+static void test_objArray_cache(gconstpointer user_data) {
+  reader_t *reader = (reader_t *)user_data;
+  common_cache_params_t cc_params = {
+      .cache_size = CACHE_SIZE / 16, .hashpower = 20, .default_ttl = 0};
+  cache_t *cache = create_test_cache("Random", cc_params, reader, NULL);
+  request_t *req = new_request();
+
+  /* the array holds exactly the resident objects */
+  read_one_req(reader, req);
+  while (req->valid) {
+    cache->get(cache, req);
+    read_one_req(reader, req);
+  }
+  const obj_array_t *arr = cache->sample_array;
+  g_assert_true(arr != NULL);
+  g_assert_cmpuint(arr->n_obj, ==, cache->n_obj);
+  verify_obj_array(arr);
+  for (uint64_t i = 0; i < arr->n_obj; i++) {
+    req->obj_id = arr->objs[i]->obj_id;
+    req->hv = 0;
+    g_assert_true(cache->find(cache, req, false) == arr->objs[i]);
+  }
+
+  reset_reader(reader);
+  free_request(req);
+  cache->cache_free(cache);
+}
+
+int main(int argc, char *argv[]) {
+  g_test_init(&argc, &argv, NULL);
+  srand(0);  // for reproducibility
+  set_rand_seed(rand());
+
+  g_test_add_func("/libCacheSim/objArray_append_remove",
+                  test_objArray_append_remove);
+  g_test_add_func("/libCacheSim/objArray_rand", test_objArray_rand);
+  g_test_add_data_func_full("/libCacheSim/objArray_cache",
+                            setup_oracleGeneralBin_reader(),
+                            test_objArray_cache, test_teardown);
+
+  return g_test_run();
+}
@@ -591,5 +591,12 @@ int main(int argc, char *argv[]) {
   g_test_add_data_func_full("/libCacheSim/empty", reader, empty_test,
                             test_teardown);
 
+  /* the hash table uses the hash computed by the reader */
+  reader = setup_oracleGeneralBin_reader_with_hash();
+  g_test_add_data_func("/libCacheSim/cacheAlgo_LRU_offload_hash", reader,
+                       test_LRU);
+  g_test_add_data_func_full("/libCacheSim/cacheAlgo_S3FIFO_offload_hash",
+                            reader, test_S3FIFO, test_teardown);
+
   return g_test_run();
 }
@@ -2,6 +2,9 @@
 // Created by Juncheng Yang on 11/19/19.
 //
 
+#include "../libCacheSim/dataStructure/hash/hash.h"
+#include "../libCacheSim/include/libCacheSim/shmTrace.h"
+#include "../libCacheSim/traceReader/generalReader/directReader.h"
 #include "common.h"
 
 // defined in reader.c file, not in public interface
@@ -134,6 +137,200 @@ void test_reader_more2(gconstpointer user_data) {
   close_reader(cloned_reader);
 }
 
+void test_reader_offload_hash(gconstpointer user_data) {
+  reader_t *reader = (reader_t *)user_data;
+  request_t *req = new_request();
+  obj_id_t obj_ids[N_TEST_REQ];
+  uint64_t hvs[N_TEST_REQ];
+
+  // the reader stores the hash of each request
+  for (int i = 0; i < N_TEST_REQ; i++) {
+    read_one_req(reader, req);
+    verify_req(reader, req, i);
+    g_assert_cmpuint(req->hv, ==, get_hash_value_int_64(&req->obj_id));
+    obj_ids[i] = req->obj_id;
+  }
+
+  // the batch hash gives the same values
+  get_hash_value_int_64_batch(obj_ids, hvs, N_TEST_REQ);
+  for (int i = 0; i < N_TEST_REQ; i++) {
+    g_assert_cmpuint(hvs[i], ==, get_hash_value_int_64(&obj_ids[i]));
+  }
+  reset_reader(reader);
+
+  // check clone reader
+  reader_t *cloned_reader = clone_reader(reader);
+  read_one_req(cloned_reader, req);
+  verify_req(cloned_reader, req, 0);
+  g_assert_cmpuint(req->hv, ==, hvs[0]);
+  close_reader(cloned_reader);
+
+  free_request(req);
+}
+
+// the reader gives the same requests as a reader that reads the trace file
+// one request at a time
+void test_reader_same_as_default(gconstpointer user_data) {
+  reader_t *reader = (reader_t *)user_data;
+  reader_init_param_t init_params = reader->init_params;
+  init_params.shm_cache_size = 0;
+  init_params.direct_io_n_buf = 0;
+  init_params.n_parse_thread = 0;
+  reader_t *default_reader =
+      setup_reader(reader->trace_path, reader->trace_type, &init_params);
+  request_t *req = new_request();
+  request_t *default_req = new_request();
+  uint64_t n_req = 0;
+
+  read_one_req(reader, req);
+  read_one_req(default_reader, default_req);
+  while (default_req->valid) {
+    g_assert_true(req->valid);
+    g_assert_cmpuint(req->obj_id, ==, default_req->obj_id);
+    g_assert_cmpint(req->obj_size, ==, default_req->obj_size);
+    g_assert_cmpint(req->clock_time, ==, default_req->clock_time);
+    g_assert_cmpint(req->next_access_vtime, ==,
+                    default_req->next_access_vtime);
+    n_req += 1;
+    read_one_req(reader, req);
+    read_one_req(default_reader, default_req);
+  }
+  g_assert_false(req->valid);
+  g_assert_cmpuint(n_req, ==, get_num_of_req(default_reader));
+  reset_reader(reader);
+
+  close_reader(default_reader);
+  free_request(req);
+  free_request(default_req);
+}
+
+void test_reader_shm(gconstpointer user_data) {
+  reader_t *reader = (reader_t *)user_data;
+  g_assert_true(reader->shm_trace != NULL);
+
+  // a second reader of the trace attaches to the decoded trace
+  reader_t *cloned_reader = clone_reader(reader);
+  g_assert_true(cloned_reader->shm_trace != NULL);
+  test_reader_basic(cloned_reader);
+  close_reader(cloned_reader);
+}
+
+static void test_teardown_shm(gpointer data) {
+  test_teardown(data);
+  // the decoded trace is not used by any reader and is removed
+  g_assert_cmpint(shm_trace_evict(0), >, 0);
+}
+
+void test_reader_direct_io(gconstpointer user_data) {
+  reader_t *reader = (reader_t *)user_data;
+  g_assert_true(reader->direct_reader_p != NULL);
+
+  reader_t *cloned_reader = clone_reader(reader);
+  g_assert_true(cloned_reader->direct_reader_p != NULL);
+  test_reader_basic(cloned_reader);
+  close_reader(cloned_reader);
+}
+
+#define DIRECT_TEST_FILE "directReader.test.bin"
+#define DIRECT_TEST_REC_SIZE 24
+
+// the records span the buffers because the buffer size is not a multiple of
+// the record size
+void test_direct_reader_read_bytes(void) {
+  int64_t n_word = (DIRECT_READER_BUF_SIZE * 2 + 1234) / sizeof(uint32_t);
+  FILE *f = fopen(DIRECT_TEST_FILE, "wb");
+  g_assert_true(f != NULL);
+  for (uint32_t i = 0; i < n_word; i++) {
+    g_assert_cmpint(fwrite(&i, sizeof(i), 1, f), ==, 1);
+  }
+  fclose(f);
+
+  direct_reader_t *reader = create_direct_reader(DIRECT_TEST_FILE, 2, -1);
+  g_assert_true(reader != NULL);
+  g_assert_cmpint(reader->file_size, ==, n_word * sizeof(uint32_t));
+
+  int64_t n_rec = reader->file_size / DIRECT_TEST_REC_SIZE;
+  for (int64_t i = 0; i < n_rec; i++) {
+    int64_t offset = i * DIRECT_TEST_REC_SIZE;
+    uint32_t *rec = (uint32_t *)direct_reader_read_bytes(reader, offset,
+                                                         DIRECT_TEST_REC_SIZE);
+    g_assert_true(rec != NULL);
+    for (size_t j = 0; j < DIRECT_TEST_REC_SIZE / sizeof(uint32_t); j++) {
+      g_assert_cmpuint(rec[j], ==, offset / sizeof(uint32_t) + j);
+    }
+  }
+
+  // a partial record at the end of the file
+  g_assert_true(direct_reader_read_bytes(reader, n_rec * DIRECT_TEST_REC_SIZE,
+                                         DIRECT_TEST_REC_SIZE) == NULL);
+
+  // reading backward restarts the reads
+  uint32_t *rec = (uint32_t *)direct_reader_read_bytes(reader, 400, 8);
+  g_assert_true(rec != NULL);
+  g_assert_cmpuint(rec[0], ==, 100);
+  g_assert_cmpuint(rec[1], ==, 101);
+
+  free_direct_reader(reader);
+  g_assert_cmpint(unlink(DIRECT_TEST_FILE), ==, 0);
+}
+
+#define QUOTED_CSV_TEST_FILE "txtParallel.test.csv"
+#define QUOTED_CSV_N_REQ 40000
+
+// every line has a quoted field with line ends, delimiters and quotes, the
+// trace is longer than a few chunks so some chunks are cut inside the field
+void test_reader_quoted_csv(void) {
+  FILE *f = fopen(QUOTED_CSV_TEST_FILE, "w");
+  g_assert_true(f != NULL);
+  fprintf(f, "time,id,size,note\n");
+  for (int i = 0; i < QUOTED_CSV_N_REQ; i++) {
+    fprintf(f, "%d,%d,%d,\"", i, i * 7 + 1, i % 1000 + 1);
+    for (int j = 0; j < 8; j++) {
+      fprintf(f, "line %d of request %d, \"\"quoted\"\" text\n", j, i);
+    }
+    fprintf(f, "\"\n");
+  }
+  fclose(f);
+
+  reader_init_param_t init_params = default_reader_init_params();
+  init_params.time_field = 1;
+  init_params.obj_id_field = 2;
+  init_params.obj_size_field = 3;
+  init_params.has_header = true;
+  init_params.has_header_set = true;
+  init_params.n_parse_thread = 4;
+  reader_t *reader = setup_reader(QUOTED_CSV_TEST_FILE, CSV_TRACE,
+                                  &init_params);
+  g_assert_true(reader->txt_parallel != NULL);
+  g_assert_cmpuint(get_num_of_req(reader), ==, QUOTED_CSV_N_REQ);
+
+  request_t *req = new_request();
+  for (int i = 0; i < QUOTED_CSV_N_REQ; i++) {
+    read_one_req(reader, req);
+    g_assert_true(req->valid);
+    g_assert_cmpint(req->clock_time, ==, i);
+    g_assert_cmpuint(req->obj_id, ==, i * 7 + 1);
+    g_assert_cmpint(req->obj_size, ==, i % 1000 + 1);
+  }
+  read_one_req(reader, req);
+  g_assert_false(req->valid);
+
+  // read backward over the chunks
+  reader_set_read_pos(reader, 1.0);
+  for (int i = QUOTED_CSV_N_REQ - 1; i >= 0; i--) {
+    g_assert_cmpint(go_back_one_req(reader), ==, 0);
+    read_one_req(reader, req);
+    g_assert_cmpuint(req->obj_id, ==, i * 7 + 1);
+    g_assert_cmpint(go_back_one_req(reader), ==, 0);
+  }
+
+  free_request(req);
+  close_reader(reader);
+  g_assert_cmpint(unlink(QUOTED_CSV_TEST_FILE), ==, 0);
+  // counting the requests writes the manifest next to the trace
+  unlink(QUOTED_CSV_TEST_FILE ".manifest");
+}
+
 void test_twr(gconstpointer user_data) {
   reader_t *reader = setup_reader("/Users/junchengy/twr.sbin", TWR_TRACE, NULL);
   gint64 n_req = get_num_of_req(reader);
@@ -186,6 +383,49 @@ int main(int argc, char *argv[]) {
   g_test_add_data_func_full("/libCacheSim/reader_more2_csv_str", reader,
                             test_reader_more2, test_teardown);
 
+  reader = setup_csv_reader_parallel(true);
+  g_test_add_data_func("/libCacheSim/reader_basic_csv_num_parallel", reader,
+                       test_reader_basic);
+  g_test_add_data_func("/libCacheSim/reader_same_csv_num_parallel", reader,
+                       test_reader_same_as_default);
+  g_test_add_data_func("/libCacheSim/reader_more1_csv_num_parallel", reader,
+                       test_reader_more1);
+  g_test_add_data_func_full("/libCacheSim/reader_more2_csv_num_parallel",
+                            reader, test_reader_more2, test_teardown);
+
+  reader = setup_csv_reader_parallel(false);
+  g_test_add_data_func("/libCacheSim/reader_basic_csv_str_parallel", reader,
+                       test_reader_basic);
+  g_test_add_data_func("/libCacheSim/reader_same_csv_str_parallel", reader,
+                       test_reader_same_as_default);
+  g_test_add_data_func("/libCacheSim/reader_more1_csv_str_parallel", reader,
+                       test_reader_more1);
+  g_test_add_data_func_full("/libCacheSim/reader_more2_csv_str_parallel",
+                            reader, test_reader_more2, test_teardown);
+
+  reader = setup_plaintxt_reader_parallel(true);
+  g_test_add_data_func("/libCacheSim/reader_basic_plain_num_parallel", reader,
+                       test_reader_basic);
+  g_test_add_data_func("/libCacheSim/reader_same_plain_num_parallel", reader,
+                       test_reader_same_as_default);
+  g_test_add_data_func("/libCacheSim/reader_more1_plain_num_parallel", reader,
+                       test_reader_more1);
+  g_test_add_data_func_full("/libCacheSim/reader_more2_plain_num_parallel",
+                            reader, test_reader_more2, test_teardown);
+
+  reader = setup_plaintxt_reader_parallel(false);
+  g_test_add_data_func("/libCacheSim/reader_basic_plain_str_parallel", reader,
+                       test_reader_basic);
+  g_test_add_data_func("/libCacheSim/reader_same_plain_str_parallel", reader,
+                       test_reader_same_as_default);
+  g_test_add_data_func("/libCacheSim/reader_more1_plain_str_parallel", reader,
+                       test_reader_more1);
+  g_test_add_data_func_full("/libCacheSim/reader_more2_plain_str_parallel",
+                            reader, test_reader_more2, test_teardown);
+
+  g_test_add_func("/libCacheSim/reader_quoted_csv_parallel",
+                  test_reader_quoted_csv);
+
   reader = setup_binary_reader();
   g_test_add_data_func("/libCacheSim/reader_basic_binary", reader,
                        test_reader_basic);
@@ -210,6 +450,30 @@ int main(int argc, char *argv[]) {
   g_test_add_data_func_full("/libCacheSim/reader_more2_oracleGeneral", reader,
                             test_reader_more2, test_teardown);
 
+  reader = setup_oracleGeneralBin_reader_with_hash();
+  g_test_add_data_func("/libCacheSim/reader_basic_oracleGeneral_hash", reader,
+                       test_reader_basic);
+  g_test_add_data_func_full("/libCacheSim/reader_offload_hash_oracleGeneral",
+                            reader, test_reader_offload_hash, test_teardown);
+
+  reader = setup_oracleGeneralBin_reader_shm();
+  g_test_add_data_func("/libCacheSim/reader_basic_oracleGeneral_shm", reader,
+                       test_reader_basic);
+  g_test_add_data_func("/libCacheSim/reader_same_oracleGeneral_shm", reader,
+                       test_reader_same_as_default);
+  g_test_add_data_func_full("/libCacheSim/reader_shm_oracleGeneral", reader,
+                            test_reader_shm, test_teardown_shm);
+
+  reader = setup_oracleGeneralBin_reader_direct_io();
+  g_test_add_data_func("/libCacheSim/reader_basic_oracleGeneral_direct", reader,
+                       test_reader_basic);
+  g_test_add_data_func("/libCacheSim/reader_same_oracleGeneral_direct", reader,
+                       test_reader_same_as_default);
+  g_test_add_data_func_full("/libCacheSim/reader_direct_io_oracleGeneral",
+                            reader, test_reader_direct_io, test_teardown);
+  g_test_add_func("/libCacheSim/direct_reader_read_bytes",
+                  test_direct_reader_read_bytes);
+
   // g_test_add_data_func("/libCacheSim/test_twr", NULL, test_twr);
   return g_test_run();
 }
\ No newline at end of file